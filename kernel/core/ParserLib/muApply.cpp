@@ -16,6 +16,7 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 ******************************************************************************/
 
+#include <algorithm>
 #include "muApply.hpp"
 #include "muStructures.hpp"
 
@@ -43,6 +44,93 @@ namespace mu
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief Apply a function to an Array. Real
+    /// homogeneous Arrays are passed to the
+    /// real-valued kernel at once and the result is
+    /// packed, other Arrays are collected in small
+    /// blocks. Elements, for which the kernel
+    /// returns NaN (e.g. because the result leaves
+    /// the real domain), and blocks containing
+    /// complex or non-numerical values are evaluated
+    /// using the complex function.
+    ///
+    /// \param func std::complex<double>(*func)(const std::complex<double>&)
+    /// \param kernel RealKernel
+    /// \param a const Array&
+    /// \return Array
+    ///
+    /////////////////////////////////////////////////
+    Array apply(std::complex<double>(*func)(const std::complex<double>&), RealKernel kernel, const Array& a)
+    {
+        if (a.size() < NumArray::MIN_SIZE)
+            return apply(func, a);
+
+        NumArray numBuffer;
+        const NumArray& num = NumArray::view(a, numBuffer);
+
+        if (num.isValid() && num.getStorage() != NumArray::STORE_COMPLEX)
+        {
+            std::vector<double> buffer;
+            const double* vals = num.asReals(buffer);
+            std::vector<double> res(num.size());
+
+            kernel(vals, res.data(), res.size());
+
+            if (std::none_of(res.begin(), res.end(), [](double v){return std::isnan(v);}))
+                return Array(NumArray(std::move(res), F64));
+
+            Array ret;
+            ret.reserve(res.size());
+
+            for (size_t i = 0; i < res.size(); i++)
+            {
+                if (std::isnan(res[i]))
+                    ret.emplace_back(func(vals[i]));
+                else
+                    ret.emplace_back(res[i]);
+            }
+
+            return ret;
+        }
+
+        // Block size keeping both buffers within the L1 cache
+        const size_t BLOCKSIZE = 256;
+        double vals[BLOCKSIZE];
+        double res[BLOCKSIZE];
+
+        Array ret;
+        ret.reserve(a.size());
+
+        for (size_t i = 0; i < a.size(); i += BLOCKSIZE)
+        {
+            size_t nBlock = std::min(BLOCKSIZE, a.size()-i);
+
+            if (!NumArray::gatherReals(a, i, nBlock, vals))
+            {
+                for (size_t j = 0; j < nBlock; j++)
+                {
+                    ret.emplace_back(func(a[i+j].getNum().asCF64()));
+                }
+
+                continue;
+            }
+
+            kernel(vals, res, nBlock);
+
+            for (size_t j = 0; j < nBlock; j++)
+            {
+                if (std::isnan(res[j]))
+                    ret.emplace_back(func(vals[j]));
+                else
+                    ret.emplace_back(res[j]);
+            }
+        }
+
+        return ret;
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief Apply a function to an Array.
     ///
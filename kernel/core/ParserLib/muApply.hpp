@@ -22,6 +22,8 @@
 #include <complex>
 #include <string>
 
+#include "muSimd.hpp"
+
 namespace mu
 {
     class Array;
@@ -29,6 +31,9 @@ namespace mu
 
     Array apply(std::complex<double>(*)(const std::complex<double>&),
                 const Array& a);
+    Array apply(std::complex<double>(*)(const std::complex<double>&),
+                RealKernel kernel,
+                const Array& a);
     Array apply(Value(*)(const Value&),
                 const Array& a);
     Array apply(std::string(*)(const std::string&),
@@ -28,6 +28,7 @@
 
 //--- Standard includes ------------------------------------------------------------------------
 #include <cmath>
+#include <array>
 #include <algorithm>
 #include <numeric>
 
@@ -86,6 +87,45 @@ namespace mu
         return !v;
     }
 
+    /////////////////////////////////////////////////
+    /// \brief Scalar counterpart of the unary minus
+    /// operator for the compiled expression tier.
+    ///
+    /// \param v const Value&
+    /// \return Value
+    ///
+    /////////////////////////////////////////////////
+    Value Parser::UnaryMinusScalar(const Value& v)
+    {
+        return -v;
+    }
+
+    /////////////////////////////////////////////////
+    /// \brief Scalar counterpart of the unary plus
+    /// operator for the compiled expression tier.
+    ///
+    /// \param v const Value&
+    /// \return Value
+    ///
+    /////////////////////////////////////////////////
+    Value Parser::UnaryPlusScalar(const Value& v)
+    {
+        return v;
+    }
+
+    /////////////////////////////////////////////////
+    /// \brief Scalar counterpart of the logical NOT
+    /// operator for the compiled expression tier.
+    ///
+    /// \param v const Value&
+    /// \return Value
+    ///
+    /////////////////////////////////////////////////
+    Value Parser::LogicalNotScalar(const Value& v)
+    {
+        return !v;
+    }
+
     //---------------------------------------------------------------------------
     /** \brief Callback for adding multiple values.
         \param [in] a_afArg Vector with the function arguments
@@ -234,6 +274,10 @@ namespace mu
         DefineInfixOprt("-", UnaryMinus);
         DefineInfixOprt("+", UnaryPlus);
         DefineInfixOprt("!", LogicalNot);
+
+        DefineScalarFun(UnaryMinus, UnaryMinusScalar);
+        DefineScalarFun(UnaryPlus, UnaryPlusScalar);
+        DefineScalarFun(LogicalNot, LogicalNotScalar);
     }
 
     //---------------------------------------------------------------------------
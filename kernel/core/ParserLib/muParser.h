@@ -72,6 +72,11 @@ namespace mu
             static Array  UnaryPlus(const Array&);
             static Array  LogicalNot(const Array&);
 
+            // Scalar counterparts of the prefix operators
+            static Value  UnaryMinusScalar(const Value&);
+            static Value  UnaryPlusScalar(const Value&);
+            static Value  LogicalNotScalar(const Value&);
+
             // Functions with variable number of arguments
             static Array Sum(const Array*, int);  // sum
             static Array Avg(const Array*, int);  // mean value
@@ -25,6 +25,7 @@
 
 #include "muParserBase.h"
 #include "muParserTemplateMagic.h"
+#include "muParserParallel.hpp"
 #include "muHelpers.hpp"
 #include "../utils/tools.hpp"
 #include "../utils/timer.hpp"
@@ -38,6 +39,7 @@
 #include <deque>
 #include <sstream>
 #include <locale>
+#include <atomic>
 #include <omp.h>
 
 using namespace std;
@@ -127,6 +129,10 @@ namespace mu
 		bPauseLoopByteCode = false;
 		bPauseLock = false;
 		m_state = &m_compilingState;
+		m_byteCodeCache = nullptr;
+		m_nCacheLine = -1;
+		m_bEnableJit = false;
+		m_nDefinitionStamp = 0;
 		nMaxThreads = omp_get_max_threads();// std::min(omp_get_max_threads(), s_MaxNumOpenMPThreads);
 	}
 
@@ -190,11 +196,14 @@ namespace mu
 		m_PostOprtDef = a_Parser.m_PostOprtDef;   // post value unary operators
 		m_InfixOprtDef = a_Parser.m_InfixOprtDef; // unary operators for infix notation
 		m_OprtDef = a_Parser.m_OprtDef;           // binary operators
+		m_ScalarDef = a_Parser.m_ScalarDef;       // scalar function counterparts
+		m_bEnableJit = a_Parser.m_bEnableJit;
 
 		m_sNameChars = a_Parser.m_sNameChars;
 		m_sOprtChars = a_Parser.m_sOprtChars;
 		m_sInfixOprtChars = a_Parser.m_sInfixOprtChars;
 		nCurrVectorIndex = a_Parser.nCurrVectorIndex;
+		m_nDefinitionStamp = a_Parser.m_nDefinitionStamp;
 	}
 
 	//---------------------------------------------------------------------------
@@ -209,6 +218,7 @@ namespace mu
 	{
 		char_type cThousandsSep = std::use_facet< change_dec_sep<char_type> >(s_locale).thousands_sep();
 		s_locale = std::locale(std::locale("C"), new change_dec_sep<char_type>(cDecSep, cThousandsSep));
+		SharedExpressionCache::get().clear();
 	}
 
 	//---------------------------------------------------------------------------
@@ -223,6 +233,7 @@ namespace mu
 	{
 		char_type cDecSep = std::use_facet< change_dec_sep<char_type> >(s_locale).decimal_point();
 		s_locale = std::locale(std::locale("C"), new change_dec_sep<char_type>(cDecSep, cThousandsSep));
+		SharedExpressionCache::get().clear();
 	}
 
 	//---------------------------------------------------------------------------
@@ -234,6 +245,7 @@ namespace mu
 	void ParserBase::ResetLocale()
 	{
 		s_locale = std::locale(std::locale("C"), new change_dec_sep<char_type>('.'));
+		SharedExpressionCache::get().clear();
 		SetArgSep(',');
 	}
 
@@ -364,6 +376,7 @@ namespace mu
 	void ParserBase::AddValIdent(identfun_type a_pCallback)
 	{
 		m_pTokenReader->AddValIdent(a_pCallback);
+		m_nDefinitionStamp = 0;
 	}
 
 	//---------------------------------------------------------------------------
@@ -393,6 +406,7 @@ namespace mu
 
 		CheckOprt(a_strName, a_Callback, a_szCharSet);
 		a_Storage[a_strName] = a_Callback;
+		m_nDefinitionStamp = 0;
 		ReInit();
 	}
 
@@ -453,7 +467,10 @@ namespace mu
 		// -> Return, if that is true
 		// -> Invalidate the bytecode for this formula, if necessary
 		if (IsAlreadyParsed(a_sExpr))
+        {
+            m_nCacheLine = -1;
 			return;
+        }
 		else if (bMakeLoopByteCode
                  && !bPauseLoopByteCode
                  && this->GetExpr().length()
@@ -1012,6 +1029,7 @@ namespace mu
 	void ParserBase::DefineNameChars(const char_type* a_szCharset)
 	{
 		m_sNameChars = a_szCharset;
+		m_nDefinitionStamp = 0;
 	}
 
 	//---------------------------------------------------------------------------
@@ -1021,6 +1039,7 @@ namespace mu
 	void ParserBase::DefineOprtChars(const char_type* a_szCharset)
 	{
 		m_sOprtChars = a_szCharset;
+		m_nDefinitionStamp = 0;
 	}
 
 	//---------------------------------------------------------------------------
@@ -1030,6 +1049,7 @@ namespace mu
 	void ParserBase::DefineInfixOprtChars(const char_type* a_szCharset)
 	{
 		m_sInfixOprtChars = a_szCharset;
+		m_nDefinitionStamp = 0;
 	}
 
 	//---------------------------------------------------------------------------
@@ -1199,6 +1219,7 @@ namespace mu
 	{
 		CheckName(a_sName, ValidNameChars());
 		m_ConstDef[a_sName] = a_fVal;
+		m_nDefinitionStamp = 0;
 		ReInit();
 	}
 
@@ -1620,9 +1641,226 @@ namespace mu
 	*/
 	void ParserBase::ParseCmdCode()
 	{
+	    // Use the compiled tier, if it is enabled and
+	    // the current bytecode is hot
+	    if (m_bEnableJit && m_state->m_byteCode.EvalJit(&m_state->m_stackBuffer[0], m_ScalarDef))
+            return;
+
+        // Evaluate large element-wise expressions in
+        // parallel blocks
+        size_t nVectorLength = GetParallelVectorLength();
+
+        if (nVectorLength && ParseCmdCodeBulkParallel(nVectorLength))
+            return;
+
 		ParseCmdCodeBulk(0, 0);
 	}
 
+    /////////////////////////////////////////////////
+    /// \brief Static helper returning the Array
+    /// referenced by a non-stack operand of a fused
+    /// register instruction.
+    ///
+    /// \param arg const SOperand&
+    /// \return const Array&
+    ///
+    /////////////////////////////////////////////////
+    static const Array& getOperand(const SOperand& arg)
+    {
+        if (arg.src == SOperand::SRC_VAR)
+            return *arg.var;
+
+        return arg.val;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper applying a built-in
+    /// binary operator in the same way as the
+    /// bytecode interpreter does. The result may be
+    /// the same instance as the left operand.
+    ///
+    /// \param oprt ECmdCode
+    /// \param res Array&
+    /// \param lhs const Array&
+    /// \param rhs const Array&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void applyBinOprt(ECmdCode oprt, Array& res, const Array& lhs, const Array& rhs)
+    {
+        switch (oprt)
+        {
+            case cmLE:
+                res = lhs <= rhs;
+                return;
+            case cmGE:
+                res = lhs >= rhs;
+                return;
+            case cmNEQ:
+                res = lhs != rhs;
+                return;
+            case cmEQ:
+                res = lhs == rhs;
+                return;
+            case cmLT:
+                res = lhs < rhs;
+                return;
+            case cmGT:
+                res = lhs > rhs;
+                return;
+            case cmPOW:
+                res = lhs.pow(rhs);
+                return;
+            case cmLAND:
+                res = lhs && rhs;
+                return;
+            case cmLOR:
+                res = lhs || rhs;
+                return;
+            default:
+                break;
+        }
+
+        // The arithmetic operators are applied in place
+        if (&res != &lhs)
+            res = lhs;
+
+        switch (oprt)
+        {
+            case cmADD:
+                res += rhs;
+                return;
+            case cmSUB:
+                res -= rhs;
+                return;
+            case cmMUL:
+                res *= rhs;
+                return;
+            case cmDIV:
+                res /= rhs;
+                return;
+            default:
+                throw ParserError(ecINTERNAL_ERROR);
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper comparing two single
+    /// values with the passed comparison operator.
+    ///
+    /// \param oprt ECmdCode
+    /// \param lhs const Value&
+    /// \param rhs const Value&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    static bool compareValues(ECmdCode oprt, const Value& lhs, const Value& rhs)
+    {
+        switch (oprt)
+        {
+            case cmLE:
+                return bool(lhs <= rhs);
+            case cmGE:
+                return bool(lhs >= rhs);
+            case cmNEQ:
+                return bool(lhs != rhs);
+            case cmEQ:
+                return bool(lhs == rhs);
+            case cmLT:
+                return bool(lhs < rhs);
+            case cmGT:
+                return bool(lhs > rhs);
+            default:
+                throw ParserError(ecINTERNAL_ERROR);
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Evaluate a fused binary operator
+    /// instruction. Only the first operand may be
+    /// read from the stack.
+    ///
+    /// \param reg const SRegData&
+    /// \param Stack Array*
+    /// \param sidx int&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void evalRegOprt(const SRegData& reg, Array* Stack, int& sidx)
+    {
+        sidx += 1 - reg.stackArgs;
+        Array& res = Stack[sidx];
+
+        applyBinOprt(reg.oprt, res, reg.stackArgs ? res : getOperand(reg.args[0]), getOperand(reg.args[1]));
+
+        if (reg.argc > 2)
+            applyBinOprt(reg.oprt2, res, res, getOperand(reg.args[2]));
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Evaluate a fused select instruction
+    /// of the ternary operator. If the condition is
+    /// a comparison of plain operands, it is
+    /// evaluated element-wise together with the
+    /// selection to avoid the temporary condition
+    /// Array.
+    ///
+    /// \param reg const SRegData&
+    /// \param Stack Array*
+    /// \param sidx int&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void evalRegSelect(const SRegData& reg, Array* Stack, int& sidx)
+    {
+        sidx += 1 - reg.stackArgs;
+
+        if (reg.argc == 3)
+        {
+            Stack[sidx] = (*(fun_type3)reg.fun)(reg.stackArgs ? Stack[sidx] : getOperand(reg.args[0]),
+                                                getOperand(reg.args[1]),
+                                                getOperand(reg.args[2]));
+            return;
+        }
+
+        const Array& lhs = getOperand(reg.args[0]);
+        const Array& rhs = getOperand(reg.args[1]);
+        const Array& trueCase = getOperand(reg.args[2]);
+        const Array& falseCase = getOperand(reg.args[3]);
+
+        size_t nCond = std::max(lhs.size(), rhs.size());
+        size_t nElems = std::max({nCond, trueCase.size(), falseCase.size()});
+
+        // Use the separate condition, if it cannot be
+        // broadcasted or if the typed comparison
+        // kernels are faster
+        if ((nCond != 1 && nCond != nElems) || nCond >= NumArray::MIN_SIZE)
+        {
+            Array cond;
+            applyBinOprt(reg.oprt, cond, lhs, rhs);
+            Stack[sidx] = (*(fun_type3)reg.fun)(cond, trueCase, falseCase);
+            return;
+        }
+
+        Array ret(nElems);
+        bool cond = nCond == 1 && compareValues(reg.oprt, lhs.get(0), rhs.get(0));
+
+        for (size_t i = 0; i < nElems; i++)
+        {
+            if (nCond > 1)
+                cond = compareValues(reg.oprt, lhs.get(i), rhs.get(i));
+
+            ret.get(i) = cond ? trueCase.get(i) : falseCase.get(i);
+        }
+
+        Stack[sidx] = std::move(ret);
+    }
+
+
 	//---------------------------------------------------------------------------
 	/** \brief Evaluate the RPN.
 	    \param nOffset The offset added to variable addresses (for bulk mode)
@@ -1641,10 +1879,27 @@ namespace mu
             ? &m_state->m_stackBuffer[0]
             : &m_state->m_stackBuffer[nThreadID * (m_state->m_stackBuffer.size() / nMaxThreads)];
 
+        EvalByteCode(m_state->m_byteCode.GetBase(), Stack);
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Evaluate the bytecode starting at the
+    /// passed token using the passed stack. The
+    /// results are stored beginning at the second
+    /// element of the stack.
+    ///
+    /// \param pTok SToken*
+    /// \param Stack Array*
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+	void ParserBase::EvalByteCode(SToken* pTok, Array* Stack)
+	{
 		Array buf;
 		int sidx(0);
 
-        for (SToken* pTok = m_state->m_byteCode.GetBase(); pTok->Cmd != cmEND ; ++pTok)
+        for ( ; pTok->Cmd != cmEND ; ++pTok)
         {
             switch (pTok->Cmd)
             {
@@ -1801,6 +2056,24 @@ namespace mu
                     Stack[++sidx] = pTok->Val().data2 + Array(*pTok->Val().var) * pTok->Val().data;
                     continue;
 
+                // stored results of common subexpressions
+                case  cmSTORE:
+                    Stack[pTok->Oprt().offset] = Stack[sidx];
+                    continue;
+
+                case  cmLOAD:
+                    Stack[++sidx] = Stack[pTok->Oprt().offset];
+                    continue;
+
+                // fused register instructions
+                case  cmREGOP:
+                    evalRegOprt(pTok->Reg(), Stack, sidx);
+                    continue;
+
+                case  cmREGSELECT:
+                    evalRegSelect(pTok->Reg(), Stack, sidx);
+                    continue;
+
                 // Next is treatment of numeric functions
                 case  cmFUNC:
                     {
@@ -1941,331 +2214,182 @@ namespace mu
 
 
     /////////////////////////////////////////////////
-    /// \brief OpenMP optimized parallel bytecode
-    /// executor.
+    /// \brief Evaluate the current element-wise
+    /// bytecode in parallel. The vector variables
+    /// are split into cache-sized blocks, which are
+    /// distributed dynamically among the threads,
+    /// i.e. idle threads take over the remaining
+    /// blocks. Every thread evaluates its blocks
+    /// with a private copy of the bytecode
+    /// referencing thread-local slices of the
+    /// vector variables and writes its results in
+    /// place into the result arrays. Returns false,
+    /// if one of the blocks could not be evaluated.
+    /// The bytecode has to be evaluated serially in
+    /// this case, which will then also report the
+    /// corresponding error.
     ///
     /// \param nVectorLength size_t
-    /// \return void
+    /// \return bool
     ///
     /////////////////////////////////////////////////
-	void ParserBase::ParseCmdCodeBulkParallel(size_t nVectorLength)
+	bool ParserBase::ParseCmdCodeBulkParallel(size_t nVectorLength)
 	{
-	    size_t nBufferOffset = m_state->m_stackBuffer.size() / nMaxThreads;
-	    int nStackSize = m_state->m_numResults;
+	    const ParserByteCode& byteCode = m_state->m_byteCode;
+	    const std::vector<Variable*>& vVars = m_state->m_byteCode.GetElementWiseVars();
+	    int nResults = m_state->m_numResults;
+	    size_t nStackSize = byteCode.GetMaxStackSize();
+	    size_t nBlockSize = ParallelCalibration::get().getBlockSize(vVars.size() + nStackSize, nVectorLength);
+
+	    // The last block takes the remaining elements, i.e.
+	    // all blocks contain more than a single element
+	    size_t nBlocks = std::max(nVectorLength / nBlockSize, (size_t)1);
+
+	    Array* Stack = &m_state->m_stackBuffer[0];
+	    std::vector<Array> vScalarResults(nResults+1);
+	    std::vector<bool> vIsScalar(nResults+1, false);
+	    std::atomic<bool> bFailed(false);
+
+	    // Prepare the result arrays, which are filled in place
+	    for (int i = 1; i <= nResults; i++)
+        {
+            Stack[i] = Array();
+            Stack[i].resize(nVectorLength);
+        }
 
-        #pragma omp parallel for //schedule(static, (nVectorLength-1)/nMaxThreads)
-        for (size_t nOffset = 1; nOffset < nVectorLength; ++nOffset)
+        // Scalar variables are shared among the threads.
+        // Their common type is cached lazily, i.e. it has
+        // to be determined before the parallel region to
+        // avoid concurrent writes. Packed vectors are
+        // unpacked for the same reason
+        for (Variable* var : vVars)
         {
-            int nThreadID = omp_get_thread_num();
-            Array* Stack = &m_state->m_stackBuffer[nThreadID * nBufferOffset];
-            Array buf;
-            int sidx(0);
+            var->unpack();
+
+            if (var->size() == 1)
+                var->getCommonType();
+        }
 
-            // Run the bytecode
-            for (SToken* pTok = m_state->m_byteCode.GetBase(); pTok->Cmd != cmEND ; ++pTok)
+        #pragma omp parallel num_threads(nMaxThreads)
+        {
+            ParserByteCode localByteCode;
+            std::vector<Variable> vSlices(vVars.size());
+            std::vector<Array> vLocalStack(nStackSize);
+
+            try
             {
-                switch (pTok->Cmd)
+                localByteCode = byteCode;
+
+                for (size_t v = 0; v < vVars.size(); v++)
                 {
-                    // built in binary operators
-                    case  cmLE:
-                        --sidx;
-                        Stack[sidx]  = Stack[sidx] <= Stack[sidx + 1];
-                        continue;
-                    case  cmGE:
-                        --sidx;
-                        Stack[sidx]  = Stack[sidx] >= Stack[sidx + 1];
-                        continue;
-                    case  cmNEQ:
-                        --sidx;
-                        Stack[sidx]  = Stack[sidx] != Stack[sidx + 1];
-                        continue;
-                    case  cmEQ:
-                        --sidx;
-                        Stack[sidx]  = Stack[sidx] == Stack[sidx + 1];
-                        continue;
-                    case  cmLT:
-                        --sidx;
-                        Stack[sidx]  = Stack[sidx] < Stack[sidx + 1];
-                        continue;
-                    case  cmGT:
-                        --sidx;
-                        Stack[sidx]  = Stack[sidx] > Stack[sidx + 1];
-                        continue;
-                    case  cmADD:
-                        --sidx;
-                        Stack[sidx] += Stack[1 + sidx];
-                        continue;
-                    case  cmSUB:
-                        --sidx;
-                        Stack[sidx] -= Stack[1 + sidx];
-                        continue;
-                    case  cmMUL:
-                        --sidx;
-                        Stack[sidx] *= Stack[1 + sidx];
-                        continue;
-                    case  cmDIV:
-                        --sidx;
-                        Stack[sidx] /= Stack[1 + sidx];
-                        continue;
-
-                    case  cmPOW:
-                        --sidx;
-                        Stack[sidx] = Stack[sidx].pow(Stack[1+sidx]);
-                        continue;
-
-                    case  cmLAND:
-                        --sidx;
-                        Stack[sidx]  = Stack[sidx] && Stack[sidx + 1];
-                        continue;
-                    case  cmLOR:
-                        --sidx;
-                        Stack[sidx]  = Stack[sidx] || Stack[sidx + 1];
-                        continue;
-
-                    case  cmVAL2STR:
-                        --sidx;
-                        Stack[sidx]  = val2Str(Stack[sidx], Stack[sidx+1].front().getNum().asUI64());
-                        continue;
-
-                    case  cmASSIGN:
-                        --sidx;
-                        Stack[sidx] = pTok->Oprt().var = Stack[sidx + 1];
-                        continue;
-
-                    case  cmADDASGN:
-                        --sidx;
-                        Stack[sidx] = pTok->Oprt().var += Stack[sidx + 1];
-                        continue;
-
-                    case  cmSUBASGN:
-                        --sidx;
-                        Stack[sidx] = pTok->Oprt().var -= Stack[sidx + 1];
-                        continue;
-
-                    case  cmMULASGN:
-                        --sidx;
-                        Stack[sidx] = pTok->Oprt().var *= Stack[sidx + 1];
-                        continue;
-
-                    case  cmDIVASGN:
-                        --sidx;
-                        Stack[sidx] = pTok->Oprt().var /= Stack[sidx + 1];
-                        continue;
-
-                    case  cmPOWASGN:
-                        --sidx;
-                        Stack[sidx] = pTok->Oprt().var = pTok->Oprt().var.pow(Stack[sidx + 1]);
-                        continue;
-
-                    case  cmINCR:
-                        --sidx;
-                        Stack[sidx] = pTok->Oprt().var += Value(1);
-                        continue;
-
-                    case  cmDECR:
-                        --sidx;
-                        Stack[sidx] = pTok->Oprt().var -= Value(1);
-                        continue;
-
-                    case  cmIF: // Not needed right now, operator converted to a function
-                        if (!all(Stack[sidx--]))
-                            pTok += pTok->Oprt().offset;
-                        continue;
-
-                    case  cmELSE: // Not needed right now, operator converted to a function
-                        pTok += pTok->Oprt().offset;
-                        continue;
-
-                    case  cmENDIF: // Not needed right now, operator converted to a function
-                        continue;
-
-                    // value and variable tokens
-                    case  cmVAL:
-                        Stack[++sidx] = pTok->Val().data2;
-                        continue;
-
-                    case  cmVAR:
-                        Stack[++sidx] = *pTok->Val().var;
-                        //print(toString(*(pTok->Val.ptr + pTok->Val.isVect*nOffset), 14));
-                        continue;
-
-                    case  cmVARARRAY:
-                        Stack[++sidx] = pTok->Oprt().var.asArray();
-                        continue;
-
-                    case  cmVARPOW2:
-                        buf = *pTok->Val().var;
-                        Stack[++sidx] = buf * buf;
-                        continue;
-
-                    case  cmVARPOW3:
-                        buf = *pTok->Val().var;
-                        Stack[++sidx] = buf * buf * buf;
-                        continue;
-
-                    case  cmVARPOW4:
-                        buf = *pTok->Val().var;
-                        Stack[++sidx] = buf * buf * buf * buf;
-                        continue;
-
-                    case  cmVARPOWN:
-                        Stack[++sidx] = Array(*pTok->Val().var).pow(pTok->Val().data);
-                        continue;
-
-                    case  cmVARMUL:
-                        Stack[++sidx] = Array(*pTok->Val().var) * pTok->Val().data + pTok->Val().data2;
-                        continue;
-
-                    case  cmREVVARMUL:
-                        Stack[++sidx] = pTok->Val().data2 + Array(*pTok->Val().var) * pTok->Val().data;
-                        continue;
-
-                    // Next is treatment of numeric functions
-                    case  cmFUNC:
-                        {
-                            int iArgCount = pTok->Fun().argc;
+                    if (vVars[v]->size() > 1)
+                        localByteCode.ChangeVar(vVars[v], &vSlices[v], false);
+                }
+            }
+            catch (...)
+            {
+                bFailed = true;
+            }
 
-                            // switch according to argument count
-                            switch (iArgCount)
-                            {
-                                case 0:
-                                    sidx += 1;
-                                    Stack[sidx] = (*(fun_type0)pTok->Fun().ptr)();
-                                    continue;
-                                case 1:
-                                    Stack[sidx] = (*(fun_type1)pTok->Fun().ptr)(Stack[sidx]);
-                                    continue;
-                                case 2:
-                                    sidx -= 1;
-                                    Stack[sidx] = (*(fun_type2)pTok->Fun().ptr)(Stack[sidx],
-                                                                                Stack[sidx + 1]);
-                                    continue;
-                                case 3:
-                                    sidx -= 2;
-                                    Stack[sidx] = (*(fun_type3)pTok->Fun().ptr)(Stack[sidx],
-                                                                                Stack[sidx + 1],
-                                                                                Stack[sidx + 2]);
-                                    continue;
-                                case 4:
-                                    sidx -= 3;
-                                    Stack[sidx] = (*(fun_type4)pTok->Fun().ptr)(Stack[sidx],
-                                                                                Stack[sidx + 1],
-                                                                                Stack[sidx + 2],
-                                                                                Stack[sidx + 3]);
-                                    continue;
-                                case 5:
-                                    sidx -= 4;
-                                    Stack[sidx] = (*(fun_type5)pTok->Fun().ptr)(Stack[sidx],
-                                                                                Stack[sidx + 1],
-                                                                                Stack[sidx + 2],
-                                                                                Stack[sidx + 3],
-                                                                                Stack[sidx + 4]);
-                                    continue;
-                                case 6:
-                                    sidx -= 5;
-                                    Stack[sidx] = (*(fun_type6)pTok->Fun().ptr)(Stack[sidx],
-                                                                                Stack[sidx + 1],
-                                                                                Stack[sidx + 2],
-                                                                                Stack[sidx + 3],
-                                                                                Stack[sidx + 4],
-                                                                                Stack[sidx + 5]);
-                                    continue;
-                                case 7:
-                                    sidx -= 6;
-                                    Stack[sidx] = (*(fun_type7)pTok->Fun().ptr)(Stack[sidx],
-                                                                                Stack[sidx + 1],
-                                                                                Stack[sidx + 2],
-                                                                                Stack[sidx + 3],
-                                                                                Stack[sidx + 4],
-                                                                                Stack[sidx + 5],
-                                                                                Stack[sidx + 6]);
-                                    continue;
-                                case 8:
-                                    sidx -= 7;
-                                    Stack[sidx] = (*(fun_type8)pTok->Fun().ptr)(Stack[sidx],
-                                                                                Stack[sidx + 1],
-                                                                                Stack[sidx + 2],
-                                                                                Stack[sidx + 3],
-                                                                                Stack[sidx + 4],
-                                                                                Stack[sidx + 5],
-                                                                                Stack[sidx + 6],
-                                                                                Stack[sidx + 7]);
-                                    continue;
-                                case 9:
-                                    sidx -= 8;
-                                    Stack[sidx] = (*(fun_type9)pTok->Fun().ptr)(Stack[sidx],
-                                                                                Stack[sidx + 1],
-                                                                                Stack[sidx + 2],
-                                                                                Stack[sidx + 3],
-                                                                                Stack[sidx + 4],
-                                                                                Stack[sidx + 5],
-                                                                                Stack[sidx + 6],
-                                                                                Stack[sidx + 7],
-                                                                                Stack[sidx + 8]);
-                                    continue;
-                                case 10:
-                                    sidx -= 9;
-                                    Stack[sidx] = (*(fun_type10)pTok->Fun().ptr)(Stack[sidx],
-                                                                                 Stack[sidx + 1],
-                                                                                 Stack[sidx + 2],
-                                                                                 Stack[sidx + 3],
-                                                                                 Stack[sidx + 4],
-                                                                                 Stack[sidx + 5],
-                                                                                 Stack[sidx + 6],
-                                                                                 Stack[sidx + 7],
-                                                                                 Stack[sidx + 8],
-                                                                                 Stack[sidx + 9]);
-                                    continue;
-                                default:
-                                    if (iArgCount > 0) // function with variable arguments store the number as a negative value
-                                        Error(ecINTERNAL_ERROR, 1);
-
-                                    sidx -= -iArgCount - 1;
-                                    Stack[sidx] = (*(multfun_type)pTok->Fun().ptr)(&Stack[sidx], -iArgCount);
-                                    continue;
-                            }
-                        }
+            #pragma omp for schedule(dynamic, 1)
+            for (size_t b = 0; b < nBlocks; b++)
+            {
+                if (bFailed)
+                    continue;
 
-                    case  cmMETHOD:
+                size_t nStart = b * nBlockSize;
+                size_t nLength = (b+1 == nBlocks ? nVectorLength : nStart + nBlockSize) - nStart;
+
+                try
+                {
+                    for (size_t v = 0; v < vVars.size(); v++)
+                    {
+                        if (vVars[v]->size() > 1)
                         {
-                            int iArgCount = pTok->Fun().argc;
+                            // Reset the common type first
+                            vSlices[v].overwrite(Array());
+                            vSlices[v].assign(vVars[v]->begin() + nStart, vVars[v]->begin() + nStart + nLength);
+                        }
+                    }
+
+                    EvalByteCode(localByteCode.GetBase(), &vLocalStack[0]);
+
+                    for (int i = 1; i <= nResults; i++)
+                    {
+                        Array& res = vLocalStack[i];
 
-                            // switch according to argument count
-                            switch (iArgCount)
+                        // Results not depending on any vector
+                        // are identical for all blocks
+                        if (res.size() == 1)
+                        {
+                            if (b == 0)
                             {
-                                case 1:
-                                    Stack[sidx] = Stack[sidx].call(pTok->Fun().name);
-                                    continue;
-                                case 2:
-                                    sidx -= 1;
-                                    Stack[sidx] = Stack[sidx].call(pTok->Fun().name,
-                                                                   Stack[sidx + 1]);
-                                    continue;
-                                case 3:
-                                    sidx -= 2;
-                                    Stack[sidx] = Stack[sidx].call(pTok->Fun().name,
-                                                                   Stack[sidx + 1],
-                                                                   Stack[sidx + 2]);
-                                    continue;
-                                default:
-                                    Error(ecINTERNAL_ERROR, 1);
+                                vIsScalar[i] = true;
+                                vScalarResults[i] = std::move(res);
                             }
                         }
+                        else if (res.size() == nLength)
+                            std::move(res.begin(), res.end(), Stack[i].begin() + nStart);
+                        else
+                            bFailed = true;
+                    }
+                }
+                catch (...)
+                {
+                    bFailed = true;
+                }
+            }
+        }
 
-                    default:
-                        Error(ecINTERNAL_ERROR, 3);
-                } // switch CmdCode
-            } // for all bytecode tokens
+        if (bFailed)
+            return false;
 
-            // Copy the results
-            for (int j = 0; j < nStackSize; j++)
-            {
-                m_buffer[nOffset*nStackSize + j] = m_state->m_stackBuffer[nThreadID*nBufferOffset + j + 1];
-            }
+        for (int i = 1; i <= nResults; i++)
+        {
+            if (vIsScalar[i])
+                Stack[i] = std::move(vScalarResults[i]);
         }
 
+        return true;
 	}
 
+
+    /////////////////////////////////////////////////
+    /// \brief Determine the vector length, if the
+    /// current bytecode is element-wise, all of its
+    /// vector variables share the same length and
+    /// this length is large enough for a parallel
+    /// evaluation according to the calibration.
+    /// Returns zero otherwise.
+    ///
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+	size_t ParserBase::GetParallelVectorLength()
+	{
+	    if (nMaxThreads < 2 || omp_in_parallel() || !m_state->m_byteCode.IsElementWise(m_ScalarDef))
+            return 0;
+
+        size_t nVectorLength = 1;
+
+        for (const Variable* var : m_state->m_byteCode.GetElementWiseVars())
+        {
+            if (var->size() == 1)
+                continue;
+
+            if (!var->size() || (nVectorLength > 1 && var->size() != nVectorLength))
+                return 0;
+
+            nVectorLength = var->size();
+        }
+
+        if (nVectorLength < ParallelCalibration::get().getMinElements(m_state->m_byteCode.GetSize()-1))
+            return 0;
+
+        return nVectorLength;
+	}
+
+
 	//---------------------------------------------------------------------------
 	void ParserBase::CreateRPN()
 	{
@@ -2636,9 +2760,7 @@ namespace mu
 		} // while (true)
 
 
-#ifndef PARSERSTANDALONE
 		if (ParserBase::g_DbgDumpCmdCode)
-#endif // PARSERSTANDALONE
 			m_compilingState.m_byteCode.AsciiDump();
 
 		if (m_nIfElseCounter > 0)
@@ -2672,10 +2794,29 @@ namespace mu
 	*/
 	void ParserBase::ParseString()
 	{
-		CreateRPN();
-        m_compilingState.m_usedVar = m_pTokenReader->GetUsedVar();
-        m_compilingState.m_expr = m_pTokenReader->GetExpr().to_string();
-        StripSpaces(m_compilingState.m_expr);
+	    // The cache location is only valid for the current
+	    // expression
+	    std::string sFileHash;
+	    int nLine = m_nCacheLine;
+	    sFileHash.swap(m_sCacheFileHash);
+	    m_nCacheLine = -1;
+
+	    // Expressions are first searched in the cache shared
+	    // by all parser instances, because its entries do
+	    // not need to be deserialized
+	    if (!RestoreSharedByteCode())
+        {
+            if (!RestoreCachedByteCode(sFileHash, nLine))
+            {
+                CreateRPN();
+                m_compilingState.m_usedVar = m_pTokenReader->GetUsedVar();
+                m_compilingState.m_expr = m_pTokenReader->GetExpr().to_string();
+                StripSpaces(m_compilingState.m_expr);
+                StoreCachedByteCode(sFileHash, nLine);
+            }
+
+            StoreSharedByteCode();
+        }
 
 		if (bMakeLoopByteCode
             && !bPauseLoopByteCode
@@ -2692,6 +2833,385 @@ namespace mu
 		//(this->*m_pParseFormula)();
 	}
 
+
+    /////////////////////////////////////////////////
+    /// \brief This class resolves the symbols of a
+    /// serialized bytecode using the used variables
+    /// of the expression and the callback maps of
+    /// the parser. Callbacks are prefixed with the
+    /// kind of their map, because the same name may
+    /// denote e.g. an infix and a binary operator.
+    /////////////////////////////////////////////////
+	class ParserSymbols : public ByteCodeSymbols
+	{
+	    private:
+	        const varmap_type& m_usedVar;
+	        const funmap_type* m_funMaps[4];
+
+	        static const std::string FUNKINDS;
+
+	    public:
+	        ParserSymbols(const varmap_type& usedVar, const funmap_type& funDef, const funmap_type& oprtDef,
+                          const funmap_type& infixOprtDef, const funmap_type& postOprtDef)
+                : m_usedVar(usedVar), m_funMaps{&funDef, &oprtDef, &infixOprtDef, &postOprtDef}
+            { }
+
+	        virtual bool getVarSymbol(const Variable* var, std::string& sSymbol) const override
+	        {
+	            for (const auto& iter : m_usedVar)
+                {
+                    if (iter.second == var)
+                    {
+                        sSymbol = iter.first;
+                        return true;
+                    }
+                }
+
+                return false;
+	        }
+
+	        virtual Variable* getVar(const std::string& sSymbol) const override
+	        {
+	            auto iter = m_usedVar.find(sSymbol);
+
+	            if (iter != m_usedVar.end())
+                    return iter->second;
+
+                return nullptr;
+	        }
+
+	        virtual bool getFunSymbol(generic_fun_type fun, const std::string& sName, std::string& sSymbol) const override
+	        {
+	            for (size_t i = 0; i < FUNKINDS.length(); i++)
+                {
+                    auto iter = m_funMaps[i]->find(sName);
+
+                    if (iter != m_funMaps[i]->end() && (generic_fun_type)iter->second.GetAddr() == fun)
+                    {
+                        sSymbol = FUNKINDS[i] + sName;
+                        return true;
+                    }
+                }
+
+                return false;
+	        }
+
+	        virtual generic_fun_type getFun(const std::string& sSymbol) const override
+	        {
+	            size_t nKind = FUNKINDS.find(sSymbol.front());
+
+	            if (nKind == std::string::npos)
+                    return nullptr;
+
+                auto iter = m_funMaps[nKind]->find(sSymbol.substr(1));
+
+                if (iter != m_funMaps[nKind]->end())
+                    return (generic_fun_type)iter->second.GetAddr();
+
+                return nullptr;
+	        }
+	};
+
+	const std::string ParserSymbols::FUNKINDS = "fbip";
+
+
+    /////////////////////////////////////////////////
+    /// \brief Try to restore the bytecode of the
+    /// current expression from the persistent
+    /// bytecode cache. Returns false, if no matching
+    /// entry exists or if one of its symbols cannot
+    /// be resolved in the current session.
+    ///
+    /// \param sFileHash const std::string&
+    /// \param nLine int
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	bool ParserBase::RestoreCachedByteCode(const std::string& sFileHash, int nLine)
+	{
+	    if (!m_byteCodeCache || nLine < 0 || !sFileHash.length() || bMakeLoopByteCode)
+            return false;
+
+        const ByteCodeCache::Entry* entry = m_byteCodeCache->find(sFileHash, nLine);
+
+        if (!entry)
+            return false;
+
+        std::string sExpr = m_pTokenReader->GetExpr().to_string();
+        StripSpaces(sExpr);
+
+        // The line might result in a different expression
+        // after pre-processing
+        if (entry->m_expr != sExpr)
+            return false;
+
+        varmap_type usedVar;
+
+        for (const std::string& sVar : entry->m_usedVars)
+        {
+            Variable* var = m_factory->Get(sVar);
+
+            if (!var)
+                return false;
+
+            usedVar[sVar] = var;
+        }
+
+        std::istringstream byteCode(entry->m_byteCode);
+
+        if (!m_compilingState.m_byteCode.Deserialize(byteCode,
+                                                     ParserSymbols(usedVar, m_FunDef, m_OprtDef, m_InfixOprtDef, m_PostOprtDef)))
+            return false;
+
+        if (ParserBase::g_DbgDumpCmdCode)
+            m_compilingState.m_byteCode.AsciiDump();
+
+        m_pTokenReader->GetUsedVar() = usedVar;
+        m_compilingState.m_usedVar.swap(usedVar);
+        m_compilingState.m_expr = sExpr;
+        m_compilingState.m_numResults = entry->m_numResults;
+        m_compilingState.m_stackBuffer.resize(m_compilingState.m_byteCode.GetMaxStackSize() * nMaxThreads);
+
+        return true;
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Store the freshly compiled bytecode of
+    /// the current expression in the persistent
+    /// bytecode cache. Expressions referencing
+    /// session-specific elements are not stored.
+    ///
+    /// \param sFileHash const std::string&
+    /// \param nLine int
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+	void ParserBase::StoreCachedByteCode(const std::string& sFileHash, int nLine)
+	{
+	    if (!m_byteCodeCache || nLine < 0 || !sFileHash.length() || bMakeLoopByteCode)
+            return;
+
+        std::ostringstream byteCode;
+
+        if (!m_compilingState.m_byteCode.Serialize(byteCode,
+                                                   ParserSymbols(m_compilingState.m_usedVar, m_FunDef, m_OprtDef, m_InfixOprtDef, m_PostOprtDef)))
+            return;
+
+        ByteCodeCache::Entry entry;
+        entry.m_expr = m_compilingState.m_expr;
+        entry.m_numResults = m_compilingState.m_numResults;
+        entry.m_byteCode = byteCode.str();
+
+        for (const auto& iter : m_compilingState.m_usedVar)
+        {
+            entry.m_usedVars.push_back(iter.first);
+        }
+
+        m_byteCodeCache->store(sFileHash, nLine, entry);
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Try to restore the bytecode of the
+    /// current expression from the cache shared by
+    /// all parser instances. Returns false, if the
+    /// expression was not compiled with the current
+    /// definitions or if one of its variables does
+    /// not exist or has a different type in this
+    /// parser. The restored bytecode is rebound to
+    /// the variables of this parser.
+    ///
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	bool ParserBase::RestoreSharedByteCode()
+	{
+	    if (bMakeLoopByteCode)
+            return false;
+
+        std::string sExpr = m_pTokenReader->GetExpr().to_string();
+        StripSpaces(sExpr);
+
+        std::shared_ptr<const SharedExpressionCache::Entry> entry;
+        entry = SharedExpressionCache::get().find(sExpr,
+                                                  GetDefinitionStamp(),
+                                                  m_compilingState.m_byteCode.IsOptimizerEnabled(),
+                                                  *m_factory);
+
+        if (!entry)
+            return false;
+
+        m_compilingState.m_byteCode = entry->m_byteCode;
+
+        // The entry might have been compiled by another
+        // parser instance with different variable addresses
+        varmap_type usedVar;
+        std::map<Variable*, Variable*> binding;
+
+        for (const auto& iter : entry->m_usedVar)
+        {
+            Variable* var = m_factory->Get(iter.first);
+            usedVar[iter.first] = var;
+
+            if (var != iter.second)
+                binding[iter.second] = var;
+        }
+
+        if (binding.size())
+            m_compilingState.m_byteCode.RebindVars(binding);
+
+        if (ParserBase::g_DbgDumpCmdCode)
+            m_compilingState.m_byteCode.AsciiDump();
+
+        m_pTokenReader->GetUsedVar() = usedVar;
+        m_compilingState.m_usedVar = usedVar;
+        m_compilingState.m_expr = sExpr;
+        m_compilingState.m_numResults = entry->m_numResults;
+        m_compilingState.m_stackBuffer.resize(m_compilingState.m_byteCode.GetMaxStackSize() * nMaxThreads);
+
+        return true;
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Store the compiled bytecode of the
+    /// current expression in the cache shared by all
+    /// parser instances. Expressions referencing
+    /// undefined variables are not stored.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+	void ParserBase::StoreSharedByteCode()
+	{
+	    if (bMakeLoopByteCode)
+            return;
+
+        for (const auto& iter : m_compilingState.m_usedVar)
+        {
+            if (!iter.second)
+                return;
+        }
+
+        std::shared_ptr<SharedExpressionCache::Entry> entry = std::make_shared<SharedExpressionCache::Entry>();
+        entry->m_expr = m_compilingState.m_expr;
+        entry->m_definitionStamp = GetDefinitionStamp();
+        entry->m_usedVar = m_compilingState.m_usedVar;
+        entry->m_numResults = m_compilingState.m_numResults;
+
+        for (const auto& iter : m_compilingState.m_usedVar)
+        {
+            entry->m_varTypes.push_back(iter.second->getCommonType());
+        }
+        entry->m_byteCode = m_compilingState.m_byteCode;
+
+        SharedExpressionCache::get().store(entry);
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to add the callbacks of
+    /// the passed function or operator map to the
+    /// definition hash.
+    ///
+    /// \param hasher DefinitionHasher&
+    /// \param funDef const funmap_type&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+	static void hashCallbacks(DefinitionHasher& hasher, const funmap_type& funDef)
+	{
+	    hasher.addValue(funDef.size());
+
+	    for (const auto& iter : funDef)
+        {
+            hasher.add(iter.first);
+            hasher.addValue(iter.second.GetAddr());
+            hasher.addValue(iter.second.GetArgc());
+            hasher.addValue(iter.second.GetOptC());
+            hasher.addValue(iter.second.GetPri());
+            hasher.addValue(iter.second.GetAssociativity());
+            hasher.addValue(iter.second.GetCode());
+            hasher.addValue(iter.second.GetType());
+            hasher.addValue(iter.second.IsOptimizable());
+        }
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Return the definition stamp of this
+    /// parser, which identifies its definitions in
+    /// the shared expression cache. It is the hash
+    /// of the names and callbacks of all functions
+    /// and operators, the constants, the character
+    /// sets and the value identification callbacks.
+    /// Therefore, independently constructed parsers
+    /// with the same definitions share their cache
+    /// entries. The hash is only recalculated after
+    /// the definitions have been changed.
+    ///
+    /// \return uint64_t
+    ///
+    /////////////////////////////////////////////////
+	uint64_t ParserBase::GetDefinitionStamp()
+	{
+	    if (m_nDefinitionStamp)
+            return m_nDefinitionStamp;
+
+        DefinitionHasher hasher;
+
+        hashCallbacks(hasher, m_FunDef);
+        hashCallbacks(hasher, m_PostOprtDef);
+        hashCallbacks(hasher, m_InfixOprtDef);
+        hashCallbacks(hasher, m_OprtDef);
+
+        // Constants are inserted into the bytecode
+        // by value
+        hasher.addValue(m_ConstDef.size());
+
+        for (const auto& iter : m_ConstDef)
+        {
+            hasher.add(iter.first);
+            hasher.addValue(iter.second.getType());
+
+            if (iter.second.isNumerical())
+            {
+                const Numerical& num = iter.second.getNum();
+                hasher.addValue(num.getType());
+
+                if (num.getType() <= I64)
+                    hasher.addValue(num.asI64());
+                else
+                {
+                    hasher.addValue(num.asCF64().real());
+                    hasher.addValue(num.asCF64().imag());
+                }
+            }
+            else if (iter.second.isString())
+                hasher.add(iter.second.getStr());
+            else
+                hasher.add(iter.second.printVal());
+        }
+
+        const std::list<identfun_type>& identFun = m_pTokenReader->GetValIdents();
+        hasher.addValue(identFun.size());
+
+        for (identfun_type fun : identFun)
+        {
+            hasher.addValue(fun);
+        }
+
+        hasher.add(m_sNameChars);
+        hasher.add(m_sOprtChars);
+        hasher.add(m_sInfixOprtChars);
+        hasher.addValue(m_pTokenReader->GetArgSep());
+        hasher.addValue(m_bBuiltInOp);
+
+        m_nDefinitionStamp = hasher.get();
+        return m_nDefinitionStamp;
+	}
+
 	//---------------------------------------------------------------------------
 	/** \brief Create an error containing the parse error position.
 
@@ -2758,6 +3278,7 @@ namespace mu
 	void ParserBase::ClearFun()
 	{
 		m_FunDef.clear();
+		m_nDefinitionStamp = 0;
 		ReInit();
 	}
 
@@ -2771,6 +3292,7 @@ namespace mu
 	void ParserBase::ClearConst()
 	{
 		m_ConstDef.clear();
+		m_nDefinitionStamp = 0;
 		ReInit();
 	}
 
@@ -2782,6 +3304,7 @@ namespace mu
 	void ParserBase::ClearPostfixOprt()
 	{
 		m_PostOprtDef.clear();
+		m_nDefinitionStamp = 0;
 		ReInit();
 	}
 
@@ -2793,6 +3316,7 @@ namespace mu
 	void ParserBase::ClearOprt()
 	{
 		m_OprtDef.clear();
+		m_nDefinitionStamp = 0;
 		ReInit();
 	}
 
@@ -2804,6 +3328,7 @@ namespace mu
 	void ParserBase::ClearInfixOprt()
 	{
 		m_InfixOprtDef.clear();
+		m_nDefinitionStamp = 0;
 		ReInit();
 	}
 
@@ -2844,6 +3369,7 @@ namespace mu
 	void ParserBase::EnableBuiltInOprt(bool a_bIsOn)
 	{
 		m_bBuiltInOp = a_bIsOn;
+		m_nDefinitionStamp = 0;
 		ReInit();
 	}
 
@@ -2872,6 +3398,7 @@ namespace mu
 	void ParserBase::SetArgSep(char_type cArgSep)
 	{
 		m_pTokenReader->SetArgSep(cArgSep);
+		m_nDefinitionStamp = 0;
 	}
 
 	//------------------------------------------------------------------------------
@@ -3480,6 +4007,92 @@ namespace mu
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief Set the persistent cache used for
+    /// storing and restoring the bytecode of
+    /// procedure lines. Pass a nullptr to disable
+    /// the cache.
+    ///
+    /// \param cache ByteCodeCache*
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void ParserBase::SetByteCodeCache(ByteCodeCache* cache)
+    {
+        m_byteCodeCache = cache;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Declare the location of the next
+    /// expression passed to SetExpr(). The location
+    /// is used as key in the persistent bytecode
+    /// cache and is only valid for this single
+    /// expression.
+    ///
+    /// \param sFileHash const std::string&
+    /// \param nLine int
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void ParserBase::SetCacheLocation(const std::string& sFileHash, int nLine)
+    {
+        m_sCacheFileHash = sFileHash;
+        m_nCacheLine = nLine;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Enable or disable the compiled tier
+    /// for hot expressions. Expressions, which are
+    /// evaluated often enough, are then evaluated
+    /// by a register program operating on single
+    /// values, as long as all of their variables
+    /// are numerical scalars.
+    ///
+    /// \param a_bIsOn bool
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void ParserBase::EnableJit(bool a_bIsOn)
+    {
+        m_bEnableJit = a_bIsOn;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Define the scalar counterpart of an
+    /// already defined single argument function or
+    /// infix operator. Only functions with a scalar
+    /// counterpart can be used by the compiled tier.
+    /// The counterpart has to return exactly the
+    /// same value as the function for a single
+    /// element.
+    ///
+    /// \param a_pFun fun_type1
+    /// \param a_pScalarFun scalar_fun_type
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void ParserBase::DefineScalarFun(fun_type1 a_pFun, scalar_fun_type a_pScalarFun)
+    {
+        m_ScalarDef[(void*)a_pFun] = a_pScalarFun;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Return the counters of the compiled
+    /// tier accumulated over all parser instances.
+    ///
+    /// \return JitStatistics
+    ///
+    /////////////////////////////////////////////////
+    JitStatistics ParserBase::GetJitStatistics()
+    {
+        return JitProgram::getStatistics();
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief This member function copies the passed
     /// vector into the internal storage referencing
@@ -41,6 +41,7 @@
 #include "muParserBytecode.h"
 #include "muParserError.h"
 #include "muParserState.hpp"
+#include "muParserCache.hpp"
 #include "muVarFactory.hpp"
 
 class StringView;
@@ -118,6 +119,15 @@ namespace mu
 			bool IsAlreadyParsed(StringView sNewEquation);
 			bool IsNotLastStackItem() const;
 
+			// Persistent bytecode cache interface section
+			void SetByteCodeCache(ByteCodeCache* cache);
+			void SetCacheLocation(const std::string& sFileHash, int nLine);
+
+			// Compiled expression tier interface section
+			void EnableJit(bool a_bIsOn = true);
+			void DefineScalarFun(fun_type1 a_pFun, scalar_fun_type a_pScalarFun);
+			static JitStatistics GetJitStatistics();
+
 			static void EnableDebugDump(bool bDumpCmd, bool bDumpStack);
 
 			ParserBase();
@@ -316,9 +326,16 @@ namespace mu
 			void CreateRPN();
 
 			void ParseString();
+			bool RestoreCachedByteCode(const std::string& sFileHash, int nLine);
+			void StoreCachedByteCode(const std::string& sFileHash, int nLine);
+			bool RestoreSharedByteCode();
+			void StoreSharedByteCode();
+			uint64_t GetDefinitionStamp();
 			void ParseCmdCode();
 			void ParseCmdCodeBulk(int nOffset, int nThreadID);
-			void ParseCmdCodeBulkParallel(size_t nVectorLength);
+			void EvalByteCode(SToken* pTok, Array* Stack);
+			bool ParseCmdCodeBulkParallel(size_t nVectorLength);
+			size_t GetParallelVectorLength();
 
 			void CheckName(const string_type& a_strName, const string_type& a_CharSet) const;
 			void CheckOprt(const string_type& a_sName,
@@ -350,6 +367,14 @@ namespace mu
 			bool bCompiling;
 			int nMaxThreads;
 
+			ByteCodeCache* m_byteCodeCache; ///< Persistent cache for the compiled lines of procedures
+			std::string m_sCacheFileHash;   ///< Hash of the file containing the next expression
+			int m_nCacheLine;               ///< Line of the next expression within its file
+			uint64_t m_nDefinitionStamp;    ///< Hash of the current definitions for the shared expression cache, zero if outdated
+
+			bool m_bEnableJit;              ///< Flag for using the compiled tier for hot expressions
+			scalarmap_type m_ScalarDef;     ///< Scalar counterparts of single argument functions
+
 			std::unique_ptr<token_reader_type> m_pTokenReader; ///< Managed pointer to the token reader object.
 
 			funmap_type  m_FunDef;         ///< Map of function names and pointers.
@@ -25,6 +25,7 @@
 
 #include "muParserBytecode.h"
 #include "muHelpers.hpp"
+#include "muParserCache.hpp"
 #include "../utils/tools.hpp"
 
 #include <cassert>
@@ -32,6 +33,8 @@
 #include <stack>
 #include <vector>
 #include <iostream>
+#include <algorithm>
+#include <map>
 
 #include "muParserDef.h"
 #include "muParserError.h"
@@ -48,6 +51,8 @@ namespace mu
 		, m_iMaxStackSize(0)
 		, m_vRPN()
 		, m_bEnableOptimizer(true)
+		, m_eElementWise(EW_UNKNOWN)
+		, m_iUnoptimizedSize(0)
 	{
 		m_vRPN.reserve(50);
 	}
@@ -79,6 +84,12 @@ namespace mu
 		m_bEnableOptimizer = bStat;
 	}
 
+	//---------------------------------------------------------------------------
+	bool ParserByteCode::IsOptimizerEnabled() const
+	{
+		return m_bEnableOptimizer;
+	}
+
 	//---------------------------------------------------------------------------
 	/** \brief Copy state of another object to this.
 
@@ -93,6 +104,8 @@ namespace mu
 		m_vRPN = a_ByteCode.m_vRPN;
 		m_iMaxStackSize = a_ByteCode.m_iMaxStackSize;
 		m_bEnableOptimizer = a_ByteCode.m_bEnableOptimizer;
+		m_iUnoptimizedSize = a_ByteCode.m_iUnoptimizedSize;
+		ResetEvaluationTiers();
 	}
 
 	//---------------------------------------------------------------------------
@@ -473,6 +486,9 @@ namespace mu
     /////////////////////////////////////////////////
 	void ParserByteCode::AddFun(generic_fun_type a_pFun, int a_iArgc, bool optimizeAway, const std::string& funcName)
 	{
+	    // Functions, which may be optimized away, are pure
+	    bool isPure = optimizeAway;
+
 	    // Shall we try to optimize?
 		if (m_bEnableOptimizer && optimizeAway)
 		{
@@ -627,7 +643,7 @@ namespace mu
 
             SToken tok;
             tok.Cmd = cmFUNC;
-            tok.m_data = SFunData{.ptr{a_pFun}, .name{funcName}, .argc{a_iArgc}, .idx{0}};
+            tok.m_data = SFunData{.ptr{a_pFun}, .name{funcName}, .argc{a_iArgc}, .idx{0}, .optimizeAway{isPure}};
             m_vRPN.push_back(tok);
 		}
 	}
@@ -664,197 +680,1246 @@ namespace mu
 	{
 	    if (m_vRPN.size())
             m_vRPN.pop_back();
+
+        ResetEvaluationTiers();
 	}
 
-	//---------------------------------------------------------------------------
-	/** \brief Add end marker to bytecode.
+    /////////////////////////////////////////////////
+    /// \brief Static helper to determine, whether
+    /// the passed token is a plain value or variable,
+    /// which can be read directly by a fused
+    /// register instruction.
+    ///
+    /// \param tok const SToken&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	static bool isOperandLoad(const SToken& tok)
+	{
+	    return tok.Cmd == cmVAL || tok.Cmd == cmVAR;
+	}
 
-	    \throw nothrow
-	*/
-	void ParserByteCode::Finalize()
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to determine, whether
+    /// the passed operator code can be fused into a
+    /// register instruction.
+    ///
+    /// \param oprt ECmdCode
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	static bool isFusableOprt(ECmdCode oprt)
 	{
-		SToken tok;
-		tok.Cmd = cmEND;
-		m_vRPN.push_back(tok);
-		rpn_type(m_vRPN).swap(m_vRPN);     // shrink bytecode vector to fit
+	    return oprt <= cmGT || (oprt >= cmADD && oprt <= cmLOR);
+	}
 
-		// Determine the if-then-else jump offsets
-		ParserStack<int> stIf, stElse;
-		int idx;
-		for (int i = 0; i < (int)m_vRPN.size(); ++i)
-		{
-			switch (m_vRPN[i].Cmd)
-			{
-				case cmIF:
-					stIf.push(i);
-					break;
 
-				case  cmELSE:
-					stElse.push(i);
-					idx = stIf.pop();
-					m_vRPN[idx].Oprt().offset = i - idx;
-					break;
+    /////////////////////////////////////////////////
+    /// \brief Static helper to convert a value or
+    /// variable token into an operand of a register
+    /// instruction.
+    ///
+    /// \param tok const SToken&
+    /// \return SOperand
+    ///
+    /////////////////////////////////////////////////
+	static SOperand toOperand(const SToken& tok)
+	{
+	    if (tok.Cmd == cmVAR)
+            return SOperand{.src{SOperand::SRC_VAR}, .var{tok.Val().var}};
 
-				case cmENDIF:
-					idx = stElse.pop();
-					m_vRPN[idx].Oprt().offset = i - idx;
-					break;
+        if (tok.Cmd == cmVAL)
+            return SOperand{.src{SOperand::SRC_VAL}, .var{nullptr}, .val{tok.Val().data2}};
 
-				default:
-					break;
-			}
-		}
+        return SOperand{.src{SOperand::SRC_STACK}, .var{nullptr}};
 	}
 
 
     /////////////////////////////////////////////////
-    /// \brief Changes all old variable pointers to
-    /// the new addresses. Will be used to compensate
-    /// for different local variable adresses in
-    /// different scopes.
+    /// \brief Lowers the RPN into fused register
+    /// instructions. Binary operators read plain
+    /// values and variables directly instead of
+    /// copying them to the stack first, a directly
+    /// following operator with a plain operand is
+    /// chained to the previous one (e.g. a*b+c) and
+    /// comparisons followed by both cases of the
+    /// ternary operator are fused into a single
+    /// select instruction. The stack positions of all
+    /// results are not changed.
     ///
-    /// \param a_pOldVar value_type*
-    /// \param a_pNewVar value_type*
-    /// \param isVect bool
     /// \return void
     ///
     /////////////////////////////////////////////////
-	void ParserByteCode::ChangeVar(Variable* a_pOldVar, Variable* a_pNewVar, bool isVect)
+	void ParserByteCode::LowerToRegisterCode()
 	{
-	    for (size_t i = 0; i < m_vRPN.size(); ++i)
+	    // The jump offsets of the if-then-else tokens
+	    // refer to the positions within the RPN
+	    for (const SToken& tok : m_vRPN)
         {
-            if (m_vRPN[i].Cmd >= cmVAR && m_vRPN[i].Cmd < cmVAR_END && m_vRPN[i].Val().var == a_pOldVar)
+            if (tok.Cmd == cmIF)
+                return;
+        }
+
+	    rpn_type vLowered;
+	    vLowered.reserve(m_vRPN.size());
+
+	    for (SToken& tok : m_vRPN)
+        {
+            size_t sz = vLowered.size();
+
+            if (isFusableOprt(tok.Cmd) && sz >= 1 && isOperandLoad(vLowered[sz-1]))
             {
-                m_vRPN[i].Val().var = a_pNewVar;
-                m_vRPN[i].Val().isVect = isVect;
+                SToken regTok;
+                regTok.Cmd = cmREGOP;
+
+                if (sz >= 2 && isOperandLoad(vLowered[sz-2]))
+                {
+                    // Both operands can be read directly: a+b
+                    regTok.m_data = SRegData{.oprt{tok.Cmd}, .oprt2{cmUNKNOWN},
+                                             .args{toOperand(vLowered[sz-2]), toOperand(vLowered[sz-1])},
+                                             .argc{2}, .stackArgs{0}, .fun{nullptr}};
+                    vLowered.pop_back();
+                }
+                else if (sz >= 2 && vLowered[sz-2].Cmd == cmREGOP && vLowered[sz-2].Reg().argc == 2)
+                {
+                    // The left operand is the result of the
+                    // previous instruction: (a*b)+c
+                    SRegData& reg = vLowered[sz-2].Reg();
+                    reg.oprt2 = tok.Cmd;
+                    reg.args[2] = toOperand(vLowered[sz-1]);
+                    reg.argc = 3;
+                    vLowered.pop_back();
+                    continue;
+                }
+                else
+                {
+                    // Only the right operand can be read directly: (...)+b
+                    regTok.m_data = SRegData{.oprt{tok.Cmd}, .oprt2{cmUNKNOWN},
+                                             .args{SOperand{.src{SOperand::SRC_STACK}, .var{nullptr}}, toOperand(vLowered[sz-1])},
+                                             .argc{2}, .stackArgs{1}, .fun{nullptr}};
+                }
+
+                vLowered.back() = std::move(regTok);
+                continue;
             }
+
+            if (tok.Cmd == cmFUNC
+                && tok.Fun().argc == 3
+                && tok.Fun().name == MU_IF_ELSE
+                && sz >= 2
+                && isOperandLoad(vLowered[sz-2])
+                && isOperandLoad(vLowered[sz-1]))
+            {
+                if (sz >= 3
+                    && vLowered[sz-3].Cmd == cmREGOP
+                    && vLowered[sz-3].Reg().argc == 2
+                    && vLowered[sz-3].Reg().stackArgs == 0
+                    && vLowered[sz-3].Reg().oprt <= cmGT)
+                {
+                    // The condition is a comparison of plain
+                    // operands: a < b ? c : d
+                    SRegData& reg = vLowered[sz-3].Reg();
+                    reg.args[2] = toOperand(vLowered[sz-2]);
+                    reg.args[3] = toOperand(vLowered[sz-1]);
+                    reg.argc = 4;
+                    reg.fun = tok.Fun().ptr;
+                    vLowered[sz-3].Cmd = cmREGSELECT;
+                    vLowered.resize(sz-2);
+                    continue;
+                }
+
+                // The condition is on the stack: (...) ? c : d
+                SToken regTok;
+                regTok.Cmd = cmREGSELECT;
+                regTok.m_data = SRegData{.oprt{cmUNKNOWN}, .oprt2{cmUNKNOWN},
+                                         .args{SOperand{.src{SOperand::SRC_STACK}, .var{nullptr}}, toOperand(vLowered[sz-2]), toOperand(vLowered[sz-1])},
+                                         .argc{3}, .stackArgs{1}, .fun{tok.Fun().ptr}};
+                vLowered.pop_back();
+                vLowered.back() = std::move(regTok);
+                continue;
+            }
+
+            vLowered.push_back(std::move(tok));
         }
+
+        m_vRPN.swap(vLowered);
 	}
 
 
-	//---------------------------------------------------------------------------
-	SToken* ParserByteCode::GetBase()
+    /////////////////////////////////////////////////
+    /// \brief Static helper returning the number of
+    /// stack elements consumed by the passed token
+    /// of a not yet lowered RPN. Every token leaves
+    /// exactly one element on the stack. Returns -1
+    /// for tokens, which cannot be handled by the
+    /// optimizer, e.g. jumps, assignments and
+    /// methods.
+    ///
+    /// \param tok const SToken&
+    /// \return int
+    ///
+    /////////////////////////////////////////////////
+	static int getTokenArity(const SToken& tok)
 	{
-		if (m_vRPN.size() == 0)
-			throw ParserError(ecINTERNAL_ERROR);
-		else
-			return &m_vRPN[0];
+	    if (tok.Cmd >= cmVAL && tok.Cmd < cmVAR_END)
+            return 0;
+
+        if (tok.Cmd <= cmGT || (tok.Cmd >= cmADD && tok.Cmd <= cmLOR) || tok.Cmd == cmVAL2STR)
+            return 2;
+
+        switch (tok.Cmd)
+        {
+            case cmLOAD:
+                return 0;
+            case cmSTORE:
+                return 1;
+            case cmFUNC:
+                return std::abs(tok.Fun().argc);
+            default:
+                return -1;
+        }
 	}
 
-	//---------------------------------------------------------------------------
-	std::size_t ParserByteCode::GetMaxStackSize() const
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to determine, whether
+    /// the passed variable token does not only load
+    /// the variable but also calculates something,
+    /// e.g. 2*a+1.
+    ///
+    /// \param tok const SToken&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	static bool isComputingVarToken(const SToken& tok)
 	{
-		return m_iMaxStackSize + 1;
+	    return tok.Cmd > cmVARARRAY && tok.Cmd < cmVAR_END;
 	}
 
-	//---------------------------------------------------------------------------
-	/** \brief Returns the number of entries in the bytecode. */
-	std::size_t ParserByteCode::GetSize() const
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to determine, whether
+    /// the passed token may be evaluated only once
+    /// for all of its occurences.
+    ///
+    /// \param tok const SToken&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	static bool isPureToken(const SToken& tok)
 	{
-		return m_vRPN.size();
+	    return tok.Cmd != cmFUNC || tok.Fun().optimizeAway;
 	}
 
-	//---------------------------------------------------------------------------
-	/** \brief Delete the bytecode.
 
-	    \throw nothrow
+    /////////////////////////////////////////////////
+    /// \brief Static helper comparing two constant
+    /// Arrays including their types. NaNs are never
+    /// considered as identical.
+    ///
+    /// \param a const Array&
+    /// \param b const Array&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	static bool isSameArray(const Array& a, const Array& b)
+	{
+	    if (a.size() != b.size())
+            return false;
 
-	    The name of this function is a violation of my own coding guidelines
-	    but this way it's more in line with the STL functions thus more
-	    intuitive.
-	*/
-	void ParserByteCode::clear()
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            if (a[i].getType() != b[i].getType())
+                return false;
+
+            if (a[i].isNumerical())
+            {
+                if (a[i].getNum().getType() != b[i].getNum().getType() || !(a[i].getNum() == b[i].getNum()))
+                    return false;
+            }
+            else if (a[i].isString())
+            {
+                if (a[i].getStr() != b[i].getStr())
+                    return false;
+            }
+            else if (!a[i].isVoid())
+                return false;
+        }
+
+        return true;
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper comparing two tokens of
+    /// a not yet lowered RPN.
+    ///
+    /// \param a const SToken&
+    /// \param b const SToken&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	static bool isSameToken(const SToken& a, const SToken& b)
 	{
-		m_vRPN.clear();
-		m_iStackPos = 0;
-		m_iMaxStackSize = 0;
+	    if (a.Cmd != b.Cmd)
+            return false;
+
+        switch (a.Cmd)
+        {
+            case cmVAL:
+                return isSameArray(a.Val().data2, b.Val().data2);
+            case cmVAR:
+            case cmVARPOW2:
+            case cmVARPOW3:
+            case cmVARPOW4:
+                return a.Val().var == b.Val().var;
+            case cmVARPOWN:
+                return a.Val().var == b.Val().var && isSameArray(a.Val().data, b.Val().data);
+            case cmVARMUL:
+            case cmREVVARMUL:
+                return a.Val().var == b.Val().var
+                    && isSameArray(a.Val().data, b.Val().data)
+                    && isSameArray(a.Val().data2, b.Val().data2);
+            case cmVARARRAY:
+                return a.Oprt().var == b.Oprt().var;
+            case cmSTORE:
+            case cmLOAD:
+                return a.Oprt().offset == b.Oprt().offset;
+            case cmFUNC:
+                return a.Fun().ptr == b.Fun().ptr && a.Fun().argc == b.Fun().argc && a.Fun().name == b.Fun().name;
+            default:
+                return true;
+        }
 	}
 
-	//---------------------------------------------------------------------------
-	/** \brief Dump bytecode (for debugging only!). */
-	void ParserByteCode::AsciiDump()
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper calculating a hash of
+    /// the passed token. Identical tokens yield
+    /// identical hashes.
+    ///
+    /// \param tok const SToken&
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+	static size_t hashToken(const SToken& tok)
 	{
-		if (!m_vRPN.size())
-		{
-			print("No bytecode available");
-			return;
-		}
+	    size_t hash = std::hash<int>()(tok.Cmd);
 
-		toggleTableMode();
-		print("Number of RPN tokens: " + toString(m_vRPN.size()));
+	    auto combine = [&hash](size_t val)
+            {
+                hash ^= val + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            };
 
-		for (std::size_t i = 0; i < m_vRPN.size() && m_vRPN[i].Cmd != cmEND; ++i)
-		{
-		    printFormatted("|   " + toString(i) + " : \t");
-			switch (m_vRPN[i].Cmd)
-			{
-				case cmVAL:
-				    printFormatted("VAL       \t[" + m_vRPN[i].Val().data2.print() + "]\n");
-					break;
+        auto combineArray = [&combine](const Array& arr)
+            {
+                combine(arr.size());
 
-				case cmVAR:
-				    printFormatted("VAR       \t[" + m_vRPN[i].Val().var->print() + "]\n");
-					break;
+                for (const Value& val : arr)
+                {
+                    if (val.isNumerical())
+                    {
+                        std::complex<double> cmplx = val.getNum().asCF64();
+                        combine(std::hash<double>()(cmplx.real()));
+                        combine(std::hash<double>()(cmplx.imag()));
+                    }
+                    else if (val.isString())
+                        combine(std::hash<std::string>()(val.getStr()));
+                }
+            };
 
-				case cmVARARRAY:
-				    printFormatted("VARARR    \t[" + m_vRPN[i].Oprt().var.print() + "]\n");
-					break;
+        if (std::holds_alternative<SValData>(tok.m_data))
+        {
+            combine(std::hash<const void*>()(tok.Val().var));
 
-				case cmVARPOW2:
-				    printFormatted("VARPOW2   \t[" + m_vRPN[i].Val().var->print() + "]\n");
-					break;
+            if (tok.Cmd == cmVAL)
+                combineArray(tok.Val().data2);
+            else if (tok.Cmd >= cmVARPOWN)
+            {
+                combineArray(tok.Val().data);
+                combineArray(tok.Val().data2);
+            }
+        }
+        else if (std::holds_alternative<SFunData>(tok.m_data))
+            combine(std::hash<const void*>()((const void*)tok.Fun().ptr));
+        else if (std::holds_alternative<SOprtData>(tok.m_data))
+        {
+            combine(tok.Oprt().offset);
 
-				case cmVARPOW3:
-					printFormatted("VARPOW3   \t[" + m_vRPN[i].Val().var->print() + "]\n");
-					break;
+            for (const Variable* var : tok.Oprt().var)
+            {
+                combine(std::hash<const void*>()(var));
+            }
+        }
 
-				case cmVARPOW4:
-					printFormatted("VARPOW4   \t[" + m_vRPN[i].Val().var->print() + "]\n");
-					break;
+        return hash;
+	}
 
-				case cmVARPOWN:
-					printFormatted("VARPOWN   \t[" + m_vRPN[i].Val().var->print() + "] ^ [" + m_vRPN[i].Val().data.print() + "]\n");
-					break;
 
-				case cmVARMUL:
-					printFormatted("VARMUL    \t[" + m_vRPN[i].Val().var->print() + "]");
-					printFormatted(" * [" + m_vRPN[i].Val().data.print() + "] + [" + m_vRPN[i].Val().data2.print() + "]\n");
-					break;
+    /////////////////////////////////////////////////
+    /// \brief Static helper returning the type of a
+    /// scalar numerical constant or false, if the
+    /// passed token is not such a constant.
+    ///
+    /// \param tok const SToken&
+    /// \param info TypeInfo&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	static bool getConstantType(const SToken& tok, TypeInfo& info)
+	{
+	    if (tok.Cmd != cmVAL || tok.Val().data2.size() != 1 || !tok.Val().data2.front().isNumerical())
+            return false;
 
-				case cmREVVARMUL:
-					printFormatted("REVVARMUL \t[" + m_vRPN[i].Val().data2.print() + "]");
-					printFormatted(" + [" + m_vRPN[i].Val().var->print() + "] * [" + m_vRPN[i].Val().data.print() + "]\n");
-					break;
+        info = tok.Val().data2.front().getNum().getInfo();
+        return true;
+	}
 
-				case cmFUNC:
-				    printFormatted("CALL      \t[ARG: " + toString(m_vRPN[i].Fun().argc) + "] [FUNC: " + m_vRPN[i].Fun().name + "] [ADDR: " + toHexString((size_t)m_vRPN[i].Fun().ptr) + "]\n");
-					break;
 
-				case cmMETHOD:
-				    printFormatted("CALL      \t[ARG: " + toString(m_vRPN[i].Fun().argc) + "] [METHOD: " + m_vRPN[i].Fun().name + "]\n");
-					break;
+    /////////////////////////////////////////////////
+    /// \brief Static helper to determine, whether a
+    /// value with the passed lower type bound keeps
+    /// its type, if it is combined with a value of
+    /// the passed type.
+    ///
+    /// \param bound const TypeInfo&
+    /// \param info const TypeInfo&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	static bool isTypePreserved(const TypeInfo& bound, const TypeInfo& info)
+	{
+	    return bound.m_bits >= info.m_bits && bound.m_flags >= info.m_flags;
+	}
 
-				case cmLT:
-				    printFormatted("LT\n");
-					break;
-				case cmGT:
-					printFormatted("GT\n");
-					break;
-				case cmLE:
-					printFormatted("LE\n");
-					break;
-				case cmGE:
-					printFormatted("GE\n");
-					break;
-				case cmEQ:
-					printFormatted("EQ\n");
-					break;
-				case cmNEQ:
-					printFormatted("NEQ\n");
-					break;
-				case cmADD:
-					printFormatted("ADD\n");
-					break;
+
+    /////////////////////////////////////////////////
+    /// \brief Removes neutral operands, i.e. x*1,
+    /// 1*x, x+0, 0+x and x-0 yield x. The neutral
+    /// operand is only removed, if the other operand
+    /// is known to have at least its type. Otherwise
+    /// the type promotion would be lost, e.g. (a>b)*1
+    /// is numerical and not logical.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+	void ParserByteCode::SimplifyAlgebraic()
+	{
+	    // A subexpression within the simplified RPN
+	    // together with the lower bound of its type,
+	    // if known
+	    struct SubExpr
+	    {
+	        size_t start;
+	        bool hasBound;
+	        TypeInfo bound;
+	    };
+
+	    rpn_type vSimplified;
+	    vSimplified.reserve(m_vRPN.size());
+	    std::vector<SubExpr> vStack;
+	    std::map<int, TypeInfo> mSlotBounds;
+
+	    for (SToken& tok : m_vRPN)
+        {
+            int nArgs = getTokenArity(tok);
+            SubExpr expr{vSimplified.size(), false, TypeInfo(LOGICAL)};
+
+            if (nArgs == 2 && (tok.Cmd == cmADD || tok.Cmd == cmSUB || tok.Cmd == cmMUL))
+            {
+                SubExpr rhs = vStack.back();
+                vStack.pop_back();
+                SubExpr lhs = vStack.back();
+                vStack.pop_back();
+
+                const SToken& lhsTok = vSimplified[lhs.start];
+                const SToken& rhsTok = vSimplified.back();
+                Array neutral(Value(tok.Cmd == cmMUL ? 1.0 : 0.0));
+                TypeInfo info;
+
+                if (getConstantType(rhsTok, info)
+                    && lhs.hasBound
+                    && isTypePreserved(lhs.bound, info)
+                    && all(rhsTok.Val().data2 == neutral))
+                {
+                    // x*1, x+0, x-0
+                    vSimplified.pop_back();
+                    vStack.push_back(lhs);
+                    continue;
+                }
+                else if (tok.Cmd != cmSUB
+                         && rhs.start - lhs.start == 1
+                         && getConstantType(lhsTok, info)
+                         && rhs.hasBound
+                         && isTypePreserved(rhs.bound, info)
+                         && all(lhsTok.Val().data2 == neutral))
+                {
+                    // 1*x, 0+x
+                    vSimplified.erase(vSimplified.begin() + lhs.start);
+                    rhs.start = lhs.start;
+                    vStack.push_back(rhs);
+                    continue;
+                }
+
+                // The result has at least the type of
+                // its operands
+                expr.start = lhs.start;
+
+                if (lhs.hasBound || rhs.hasBound)
+                {
+                    expr.hasBound = true;
+                    expr.bound = lhs.hasBound ? lhs.bound : rhs.bound;
+                    expr.bound.promote(rhs.hasBound ? rhs.bound : lhs.bound);
+                }
+            }
+            else
+            {
+                if (tok.Cmd == cmSTORE)
+                {
+                    // Storing does not change the value
+                    // itself
+                    expr = vStack.back();
+                    vStack.pop_back();
+
+                    if (expr.hasBound)
+                        mSlotBounds[tok.Oprt().offset] = expr.bound;
+                }
+                else if (nArgs)
+                {
+                    expr.start = vStack[vStack.size()-nArgs].start;
+                    vStack.resize(vStack.size()-nArgs);
+                }
+
+                TypeInfo info;
+                auto iter = mSlotBounds.end();
+
+                if (tok.Cmd == cmLOAD && (iter = mSlotBounds.find(tok.Oprt().offset)) != mSlotBounds.end())
+                {
+                    expr.hasBound = true;
+                    expr.bound = iter->second;
+                }
+                else if (getConstantType(tok, info))
+                {
+                    expr.hasBound = true;
+                    expr.bound = info;
+                }
+                else if ((tok.Cmd == cmVARMUL || tok.Cmd == cmREVVARMUL)
+                         && tok.Val().data.size() == 1
+                         && tok.Val().data.front().isNumerical())
+                {
+                    // The scale factor determines the lower
+                    // bound of the result
+                    expr.hasBound = true;
+                    expr.bound = tok.Val().data.front().getNum().getInfo();
+                }
+            }
+
+            vSimplified.push_back(std::move(tok));
+            vStack.push_back(expr);
+        }
+
+        m_vRPN.swap(vSimplified);
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Evaluates identical subexpressions
+    /// consisting only of pure functions and
+    /// operators only once. The first occurence is
+    /// stored in a separate slot and all other
+    /// occurences are replaced by loading this slot.
+    /// The largest common subexpression is replaced
+    /// first.
+    ///
+    /// \param nSlots int&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+	void ParserByteCode::EliminateCommonSubexpressions(int& nSlots)
+	{
+	    // Limit the number of slots for extremely long
+	    // expressions
+	    const int MAXSLOTS = 64;
+
+	    while (nSlots < MAXSLOTS)
+        {
+            std::vector<size_t> vStart(m_vRPN.size());
+            std::vector<size_t> vHash(m_vRPN.size());
+            std::vector<bool> vPure(m_vRPN.size());
+            std::vector<size_t> vStack;
+
+            // Determine the subexpression of every token
+            for (size_t i = 0; i < m_vRPN.size(); i++)
+            {
+                int nArgs = getTokenArity(m_vRPN[i]);
+                vStart[i] = i;
+                vHash[i] = hashToken(m_vRPN[i]);
+                vPure[i] = isPureToken(m_vRPN[i]);
+
+                for (size_t n = vStack.size()-nArgs; n < vStack.size(); n++)
+                {
+                    vHash[i] ^= vHash[vStack[n]] + 0x9e3779b9 + (vHash[i] << 6) + (vHash[i] >> 2);
+                    vPure[i] = vPure[i] && vPure[vStack[n]];
+                }
+
+                if (nArgs)
+                {
+                    vStart[i] = vStart[vStack[vStack.size()-nArgs]];
+                    vStack.resize(vStack.size()-nArgs);
+                }
+
+                vStack.push_back(i);
+            }
+
+            // Candidates are pure subexpressions, which do
+            // not only load a single value or variable. The
+            // largest ones are examined first.
+            std::vector<size_t> vCandidates;
+
+            for (size_t i = 0; i < m_vRPN.size(); i++)
+            {
+                if (vPure[i] && (i > vStart[i] || isComputingVarToken(m_vRPN[i])) && m_vRPN[i].Cmd != cmSTORE)
+                    vCandidates.push_back(i);
+            }
+
+            std::stable_sort(vCandidates.begin(), vCandidates.end(),
+                             [&vStart](size_t a, size_t b){return a - vStart[a] > b - vStart[b];});
+
+            std::vector<size_t> vOccurences;
+
+            for (size_t c = 0; c < vCandidates.size() && vOccurences.size() < 2; c++)
+            {
+                size_t first = vCandidates[c];
+                size_t len = first - vStart[first] + 1;
+                vOccurences.assign(1, first);
+
+                for (size_t o = c+1; o < vCandidates.size() && vCandidates[o] - vStart[vCandidates[o]] + 1 == len; o++)
+                {
+                    size_t other = vCandidates[o];
+
+                    if (vHash[other] != vHash[first])
+                        continue;
+
+                    bool isSame = true;
+
+                    for (size_t n = 0; n < len && isSame; n++)
+                    {
+                        isSame = isSameToken(m_vRPN[vStart[first]+n], m_vRPN[vStart[other]+n]);
+                    }
+
+                    if (isSame)
+                        vOccurences.push_back(other);
+                }
+            }
+
+            if (vOccurences.size() < 2)
+                return;
+
+            std::sort(vOccurences.begin(), vOccurences.end());
+
+            // Store the first occurence and load it for
+            // all other occurences
+            rpn_type vEliminated;
+            vEliminated.reserve(m_vRPN.size());
+            size_t nOccurence = 0;
+
+            SToken store;
+            store.Cmd = cmSTORE;
+            store.m_data = SOprtData{.var{}, .offset{nSlots}};
+
+            for (size_t i = 0; i < m_vRPN.size(); i++)
+            {
+                if (nOccurence < vOccurences.size() && i == vOccurences[nOccurence])
+                {
+                    if (!nOccurence)
+                    {
+                        vEliminated.push_back(std::move(m_vRPN[i]));
+                        vEliminated.push_back(store);
+                    }
+                    else
+                    {
+                        vEliminated.resize(vEliminated.size() - (i - vStart[i]));
+                        vEliminated.push_back(store);
+                        vEliminated.back().Cmd = cmLOAD;
+                    }
+
+                    nOccurence++;
+                }
+                else
+                    vEliminated.push_back(std::move(m_vRPN[i]));
+            }
+
+            m_vRPN.swap(vEliminated);
+            nSlots++;
+        }
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Optimizes the whole RPN after all
+    /// tokens have been added: algebraic
+    /// simplification, elimination of common
+    /// subexpressions and removal of stored results,
+    /// which are never used. The stored results are
+    /// placed in slots above the stack used by the
+    /// expression itself. Expressions containing
+    /// tokens with side effects or jumps are not
+    /// changed.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+	void ParserByteCode::Optimize()
+	{
+	    int nDepth = 0;
+	    int nMaxDepth = 0;
+
+	    for (const SToken& tok : m_vRPN)
+        {
+            int nArgs = getTokenArity(tok);
+
+            if (nArgs < 0 || nArgs > nDepth)
+                return;
+
+            nDepth += 1 - nArgs;
+            nMaxDepth = std::max(nMaxDepth, nDepth);
+        }
+
+        int nSlots = 0;
+        EliminateCommonSubexpressions(nSlots);
+        SimplifyAlgebraic();
+
+        if (!nSlots)
+            return;
+
+        // Remove stored results, which are never loaded,
+        // and number the remaining slots consecutively
+        std::vector<int> vSlotIndex(nSlots, -1);
+
+        for (const SToken& tok : m_vRPN)
+        {
+            if (tok.Cmd == cmLOAD)
+                vSlotIndex[tok.Oprt().offset] = 0;
+        }
+
+        int nUsedSlots = 0;
+
+        for (int& index : vSlotIndex)
+        {
+            if (!index)
+                index = nUsedSlots++;
+        }
+
+        // The slots are located above the deepest stack
+        // position of the expression
+        int nBase = std::max((int)m_iMaxStackSize, nMaxDepth) + 1;
+        rpn_type vOptimized;
+        vOptimized.reserve(m_vRPN.size());
+
+        for (SToken& tok : m_vRPN)
+        {
+            if (tok.Cmd == cmSTORE || tok.Cmd == cmLOAD)
+            {
+                if (vSlotIndex[tok.Oprt().offset] < 0)
+                    continue;
+
+                tok.Oprt().offset = nBase + vSlotIndex[tok.Oprt().offset];
+            }
+
+            vOptimized.push_back(std::move(tok));
+        }
+
+        m_vRPN.swap(vOptimized);
+        m_iMaxStackSize = nBase + nUsedSlots - 1;
+	}
+
+
+	//---------------------------------------------------------------------------
+	/** \brief Add end marker to bytecode.
+
+	    \throw nothrow
+	*/
+	void ParserByteCode::Finalize()
+	{
+	    ResetEvaluationTiers();
+	    m_iUnoptimizedSize = m_vRPN.size() + 1; // including the end marker
+
+	    if (m_bEnableOptimizer)
+        {
+            Optimize();
+            LowerToRegisterCode();
+        }
+
+		SToken tok;
+		tok.Cmd = cmEND;
+		m_vRPN.push_back(tok);
+		rpn_type(m_vRPN).swap(m_vRPN);     // shrink bytecode vector to fit
+
+		// Determine the if-then-else jump offsets
+		ParserStack<int> stIf, stElse;
+		int idx;
+		for (int i = 0; i < (int)m_vRPN.size(); ++i)
+		{
+			switch (m_vRPN[i].Cmd)
+			{
+				case cmIF:
+					stIf.push(i);
+					break;
+
+				case  cmELSE:
+					stElse.push(i);
+					idx = stIf.pop();
+					m_vRPN[idx].Oprt().offset = i - idx;
+					break;
+
+				case cmENDIF:
+					idx = stElse.pop();
+					m_vRPN[idx].Oprt().offset = i - idx;
+					break;
+
+				default:
+					break;
+			}
+		}
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Changes all old variable pointers to
+    /// the new addresses. Will be used to compensate
+    /// for different local variable adresses in
+    /// different scopes.
+    ///
+    /// \param a_pOldVar value_type*
+    /// \param a_pNewVar value_type*
+    /// \param isVect bool
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+	void ParserByteCode::ChangeVar(Variable* a_pOldVar, Variable* a_pNewVar, bool isVect)
+	{
+	    for (size_t i = 0; i < m_vRPN.size(); ++i)
+        {
+            if (m_vRPN[i].Cmd >= cmVAR && m_vRPN[i].Cmd < cmVAR_END && m_vRPN[i].Val().var == a_pOldVar)
+            {
+                m_vRPN[i].Val().var = a_pNewVar;
+                m_vRPN[i].Val().isVect = isVect;
+            }
+            else if (m_vRPN[i].Cmd == cmREGOP || m_vRPN[i].Cmd == cmREGSELECT)
+            {
+                SRegData& reg = m_vRPN[i].Reg();
+
+                for (int n = 0; n < reg.argc; n++)
+                {
+                    if (reg.args[n].src == SOperand::SRC_VAR && reg.args[n].var == a_pOldVar)
+                        reg.args[n].var = a_pNewVar;
+                }
+            }
+        }
+
+        // The compiled tier and the element-wise analysis
+        // refer to the old addresses
+        ResetEvaluationTiers();
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Replaces all variable pointers at once
+    /// by the ones they are mapped to. In contrast
+    /// to ChangeVar(), the new addresses may also
+    /// appear as old addresses in the map. Used to
+    /// bind a bytecode compiled by another parser
+    /// instance to the variables of the current one.
+    ///
+    /// \param binding const std::map<Variable*, Variable*>&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+	void ParserByteCode::RebindVars(const std::map<Variable*, Variable*>& binding)
+	{
+	    auto rebind = [&binding](Variable*& var)
+	        {
+	            auto iter = binding.find(var);
+
+	            if (iter != binding.end())
+                    var = iter->second;
+	        };
+
+	    for (SToken& tok : m_vRPN)
+        {
+            if (std::holds_alternative<SValData>(tok.m_data))
+                rebind(tok.Val().var);
+            else if (std::holds_alternative<SOprtData>(tok.m_data))
+            {
+                for (Variable*& var : tok.Oprt().var)
+                {
+                    rebind(var);
+                }
+            }
+            else if (std::holds_alternative<SRegData>(tok.m_data))
+            {
+                SRegData& reg = tok.Reg();
+
+                for (int n = 0; n < reg.argc; n++)
+                {
+                    if (reg.args[n].src == SOperand::SRC_VAR)
+                        rebind(reg.args[n].var);
+                }
+            }
+        }
+
+        ResetEvaluationTiers();
+	}
+
+
+	//---------------------------------------------------------------------------
+	SToken* ParserByteCode::GetBase()
+	{
+		if (m_vRPN.size() == 0)
+			throw ParserError(ecINTERNAL_ERROR);
+		else
+			return &m_vRPN[0];
+	}
+
+    /////////////////////////////////////////////////
+    /// \brief Evaluate this bytecode using its
+    /// compiled tier. Returns false, if the bytecode
+    /// is not (yet) compiled or cannot be evaluated
+    /// by the compiled tier for the current values.
+    /// The interpreter has to be used in this case.
+    ///
+    /// \param Stack Array*
+    /// \param scalarFuns const scalarmap_type&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	bool ParserByteCode::EvalJit(Array* Stack, const scalarmap_type& scalarFuns)
+	{
+	    if (m_vRPN.empty())
+            return false;
+
+        return m_jit.eval(&m_vRPN[0], scalarFuns, Stack);
+	}
+
+    /////////////////////////////////////////////////
+    /// \brief Determine, whether this bytecode is
+    /// evaluated element by element, i.e. whether
+    /// its results can be calculated independently
+    /// for any part of its vector variables. This is
+    /// true, if it only consists of plain operands,
+    /// built-in operators, fused register
+    /// instructions and functions with a scalar
+    /// counterpart. The result of the analysis is
+    /// cached.
+    ///
+    /// \param scalarFuns const scalarmap_type&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	bool ParserByteCode::IsElementWise(const scalarmap_type& scalarFuns)
+	{
+	    if (m_eElementWise != EW_UNKNOWN)
+            return m_eElementWise == EW_TRUE;
+
+        m_eElementWise = EW_FALSE;
+        m_vElementWiseVars.clear();
+
+        auto addVar = [this](Variable* var)
+            {
+                if (std::find(m_vElementWiseVars.begin(), m_vElementWiseVars.end(), var) == m_vElementWiseVars.end())
+                    m_vElementWiseVars.push_back(var);
+            };
+
+        for (const SToken& tok : m_vRPN)
+        {
+            switch (tok.Cmd)
+            {
+                case cmLE:
+                case cmGE:
+                case cmNEQ:
+                case cmEQ:
+                case cmLT:
+                case cmGT:
+                case cmADD:
+                case cmSUB:
+                case cmMUL:
+                case cmDIV:
+                case cmPOW:
+                case cmLAND:
+                case cmLOR:
+                case cmEND:
+                    break;
+
+                case cmVAL:
+                    if (tok.Val().data2.size() != 1)
+                        return false;
+
+                    break;
+
+                case cmVAR:
+                case cmVARPOW2:
+                case cmVARPOW3:
+                case cmVARPOW4:
+                    addVar(tok.Val().var);
+                    break;
+
+                case cmVARPOWN:
+                case cmVARMUL:
+                case cmREVVARMUL:
+                    if (tok.Val().data.size() != 1 || tok.Val().data2.size() != 1)
+                        return false;
+
+                    addVar(tok.Val().var);
+                    break;
+
+                case cmREGOP:
+                case cmREGSELECT:
+                {
+                    const SRegData& reg = tok.Reg();
+
+                    for (int i = reg.stackArgs; i < reg.argc; i++)
+                    {
+                        if (reg.args[i].src == SOperand::SRC_VAR)
+                            addVar(reg.args[i].var);
+                        else if (reg.args[i].src != SOperand::SRC_VAL || reg.args[i].val.size() != 1)
+                            return false;
+                    }
+
+                    break;
+                }
+
+                case cmFUNC:
+                    if (tok.Fun().argc != 1 || scalarFuns.find((void*)tok.Fun().ptr) == scalarFuns.end())
+                        return false;
+
+                    break;
+
+                case cmSTORE:
+                case cmLOAD:
+                    break;
+
+                default:
+                    return false;
+            }
+        }
+
+        m_eElementWise = EW_TRUE;
+        return true;
+	}
+
+    /////////////////////////////////////////////////
+    /// \brief Return the variables referenced by
+    /// this bytecode. Only valid, if IsElementWise()
+    /// returned true.
+    ///
+    /// \return const std::vector<Variable*>&
+    ///
+    /////////////////////////////////////////////////
+	const std::vector<Variable*>& ParserByteCode::GetElementWiseVars() const
+	{
+	    return m_vElementWiseVars;
+	}
+
+    /////////////////////////////////////////////////
+    /// \brief Reset the compiled tier and the
+    /// element-wise analysis, because the bytecode
+    /// has been changed.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+	void ParserByteCode::ResetEvaluationTiers()
+	{
+	    m_jit.reset();
+	    m_eElementWise = EW_UNKNOWN;
+	    m_vElementWiseVars.clear();
+	}
+
+	//---------------------------------------------------------------------------
+	std::size_t ParserByteCode::GetMaxStackSize() const
+	{
+		return m_iMaxStackSize + 1;
+	}
+
+	//---------------------------------------------------------------------------
+	/** \brief Returns the number of entries in the bytecode. */
+	std::size_t ParserByteCode::GetSize() const
+	{
+		return m_vRPN.size();
+	}
+
+	//---------------------------------------------------------------------------
+	/** \brief Delete the bytecode.
+
+	    \throw nothrow
+
+	    The name of this function is a violation of my own coding guidelines
+	    but this way it's more in line with the STL functions thus more
+	    intuitive.
+	*/
+	void ParserByteCode::clear()
+	{
+		m_vRPN.clear();
+		m_iStackPos = 0;
+		m_iMaxStackSize = 0;
+		m_iUnoptimizedSize = 0;
+		ResetEvaluationTiers();
+	}
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper returning the name of
+    /// the passed operator for the bytecode dump.
+    ///
+    /// \param oprt ECmdCode
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+	static std::string printOprt(ECmdCode oprt)
+	{
+	    switch (oprt)
+	    {
+	        case cmLT:
+	            return "LT";
+	        case cmGT:
+	            return "GT";
+	        case cmLE:
+	            return "LE";
+	        case cmGE:
+	            return "GE";
+	        case cmEQ:
+	            return "EQ";
+	        case cmNEQ:
+	            return "NEQ";
+	        case cmADD:
+	            return "ADD";
+	        case cmSUB:
+	            return "SUB";
+	        case cmMUL:
+	            return "MUL";
+	        case cmDIV:
+	            return "DIV";
+	        case cmPOW:
+	            return "POW";
+	        case cmLAND:
+	            return "AND";
+	        case cmLOR:
+	            return "OR";
+	        default:
+	            return "";
+	    }
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper printing an operand of a
+    /// register instruction for the bytecode dump.
+    ///
+    /// \param arg const SOperand&
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+	static std::string printOperand(const SOperand& arg)
+	{
+	    if (arg.src == SOperand::SRC_VAR)
+            return "[VAR " + arg.var->print() + "]";
+
+        if (arg.src == SOperand::SRC_VAL)
+            return "[VAL " + arg.val.print() + "]";
+
+        return "[STACK]";
+	}
+
+
+	//---------------------------------------------------------------------------
+	/** \brief Dump bytecode (for debugging only!). */
+	void ParserByteCode::AsciiDump()
+	{
+		if (!m_vRPN.size())
+		{
+			print("No bytecode available");
+			return;
+		}
+
+		toggleTableMode();
+		print("Number of RPN tokens: " + toString(m_vRPN.size()));
+
+		if (m_iUnoptimizedSize)
+            print("Number of RPN tokens before optimization: " + toString(m_iUnoptimizedSize));
+
+		for (std::size_t i = 0; i < m_vRPN.size() && m_vRPN[i].Cmd != cmEND; ++i)
+		{
+		    printFormatted("|   " + toString(i) + " : \t");
+			switch (m_vRPN[i].Cmd)
+			{
+				case cmVAL:
+				    printFormatted("VAL       \t[" + m_vRPN[i].Val().data2.print() + "]\n");
+					break;
+
+				case cmVAR:
+				    printFormatted("VAR       \t[" + m_vRPN[i].Val().var->print() + "]\n");
+					break;
+
+				case cmVARARRAY:
+				    printFormatted("VARARR    \t[" + m_vRPN[i].Oprt().var.print() + "]\n");
+					break;
+
+				case cmVARPOW2:
+				    printFormatted("VARPOW2   \t[" + m_vRPN[i].Val().var->print() + "]\n");
+					break;
+
+				case cmVARPOW3:
+					printFormatted("VARPOW3   \t[" + m_vRPN[i].Val().var->print() + "]\n");
+					break;
+
+				case cmVARPOW4:
+					printFormatted("VARPOW4   \t[" + m_vRPN[i].Val().var->print() + "]\n");
+					break;
+
+				case cmVARPOWN:
+					printFormatted("VARPOWN   \t[" + m_vRPN[i].Val().var->print() + "] ^ [" + m_vRPN[i].Val().data.print() + "]\n");
+					break;
+
+				case cmVARMUL:
+					printFormatted("VARMUL    \t[" + m_vRPN[i].Val().var->print() + "]");
+					printFormatted(" * [" + m_vRPN[i].Val().data.print() + "] + [" + m_vRPN[i].Val().data2.print() + "]\n");
+					break;
+
+				case cmREVVARMUL:
+					printFormatted("REVVARMUL \t[" + m_vRPN[i].Val().data2.print() + "]");
+					printFormatted(" + [" + m_vRPN[i].Val().var->print() + "] * [" + m_vRPN[i].Val().data.print() + "]\n");
+					break;
+
+				case cmFUNC:
+				    printFormatted("CALL      \t[ARG: " + toString(m_vRPN[i].Fun().argc) + "] [FUNC: " + m_vRPN[i].Fun().name + "] [ADDR: " + toHexString((size_t)m_vRPN[i].Fun().ptr) + "]\n");
+					break;
+
+				case cmMETHOD:
+				    printFormatted("CALL      \t[ARG: " + toString(m_vRPN[i].Fun().argc) + "] [METHOD: " + m_vRPN[i].Fun().name + "]\n");
+					break;
+
+				case cmLT:
+				    printFormatted("LT\n");
+					break;
+				case cmGT:
+					printFormatted("GT\n");
+					break;
+				case cmLE:
+					printFormatted("LE\n");
+					break;
+				case cmGE:
+					printFormatted("GE\n");
+					break;
+				case cmEQ:
+					printFormatted("EQ\n");
+					break;
+				case cmNEQ:
+					printFormatted("NEQ\n");
+					break;
+				case cmADD:
+					printFormatted("ADD\n");
+					break;
 				case cmLAND:
 					printFormatted("AND\n");
 					break;
@@ -877,6 +1942,40 @@ namespace mu
 					printFormatted("VAL2STR\n");
 					break;
 
+				case cmREGOP:
+				{
+				    const SRegData& reg = m_vRPN[i].Reg();
+				    printFormatted("REGOP     \t" + printOprt(reg.oprt) + " " + printOperand(reg.args[0]) + " " + printOperand(reg.args[1]));
+
+				    if (reg.argc > 2)
+                        printFormatted(" " + printOprt(reg.oprt2) + " " + printOperand(reg.args[2]));
+
+                    printFormatted("\n");
+					break;
+				}
+
+				case cmREGSELECT:
+				{
+				    const SRegData& reg = m_vRPN[i].Reg();
+
+				    if (reg.argc == 4)
+                        printFormatted("REGSELECT \t" + printOprt(reg.oprt) + " " + printOperand(reg.args[0]) + " " + printOperand(reg.args[1])
+                                       + " ? " + printOperand(reg.args[2]) + " : " + printOperand(reg.args[3]) + "\n");
+                    else
+                        printFormatted("REGSELECT \t" + printOperand(reg.args[0])
+                                       + " ? " + printOperand(reg.args[1]) + " : " + printOperand(reg.args[2]) + "\n");
+
+					break;
+				}
+
+				case cmSTORE:
+				    printFormatted("STORE     \t[SLOT: " + toString(m_vRPN[i].Oprt().offset) + "]\n");
+					break;
+
+				case cmLOAD:
+				    printFormatted("LOAD      \t[SLOT: " + toString(m_vRPN[i].Oprt().offset) + "]\n");
+					break;
+
 				case cmIF:
 				    printFormatted("IF        \t[OFFSET: " + toString(m_vRPN[i].Oprt().offset) + "]\n");
 					break;
@@ -930,4 +2029,493 @@ namespace mu
 		toggleTableMode();
 		printFormatted("|   END\n");
 	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper writing a Numerical
+    /// together with its type to the stream.
+    ///
+    /// \param stream std::ostream&
+    /// \param num const Numerical&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+	static void writeNumerical(std::ostream& stream, const Numerical& num)
+	{
+	    writeNumField<uint8_t>(stream, num.getType());
+
+	    switch (num.getType())
+	    {
+	        case LOGICAL:
+	        case I8:
+	        case I16:
+	        case I32:
+	        case I64:
+	            writeNumField<int64_t>(stream, num.asI64());
+	            break;
+	        case UI8:
+	        case UI16:
+	        case UI32:
+	        case UI64:
+	            writeNumField<uint64_t>(stream, num.asUI64());
+	            break;
+	        default:
+	            writeNumField<double>(stream, num.asCF64().real());
+	            writeNumField<double>(stream, num.asCF64().imag());
+	    }
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper reading a Numerical
+    /// from the stream. Restores the stored type.
+    ///
+    /// \param stream std::istream&
+    /// \return Numerical
+    ///
+    /////////////////////////////////////////////////
+	static Numerical readNumerical(std::istream& stream)
+	{
+	    NumericalType type = (NumericalType)readNumField<uint8_t>(stream);
+
+	    switch (type)
+	    {
+	        case LOGICAL:
+	            return Numerical(readNumField<int64_t>(stream) != 0);
+	        case I8:
+	        case I16:
+	        case I32:
+	        case I64:
+	            return Numerical(readNumField<int64_t>(stream), type);
+	        case UI8:
+	        case UI16:
+	        case UI32:
+	        case UI64:
+	            return Numerical(readNumField<uint64_t>(stream), type);
+	        case F32:
+	        case F64:
+	        case DATETIME:
+	        case CF32:
+	        case CF64:
+	        {
+	            double re = readNumField<double>(stream);
+	            double im = readNumField<double>(stream);
+	            return Numerical(std::complex<double>(re, im), type);
+	        }
+	        default:
+	            stream.setstate(std::ios_base::failbit);
+	    }
+
+	    return Numerical();
+	}
+
+
+	static bool writeArray(std::ostream& stream, const Array& arr);
+	static Array readArray(std::istream& stream);
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper writing a single Value
+    /// to the stream. Returns false, if the type of
+    /// the Value cannot be serialized.
+    ///
+    /// \param stream std::ostream&
+    /// \param val const Value&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	static bool writeValue(std::ostream& stream, const Value& val)
+	{
+	    writeNumField<uint8_t>(stream, val.getType());
+
+	    switch (val.getType())
+	    {
+	        case TYPE_VOID:
+	            return true;
+	        case TYPE_NUMERICAL:
+	            writeNumerical(stream, val.getNum());
+	            return true;
+	        case TYPE_STRING:
+	            writeStringField(stream, val.getStr());
+	            return true;
+	        case TYPE_CATEGORY:
+	            writeNumerical(stream, val.getCategory().val);
+	            writeStringField(stream, val.getCategory().name);
+	            return true;
+	        case TYPE_ARRAY:
+	            return writeArray(stream, val.getArray());
+	        default:
+	            return false;
+	    }
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper reading a single Value
+    /// from the stream.
+    ///
+    /// \param stream std::istream&
+    /// \return Value
+    ///
+    /////////////////////////////////////////////////
+	static Value readValue(std::istream& stream)
+	{
+	    switch (readNumField<uint8_t>(stream))
+	    {
+	        case TYPE_VOID:
+	            return Value();
+	        case TYPE_NUMERICAL:
+	            return Value(readNumerical(stream));
+	        case TYPE_STRING:
+	            return Value(readStringField(stream));
+	        case TYPE_CATEGORY:
+	        {
+	            Category cat;
+	            cat.val = readNumerical(stream);
+	            cat.name = readStringField(stream);
+	            return Value(cat);
+	        }
+	        case TYPE_ARRAY:
+	            return Value(readArray(stream));
+	        default:
+	            stream.setstate(std::ios_base::failbit);
+	    }
+
+	    return Value();
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper writing an Array to the
+    /// stream.
+    ///
+    /// \param stream std::ostream&
+    /// \param arr const Array&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	static bool writeArray(std::ostream& stream, const Array& arr)
+	{
+	    writeNumField<uint64_t>(stream, arr.size());
+
+	    for (const Value& val : arr)
+        {
+            if (!writeValue(stream, val))
+                return false;
+        }
+
+        return true;
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper reading an Array from
+    /// the stream.
+    ///
+    /// \param stream std::istream&
+    /// \return Array
+    ///
+    /////////////////////////////////////////////////
+	static Array readArray(std::istream& stream)
+	{
+	    uint64_t nElems = readNumField<uint64_t>(stream);
+	    Array arr;
+
+	    for (uint64_t i = 0; i < nElems && stream.good(); i++)
+        {
+            arr.push_back(readValue(stream));
+        }
+
+        return arr;
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper writing the symbol of a
+    /// variable to the stream. A nullptr is written
+    /// as an empty symbol.
+    ///
+    /// \param stream std::ostream&
+    /// \param var const Variable*
+    /// \param symbols const ByteCodeSymbols&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	static bool writeVar(std::ostream& stream, const Variable* var, const ByteCodeSymbols& symbols)
+	{
+	    std::string sSymbol;
+
+	    if (var && !symbols.getVarSymbol(var, sSymbol))
+            return false;
+
+        writeStringField(stream, sSymbol);
+        return true;
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper reading the symbol of a
+    /// variable from the stream and resolving it.
+    ///
+    /// \param stream std::istream&
+    /// \param var Variable*&
+    /// \param symbols const ByteCodeSymbols&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	static bool readVar(std::istream& stream, Variable*& var, const ByteCodeSymbols& symbols)
+	{
+	    std::string sSymbol = readStringField(stream);
+	    var = sSymbol.length() ? symbols.getVar(sSymbol) : nullptr;
+	    return var || !sSymbol.length();
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper writing the symbol of a
+    /// callback to the stream. A nullptr is written
+    /// as an empty symbol.
+    ///
+    /// \param stream std::ostream&
+    /// \param fun generic_fun_type
+    /// \param sName const std::string&
+    /// \param symbols const ByteCodeSymbols&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	static bool writeFun(std::ostream& stream, generic_fun_type fun, const std::string& sName, const ByteCodeSymbols& symbols)
+	{
+	    std::string sSymbol;
+
+	    if (fun && !symbols.getFunSymbol(fun, sName, sSymbol))
+            return false;
+
+        writeStringField(stream, sSymbol);
+        return true;
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper reading the symbol of a
+    /// callback from the stream and resolving it.
+    ///
+    /// \param stream std::istream&
+    /// \param fun generic_fun_type&
+    /// \param symbols const ByteCodeSymbols&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	static bool readFun(std::istream& stream, generic_fun_type& fun, const ByteCodeSymbols& symbols)
+	{
+	    std::string sSymbol = readStringField(stream);
+	    fun = sSymbol.length() ? symbols.getFun(sSymbol) : nullptr;
+	    return fun || !sSymbol.length();
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Serialize the finalized bytecode into
+    /// the passed binary stream. Variables and
+    /// callbacks are stored by their symbols, so
+    /// that the bytecode may be restored in a
+    /// different session. Returns false, if the
+    /// bytecode contains elements, which cannot be
+    /// represented by a symbol.
+    ///
+    /// \param stream std::ostream&
+    /// \param symbols const ByteCodeSymbols&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	bool ParserByteCode::Serialize(std::ostream& stream, const ByteCodeSymbols& symbols) const
+	{
+	    writeNumField<uint64_t>(stream, m_iMaxStackSize);
+	    writeNumField<uint64_t>(stream, m_vRPN.size());
+
+	    for (const SToken& tok : m_vRPN)
+        {
+            writeNumField<int32_t>(stream, tok.Cmd);
+            writeNumField<uint8_t>(stream, tok.m_data.index());
+
+            if (std::holds_alternative<SValData>(tok.m_data))
+            {
+                const SValData& val = tok.Val();
+
+                if (!writeVar(stream, val.var, symbols)
+                    || !writeArray(stream, val.data)
+                    || !writeArray(stream, val.data2))
+                    return false;
+
+                writeNumField<uint8_t>(stream, val.isVect);
+            }
+            else if (std::holds_alternative<SFunData>(tok.m_data))
+            {
+                const SFunData& fun = tok.Fun();
+
+                if (!writeFun(stream, fun.ptr, fun.name, symbols))
+                    return false;
+
+                writeStringField(stream, fun.name);
+                writeNumField<int32_t>(stream, fun.argc);
+                writeNumField<int32_t>(stream, fun.idx);
+                writeNumField<uint8_t>(stream, fun.optimizeAway);
+            }
+            else if (std::holds_alternative<SOprtData>(tok.m_data))
+            {
+                const SOprtData& oprt = tok.Oprt();
+                writeNumField<uint64_t>(stream, oprt.var.size());
+
+                for (const Variable* var : oprt.var)
+                {
+                    if (!writeVar(stream, var, symbols))
+                        return false;
+                }
+
+                writeNumField<int32_t>(stream, oprt.offset);
+            }
+            else
+            {
+                const SRegData& reg = tok.Reg();
+                writeNumField<int32_t>(stream, reg.oprt);
+                writeNumField<int32_t>(stream, reg.oprt2);
+                writeNumField<int32_t>(stream, reg.argc);
+                writeNumField<int32_t>(stream, reg.stackArgs);
+
+                for (const SOperand& arg : reg.args)
+                {
+                    writeNumField<uint8_t>(stream, arg.src);
+
+                    if (!writeVar(stream, arg.var, symbols) || !writeArray(stream, arg.val))
+                        return false;
+                }
+
+                // The only callback of a register instruction
+                // is the ternary operator
+                if (!writeFun(stream, reg.fun, MU_IF_ELSE, symbols))
+                    return false;
+            }
+        }
+
+        return stream.good();
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Restore the bytecode from the passed
+    /// binary stream. The symbols of the variables
+    /// and callbacks are resolved using the passed
+    /// symbols. The current bytecode is only
+    /// replaced, if the whole bytecode could be
+    /// restored.
+    ///
+    /// \param stream std::istream&
+    /// \param symbols const ByteCodeSymbols&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	bool ParserByteCode::Deserialize(std::istream& stream, const ByteCodeSymbols& symbols)
+	{
+	    size_t nMaxStackSize = readNumField<uint64_t>(stream);
+	    uint64_t nTokens = readNumField<uint64_t>(stream);
+	    rpn_type vRPN;
+
+	    for (uint64_t i = 0; i < nTokens && stream.good(); i++)
+        {
+            SToken tok;
+            tok.Cmd = (ECmdCode)readNumField<int32_t>(stream);
+
+            if (tok.Cmd < cmLE || tok.Cmd > cmEND)
+                return false;
+
+            switch (readNumField<uint8_t>(stream))
+            {
+                case 0:
+                {
+                    SValData val;
+
+                    if (!readVar(stream, val.var, symbols))
+                        return false;
+
+                    val.data = readArray(stream);
+                    val.data2 = readArray(stream);
+                    val.isVect = readNumField<uint8_t>(stream);
+                    tok.m_data = val;
+                    break;
+                }
+                case 1:
+                {
+                    SFunData fun;
+
+                    if (!readFun(stream, fun.ptr, symbols))
+                        return false;
+
+                    fun.name = readStringField(stream);
+                    fun.argc = readNumField<int32_t>(stream);
+                    fun.idx = readNumField<int32_t>(stream);
+                    fun.optimizeAway = readNumField<uint8_t>(stream);
+                    tok.m_data = fun;
+                    break;
+                }
+                case 2:
+                {
+                    SOprtData oprt;
+                    uint64_t nVars = readNumField<uint64_t>(stream);
+
+                    for (uint64_t n = 0; n < nVars && stream.good(); n++)
+                    {
+                        Variable* var;
+
+                        if (!readVar(stream, var, symbols))
+                            return false;
+
+                        oprt.var.push_back(var);
+                    }
+
+                    oprt.offset = readNumField<int32_t>(stream);
+                    tok.m_data = oprt;
+                    break;
+                }
+                case 3:
+                {
+                    SRegData reg;
+                    reg.oprt = (ECmdCode)readNumField<int32_t>(stream);
+                    reg.oprt2 = (ECmdCode)readNumField<int32_t>(stream);
+                    reg.argc = readNumField<int32_t>(stream);
+                    reg.stackArgs = readNumField<int32_t>(stream);
+
+                    for (SOperand& arg : reg.args)
+                    {
+                        arg.src = (SOperand::SourceType)readNumField<uint8_t>(stream);
+
+                        if (!readVar(stream, arg.var, symbols))
+                            return false;
+
+                        arg.val = readArray(stream);
+                    }
+
+                    if (!readFun(stream, reg.fun, symbols))
+                        return false;
+
+                    tok.m_data = reg;
+                    break;
+                }
+                default:
+                    return false;
+            }
+
+            vRPN.push_back(tok);
+        }
+
+        // The restored bytecode has to be complete
+        if (!stream.good() || vRPN.empty() || vRPN.back().Cmd != cmEND)
+            return false;
+
+        m_vRPN.swap(vRPN);
+        m_iMaxStackSize = nMaxStackSize;
+        m_iStackPos = 0;
+        m_iUnoptimizedSize = 0;
+        ResetEvaluationTiers();
+
+        return true;
+	}
 } // namespace mu
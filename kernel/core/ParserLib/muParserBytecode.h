@@ -30,10 +30,12 @@
 #include <stack>
 #include <vector>
 #include <variant>
+#include <iosfwd>
 
 #include "muParserDef.h"
 #include "muParserError.h"
 #include "muParserToken.h"
+#include "muParserJit.hpp"
 
 /** \file
     \brief Definition of the parser bytecode class.
@@ -68,6 +70,7 @@ namespace mu
         std::string name;
         int   argc;
         int   idx;
+        bool  optimizeAway;
     };
 
     /////////////////////////////////////////////////
@@ -80,6 +83,42 @@ namespace mu
         int offset;
     };
 
+    /////////////////////////////////////////////////
+    /// \brief An operand of a fused register
+    /// instruction. Operands are either read from
+    /// the topmost stack elements or directly from a
+    /// variable or a constant value.
+    /////////////////////////////////////////////////
+    struct SOperand
+    {
+        enum SourceType
+        {
+            SRC_STACK,
+            SRC_VAR,
+            SRC_VAL
+        };
+
+        SourceType src;
+        Variable* var;
+        Array val;
+    };
+
+    /////////////////////////////////////////////////
+    /// \brief A structure representing a fused
+    /// register instruction, i.e. a binary operator
+    /// with an optional second operator or a (compare
+    /// and) select for the ternary operator.
+    /////////////////////////////////////////////////
+    struct SRegData
+    {
+        ECmdCode oprt;
+        ECmdCode oprt2;
+        SOperand args[4];
+        int argc;
+        int stackArgs;
+        generic_fun_type fun;
+    };
+
     /////////////////////////////////////////////////
     /// \brief This struct represents an already
     /// classified token together with its associated
@@ -88,7 +127,7 @@ namespace mu
 	struct SToken
 	{
 		ECmdCode Cmd;
-        std::variant<SValData, SFunData, SOprtData> m_data;
+        std::variant<SValData, SFunData, SOprtData, SRegData> m_data;
 
 		SToken()
 		{
@@ -124,9 +163,38 @@ namespace mu
 		{
 		    return std::get<SOprtData>(m_data);
 		}
+
+		SRegData& Reg()
+		{
+		    return std::get<SRegData>(m_data);
+		}
+
+		const SRegData& Reg() const
+		{
+		    return std::get<SRegData>(m_data);
+		}
 	};
 
 
+    /////////////////////////////////////////////////
+    /// \brief Interface for translating the
+    /// addresses of variables and callbacks within a
+    /// bytecode into symbolic names and back. This
+    /// is necessary for storing compiled expressions
+    /// beyond the lifetime of the current session.
+    /////////////////////////////////////////////////
+    class ByteCodeSymbols
+    {
+        public:
+            virtual ~ByteCodeSymbols() {}
+
+            virtual bool getVarSymbol(const Variable* var, std::string& sSymbol) const = 0;
+            virtual Variable* getVar(const std::string& sSymbol) const = 0;
+            virtual bool getFunSymbol(generic_fun_type fun, const std::string& sName, std::string& sSymbol) const = 0;
+            virtual generic_fun_type getFun(const std::string& sSymbol) const = 0;
+    };
+
+
 	/** \brief Bytecode implementation of the Math Parser.
 
 	The bytecode contains the formula converted to revers polish notation stored in a continious
@@ -157,7 +225,31 @@ namespace mu
 
 			bool m_bEnableOptimizer;
 
+			/** \brief The compiled tier of this bytecode. */
+			JitProgram m_jit;
+
+			enum EElementWise
+			{
+			    EW_UNKNOWN,
+			    EW_FALSE,
+			    EW_TRUE
+			};
+
+			/** \brief Cached result of the element-wise analysis. */
+			EElementWise m_eElementWise;
+
+			/** \brief Variables referenced by an element-wise bytecode. */
+			std::vector<Variable*> m_vElementWiseVars;
+
+			/** \brief Number of tokens before the optimization of the whole RPN. */
+			std::size_t m_iUnoptimizedSize;
+
 			void ConstantFolding(ECmdCode a_Oprt);
+			void SimplifyAlgebraic();
+			void EliminateCommonSubexpressions(int& nSlots);
+			void Optimize();
+			void LowerToRegisterCode();
+			void ResetEvaluationTiers();
 
 		public:
 
@@ -179,15 +271,24 @@ namespace mu
 			void pop();
 
 			void EnableOptimizer(bool bStat);
+			bool IsOptimizerEnabled() const;
 
 			void Finalize();
 			void ChangeVar(Variable* a_pOldVar, Variable* a_pNewVar, bool isVect);
+			void RebindVars(const std::map<Variable*, Variable*>& binding);
 			void clear();
 			std::size_t GetMaxStackSize() const;
 			std::size_t GetSize() const;
 
 			SToken* GetBase();
 			void AsciiDump();
+
+			bool EvalJit(Array* Stack, const scalarmap_type& scalarFuns);
+			bool IsElementWise(const scalarmap_type& scalarFuns);
+			const std::vector<Variable*>& GetElementWiseVars() const;
+
+			bool Serialize(std::ostream& stream, const ByteCodeSymbols& symbols) const;
+			bool Deserialize(std::istream& stream, const ByteCodeSymbols& symbols);
 	};
 
 } // namespace mu
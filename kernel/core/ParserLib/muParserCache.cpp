@@ -0,0 +1,536 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2024  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "muParserCache.hpp"
+#include "muParserDef.h"
+
+#include <fstream>
+#include <ctime>
+#include <functional>
+#include <algorithm>
+
+#define BYTECODECACHE_MAGIC "NUMERE-BYTECODE-CACHE"
+
+namespace mu
+{
+    /////////////////////////////////////////////////
+    /// \brief Create an empty bytecode cache.
+    /////////////////////////////////////////////////
+    ByteCodeCache::ByteCodeCache() : m_isModified(false)
+    {
+        //
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Set the file name of the cache file.
+    ///
+    /// \param sFileName const std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void ByteCodeCache::setFileName(const std::string& sFileName)
+    {
+        m_fileName = sFileName;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Load the cache file. Files with a
+    /// different version or a different set of
+    /// command codes are ignored and will be
+    /// replaced upon the next save.
+    ///
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    bool ByteCodeCache::load()
+    {
+        m_files.clear();
+        m_isModified = false;
+
+        std::ifstream cacheFile(m_fileName, std::ios_base::in | std::ios_base::binary);
+
+        if (!cacheFile.good())
+            return false;
+
+        if (readStringField(cacheFile) != BYTECODECACHE_MAGIC
+            || readNumField<uint32_t>(cacheFile) != VERSION
+            || readNumField<uint32_t>(cacheFile) != (uint32_t)cmEND)
+            return false;
+
+        uint32_t nFiles = readNumField<uint32_t>(cacheFile);
+
+        for (uint32_t i = 0; i < nFiles && cacheFile.good(); i++)
+        {
+            std::string sFileHash = readStringField(cacheFile);
+            FileEntries& file = m_files[sFileHash];
+            file.m_lastUse = readNumField<int64_t>(cacheFile);
+
+            uint32_t nLines = readNumField<uint32_t>(cacheFile);
+
+            for (uint32_t j = 0; j < nLines && cacheFile.good(); j++)
+            {
+                Entry& entry = file.m_lines[readNumField<int32_t>(cacheFile)];
+                entry.m_expr = readStringField(cacheFile);
+                entry.m_numResults = readNumField<int32_t>(cacheFile);
+                entry.m_usedVars.resize(readNumField<uint32_t>(cacheFile));
+
+                for (std::string& sVar : entry.m_usedVars)
+                {
+                    sVar = readStringField(cacheFile);
+                }
+
+                entry.m_byteCode = readStringField(cacheFile);
+            }
+        }
+
+        // Do not use partially read files
+        if (!cacheFile.good())
+        {
+            m_files.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Save the cache file, if the cache was
+    /// modified. Entries of files, which have not
+    /// been used for a longer duration, are removed
+    /// before saving.
+    ///
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    bool ByteCodeCache::save()
+    {
+        if (!m_isModified || !m_fileName.length())
+            return true;
+
+        int64_t now = time(0);
+
+        for (auto iter = m_files.begin(); iter != m_files.end(); )
+        {
+            if (now - iter->second.m_lastUse > EXPIRATION || iter->second.m_lines.empty())
+                iter = m_files.erase(iter);
+            else
+                ++iter;
+        }
+
+        std::ofstream cacheFile(m_fileName, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+        if (!cacheFile.good())
+            return false;
+
+        writeStringField(cacheFile, BYTECODECACHE_MAGIC);
+        writeNumField<uint32_t>(cacheFile, VERSION);
+        writeNumField<uint32_t>(cacheFile, (uint32_t)cmEND);
+        writeNumField<uint32_t>(cacheFile, m_files.size());
+
+        for (const auto& file : m_files)
+        {
+            writeStringField(cacheFile, file.first);
+            writeNumField<int64_t>(cacheFile, file.second.m_lastUse);
+            writeNumField<uint32_t>(cacheFile, file.second.m_lines.size());
+
+            for (const auto& line : file.second.m_lines)
+            {
+                writeNumField<int32_t>(cacheFile, line.first);
+                writeStringField(cacheFile, line.second.m_expr);
+                writeNumField<int32_t>(cacheFile, line.second.m_numResults);
+                writeNumField<uint32_t>(cacheFile, line.second.m_usedVars.size());
+
+                for (const std::string& sVar : line.second.m_usedVars)
+                {
+                    writeStringField(cacheFile, sVar);
+                }
+
+                writeStringField(cacheFile, line.second.m_byteCode);
+            }
+        }
+
+        m_isModified = !cacheFile.good();
+        return !m_isModified;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Find the cached entry of the selected
+    /// line within the file with the passed hash.
+    /// Returns a nullptr, if no entry is available.
+    ///
+    /// \param sFileHash const std::string&
+    /// \param nLine int
+    /// \return const ByteCodeCache::Entry*
+    ///
+    /////////////////////////////////////////////////
+    const ByteCodeCache::Entry* ByteCodeCache::find(const std::string& sFileHash, int nLine)
+    {
+        auto fileIter = m_files.find(sFileHash);
+
+        if (fileIter == m_files.end())
+            return nullptr;
+
+        auto lineIter = fileIter->second.m_lines.find(nLine);
+
+        if (lineIter == fileIter->second.m_lines.end())
+            return nullptr;
+
+        // Refresh the usage time stamp only once per day to
+        // avoid rewriting an otherwise unchanged file
+        int64_t now = time(0);
+
+        if (now - fileIter->second.m_lastUse > 24*3600)
+        {
+            fileIter->second.m_lastUse = now;
+            m_isModified = true;
+        }
+
+        return &lineIter->second;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Store a compiled expression for the
+    /// selected line. An already existing entry is
+    /// replaced.
+    ///
+    /// \param sFileHash const std::string&
+    /// \param nLine int
+    /// \param entry const ByteCodeCache::Entry&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void ByteCodeCache::store(const std::string& sFileHash, int nLine, const ByteCodeCache::Entry& entry)
+    {
+        FileEntries& file = m_files[sFileHash];
+        file.m_lines[nLine] = entry;
+        file.m_lastUse = time(0);
+        m_isModified = true;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Remove all entries of the file with
+    /// the passed hash, e.g. because the file was
+    /// modified or deleted.
+    ///
+    /// \param sFileHash const std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void ByteCodeCache::invalidate(const std::string& sFileHash)
+    {
+        if (m_files.erase(sFileHash))
+            m_isModified = true;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Remove all entries from the cache.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void ByteCodeCache::clear()
+    {
+        m_isModified = m_isModified || m_files.size();
+        m_files.clear();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Return the number of cached entries.
+    ///
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+    size_t ByteCodeCache::size() const
+    {
+        size_t nEntries = 0;
+
+        for (const auto& file : m_files)
+        {
+            nEntries += file.second.m_lines.size();
+        }
+
+        return nEntries;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to determine, whether
+    /// the passed factory contains a variable with
+    /// the same name and type for every slot of the
+    /// used variables of an entry. The addresses of
+    /// the variables do not matter, because the
+    /// bytecode is rebound before being used.
+    ///
+    /// \param entry const SharedExpressionCache::Entry&
+    /// \param factory VarFactory&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    static bool isSameBinding(const SharedExpressionCache::Entry& entry, VarFactory& factory)
+    {
+        size_t nSlot = 0;
+
+        for (const auto& iter : entry.m_usedVar)
+        {
+            Variable* var = factory.Get(iter.first);
+
+            if (!var || var->getCommonType() != entry.m_varTypes[nSlot])
+                return false;
+
+            nSlot++;
+        }
+
+        return true;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to determine, whether
+    /// two entries bind the same variable names and
+    /// types to their slots.
+    ///
+    /// \param entry const SharedExpressionCache::Entry&
+    /// \param other const SharedExpressionCache::Entry&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    static bool isSameBinding(const SharedExpressionCache::Entry& entry, const SharedExpressionCache::Entry& other)
+    {
+        if (entry.m_usedVar.size() != other.m_usedVar.size() || entry.m_varTypes != other.m_varTypes)
+            return false;
+
+        return std::equal(entry.m_usedVar.begin(), entry.m_usedVar.end(), other.m_usedVar.begin(),
+                          [](const auto& a, const auto& b){return a.first == b.first;});
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Return the shared cache. It is
+    /// created upon the first call.
+    ///
+    /// \return SharedExpressionCache&
+    ///
+    /////////////////////////////////////////////////
+    SharedExpressionCache& SharedExpressionCache::get()
+    {
+        static SharedExpressionCache cache;
+        return cache;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Private constructor.
+    /////////////////////////////////////////////////
+    SharedExpressionCache::SharedExpressionCache() : m_useCounter(0), m_capacity(DEFAULT_CAPACITY)
+    {
+        //
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Return the shard responsible for the
+    /// passed expression.
+    ///
+    /// \param sExpr const std::string&
+    /// \return SharedExpressionCache::Shard&
+    ///
+    /////////////////////////////////////////////////
+    SharedExpressionCache::Shard& SharedExpressionCache::getShard(const std::string& sExpr)
+    {
+        return m_shards[std::hash<std::string>()(sExpr) % SHARDS];
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Find the compiled expression, which
+    /// was compiled with the passed definition stamp
+    /// and optimizer setting and whose variables
+    /// have the same names and types as in the
+    /// passed factory. Returns a nullptr, if no such
+    /// entry exists.
+    ///
+    /// \param sExpr const std::string&
+    /// \param nDefinitionStamp uint64_t
+    /// \param bOptimized bool
+    /// \param factory VarFactory&
+    /// \return std::shared_ptr<const SharedExpressionCache::Entry>
+    ///
+    /////////////////////////////////////////////////
+    std::shared_ptr<const SharedExpressionCache::Entry> SharedExpressionCache::find(const std::string& sExpr,
+                                                                                    uint64_t nDefinitionStamp,
+                                                                                    bool bOptimized,
+                                                                                    VarFactory& factory)
+    {
+        std::shared_ptr<const entrymap_type> entries = std::atomic_load(&getShard(sExpr).m_entries);
+
+        if (!entries)
+            return nullptr;
+
+        auto range = entries->equal_range(sExpr);
+
+        for (auto iter = range.first; iter != range.second; ++iter)
+        {
+            const Entry& entry = *iter->second;
+
+            if (entry.m_definitionStamp == nDefinitionStamp
+                && entry.m_byteCode.IsOptimizerEnabled() == bOptimized
+                && isSameBinding(entry, factory))
+            {
+                entry.m_lastUse.store(++m_useCounter, std::memory_order_relaxed);
+                return iter->second;
+            }
+        }
+
+        return nullptr;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Store a compiled expression. An entry
+    /// with the same expression, definition stamp,
+    /// optimizer setting and variable binding is
+    /// replaced. If the shard is full, its least
+    /// recently used entries are removed.
+    ///
+    /// \param entry const std::shared_ptr<Entry>&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void SharedExpressionCache::store(const std::shared_ptr<Entry>& entry)
+    {
+        size_t nShardCapacity = m_capacity / SHARDS;
+
+        if (!nShardCapacity)
+            return;
+
+        Shard& shard = getShard(entry->m_expr);
+        std::lock_guard<std::mutex> lock(shard.m_mutex);
+
+        entry->m_lastUse = ++m_useCounter;
+        std::shared_ptr<const entrymap_type> current = std::atomic_load(&shard.m_entries);
+        std::shared_ptr<entrymap_type> entries = current
+            ? std::make_shared<entrymap_type>(*current)
+            : std::make_shared<entrymap_type>();
+
+        auto range = entries->equal_range(entry->m_expr);
+
+        for (auto iter = range.first; iter != range.second; ++iter)
+        {
+            if (iter->second->m_definitionStamp == entry->m_definitionStamp
+                && iter->second->m_byteCode.IsOptimizerEnabled() == entry->m_byteCode.IsOptimizerEnabled()
+                && isSameBinding(*iter->second, *entry))
+            {
+                entries->erase(iter);
+                break;
+            }
+        }
+
+        while (entries->size() >= nShardCapacity)
+        {
+            auto lru = entries->begin();
+
+            for (auto iter = entries->begin(); iter != entries->end(); ++iter)
+            {
+                if (iter->second->m_lastUse < lru->second->m_lastUse)
+                    lru = iter;
+            }
+
+            entries->erase(lru);
+        }
+
+        entries->emplace(entry->m_expr, entry);
+        std::atomic_store(&shard.m_entries, std::shared_ptr<const entrymap_type>(std::move(entries)));
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Remove all entries from the cache.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void SharedExpressionCache::clear()
+    {
+        for (Shard& shard : m_shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.m_mutex);
+            std::atomic_store(&shard.m_entries, std::shared_ptr<const entrymap_type>());
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Change the maximal number of entries.
+    /// The cache is disabled, if the capacity is
+    /// smaller than the number of shards.
+    /// Surplus entries are removed.
+    ///
+    /// \param nCapacity size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void SharedExpressionCache::setCapacity(size_t nCapacity)
+    {
+        m_capacity = nCapacity;
+
+        if (nCapacity < SHARDS || size() > nCapacity)
+            clear();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Return the maximal number of entries.
+    ///
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+    size_t SharedExpressionCache::getCapacity() const
+    {
+        return m_capacity;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Return the number of cached entries.
+    ///
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+    size_t SharedExpressionCache::size() const
+    {
+        size_t nEntries = 0;
+
+        for (const Shard& shard : m_shards)
+        {
+            std::shared_ptr<const entrymap_type> entries = std::atomic_load(&shard.m_entries);
+
+            if (entries)
+                nEntries += entries->size();
+        }
+
+        return nEntries;
+    }
+}
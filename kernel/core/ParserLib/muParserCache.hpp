@@ -0,0 +1,316 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2024  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef MUPARSERCACHE_HPP
+#define MUPARSERCACHE_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <istream>
+#include <ostream>
+#include <cstdint>
+
+#include "muParserBytecode.h"
+#include "muVarFactory.hpp"
+
+namespace mu
+{
+    /////////////////////////////////////////////////
+    /// \brief Write a numeric field of the selected
+    /// template type to the binary stream.
+    ///
+    /// \param stream std::ostream&
+    /// \param num T
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    template <typename T> void writeNumField(std::ostream& stream, T num)
+    {
+        stream.write((const char*)&num, sizeof(T));
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Read a numeric field of the selected
+    /// template type from the binary stream.
+    ///
+    /// \param stream std::istream&
+    /// \return T
+    ///
+    /////////////////////////////////////////////////
+    template <typename T> T readNumField(std::istream& stream)
+    {
+        T num = T();
+        stream.read((char*)&num, sizeof(T));
+        return num;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Write a string field to the binary
+    /// stream. The length is stored in front of the
+    /// characters.
+    ///
+    /// \param stream std::ostream&
+    /// \param sString const std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    inline void writeStringField(std::ostream& stream, const std::string& sString)
+    {
+        writeNumField<uint32_t>(stream, sString.length());
+        stream.write(sString.data(), sString.length());
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Read a string field from the binary
+    /// stream.
+    ///
+    /// \param stream std::istream&
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+    inline std::string readStringField(std::istream& stream)
+    {
+        uint32_t nLength = readNumField<uint32_t>(stream);
+
+        if (!stream.good())
+            return "";
+
+        std::string sString(nLength, '\0');
+        stream.read(sString.data(), nLength);
+        return sString;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief This class is the persistent cache for
+    /// compiled expressions of procedure lines. The
+    /// entries are identified by the hash of the
+    /// containing file and the line number. The
+    /// bytecode itself is stored in its symbolic
+    /// serialized form, i.e. the entries do not
+    /// depend on the addresses of the current
+    /// session.
+    /////////////////////////////////////////////////
+    class ByteCodeCache
+    {
+        public:
+            /////////////////////////////////////////////////
+            /// \brief A single compiled expression
+            /// together with the information necessary to
+            /// restore the parser state.
+            /////////////////////////////////////////////////
+            struct Entry
+            {
+                std::string m_expr;
+                int m_numResults;
+                std::vector<std::string> m_usedVars;
+                std::string m_byteCode;
+            };
+
+            // Increment, if the serialized format of the
+            // entries or the bytecode changes
+            static const uint32_t VERSION = 2;
+
+            // Entries of files, which have not been used
+            // for this duration, are removed when saving
+            static const int64_t EXPIRATION = 30*24*3600;
+
+            ByteCodeCache();
+
+            void setFileName(const std::string& sFileName);
+            bool load();
+            bool save();
+
+            const Entry* find(const std::string& sFileHash, int nLine);
+            void store(const std::string& sFileHash, int nLine, const Entry& entry);
+            void invalidate(const std::string& sFileHash);
+            void clear();
+            size_t size() const;
+
+        private:
+            /////////////////////////////////////////////////
+            /// \brief All cached entries of a single file.
+            /////////////////////////////////////////////////
+            struct FileEntries
+            {
+                std::map<int, Entry> m_lines;
+                int64_t m_lastUse;
+            };
+
+            std::map<std::string, FileEntries> m_files;
+            std::string m_fileName;
+            bool m_isModified;
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief This class accumulates a 64 bit FNV-1a
+    /// hash of the definitions of a parser, i.e. of
+    /// everything except of the variables, which
+    /// influences the compiled bytecode. Parsers
+    /// with the same definitions get the same hash
+    /// and may therefore share cache entries.
+    /////////////////////////////////////////////////
+    class DefinitionHasher
+    {
+        private:
+            uint64_t m_hash;
+
+        public:
+            DefinitionHasher() : m_hash(14695981039346656037ull) {}
+
+            /////////////////////////////////////////////////
+            /// \brief Add a block of bytes to the hash.
+            ///
+            /// \param data const void*
+            /// \param nBytes size_t
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void add(const void* data, size_t nBytes)
+            {
+                const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+                for (size_t i = 0; i < nBytes; i++)
+                {
+                    m_hash ^= bytes[i];
+                    m_hash *= 1099511628211ull;
+                }
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Add a string to the hash. Its length
+            /// is added first to separate consecutive
+            /// strings.
+            ///
+            /// \param sString const std::string&
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void add(const std::string& sString)
+            {
+                addValue(sString.length());
+                add(sString.data(), sString.length());
+            }
+
+            template <class T> void addValue(T val)
+            {
+                add(&val, sizeof(T));
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Return the hash. Zero is reserved for
+            /// marking outdated hashes and is therefore
+            /// never returned.
+            ///
+            /// \return uint64_t
+            ///
+            /////////////////////////////////////////////////
+            uint64_t get() const
+            {
+                return m_hash ? m_hash : 1;
+            }
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief This class is the process-wide cache
+    /// for compiled expressions shared by all parser
+    /// instances. The entries are identified by the
+    /// normalised expression, the definition hash
+    /// of the compiling parser and the binding of
+    /// their used variables, i.e. the name and the
+    /// type of the variable in every slot, which is
+    /// validated against the variables of the parser
+    /// looking up the expression. The bytecode has
+    /// to be rebound to the variables of this parser
+    /// afterwards. Lookups do not lock: every
+    /// shard publishes an immutable snapshot of its
+    /// entries, which is only replaced as a whole by
+    /// the writers.
+    /////////////////////////////////////////////////
+    class SharedExpressionCache
+    {
+        public:
+            /////////////////////////////////////////////////
+            /// \brief A single compiled expression. The
+            /// entries are immutable after being stored
+            /// except of their usage counter. The used
+            /// variables refer to the compiling parser and
+            /// are only used to rebind the bytecode, their
+            /// types are stored in the same order.
+            /////////////////////////////////////////////////
+            struct Entry
+            {
+                std::string m_expr;
+                uint64_t m_definitionStamp;
+                varmap_type m_usedVar;
+                std::vector<DataType> m_varTypes;
+                int m_numResults;
+                ParserByteCode m_byteCode;
+                mutable std::atomic<uint64_t> m_lastUse;
+            };
+
+            // Number of independently locked shards
+            static const size_t SHARDS = 16;
+
+            // Default number of entries of the whole cache
+            static const size_t DEFAULT_CAPACITY = 512;
+
+            static SharedExpressionCache& get();
+
+            std::shared_ptr<const Entry> find(const std::string& sExpr, uint64_t nDefinitionStamp, bool bOptimized, VarFactory& factory);
+            void store(const std::shared_ptr<Entry>& entry);
+            void clear();
+            void setCapacity(size_t nCapacity);
+            size_t getCapacity() const;
+            size_t size() const;
+
+        private:
+            typedef std::unordered_multimap<std::string, std::shared_ptr<const Entry>> entrymap_type;
+
+            /////////////////////////////////////////////////
+            /// \brief The published snapshot of a part of
+            /// the entries together with the lock of its
+            /// writers.
+            /////////////////////////////////////////////////
+            struct Shard
+            {
+                std::shared_ptr<const entrymap_type> m_entries;
+                std::mutex m_mutex;
+            };
+
+            Shard m_shards[SHARDS];
+            std::atomic<uint64_t> m_useCounter;
+            std::atomic<size_t> m_capacity;
+
+            SharedExpressionCache();
+            Shard& getShard(const std::string& sExpr);
+    };
+}
+
+#endif // MUPARSERCACHE_HPP
+
@@ -214,6 +214,10 @@ namespace mu
         cmOPRT_INFIX,          ///< code for infix operators
         cmVAL2STR,             ///< code for special var2str operator
         cmPATHPLACEHOLDER,     ///< code for path placeholder-operator
+        cmREGOP,               ///< fused binary operator reading its operands directly
+        cmREGSELECT,           ///< fused (compare and) select for the ternary operator
+        cmSTORE,               ///< store the topmost stack element in a slot for reusing it
+        cmLOAD,                ///< load a stored result from its slot
         cmEND,                 ///< end of formula
         cmUNKNOWN              ///< uninitialized item
     };
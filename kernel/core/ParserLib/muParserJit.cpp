@@ -0,0 +1,1396 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2024  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "muParserJit.hpp"
+#include "muParserBytecode.h"
+
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+// Machine code is only emitted for x86-64. All
+// other architectures use the interpreter
+#if defined(__x86_64__) || defined(_M_X64)
+#define MU_JIT_X64
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+#endif
+
+// Evaluations are counted locally and added to the
+// global counters in batches of this size to avoid
+// contention between threads
+#define JIT_STATISTICS_BATCH 256
+// Frames up to this size are allocated on the stack
+#define JIT_LOCAL_FRAME_SIZE 64
+
+// Fixed slots at the beginning of the frame
+#define FRAME_POS_LIMIT 0
+#define FRAME_NEG_LIMIT 1
+#define FRAME_ONE 2
+#define FRAME_FIXED_SLOTS 3
+
+// Integers up to this magnitude are represented
+// exactly by a double
+#define JIT_MAX_EXACT_INT 9007199254740992.0
+
+// Type tags of values in the frame. Integer types
+// are stored as JIT_TAG_INT + NumericalType
+#define JIT_TAG_F64 0
+#define JIT_TAG_AUTO 1
+#define JIT_TAG_INT 2
+
+namespace mu
+{
+    static std::atomic<size_t> s_jitCompiled(0);
+    static std::atomic<size_t> s_jitRejected(0);
+    static std::atomic<size_t> s_jitEvaluations(0);
+    static std::atomic<size_t> s_jitFallbacks(0);
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to determine, whether
+    /// the passed Array is a single numerical value,
+    /// which can be handled by the compiled tier.
+    ///
+    /// \param arr const Array&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    static bool isNumericalScalar(const Array& arr)
+    {
+        return arr.size() == 1 && arr.front().getType() == TYPE_NUMERICAL;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to determine, whether
+    /// the passed type is an integer type, which is
+    /// represented exactly in the frame.
+    ///
+    /// \param type NumericalType
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    static bool isIntType(NumericalType type)
+    {
+        return type >= UI8 && type <= I64;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper creating the Value,
+    /// which the interpreter would have created for
+    /// the passed double and its type tag.
+    ///
+    /// \param val double
+    /// \param tag int64_t
+    /// \return Value
+    ///
+    /////////////////////////////////////////////////
+    static Value makeValue(double val, int64_t tag)
+    {
+        if (tag == JIT_TAG_F64)
+            return Value(val);
+
+        if (tag == JIT_TAG_AUTO)
+            return Value(Numerical::autoType(val));
+
+        return Value(Numerical((int64_t)val, NumericalType(tag - JIT_TAG_INT)));
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper called from the
+    /// machine code to evaluate a scalar function.
+    /// Returns NaN, which makes the code fall back
+    /// to the interpreter, if the result is not a
+    /// double.
+    ///
+    /// \param val double
+    /// \param fun scalar_fun_type
+    /// \param tag int64_t
+    /// \return double
+    ///
+    /////////////////////////////////////////////////
+    static double callScalarFun(double val, scalar_fun_type fun, int64_t tag)
+    {
+        // Exceptions must not leave the machine code
+        try
+        {
+            Value res = fun(makeValue(val, tag));
+
+            if (res.isNumerical() && res.getNum().getType() == F64)
+                return res.getNum().asF64();
+        }
+        catch (...)
+        {
+            //
+        }
+
+        return NAN;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper called from the
+    /// machine code to evaluate the power operator.
+    /// Returns NaN for complex results.
+    ///
+    /// \param base double
+    /// \param exponent double
+    /// \return double
+    ///
+    /////////////////////////////////////////////////
+    static double callPow(double base, double exponent)
+    {
+        // Exceptions must not leave the machine code
+        try
+        {
+            Numerical res = Numerical(base).pow(Numerical(exponent));
+
+            if (res.getType() <= F64)
+                return res.asF64();
+        }
+        catch (...)
+        {
+            //
+        }
+
+        return NAN;
+    }
+
+
+#ifdef MU_JIT_X64
+    /////////////////////////////////////////////////
+    /// \brief This class emits the x86-64 machine
+    /// code of a compiled bytecode. The code is a
+    /// function taking the address of the frame,
+    /// which is held in RBX. Values are addressed
+    /// as [RBX + 8*slot] and only the volatile
+    /// registers XMM0 to XMM2 are used. The function
+    /// returns zero on success and one, if one of
+    /// the runtime checks failed.
+    /////////////////////////////////////////////////
+    class X64Assembler
+    {
+        public:
+            enum Condition
+            {
+                CC_B = 0x2,
+                CC_AE = 0x3,
+                CC_E = 0x4,
+                CC_NE = 0x5,
+                CC_BE = 0x6,
+                CC_A = 0x7,
+                CC_P = 0xA
+            };
+
+            enum SseOp
+            {
+                SSE_LOAD = 0x10,
+                SSE_STORE = 0x11,
+                SSE_ADD = 0x58,
+                SSE_MUL = 0x59,
+                SSE_SUB = 0x5C,
+                SSE_DIV = 0x5E
+            };
+
+        private:
+            std::vector<uint8_t> m_code;
+            std::vector<size_t> m_failJumps;
+
+            void emit(std::initializer_list<uint8_t> bytes)
+            {
+                m_code.insert(m_code.end(), bytes);
+            }
+
+            void emit32(uint32_t val)
+            {
+                for (int i = 0; i < 4; i++)
+                    m_code.push_back((val >> (8*i)) & 0xFF);
+            }
+
+            void emit64(uint64_t val)
+            {
+                for (int i = 0; i < 8; i++)
+                    m_code.push_back((val >> (8*i)) & 0xFF);
+            }
+
+            // ModRM byte and displacement of [RBX + 8*slot]
+            void frameOperand(int reg, size_t slot)
+            {
+                m_code.push_back(0x80 | (reg << 3) | 3);
+                emit32(slot*8);
+            }
+
+        public:
+            /////////////////////////////////////////////////
+            /// \brief Save RBX, align the stack (including
+            /// the shadow space of Win64) and load the
+            /// frame address.
+            ///
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void prologue()
+            {
+                emit({0x53, 0x48, 0x83, 0xEC, 0x20});
+#ifdef _WIN32
+                emit({0x48, 0x89, 0xCB}); // mov rbx,rcx
+#else
+                emit({0x48, 0x89, 0xFB}); // mov rbx,rdi
+#endif
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Emit the success and the failure exit
+            /// and bind all failure jumps.
+            ///
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void epilogue()
+            {
+                emit({0x31, 0xC0, 0x48, 0x83, 0xC4, 0x20, 0x5B, 0xC3});
+
+                for (size_t pos : m_failJumps)
+                    bind(pos);
+
+                emit({0xB8, 0x01, 0x00, 0x00, 0x00, 0x48, 0x83, 0xC4, 0x20, 0x5B, 0xC3});
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Scalar double operation of the passed
+            /// XMM register with a frame slot.
+            ///
+            /// \param op SseOp
+            /// \param xmm int
+            /// \param slot size_t
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void sse(SseOp op, int xmm, size_t slot)
+            {
+                emit({0xF2, 0x0F, (uint8_t)op});
+                frameOperand(xmm, slot);
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Compare the passed XMM register with a
+            /// frame slot (ucomisd).
+            ///
+            /// \param xmm int
+            /// \param slot size_t
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void compare(int xmm, size_t slot)
+            {
+                emit({0x66, 0x0F, 0x2E});
+                frameOperand(xmm, slot);
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Compare XMM0 with zero.
+            ///
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void compareZero()
+            {
+                emit({0x66, 0x0F, 0x57, 0xC9}); // xorpd xmm1,xmm1
+                emit({0x66, 0x0F, 0x2E, 0xC1}); // ucomisd xmm0,xmm1
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Set XMM0 to zero.
+            ///
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void clear()
+            {
+                emit({0x66, 0x0F, 0x57, 0xC0});
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Store a constant type tag in a frame
+            /// slot.
+            ///
+            /// \param slot size_t
+            /// \param tag int64_t
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void storeTag(size_t slot, int64_t tag)
+            {
+                emit({0x48, 0xC7});
+                frameOperand(0, slot);
+                emit32((uint32_t)tag);
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Copy a type tag between two frame
+            /// slots.
+            ///
+            /// \param src size_t
+            /// \param dst size_t
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void copyTag(size_t src, size_t dst)
+            {
+                emit({0x48, 0x8B});
+                frameOperand(0, src);
+                emit({0x48, 0x89});
+                frameOperand(0, dst);
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Call callPow() with XMM0 and XMM1.
+            ///
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void callPow()
+            {
+                call((const void*)&mu::callPow);
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Call callScalarFun() with XMM0, the
+            /// passed function and the type tag, which is
+            /// either constant or read from a frame slot.
+            ///
+            /// \param fun scalar_fun_type
+            /// \param tag int64_t
+            /// \param tagSlot size_t
+            /// \param dynamicTag bool
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void callScalarFun(scalar_fun_type fun, int64_t tag, size_t tagSlot, bool dynamicTag)
+            {
+#ifdef _WIN32
+                emit({0x48, 0xBA}); // mov rdx,imm64
+                emit64((uint64_t)fun);
+
+                if (dynamicTag)
+                {
+                    emit({0x4C, 0x8B}); // mov r8,[rbx+disp]
+                    frameOperand(0, tagSlot);
+                }
+                else
+                {
+                    emit({0x49, 0xB8}); // mov r8,imm64
+                    emit64((uint64_t)tag);
+                }
+#else
+                emit({0x48, 0xBF}); // mov rdi,imm64
+                emit64((uint64_t)fun);
+
+                if (dynamicTag)
+                {
+                    emit({0x48, 0x8B}); // mov rsi,[rbx+disp]
+                    frameOperand(6, tagSlot);
+                }
+                else
+                {
+                    emit({0x48, 0xBE}); // mov rsi,imm64
+                    emit64((uint64_t)tag);
+                }
+#endif
+                call((const void*)&mu::callScalarFun);
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Call a function via RAX.
+            ///
+            /// \param fun const void*
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void call(const void* fun)
+            {
+                emit({0x48, 0xB8});
+                emit64((uint64_t)fun);
+                emit({0xFF, 0xD0});
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Emit a jump with an unbound target.
+            /// Returns the position of the displacement,
+            /// which is passed to bind().
+            ///
+            /// \param cond Condition
+            /// \return size_t
+            ///
+            /////////////////////////////////////////////////
+            size_t jump(Condition cond)
+            {
+                emit({0x0F, (uint8_t)(0x80 | cond)});
+                emit32(0);
+                return m_code.size()-4;
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Emit an unconditional jump with an
+            /// unbound target.
+            ///
+            /// \return size_t
+            ///
+            /////////////////////////////////////////////////
+            size_t jump()
+            {
+                emit({0xE9});
+                emit32(0);
+                return m_code.size()-4;
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Bind the jump at the passed position
+            /// to the current position.
+            ///
+            /// \param pos size_t
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void bind(size_t pos)
+            {
+                uint32_t rel = (uint32_t)(m_code.size() - (pos+4));
+
+                for (int i = 0; i < 4; i++)
+                    m_code[pos+i] = (rel >> (8*i)) & 0xFF;
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Jump to the failure exit, if the
+            /// passed condition is met.
+            ///
+            /// \param cond Condition
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void failIf(Condition cond)
+            {
+                m_failJumps.push_back(jump(cond));
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Fail, if XMM0 is not finite. The
+            /// interpreter computes in complex arithmetic,
+            /// which may differ for non-finite values.
+            ///
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void checkFinite()
+            {
+                emit({0x66, 0x0F, 0x28, 0xC8}); // movapd xmm1,xmm0
+                emit({0xF2, 0x0F, 0x5C, 0xC8}); // subsd xmm1,xmm0
+                emit({0x66, 0x0F, 0x2E, 0xC9}); // ucomisd xmm1,xmm1
+                failIf(CC_P);
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Fail, if XMM0 is not within the range
+            /// of a 64 bit integer, because these values
+            /// cannot be converted by Numerical::autoType().
+            ///
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void checkRange()
+            {
+                compare(0, FRAME_POS_LIMIT);
+                failIf(CC_AE);
+                failIf(CC_P);
+                compare(0, FRAME_NEG_LIMIT);
+                failIf(CC_BE);
+            }
+
+            const std::vector<uint8_t>& getCode() const
+            {
+                return m_code;
+            }
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper returning the condition,
+    /// which is met, if the passed comparison is
+    /// false for the operands of a preceding
+    /// ucomisd.
+    ///
+    /// \param oprt ECmdCode
+    /// \param cond X64Assembler::Condition&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    static bool invertedCondition(ECmdCode oprt, X64Assembler::Condition& cond)
+    {
+        switch (oprt)
+        {
+            case cmLT:
+                cond = X64Assembler::CC_AE;
+                return true;
+            case cmLE:
+                cond = X64Assembler::CC_A;
+                return true;
+            case cmGT:
+                cond = X64Assembler::CC_BE;
+                return true;
+            case cmGE:
+                cond = X64Assembler::CC_B;
+                return true;
+            case cmEQ:
+                cond = X64Assembler::CC_NE;
+                return true;
+            case cmNEQ:
+                cond = X64Assembler::CC_E;
+                return true;
+            default:
+                return false;
+        }
+    }
+#endif // MU_JIT_X64
+
+
+    /////////////////////////////////////////////////
+    /// \brief Create an empty (cold) program.
+    /////////////////////////////////////////////////
+    JitProgram::JitProgram() : m_state(STATE_COLD), m_evalCount(0), m_pendingEvals(0), m_pendingFallbacks(0), m_code(nullptr), m_codeSize(0)
+    {
+        //
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Copy constructor. The compiled state
+    /// is not copied, because the copy belongs to a
+    /// different bytecode. It is compiled again, if
+    /// it becomes hot.
+    ///
+    /// \param const JitProgram&
+    ///
+    /////////////////////////////////////////////////
+    JitProgram::JitProgram(const JitProgram&) : JitProgram()
+    {
+        //
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Destructor. Adds the remaining local
+    /// counts to the global statistics and frees
+    /// the machine code.
+    /////////////////////////////////////////////////
+    JitProgram::~JitProgram()
+    {
+        flushStatistics();
+        release();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Assignment operator. Resets the
+    /// program for the same reason as the copy
+    /// constructor.
+    ///
+    /// \param const JitProgram&
+    /// \return JitProgram&
+    ///
+    /////////////////////////////////////////////////
+    JitProgram& JitProgram::operator=(const JitProgram&)
+    {
+        reset();
+        return *this;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Reset the program to its cold state.
+    /// Has to be called, whenever the corresponding
+    /// bytecode is changed.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void JitProgram::reset()
+    {
+        std::lock_guard<std::mutex> lock(m_compileMutex);
+        flushStatistics();
+        m_state = STATE_COLD;
+        m_evalCount = 0;
+        release();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Evaluate the bytecode starting at the
+    /// passed token with the machine code, if it
+    /// is hot and can be compiled. Returns false, if
+    /// the interpreter has to evaluate the bytecode
+    /// instead. Only one thread compiles the program,
+    /// all others keep interpreting until the
+    /// compiled state has been published.
+    ///
+    /// \param pTok const SToken*
+    /// \param scalarFuns const scalarmap_type&
+    /// \param Stack Array*
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    bool JitProgram::eval(const SToken* pTok, const scalarmap_type& scalarFuns, Array* Stack)
+    {
+        State state = m_state.load(std::memory_order_acquire);
+
+        if (state == STATE_REJECTED)
+            return false;
+
+        if (state == STATE_COLD)
+        {
+            if (m_evalCount.fetch_add(1, std::memory_order_relaxed)+1 < HOT_THRESHOLD)
+                return false;
+
+            std::unique_lock<std::mutex> lock(m_compileMutex, std::try_to_lock);
+
+            if (!lock.owns_lock() || m_state.load(std::memory_order_relaxed) != STATE_COLD)
+                return false;
+
+            if (!compile(pTok, scalarFuns))
+            {
+                release();
+                m_state.store(STATE_REJECTED, std::memory_order_release);
+                s_jitRejected++;
+                return false;
+            }
+
+            m_state.store(STATE_COMPILED, std::memory_order_release);
+            s_jitCompiled++;
+        }
+
+        bool success = run(Stack);
+
+        size_t pending = success ? m_pendingEvals.fetch_add(1, std::memory_order_relaxed)
+                                 : m_pendingFallbacks.fetch_add(1, std::memory_order_relaxed);
+
+        if (pending+1 >= JIT_STATISTICS_BATCH)
+            flushStatistics();
+
+        return success;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Return the counters of the compiled
+    /// tier. Evaluations are added in batches, i.e.
+    /// the values of still running programs may lag
+    /// slightly behind.
+    ///
+    /// \return JitStatistics
+    ///
+    /////////////////////////////////////////////////
+    JitStatistics JitProgram::getStatistics()
+    {
+        JitStatistics stats;
+        stats.compiled = s_jitCompiled;
+        stats.rejected = s_jitRejected;
+        stats.evaluations = s_jitEvaluations;
+        stats.fallbacks = s_jitFallbacks;
+
+        return stats;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Translate the bytecode starting at
+    /// the passed token into machine code. The stack
+    /// of the interpreter and the types of its
+    /// values are tracked at compile time, i.e.
+    /// plain variables and constants are directly
+    /// used as operands. Returns false, if the
+    /// bytecode contains unsupported tokens or
+    /// operand types, which would not yield the
+    /// same results as the interpreter.
+    ///
+    /// \param pTok const SToken*
+    /// \param scalarFuns const scalarmap_type&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    bool JitProgram::compile(const SToken* pTok, const scalarmap_type& scalarFuns)
+    {
+#ifdef MU_JIT_X64
+        release();
+
+        m_frame.assign(FRAME_FIXED_SLOTS, 0.0);
+        m_frame[FRAME_POS_LIMIT] = 9223372036854775808.0;
+        m_frame[FRAME_NEG_LIMIT] = -9223372036854775808.0;
+        m_frame[FRAME_ONE] = 1.0;
+
+        X64Assembler as;
+        as.prologue();
+
+        // The index corresponds to the stack position,
+        // i.e. the first element is not used
+        std::vector<Operand> stack(1);
+        std::vector<size_t> regSlots;
+        std::vector<size_t> tagSlots;
+        std::map<int, Operand> stored;
+
+        auto newSlot = [this](double val)
+            {
+                m_frame.push_back(val);
+                return m_frame.size()-1;
+            };
+
+        // Every stack position gets its own slot. The
+        // fixed slot zero marks unassigned positions
+        auto posSlot = [&newSlot](std::vector<size_t>& slots, size_t pos)
+            {
+                if (slots.size() <= pos)
+                    slots.resize(pos+1, 0);
+
+                if (!slots[pos])
+                    slots[pos] = newSlot(0.0);
+
+                return slots[pos];
+            };
+
+        auto varOperand = [&](const Variable* var, Operand& target)
+            {
+                if (!isNumericalScalar(*var))
+                    return false;
+
+                NumericalType type = var->front().getNum().getType();
+
+                if (type != F64 && !isIntType(type))
+                    return false;
+
+                auto iter = std::find_if(m_vars.begin(), m_vars.end(),
+                                         [var](const VarSlot& slot){return slot.m_var == var;});
+
+                if (iter == m_vars.end())
+                {
+                    m_vars.push_back(VarSlot({var, type, newSlot(0.0)}));
+                    iter = m_vars.end()-1;
+                }
+
+                target = Operand({OPD_VAR, type == F64 ? SLOT_F64 : SLOT_INT, type,
+                                  iter->m_slot, 0, size_t(iter - m_vars.begin())});
+                return true;
+            };
+
+        auto constOperand = [&](const Array& arr, Operand& target)
+            {
+                if (!isNumericalScalar(arr))
+                    return false;
+
+                NumericalType type = arr.front().getNum().getType();
+                double val = arr.front().getNum().asF64();
+
+                if (type == F64 ? !std::isfinite(val) : (!isIntType(type) || std::abs(val) > JIT_MAX_EXACT_INT))
+                    return false;
+
+                m_consts.push_back(arr.front());
+                target = Operand({OPD_CONST, type == F64 ? SLOT_F64 : SLOT_INT, type,
+                                  newSlot(val), 0, m_consts.size()-1});
+                return true;
+            };
+
+        // Convert an operand of a fused register
+        // instruction
+        auto regOperand = [&](const SOperand& opd, Operand& target)
+            {
+                if (opd.src == SOperand::SRC_VAR)
+                    return varOperand(opd.var, target);
+                else if (opd.src == SOperand::SRC_VAL)
+                    return constOperand(opd.val, target);
+
+                return false;
+            };
+
+        auto staticTag = [](const Operand& opd)
+            {
+                if (opd.m_type == SLOT_AUTO)
+                    return (int64_t)JIT_TAG_AUTO;
+                else if (opd.m_type == SLOT_INT)
+                    return (int64_t)(JIT_TAG_INT + opd.m_numType);
+
+                return (int64_t)JIT_TAG_F64;
+            };
+
+        auto pop = [&stack]()
+            {
+                Operand opd = stack.back();
+                stack.pop_back();
+                return opd;
+            };
+
+        auto regOperandAt = [&](size_t pos, SlotType type, NumericalType numType)
+            {
+                return Operand({OPD_REG, type, numType, posSlot(regSlots, pos),
+                                type == SLOT_TAGGED ? posSlot(tagSlots, pos) : 0, 0});
+            };
+
+        // Store XMM0 to the next free stack position
+        auto push = [&](SlotType type, NumericalType numType)
+            {
+                Operand opd = regOperandAt(stack.size(), type, numType);
+                as.sse(X64Assembler::SSE_STORE, 0, opd.m_slot);
+                stack.push_back(opd);
+            };
+
+        // Copy an operand together with its type tag
+        // to the passed stack position
+        auto emitMove = [&](const Operand& opd, size_t pos)
+            {
+                as.sse(X64Assembler::SSE_LOAD, 0, opd.m_slot);
+                as.sse(X64Assembler::SSE_STORE, 0, posSlot(regSlots, pos));
+
+                if (opd.m_type == SLOT_TAGGED)
+                    as.copyTag(opd.m_tag, posSlot(tagSlots, pos));
+                else
+                    as.storeTag(posSlot(tagSlots, pos), staticTag(opd));
+            };
+
+        // Determine the type of a value, which is one
+        // of the two passed operands. If their types
+        // differ, the type is tagged
+        auto mergeTypes = [](const Operand& trueCase, const Operand& falseCase, SlotType& type)
+            {
+                type = trueCase.m_type;
+
+                if (trueCase.m_type == SLOT_BOOL || falseCase.m_type == SLOT_BOOL)
+                    return trueCase.m_type == falseCase.m_type;
+
+                if (trueCase.m_type != falseCase.m_type
+                    || trueCase.m_type == SLOT_TAGGED
+                    || trueCase.m_numType != falseCase.m_numType)
+                    type = SLOT_TAGGED;
+
+                return true;
+            };
+
+        // Apply a binary operator to XMM0 and the
+        // passed operand. The operator is only
+        // accepted, if the interpreter would
+        // calculate with doubles as well
+        auto emitOprt = [&](ECmdCode oprt, SlotType& type, const Operand& rhs)
+            {
+                if (type == SLOT_BOOL || rhs.m_type == SLOT_BOOL)
+                    return false;
+
+                X64Assembler::Condition cond;
+
+                switch (oprt)
+                {
+                    case cmADD:
+                    case cmSUB:
+                    case cmMUL:
+                        // Integer arithmetic is only avoided,
+                        // if one of the operands is a double
+                        if (type != SLOT_F64 && rhs.m_type != SLOT_F64)
+                            return false;
+
+                        as.sse(oprt == cmADD ? X64Assembler::SSE_ADD
+                                             : (oprt == cmSUB ? X64Assembler::SSE_SUB : X64Assembler::SSE_MUL),
+                               0, rhs.m_slot);
+                        as.checkFinite();
+                        type = SLOT_F64;
+                        return true;
+
+                    case cmDIV:
+                        as.sse(X64Assembler::SSE_DIV, 0, rhs.m_slot);
+                        as.checkRange();
+                        type = SLOT_AUTO;
+                        return true;
+
+                    case cmPOW:
+                        as.sse(X64Assembler::SSE_LOAD, 1, rhs.m_slot);
+                        as.callPow();
+                        as.checkRange();
+                        type = SLOT_AUTO;
+                        return true;
+
+                    default:
+                    {
+                        if (!invertedCondition(oprt, cond))
+                            return false;
+
+                        as.compare(0, rhs.m_slot);
+                        size_t jmpFalse = as.jump(cond);
+                        as.sse(X64Assembler::SSE_LOAD, 0, FRAME_ONE);
+                        size_t jmpEnd = as.jump();
+                        as.bind(jmpFalse);
+                        as.clear();
+                        as.bind(jmpEnd);
+                        type = SLOT_BOOL;
+                        return true;
+                    }
+                }
+            };
+
+        // Copy one of the two operands to the next free
+        // stack position depending on the condition of
+        // the preceding comparison
+        auto emitSelect = [&](const Operand& trueCase, const Operand& falseCase, X64Assembler::Condition elseCond)
+            {
+                SlotType type;
+
+                if (!mergeTypes(trueCase, falseCase, type))
+                    return false;
+
+                size_t pos = stack.size();
+                size_t jmpElse = as.jump(elseCond);
+                emitMove(trueCase, pos);
+                size_t jmpEnd = as.jump();
+                as.bind(jmpElse);
+                emitMove(falseCase, pos);
+                as.bind(jmpEnd);
+                stack.push_back(regOperandAt(pos, type, trueCase.m_numType));
+                return true;
+            };
+
+        for ( ; pTok->Cmd != cmEND; ++pTok)
+        {
+            Operand args[4];
+
+            switch (pTok->Cmd)
+            {
+                case cmVAL:
+                    if (!constOperand(pTok->Val().data2, args[0]))
+                        return false;
+
+                    stack.push_back(args[0]);
+                    break;
+
+                case cmVAR:
+                    if (!varOperand(pTok->Val().var, args[0]))
+                        return false;
+
+                    stack.push_back(args[0]);
+                    break;
+
+                case cmVARPOW2:
+                case cmVARPOW3:
+                case cmVARPOW4:
+                {
+                    if (!varOperand(pTok->Val().var, args[0]) || args[0].m_type != SLOT_F64)
+                        return false;
+
+                    int exponent = pTok->Cmd == cmVARPOW2 ? 2 : (pTok->Cmd == cmVARPOW3 ? 3 : 4);
+                    as.sse(X64Assembler::SSE_LOAD, 0, args[0].m_slot);
+
+                    for (int i = 1; i < exponent; i++)
+                    {
+                        as.sse(X64Assembler::SSE_MUL, 0, args[0].m_slot);
+                    }
+
+                    as.checkFinite();
+                    push(SLOT_F64, F64);
+                    break;
+                }
+
+                case cmVARPOWN:
+                {
+                    if (!varOperand(pTok->Val().var, args[0]) || !constOperand(pTok->Val().data, args[1]))
+                        return false;
+
+                    SlotType type = args[0].m_type;
+                    as.sse(X64Assembler::SSE_LOAD, 0, args[0].m_slot);
+
+                    if (!emitOprt(cmPOW, type, args[1]))
+                        return false;
+
+                    push(type, F64);
+                    break;
+                }
+
+                case cmVARMUL:
+                case cmREVVARMUL:
+                {
+                    // The addition is commutative, i.e. both
+                    // variants are calculated identically. A
+                    // void offset is added as a zero
+                    const Array& offset = pTok->Val().data2;
+
+                    if (!varOperand(pTok->Val().var, args[0])
+                        || !constOperand(pTok->Val().data, args[1])
+                        || !constOperand(offset.size() == 1 && offset.front().isVoid() ? Array(Value(0.0)) : offset, args[2]))
+                        return false;
+
+                    SlotType type = args[0].m_type;
+                    as.sse(X64Assembler::SSE_LOAD, 0, args[0].m_slot);
+
+                    if (!emitOprt(cmMUL, type, args[1]) || !emitOprt(cmADD, type, args[2]))
+                        return false;
+
+                    push(type, F64);
+                    break;
+                }
+
+                case cmREGOP:
+                {
+                    const SRegData& reg = pTok->Reg();
+
+                    for (int i = reg.stackArgs; i < reg.argc; i++)
+                    {
+                        if (!regOperand(reg.args[i], args[i]))
+                            return false;
+                    }
+
+                    if (reg.stackArgs)
+                        args[0] = pop();
+
+                    SlotType type = args[0].m_type;
+                    as.sse(X64Assembler::SSE_LOAD, 0, args[0].m_slot);
+
+                    if (!emitOprt(reg.oprt, type, args[1])
+                        || (reg.argc > 2 && !emitOprt(reg.oprt2, type, args[2])))
+                        return false;
+
+                    push(type, F64);
+                    break;
+                }
+
+                case cmREGSELECT:
+                {
+                    const SRegData& reg = pTok->Reg();
+
+                    for (int i = reg.stackArgs; i < reg.argc; i++)
+                    {
+                        if (!regOperand(reg.args[i], args[i]))
+                            return false;
+                    }
+
+                    if (reg.stackArgs)
+                        args[0] = pop();
+
+                    as.sse(X64Assembler::SSE_LOAD, 0, args[0].m_slot);
+
+                    if (reg.argc == 3)
+                    {
+                        // Any numerical value different from
+                        // zero is true
+                        as.compareZero();
+
+                        if (!emitSelect(args[1], args[2], X64Assembler::CC_E))
+                            return false;
+
+                        break;
+                    }
+
+                    X64Assembler::Condition cond;
+
+                    if (args[0].m_type == SLOT_BOOL
+                        || args[1].m_type == SLOT_BOOL
+                        || !invertedCondition(reg.oprt, cond))
+                        return false;
+
+                    as.compare(0, args[1].m_slot);
+
+                    if (!emitSelect(args[2], args[3], cond))
+                        return false;
+
+                    break;
+                }
+
+                case cmSTORE:
+                {
+                    // Results in registers are copied to a
+                    // separate slot, because their stack
+                    // position will be overwritten
+                    Operand opd = stack.back();
+
+                    if (opd.m_src == OPD_REG)
+                    {
+                        as.sse(X64Assembler::SSE_LOAD, 0, opd.m_slot);
+                        opd.m_slot = newSlot(0.0);
+                        as.sse(X64Assembler::SSE_STORE, 0, opd.m_slot);
+
+                        if (opd.m_type == SLOT_TAGGED)
+                        {
+                            size_t tagSlot = newSlot(0.0);
+                            as.copyTag(opd.m_tag, tagSlot);
+                            opd.m_tag = tagSlot;
+                        }
+                    }
+
+                    stored[pTok->Oprt().offset] = opd;
+                    break;
+                }
+
+                case cmLOAD:
+                {
+                    auto iter = stored.find(pTok->Oprt().offset);
+
+                    if (iter == stored.end())
+                        return false;
+
+                    stack.push_back(iter->second);
+                    break;
+                }
+
+                case cmFUNC:
+                {
+                    // The ternary operator, which could not be
+                    // fused into a select instruction. Both
+                    // cases have already been evaluated
+                    if (pTok->Fun().argc == 3 && pTok->Fun().name == MU_IF_ELSE && stack.size() >= 4)
+                    {
+                        args[2] = pop();
+                        args[1] = pop();
+                        args[0] = pop();
+
+                        as.sse(X64Assembler::SSE_LOAD, 0, args[0].m_slot);
+                        as.compareZero();
+
+                        if (!emitSelect(args[1], args[2], X64Assembler::CC_E))
+                            return false;
+
+                        break;
+                    }
+
+                    if (pTok->Fun().argc != 1)
+                        return false;
+
+                    auto iter = scalarFuns.find((void*)pTok->Fun().ptr);
+
+                    if (iter == scalarFuns.end())
+                        return false;
+
+                    args[0] = pop();
+
+                    if (args[0].m_type == SLOT_BOOL)
+                        return false;
+
+                    as.sse(X64Assembler::SSE_LOAD, 0, args[0].m_slot);
+                    as.callScalarFun(iter->second, staticTag(args[0]), args[0].m_tag, args[0].m_type == SLOT_TAGGED);
+                    as.checkFinite();
+                    push(SLOT_F64, F64);
+                    break;
+                }
+
+                default:
+                {
+                    if (stack.size() < 3)
+                        return false;
+
+                    args[1] = pop();
+                    args[0] = pop();
+
+                    SlotType type = args[0].m_type;
+                    as.sse(X64Assembler::SSE_LOAD, 0, args[0].m_slot);
+
+                    if (!emitOprt(pTok->Cmd, type, args[1]))
+                        return false;
+
+                    push(type, F64);
+                }
+            }
+        }
+
+        if (stack.size() < 2)
+            return false;
+
+        m_results.assign(stack.begin()+1, stack.end());
+        as.epilogue();
+
+        // Copy the code to executable memory
+        const std::vector<uint8_t>& code = as.getCode();
+#ifdef _WIN32
+        void* mem = VirtualAlloc(nullptr, code.size(), MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+
+        if (!mem)
+            return false;
+
+        memcpy(mem, code.data(), code.size());
+        DWORD oldProtect;
+
+        if (!VirtualProtect(mem, code.size(), PAGE_EXECUTE_READ, &oldProtect))
+        {
+            VirtualFree(mem, 0, MEM_RELEASE);
+            return false;
+        }
+
+        FlushInstructionCache(GetCurrentProcess(), mem, code.size());
+#else
+        void* mem = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (mem == MAP_FAILED)
+            return false;
+
+        memcpy(mem, code.data(), code.size());
+
+        if (mprotect(mem, code.size(), PROT_READ | PROT_EXEC))
+        {
+            munmap(mem, code.size());
+            return false;
+        }
+#endif
+
+        m_code = mem;
+        m_codeSize = code.size();
+        return true;
+#else
+        return false;
+#endif // MU_JIT_X64
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Copy the variables into a private copy
+    /// of the frame, run the machine code and write
+    /// the results to the stack of the interpreter.
+    /// Returns false without modifying the stack, if
+    /// one of the variables changed its type or if
+    /// one of the runtime checks failed.
+    ///
+    /// \param Stack Array*
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    bool JitProgram::run(Array* Stack) const
+    {
+        double localFrame[JIT_LOCAL_FRAME_SIZE];
+        std::vector<double> heapFrame;
+        double* frame = localFrame;
+
+        if (m_frame.size() > JIT_LOCAL_FRAME_SIZE)
+        {
+            heapFrame.resize(m_frame.size());
+            frame = &heapFrame[0];
+        }
+
+        memcpy(frame, &m_frame[0], m_frame.size()*sizeof(double));
+
+        for (const VarSlot& var : m_vars)
+        {
+            if (!isNumericalScalar(*var.m_var))
+                return false;
+
+            const Numerical& num = var.m_var->front().getNum();
+            double val = num.asF64();
+
+            if (num.getType() != var.m_type
+                || (var.m_type == F64 ? !std::isfinite(val) : std::abs(val) > JIT_MAX_EXACT_INT))
+                return false;
+
+            frame[var.m_slot] = val;
+        }
+
+        if (((int (*)(double*))m_code)(frame))
+            return false;
+
+        for (size_t i = 0; i < m_results.size(); i++)
+        {
+            const Operand& opd = m_results[i];
+            Value result;
+
+            if (opd.m_src == OPD_VAR)
+                result = m_vars[opd.m_idx].m_var->front();
+            else if (opd.m_src == OPD_CONST)
+                result = m_consts[opd.m_idx];
+            else if (opd.m_type == SLOT_BOOL)
+                result = Value(frame[opd.m_slot] != 0.0);
+            else
+            {
+                int64_t tag = JIT_TAG_F64;
+
+                if (opd.m_type == SLOT_TAGGED)
+                    memcpy(&tag, &frame[opd.m_tag], sizeof(tag));
+                else if (opd.m_type == SLOT_AUTO)
+                    tag = JIT_TAG_AUTO;
+                else if (opd.m_type == SLOT_INT)
+                    tag = JIT_TAG_INT + opd.m_numType;
+
+                result = makeValue(frame[opd.m_slot], tag);
+            }
+
+            // Reuse the storage of the stack entry, if it
+            // already contains a single numerical value
+            if (result.isNumerical() && Stack[i+1].size() == 1 && Stack[i+1].getCommonType() == TYPE_NUMERICAL)
+                Stack[i+1].front() = std::move(result);
+            else
+                Stack[i+1] = Array(result);
+        }
+
+        return true;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Free the machine code and clear all
+    /// tables of the compiled program.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void JitProgram::release()
+    {
+#ifdef MU_JIT_X64
+        if (m_code)
+        {
+#ifdef _WIN32
+            VirtualFree(m_code, 0, MEM_RELEASE);
+#else
+            munmap(m_code, m_codeSize);
+#endif
+        }
+#endif // MU_JIT_X64
+
+        m_code = nullptr;
+        m_codeSize = 0;
+        m_frame.clear();
+        m_consts.clear();
+        m_vars.clear();
+        m_results.clear();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Add the locally counted evaluations
+    /// and fallbacks to the global statistics.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void JitProgram::flushStatistics()
+    {
+        size_t pending = m_pendingEvals.exchange(0, std::memory_order_relaxed);
+
+        if (pending)
+            s_jitEvaluations += pending;
+
+        pending = m_pendingFallbacks.exchange(0, std::memory_order_relaxed);
+
+        if (pending)
+            s_jitFallbacks += pending;
+    }
+}
+
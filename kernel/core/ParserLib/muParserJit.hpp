@@ -0,0 +1,190 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2024  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef MUPARSERJIT_HPP
+#define MUPARSERJIT_HPP
+
+#include <vector>
+#include <map>
+#include <complex>
+#include <atomic>
+#include <mutex>
+
+#include "muParserDef.h"
+#include "muStructures.hpp"
+
+namespace mu
+{
+    struct SToken;
+
+    /** \brief Callback type of the scalar counterpart of a single argument function. */
+    typedef Value (*scalar_fun_type)(const Value&);
+
+    /** \brief Maps the address of a single argument function to its scalar counterpart. */
+    typedef std::map<void*, scalar_fun_type> scalarmap_type;
+
+
+    /////////////////////////////////////////////////
+    /// \brief Scalar counterpart of the elementary
+    /// functions, which are implemented by applying
+    /// a complex-valued function to all elements.
+    /// The result is identical to a single element
+    /// evaluated by mu::apply().
+    ///
+    /// \param val const Value&
+    /// \return Value
+    ///
+    /////////////////////////////////////////////////
+    template<std::complex<double>(*FUNC)(const std::complex<double>&)>
+    Value scalarImpl(const Value& val)
+    {
+        return Value(FUNC(val.getNum().asCF64()));
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Counters of the compiled expression
+    /// tier accumulated over all parser instances.
+    /////////////////////////////////////////////////
+    struct JitStatistics
+    {
+        size_t compiled;
+        size_t rejected;
+        size_t evaluations;
+        size_t fallbacks;
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief This class implements the compiled
+    /// tier of the bytecode interpreter. Bytecodes,
+    /// which have been evaluated often enough, are
+    /// translated into x86-64 machine code, which
+    /// operates on plain doubles instead of Arrays.
+    /// The types of all intermediate results are
+    /// tracked at compile time, so that the results
+    /// have the same values and types as in the
+    /// interpreter. The code checks its
+    /// preconditions (numerical scalar variables of
+    /// the compiled type, finite intermediate
+    /// results) and falls back to the interpreter
+    /// otherwise. Bytecodes containing
+    /// unsupported tokens are rejected once and are
+    /// never compiled again. On other architectures
+    /// every bytecode is rejected.
+    /////////////////////////////////////////////////
+    class JitProgram
+    {
+        public:
+            // Number of interpreted evaluations before a
+            // bytecode is compiled
+            static const size_t HOT_THRESHOLD = 64;
+
+            JitProgram();
+            JitProgram(const JitProgram&);
+            ~JitProgram();
+            JitProgram& operator=(const JitProgram&);
+
+            void reset();
+            bool eval(const SToken* pTok, const scalarmap_type& scalarFuns, Array* Stack);
+
+            static JitStatistics getStatistics();
+
+        private:
+            enum OperandType
+            {
+                OPD_REG,
+                OPD_VAR,
+                OPD_CONST
+            };
+
+            /////////////////////////////////////////////////
+            /// \brief The compile-time type of a value in
+            /// the frame. SLOT_AUTO values are converted to
+            /// an integer type, if they are integral (like
+            /// the results of a division). SLOT_TAGGED
+            /// values carry their type in a separate tag
+            /// slot, because it depends on a selection.
+            /////////////////////////////////////////////////
+            enum SlotType
+            {
+                SLOT_F64,
+                SLOT_AUTO,
+                SLOT_INT,
+                SLOT_BOOL,
+                SLOT_TAGGED
+            };
+
+            /////////////////////////////////////////////////
+            /// \brief An operand of the compiled code. The
+            /// slot refers to the frame of doubles, the
+            /// index to the variable or the constant table.
+            /////////////////////////////////////////////////
+            struct Operand
+            {
+                OperandType m_src;
+                SlotType m_type;
+                NumericalType m_numType;
+                size_t m_slot;
+                size_t m_tag;
+                size_t m_idx;
+            };
+
+            /////////////////////////////////////////////////
+            /// \brief A variable, which is copied into the
+            /// frame before each run.
+            /////////////////////////////////////////////////
+            struct VarSlot
+            {
+                const Variable* m_var;
+                NumericalType m_type;
+                size_t m_slot;
+            };
+
+            enum State
+            {
+                STATE_COLD,
+                STATE_COMPILED,
+                STATE_REJECTED
+            };
+
+            // The program may be evaluated concurrently by
+            // parsers sharing a cached bytecode. The state is
+            // published atomically, compilation is serialized
+            // by the mutex and every run uses its own frame
+            std::atomic<State> m_state;
+            std::atomic<size_t> m_evalCount;
+            std::atomic<size_t> m_pendingEvals;
+            std::atomic<size_t> m_pendingFallbacks;
+            std::mutex m_compileMutex;
+            void* m_code;
+            size_t m_codeSize;
+            std::vector<double> m_frame;
+            std::vector<Value> m_consts;
+            std::vector<VarSlot> m_vars;
+            std::vector<Operand> m_results;
+
+            bool compile(const SToken* pTok, const scalarmap_type& scalarFuns);
+            bool run(Array* Stack) const;
+            void release();
+            void flushStatistics();
+    };
+}
+
+#endif // MUPARSERJIT_HPP
+
@@ -0,0 +1,175 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2024  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "muParserParallel.hpp"
+#include "muStructures.hpp"
+
+#include <omp.h>
+#include <atomic>
+#include <limits>
+#include <algorithm>
+
+// The parallel evaluation has to save at least this
+// multiple of the fork-join overhead to be used
+#define PARALLEL_PAYOFF_FACTOR 4.0
+
+// Number of blocks per thread for balancing the load
+// between the threads
+#define PARALLEL_BLOCKS_PER_THREAD 4
+
+namespace mu
+{
+    /////////////////////////////////////////////////
+    /// \brief Return the calibration. It is created
+    /// and measured upon the first call.
+    ///
+    /// \return const ParallelCalibration&
+    ///
+    /////////////////////////////////////////////////
+    const ParallelCalibration& ParallelCalibration::get()
+    {
+        static ParallelCalibration calibration;
+        return calibration;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Private constructor. Runs the
+    /// measurements, if more than one thread can
+    /// actually run at the same time.
+    /////////////////////////////////////////////////
+    ParallelCalibration::ParallelCalibration()
+        : m_threads(std::min(omp_get_max_threads(), omp_get_num_procs())), m_forkOverhead(0.0), m_opCost(0.0), m_blockBytes(256*1024)
+    {
+        if (m_threads > 1)
+            calibrate();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Measure the overhead of a parallel
+    /// region and the cost of a single element-wise
+    /// operation for different block lengths. The
+    /// fastest block length determines the size of
+    /// the working set of a block.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void ParallelCalibration::calibrate()
+    {
+        const int REGIONS = 64;
+        const size_t TOTAL = 1 << 16;
+        std::atomic<int> counter(0);
+
+        // Create the thread pool first
+        #pragma omp parallel
+        {
+            counter++;
+        }
+
+        double start = omp_get_wtime();
+
+        for (int i = 0; i < REGIONS; i++)
+        {
+            #pragma omp parallel
+            {
+                counter++;
+            }
+        }
+
+        m_forkOverhead = (omp_get_wtime() - start) / REGIONS;
+        m_opCost = std::numeric_limits<double>::max();
+
+        for (size_t nBlock = 4*MIN_BLOCKSIZE; nBlock <= TOTAL; nBlock *= 2)
+        {
+            Array a(std::vector<double>(nBlock, 1.5));
+            Array b(std::vector<double>(nBlock, 0.5));
+
+            // Use the faster one of two runs to reduce the
+            // influence of other processes
+            for (int run = 0; run < 2; run++)
+            {
+                start = omp_get_wtime();
+
+                for (size_t n = 0; n < TOTAL; n += nBlock)
+                {
+                    Array res = a * b;
+                    res += a;
+                }
+
+                double cost = (omp_get_wtime() - start) / (2.0 * TOTAL);
+
+                if (cost < m_opCost)
+                {
+                    m_opCost = cost;
+                    m_blockBytes = nBlock * sizeof(Value) * 3;
+                }
+            }
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Return the minimal vector length, for
+    /// which an expression with the passed number of
+    /// operations is evaluated in parallel.
+    ///
+    /// \param nOps size_t
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+    size_t ParallelCalibration::getMinElements(size_t nOps) const
+    {
+        if (m_threads < 2 || m_opCost <= 0.0)
+            return std::numeric_limits<size_t>::max();
+
+        // The serial part saved by the other threads has
+        // to outweigh the overhead of the parallel region
+        double savedShare = 1.0 - 1.0 / m_threads;
+        double nMin = PARALLEL_PAYOFF_FACTOR * m_forkOverhead / (std::max(nOps, (size_t)1) * m_opCost * savedShare);
+
+        if (nMin > (double)std::numeric_limits<size_t>::max() / 2)
+            return std::numeric_limits<size_t>::max();
+
+        return nMin < MIN_ELEMENTS ? MIN_ELEMENTS : (size_t)nMin;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Return the number of elements of a
+    /// single block, if the passed number of arrays
+    /// (variables and intermediate results) are
+    /// alive at the same time. The blocks are kept
+    /// small enough for being distributed among all
+    /// threads.
+    ///
+    /// \param nArrays size_t
+    /// \param nElements size_t
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+    size_t ParallelCalibration::getBlockSize(size_t nArrays, size_t nElements) const
+    {
+        size_t nBlockSize = m_blockBytes / (sizeof(Value) * std::max(nArrays, (size_t)1));
+        nBlockSize = std::min(nBlockSize, nElements / (PARALLEL_BLOCKS_PER_THREAD * std::max(m_threads, 1)));
+
+        return nBlockSize < MIN_BLOCKSIZE ? MIN_BLOCKSIZE : nBlockSize;
+    }
+}
+
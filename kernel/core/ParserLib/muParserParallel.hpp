@@ -0,0 +1,96 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2024  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef MUPARSERPARALLEL_HPP
+#define MUPARSERPARALLEL_HPP
+
+#include <cstddef>
+
+namespace mu
+{
+    /////////////////////////////////////////////////
+    /// \brief This class contains the measured
+    /// costs, which determine, whether a vectorised
+    /// expression is evaluated in parallel and how
+    /// large its blocks are. The measurement is done
+    /// once upon the first access.
+    /////////////////////////////////////////////////
+    class ParallelCalibration
+    {
+        public:
+            // Smallest number of elements in a single block
+            static const size_t MIN_BLOCKSIZE = 256;
+
+            // Smallest vector length considered for parallel
+            // evaluation at all
+            static const size_t MIN_ELEMENTS = 4096;
+
+            static const ParallelCalibration& get();
+
+            size_t getMinElements(size_t nOps) const;
+            size_t getBlockSize(size_t nArrays, size_t nElements) const;
+
+            /////////////////////////////////////////////////
+            /// \brief Average duration of starting and
+            /// joining a parallel region in seconds.
+            ///
+            /// \return double
+            ///
+            /////////////////////////////////////////////////
+            double getForkOverhead() const
+            {
+                return m_forkOverhead;
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Duration of a single element-wise
+            /// operation per element in seconds.
+            ///
+            /// \return double
+            ///
+            /////////////////////////////////////////////////
+            double getOperationCost() const
+            {
+                return m_opCost;
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Size of the working set of a single
+            /// block, which performed best, in bytes.
+            ///
+            /// \return size_t
+            ///
+            /////////////////////////////////////////////////
+            size_t getBlockBytes() const
+            {
+                return m_blockBytes;
+            }
+
+        private:
+            int m_threads;
+            double m_forkOverhead;
+            double m_opCost;
+            size_t m_blockBytes;
+
+            ParallelCalibration();
+            void calibrate();
+    };
+}
+
+#endif // MUPARSERPARALLEL_HPP
+
@@ -1019,5 +1019,14 @@ namespace mu
 	{
 		return m_cArgSep;
 	}
+
+	//---------------------------------------------------------------------------
+	/** \brief Return the value identification callbacks in the order of their
+	           evaluation.
+	*/
+	const std::list<identfun_type>& ParserTokenReader::GetValIdents() const
+	{
+		return m_vIdentFun;
+	}
 } // namespace mu
 
@@ -73,6 +73,7 @@ namespace mu
             StringView GetExpr() const;
             varmap_type& GetUsedVar();
             char_type GetArgSep() const;
+            const std::list<identfun_type>& GetValIdents() const;
 
             void IgnoreUndefVar(bool bIgnore);
             void ReInit();
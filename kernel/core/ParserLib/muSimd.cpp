@@ -0,0 +1,667 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2024  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "muSimd.hpp"
+
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MU_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace mu
+{
+    namespace simd
+    {
+#ifdef MU_SIMD_X86
+        /////////////////////////////////////////////////
+        /// \brief AVX2 variants of the vectorized
+        /// kernels. Each iteration processes four
+        /// doubles, the remainder is handled by the
+        /// scalar variants.
+        /////////////////////////////////////////////////
+        __attribute__((target("avx2")))
+        static size_t abs_avx2(const double* in, double* out, size_t n)
+        {
+            const __m256d signMask = _mm256_set1_pd(-0.0);
+            size_t i = 0;
+
+            for (; i+4 <= n; i += 4)
+            {
+                _mm256_storeu_pd(out+i, _mm256_andnot_pd(signMask, _mm256_loadu_pd(in+i)));
+            }
+
+            return i;
+        }
+
+
+        __attribute__((target("avx2")))
+        static size_t sqrt_avx2(const double* in, double* out, size_t n)
+        {
+            size_t i = 0;
+
+            for (; i+4 <= n; i += 4)
+            {
+                _mm256_storeu_pd(out+i, _mm256_sqrt_pd(_mm256_loadu_pd(in+i)));
+            }
+
+            return i;
+        }
+
+
+        __attribute__((target("avx2")))
+        static size_t floor_avx2(const double* in, double* out, size_t n)
+        {
+            size_t i = 0;
+
+            for (; i+4 <= n; i += 4)
+            {
+                _mm256_storeu_pd(out+i, _mm256_round_pd(_mm256_loadu_pd(in+i), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+            }
+
+            return i;
+        }
+
+
+        __attribute__((target("avx2")))
+        static size_t ceil_avx2(const double* in, double* out, size_t n)
+        {
+            size_t i = 0;
+
+            for (; i+4 <= n; i += 4)
+            {
+                _mm256_storeu_pd(out+i, _mm256_round_pd(_mm256_loadu_pd(in+i), _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+            }
+
+            return i;
+        }
+
+
+        __attribute__((target("avx2")))
+        static size_t rint_avx2(const double* in, double* out, size_t n)
+        {
+            size_t i = 0;
+
+            for (; i+4 <= n; i += 4)
+            {
+                _mm256_storeu_pd(out+i, _mm256_round_pd(_mm256_loadu_pd(in+i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+            }
+
+            return i;
+        }
+
+
+        __attribute__((target("avx2")))
+        static size_t sign_avx2(const double* in, double* out, size_t n)
+        {
+            const __m256d zero = _mm256_setzero_pd();
+            const __m256d one = _mm256_set1_pd(1.0);
+            const __m256d minusOne = _mm256_set1_pd(-1.0);
+            size_t i = 0;
+
+            // NaN is neither greater than nor equal to zero and
+            // therefore results in -1 like the scalar variant
+            for (; i+4 <= n; i += 4)
+            {
+                __m256d x = _mm256_loadu_pd(in+i);
+                __m256d res = _mm256_blendv_pd(minusOne, one, _mm256_cmp_pd(x, zero, _CMP_GT_OQ));
+                _mm256_storeu_pd(out+i, _mm256_blendv_pd(res, zero, _mm256_cmp_pd(x, zero, _CMP_EQ_OQ)));
+            }
+
+            return i;
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief SSE4.1 variants of the vectorized
+        /// kernels. Each iteration processes two
+        /// doubles, the remainder is handled by the
+        /// scalar variants.
+        /////////////////////////////////////////////////
+        __attribute__((target("sse4.1")))
+        static size_t abs_sse41(const double* in, double* out, size_t n)
+        {
+            const __m128d signMask = _mm_set1_pd(-0.0);
+            size_t i = 0;
+
+            for (; i+2 <= n; i += 2)
+            {
+                _mm_storeu_pd(out+i, _mm_andnot_pd(signMask, _mm_loadu_pd(in+i)));
+            }
+
+            return i;
+        }
+
+
+        __attribute__((target("sse4.1")))
+        static size_t sqrt_sse41(const double* in, double* out, size_t n)
+        {
+            size_t i = 0;
+
+            for (; i+2 <= n; i += 2)
+            {
+                _mm_storeu_pd(out+i, _mm_sqrt_pd(_mm_loadu_pd(in+i)));
+            }
+
+            return i;
+        }
+
+
+        __attribute__((target("sse4.1")))
+        static size_t floor_sse41(const double* in, double* out, size_t n)
+        {
+            size_t i = 0;
+
+            for (; i+2 <= n; i += 2)
+            {
+                _mm_storeu_pd(out+i, _mm_round_pd(_mm_loadu_pd(in+i), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+            }
+
+            return i;
+        }
+
+
+        __attribute__((target("sse4.1")))
+        static size_t ceil_sse41(const double* in, double* out, size_t n)
+        {
+            size_t i = 0;
+
+            for (; i+2 <= n; i += 2)
+            {
+                _mm_storeu_pd(out+i, _mm_round_pd(_mm_loadu_pd(in+i), _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+            }
+
+            return i;
+        }
+
+
+        __attribute__((target("sse4.1")))
+        static size_t rint_sse41(const double* in, double* out, size_t n)
+        {
+            size_t i = 0;
+
+            for (; i+2 <= n; i += 2)
+            {
+                _mm_storeu_pd(out+i, _mm_round_pd(_mm_loadu_pd(in+i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+            }
+
+            return i;
+        }
+
+
+        __attribute__((target("sse4.1")))
+        static size_t sign_sse41(const double* in, double* out, size_t n)
+        {
+            const __m128d zero = _mm_setzero_pd();
+            const __m128d one = _mm_set1_pd(1.0);
+            const __m128d minusOne = _mm_set1_pd(-1.0);
+            size_t i = 0;
+
+            for (; i+2 <= n; i += 2)
+            {
+                __m128d x = _mm_loadu_pd(in+i);
+                __m128d res = _mm_blendv_pd(minusOne, one, _mm_cmpgt_pd(x, zero));
+                _mm_storeu_pd(out+i, _mm_blendv_pd(res, zero, _mm_cmpeq_pd(x, zero)));
+            }
+
+            return i;
+        }
+#endif // MU_SIMD_X86
+
+
+        /////////////////////////////////////////////////
+        /// \brief Returns true, if the CPU supports the
+        /// AVX2 instruction set. The result is detected
+        /// only once.
+        ///
+        /// \return bool
+        ///
+        /////////////////////////////////////////////////
+        bool hasAVX2()
+        {
+#ifdef MU_SIMD_X86
+            static const bool avx2 = __builtin_cpu_supports("avx2");
+            return avx2;
+#else
+            return false;
+#endif
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Returns true, if the CPU supports the
+        /// SSE4.1 instruction set. The result is
+        /// detected only once.
+        ///
+        /// \return bool
+        ///
+        /////////////////////////////////////////////////
+        bool hasSSE41()
+        {
+#ifdef MU_SIMD_X86
+            static const bool sse41 = __builtin_cpu_supports("sse4.1");
+            return sse41;
+#else
+            return false;
+#endif
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Vectorized absolute value.
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void abs(const double* in, double* out, size_t n)
+        {
+            size_t i = 0;
+#ifdef MU_SIMD_X86
+            if (hasAVX2())
+                i = abs_avx2(in, out, n);
+            else if (hasSSE41())
+                i = abs_sse41(in, out, n);
+#endif
+
+            for (; i < n; i++)
+            {
+                out[i] = std::abs(in[i]);
+            }
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Vectorized square root. Negative
+        /// values result in NaN.
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void sqrt(const double* in, double* out, size_t n)
+        {
+            size_t i = 0;
+#ifdef MU_SIMD_X86
+            if (hasAVX2())
+                i = sqrt_avx2(in, out, n);
+            else if (hasSSE41())
+                i = sqrt_sse41(in, out, n);
+#endif
+
+            for (; i < n; i++)
+            {
+                out[i] = std::sqrt(in[i]);
+            }
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Vectorized floor function.
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void floor(const double* in, double* out, size_t n)
+        {
+            size_t i = 0;
+#ifdef MU_SIMD_X86
+            if (hasAVX2())
+                i = floor_avx2(in, out, n);
+            else if (hasSSE41())
+                i = floor_sse41(in, out, n);
+#endif
+
+            for (; i < n; i++)
+            {
+                out[i] = std::floor(in[i]);
+            }
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Vectorized ceil function.
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void ceil(const double* in, double* out, size_t n)
+        {
+            size_t i = 0;
+#ifdef MU_SIMD_X86
+            if (hasAVX2())
+                i = ceil_avx2(in, out, n);
+            else if (hasSSE41())
+                i = ceil_sse41(in, out, n);
+#endif
+
+            for (; i < n; i++)
+            {
+                out[i] = std::ceil(in[i]);
+            }
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Vectorized rint function (rounding to
+        /// the nearest integer, ties to even).
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void rint(const double* in, double* out, size_t n)
+        {
+            size_t i = 0;
+#ifdef MU_SIMD_X86
+            if (hasAVX2())
+                i = rint_avx2(in, out, n);
+            else if (hasSSE41())
+                i = rint_sse41(in, out, n);
+#endif
+
+            for (; i < n; i++)
+            {
+                out[i] = std::rint(in[i]);
+            }
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Vectorized sign function.
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void sign(const double* in, double* out, size_t n)
+        {
+            size_t i = 0;
+#ifdef MU_SIMD_X86
+            if (hasAVX2())
+                i = sign_avx2(in, out, n);
+            else if (hasSSE41())
+                i = sign_sse41(in, out, n);
+#endif
+
+            for (; i < n; i++)
+            {
+                out[i] = in[i] == 0.0 ? 0.0 : (in[i] > 0.0 ? 1.0 : -1.0);
+            }
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Real sine.
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void sin(const double* in, double* out, size_t n)
+        {
+            for (size_t i = 0; i < n; i++)
+            {
+                out[i] = std::sin(in[i]);
+            }
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Real cosine.
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void cos(const double* in, double* out, size_t n)
+        {
+            for (size_t i = 0; i < n; i++)
+            {
+                out[i] = std::cos(in[i]);
+            }
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Real tangent.
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void tan(const double* in, double* out, size_t n)
+        {
+            for (size_t i = 0; i < n; i++)
+            {
+                out[i] = std::tan(in[i]);
+            }
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Real arcus sine. Values outside of
+        /// [-1,1] result in NaN.
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void asin(const double* in, double* out, size_t n)
+        {
+            for (size_t i = 0; i < n; i++)
+            {
+                out[i] = std::asin(in[i]);
+            }
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Real arcus cosine. Values outside of
+        /// [-1,1] result in NaN.
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void acos(const double* in, double* out, size_t n)
+        {
+            for (size_t i = 0; i < n; i++)
+            {
+                out[i] = std::acos(in[i]);
+            }
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Real arcus tangent.
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void atan(const double* in, double* out, size_t n)
+        {
+            for (size_t i = 0; i < n; i++)
+            {
+                out[i] = std::atan(in[i]);
+            }
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Real hyperbolic sine.
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void sinh(const double* in, double* out, size_t n)
+        {
+            for (size_t i = 0; i < n; i++)
+            {
+                out[i] = std::sinh(in[i]);
+            }
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Real hyperbolic cosine.
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void cosh(const double* in, double* out, size_t n)
+        {
+            for (size_t i = 0; i < n; i++)
+            {
+                out[i] = std::cosh(in[i]);
+            }
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Real hyperbolic tangent.
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void tanh(const double* in, double* out, size_t n)
+        {
+            for (size_t i = 0; i < n; i++)
+            {
+                out[i] = std::tanh(in[i]);
+            }
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Real exponential function.
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void exp(const double* in, double* out, size_t n)
+        {
+            for (size_t i = 0; i < n; i++)
+            {
+                out[i] = std::exp(in[i]);
+            }
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Real natural logarithm. Values less
+        /// or equal to zero result in NaN, because
+        /// their complex logarithm differs from the
+        /// real one (including negative zero).
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void log(const double* in, double* out, size_t n)
+        {
+            for (size_t i = 0; i < n; i++)
+            {
+                out[i] = in[i] > 0.0 ? std::log(in[i]) : NAN;
+            }
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Real logarithm to the base 2.
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void log2(const double* in, double* out, size_t n)
+        {
+            // Identical to the scalar implementation
+            // in MathImpl
+            const double log_2 = std::log(2.0);
+
+            for (size_t i = 0; i < n; i++)
+            {
+                out[i] = std::log(in[i]) / log_2;
+            }
+        }
+
+
+        /////////////////////////////////////////////////
+        /// \brief Real logarithm to the base 10.
+        ///
+        /// \param in const double*
+        /// \param out double*
+        /// \param n size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void log10(const double* in, double* out, size_t n)
+        {
+            for (size_t i = 0; i < n; i++)
+            {
+                out[i] = std::log10(in[i]);
+            }
+        }
+    }
+}
+
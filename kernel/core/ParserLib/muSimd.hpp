@@ -0,0 +1,76 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2024  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef MUSIMD_HPP
+#define MUSIMD_HPP
+
+#include <cstddef>
+
+namespace mu
+{
+    /////////////////////////////////////////////////
+    /// \brief Signature of a real-valued kernel,
+    /// which applies a function element-wise to a
+    /// contiguous buffer of doubles. Results, which
+    /// leave the real domain, are signalled by
+    /// returning NaN.
+    /////////////////////////////////////////////////
+    typedef void(*RealKernel)(const double*, double*, size_t);
+
+
+    /////////////////////////////////////////////////
+    /// \brief This namespace contains the real-valued
+    /// kernels used by mu::apply() for homogeneous
+    /// real Arrays. Kernels with an exact SIMD
+    /// counterpart select the AVX2 or SSE4.1
+    /// variant during runtime depending on the
+    /// available CPU features, all others are tight
+    /// loops over the real math library.
+    /////////////////////////////////////////////////
+    namespace simd
+    {
+        bool hasAVX2();
+        bool hasSSE41();
+
+        // Vectorized kernels
+        void abs(const double* in, double* out, size_t n);
+        void sqrt(const double* in, double* out, size_t n);
+        void floor(const double* in, double* out, size_t n);
+        void ceil(const double* in, double* out, size_t n);
+        void rint(const double* in, double* out, size_t n);
+        void sign(const double* in, double* out, size_t n);
+
+        // Real math library kernels
+        void sin(const double* in, double* out, size_t n);
+        void cos(const double* in, double* out, size_t n);
+        void tan(const double* in, double* out, size_t n);
+        void asin(const double* in, double* out, size_t n);
+        void acos(const double* in, double* out, size_t n);
+        void atan(const double* in, double* out, size_t n);
+        void sinh(const double* in, double* out, size_t n);
+        void cosh(const double* in, double* out, size_t n);
+        void tanh(const double* in, double* out, size_t n);
+        void exp(const double* in, double* out, size_t n);
+        void log(const double* in, double* out, size_t n);
+        void log2(const double* in, double* out, size_t n);
+        void log10(const double* in, double* out, size_t n);
+    }
+}
+
+#endif // MUSIMD_HPP
+
@@ -24,7 +24,8 @@
 #include "../strings/functionimplementation.hpp" // for string method callees
 #include "../maths/functionimplementation.hpp" // for numerical method callees
 
-#warning FIXME (numere#1#12/09/24): Removed all move operations due to memory leaks
+#include <functional>
+#include <mutex>
 
 
 namespace mu
@@ -45,31 +46,9 @@ namespace mu
     /// \param data const Value&
     ///
     /////////////////////////////////////////////////
-    Value::Value(const Value& data)
+    Value::Value(const Value& data) : Value()
     {
-        m_type = data.m_type;
-
-        switch (m_type)
-        {
-            case TYPE_CATEGORY:
-                m_data = new Category;
-                *static_cast<Category*>(m_data) = *static_cast<Category*>(data.m_data);
-                break;
-            case TYPE_NUMERICAL:
-                m_data = new Numerical;
-                *static_cast<Numerical*>(m_data) = data.getNum();
-                break;
-            case TYPE_STRING:
-                m_data = new std::string;
-                *static_cast<std::string*>(m_data) = data.getStr();
-                break;
-            case TYPE_ARRAY:
-                m_data = new Array;
-                *static_cast<Array*>(m_data) = data.getArray();
-                break;
-            default:
-                m_data = nullptr;
-        }
+        operator=(data);
     }
 
 
@@ -79,13 +58,10 @@ namespace mu
     /// \param data Value&&
     ///
     /////////////////////////////////////////////////
-    /*Value::Value(Value&& data)
+    Value::Value(Value&& data) noexcept : Value()
     {
-        m_type = data.m_type;
-        m_data = data.m_data;
-        data.m_data = nullptr;
-        data.m_type = TYPE_VOID;
-    }*/
+        operator=(std::move(data));
+    }
 
 
     /////////////////////////////////////////////////
@@ -94,12 +70,8 @@ namespace mu
     /// \param data const Numerical&
     ///
     /////////////////////////////////////////////////
-    Value::Value(const Numerical& data)
-    {
-        m_type = TYPE_NUMERICAL;
-        m_data = new Numerical;
-        *static_cast<Numerical*>(m_data) = data;
-    }
+    Value::Value(const Numerical& data) : m_num(data), m_type(TYPE_NUMERICAL)
+    { }
 
 
     /////////////////////////////////////////////////
@@ -108,12 +80,8 @@ namespace mu
     /// \param data const Category&
     ///
     /////////////////////////////////////////////////
-    Value::Value(const Category& data)
-    {
-        m_type = TYPE_CATEGORY;
-        m_data = new Category;
-        *static_cast<Category*>(m_data) = data;
-    }
+    Value::Value(const Category& data) : m_data(new Category(data)), m_type(TYPE_CATEGORY)
+    { }
 
 
     /////////////////////////////////////////////////
@@ -122,12 +90,8 @@ namespace mu
     /// \param data const Array&
     ///
     /////////////////////////////////////////////////
-    Value::Value(const Array& data)
-    {
-        m_type = TYPE_ARRAY;
-        m_data = new Array;
-        *static_cast<Array*>(m_data) = data;
-    }
+    Value::Value(const Array& data) : m_data(new Array(data)), m_type(TYPE_ARRAY)
+    { }
 
 
     /////////////////////////////////////////////////
@@ -136,11 +100,8 @@ namespace mu
     /// \param logical bool
     ///
     /////////////////////////////////////////////////
-    Value::Value(bool logical)
-    {
-        m_type = TYPE_NUMERICAL;
-        m_data = new Numerical(logical);
-    }
+    Value::Value(bool logical) : m_num(logical), m_type(TYPE_NUMERICAL)
+    { }
 
 
     /////////////////////////////////////////////////
@@ -149,11 +110,8 @@ namespace mu
     /// \param value int32_t
     ///
     /////////////////////////////////////////////////
-    Value::Value(int32_t value)
-    {
-        m_type = TYPE_NUMERICAL;
-        m_data = new Numerical(value);
-    }
+    Value::Value(int32_t value) : m_num(value), m_type(TYPE_NUMERICAL)
+    { }
 
 
     /////////////////////////////////////////////////
@@ -162,11 +120,8 @@ namespace mu
     /// \param value uint32_t
     ///
     /////////////////////////////////////////////////
-    Value::Value(uint32_t value)
-    {
-        m_type = TYPE_NUMERICAL;
-        m_data = new Numerical(value);
-    }
+    Value::Value(uint32_t value) : m_num(value), m_type(TYPE_NUMERICAL)
+    { }
 
 
     /////////////////////////////////////////////////
@@ -175,11 +130,8 @@ namespace mu
     /// \param value int64_t
     ///
     /////////////////////////////////////////////////
-    Value::Value(int64_t value)
-    {
-        m_type = TYPE_NUMERICAL;
-        m_data = new Numerical(value);
-    }
+    Value::Value(int64_t value) : m_num(value), m_type(TYPE_NUMERICAL)
+    { }
 
 
     /////////////////////////////////////////////////
@@ -188,11 +140,8 @@ namespace mu
     /// \param value uint64_t
     ///
     /////////////////////////////////////////////////
-    Value::Value(uint64_t value)
-    {
-        m_type = TYPE_NUMERICAL;
-        m_data = new Numerical(value);
-    }
+    Value::Value(uint64_t value) : m_num(value), m_type(TYPE_NUMERICAL)
+    { }
 
 
     /////////////////////////////////////////////////
@@ -201,11 +150,8 @@ namespace mu
     /// \param value double
     ///
     /////////////////////////////////////////////////
-    Value::Value(double value)
-    {
-        m_type = TYPE_NUMERICAL;
-        m_data = new Numerical(value);
-    }
+    Value::Value(double value) : m_num(value), m_type(TYPE_NUMERICAL)
+    { }
 
 
     /////////////////////////////////////////////////
@@ -214,11 +160,8 @@ namespace mu
     /// \param value const sys_time_point&
     ///
     /////////////////////////////////////////////////
-    Value::Value(const sys_time_point& value)
-    {
-        m_type = TYPE_NUMERICAL;
-        m_data = new Numerical(value);
-    }
+    Value::Value(const sys_time_point& value) : m_num(value), m_type(TYPE_NUMERICAL)
+    { }
 
 
     /////////////////////////////////////////////////
@@ -229,11 +172,8 @@ namespace mu
     /// \param autoType bool
     ///
     /////////////////////////////////////////////////
-    Value::Value(const std::complex<double>& value, bool autoType)
-    {
-        m_type = TYPE_NUMERICAL;
-        m_data = new Numerical(value, autoType ? AUTO : CF64);
-    }
+    Value::Value(const std::complex<double>& value, bool autoType) : m_num(value, autoType ? AUTO : CF64), m_type(TYPE_NUMERICAL)
+    { }
 
 
     /////////////////////////////////////////////////
@@ -243,11 +183,8 @@ namespace mu
     /// \param value const std::complex<float>&
     ///
     /////////////////////////////////////////////////
-    Value::Value(const std::complex<float>& value)
-    {
-        m_type = TYPE_NUMERICAL;
-        m_data = new Numerical(value);
-    }
+    Value::Value(const std::complex<float>& value) : m_num(value), m_type(TYPE_NUMERICAL)
+    { }
 
 
     /////////////////////////////////////////////////
@@ -256,12 +193,19 @@ namespace mu
     /// \param sData const std::string&
     ///
     /////////////////////////////////////////////////
-    Value::Value(const std::string& sData)
-    {
-        m_type = TYPE_STRING;
-        m_data = new std::string;
-        *static_cast<std::string*>(m_data) = sData;
-    }
+    Value::Value(const std::string& sData) : m_str(sData), m_type(TYPE_STRING)
+    { }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Construct a Value by moving a
+    /// std::string.
+    ///
+    /// \param sData std::string&&
+    ///
+    /////////////////////////////////////////////////
+    Value::Value(std::string&& sData) : m_str(std::move(sData)), m_type(TYPE_STRING)
+    { }
 
 
     /////////////////////////////////////////////////
@@ -270,12 +214,8 @@ namespace mu
     /// \param sData const char*
     ///
     /////////////////////////////////////////////////
-    Value::Value(const char* sData)
-    {
-        m_type = TYPE_STRING;
-        m_data = new std::string;
-        *static_cast<std::string*>(m_data) = sData;
-    }
+    Value::Value(const char* sData) : m_str(sData), m_type(TYPE_STRING)
+    { }
 
 
     /////////////////////////////////////////////////
@@ -297,44 +237,54 @@ namespace mu
     Value& Value::operator=(const Value& other)
     {
         //Timer t("Value::operator=(&)");
-        if (m_type != other.m_type)
+        if (this == &other)
+            return *this;
+
+        // Re-use the already available storage, if
+        // the types are identical
+        if (m_type == other.m_type)
         {
-            if (m_data)
-                clear();
+            switch (m_type)
+            {
+                case TYPE_CATEGORY:
+                    *static_cast<Category*>(m_data) = *static_cast<Category*>(other.m_data);
+                    break;
+                case TYPE_NUMERICAL:
+                    m_num = other.m_num;
+                    break;
+                case TYPE_STRING:
+                    m_str = other.m_str;
+                    break;
+                case TYPE_ARRAY:
+                    *static_cast<Array*>(m_data) = *static_cast<Array*>(other.m_data);
+                    break;
+            }
 
-            m_type = other.m_type;
+            return *this;
         }
 
-        switch (m_type)
+        clear();
+
+        switch (other.m_type)
         {
             case TYPE_CATEGORY:
-                if (!m_data)
-                    m_data = new Category;
-
-                *static_cast<Category*>(m_data) = *static_cast<Category*>(other.m_data);
+                m_data = new Category(*static_cast<Category*>(other.m_data));
                 break;
             case TYPE_NUMERICAL:
-                if (!m_data)
-                    m_data = new Numerical;
-
-                *static_cast<Numerical*>(m_data) = *static_cast<Numerical*>(other.m_data);
+                new (&m_num) Numerical(other.m_num);
                 break;
             case TYPE_STRING:
-                if (!m_data)
-                    m_data = new std::string;
-
-                *static_cast<std::string*>(m_data) = *static_cast<std::string*>(other.m_data);
+                new (&m_str) std::string(other.m_str);
                 break;
             case TYPE_ARRAY:
-                if (!m_data)
-                    m_data = new Array;
-
-                *static_cast<Array*>(m_data) = *static_cast<Array*>(other.m_data);
+                m_data = new Array(*static_cast<Array*>(other.m_data));
                 break;
             default:
-                clear();
+                return *this;
         }
 
+        m_type = other.m_type;
+
         return *this;
     }
 
@@ -346,18 +296,45 @@ namespace mu
     /// \return Value&
     ///
     /////////////////////////////////////////////////
-    /*Value& Value::operator=(Value&& other)
+    Value& Value::operator=(Value&& other) noexcept
     {
         //Timer t("Value::operator=(&&)");
+        if (this == &other)
+            return *this;
+
+        if (m_type == TYPE_STRING && other.m_type == TYPE_STRING)
+        {
+            m_str = std::move(other.m_str);
+            other.clear();
+            return *this;
+        }
+
         clear();
 
+        switch (other.m_type)
+        {
+            case TYPE_CATEGORY:
+            case TYPE_ARRAY:
+                // Heap-allocated values simply change
+                // their owner
+                m_data = other.m_data;
+                other.m_data = nullptr;
+                break;
+            case TYPE_NUMERICAL:
+                new (&m_num) Numerical(other.m_num);
+                break;
+            case TYPE_STRING:
+                new (&m_str) std::string(std::move(other.m_str));
+                break;
+            default:
+                return *this;
+        }
+
         m_type = other.m_type;
-        m_data = other.m_data;
-        other.m_data = nullptr;
-        other.m_type = TYPE_VOID;
+        other.clear();
 
         return *this;
-    }*/
+    }
 
 
     /////////////////////////////////////////////////
@@ -418,7 +395,6 @@ namespace mu
     bool Value::isValid() const
     {
         return m_type != TYPE_VOID
-            && m_data
             && ((isString() && getStr().length())
                 || (isNumerical() && getNum().asCF64() == getNum().asCF64())
                 || (isArray() && getArray().size()));
@@ -434,7 +410,7 @@ namespace mu
     /////////////////////////////////////////////////
     bool Value::isNumerical() const
     {
-        return (m_type == TYPE_NUMERICAL || m_type == TYPE_CATEGORY) && m_data;
+        return m_type == TYPE_NUMERICAL || m_type == TYPE_CATEGORY;
     }
 
 
@@ -447,7 +423,7 @@ namespace mu
     /////////////////////////////////////////////////
     bool Value::isString() const
     {
-        return (m_type == TYPE_STRING || m_type == TYPE_CATEGORY) && m_data;
+        return m_type == TYPE_STRING || m_type == TYPE_CATEGORY;
     }
 
 
@@ -460,7 +436,7 @@ namespace mu
     /////////////////////////////////////////////////
     bool Value::isCategory() const
     {
-        return m_type == TYPE_CATEGORY && m_data;
+        return m_type == TYPE_CATEGORY;
     }
 
 
@@ -473,7 +449,7 @@ namespace mu
     /////////////////////////////////////////////////
     bool Value::isArray() const
     {
-        return m_type == TYPE_ARRAY && m_data;
+        return m_type == TYPE_ARRAY;
     }
 
 
@@ -491,7 +467,7 @@ namespace mu
         if (m_type == TYPE_CATEGORY)
             return ((Category*)m_data)->name;
 
-        return *(std::string*)m_data;
+        return m_str;
     }
 
 
@@ -512,7 +488,7 @@ namespace mu
         if (m_type == TYPE_CATEGORY)
             return ((Category*)m_data)->name;
 
-        return *(std::string*)m_data;
+        return m_str;
     }
 
 
@@ -530,7 +506,7 @@ namespace mu
         if (m_type == TYPE_CATEGORY)
             return ((Category*)m_data)->val;
 
-        return *(Numerical*)m_data;
+        return m_num;
     }
 
 
@@ -551,7 +527,7 @@ namespace mu
         if (m_type == TYPE_CATEGORY)
             return ((Category*)m_data)->val;
 
-        return *(Numerical*)m_data;
+        return m_num;
     }
 
 
@@ -631,7 +607,7 @@ namespace mu
         if (isCategory())
             return ((Category*)m_data)->val.asCF64();
 
-        return static_cast<Numerical*>(m_data)->asCF64();
+        return m_num.asCF64();
     }
 
 
@@ -1268,10 +1244,10 @@ namespace mu
                 delete static_cast<Category*>(m_data);
                 break;
             case TYPE_NUMERICAL:
-                delete static_cast<Numerical*>(m_data);
+                m_num.~Numerical();
                 break;
             case TYPE_STRING:
-                delete static_cast<std::string*>(m_data);
+                m_str.~basic_string();
                 break;
             case TYPE_ARRAY:
                 delete static_cast<mu::Array*>(m_data);
@@ -1348,7 +1324,7 @@ namespace mu
     /////////////////////////////////////////////////
     /// \brief Construct an empty Array.
     /////////////////////////////////////////////////
-    Array::Array() : std::vector<Value>(), m_commonType(TYPE_VOID)
+    Array::Array() : std::vector<Value>(), m_commonType(TYPE_VOID), m_packState(BOXED)
     { }
 
 
@@ -1364,6 +1340,18 @@ namespace mu
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief Move constructor.
+    ///
+    /// \param other Array&&
+    ///
+    /////////////////////////////////////////////////
+    Array::Array(Array&& other) noexcept : Array()
+    {
+        operator=(std::move(other));
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief Fill constructor.
     ///
@@ -1371,7 +1359,7 @@ namespace mu
     /// \param fillVal const Value&
     ///
     /////////////////////////////////////////////////
-    Array::Array(size_t n, const Value& fillVal) : std::vector<Value>(n, fillVal), m_commonType(fillVal.getType())
+    Array::Array(size_t n, const Value& fillVal) : std::vector<Value>(n, fillVal), m_commonType(fillVal.getType()), m_packState(BOXED)
     { }
 
 
@@ -1399,8 +1387,13 @@ namespace mu
     /// \param var const Variable&
     ///
     /////////////////////////////////////////////////
-    Array::Array(const Variable& var) : std::vector<Value>(var), m_commonType(var.m_commonType)
-    { }
+    Array::Array(const Variable& var) : std::vector<Value>(), m_commonType(var.m_commonType), m_packState(BOXED)
+    {
+        if (var.isPacked())
+            sharePacked(var);
+        else
+            std::vector<Value>::operator=(var);
+    }
 
 
     /////////////////////////////////////////////////
@@ -1410,7 +1403,7 @@ namespace mu
     /// \param other const std::vector<std::complex<double>>&
     ///
     /////////////////////////////////////////////////
-    Array::Array(const std::vector<std::complex<double>>& other) : std::vector<Value>(other.size()), m_commonType(TYPE_NUMERICAL)
+    Array::Array(const std::vector<std::complex<double>>& other) : std::vector<Value>(other.size()), m_commonType(TYPE_NUMERICAL), m_packState(BOXED)
     {
         for (size_t i = 0; i < other.size(); i++)
         {
@@ -1426,8 +1419,16 @@ namespace mu
     /// \param other const std::vector<double>&
     ///
     /////////////////////////////////////////////////
-    Array::Array(const std::vector<double>& other) : std::vector<Value>(other.size()), m_commonType(TYPE_NUMERICAL)
+    Array::Array(const std::vector<double>& other) : std::vector<Value>(), m_commonType(TYPE_NUMERICAL), m_packState(BOXED)
     {
+        if (other.size() >= NumArray::MIN_SIZE)
+        {
+            operator=(Array(NumArray(std::vector<double>(other), F64)));
+            return;
+        }
+
+        std::vector<Value>::resize(other.size());
+
         for (size_t i = 0; i < other.size(); i++)
         {
             operator[](i) = Numerical(other[i]);
@@ -1442,7 +1443,7 @@ namespace mu
     /// \param other const std::vector<size_t>&
     ///
     /////////////////////////////////////////////////
-    Array::Array(const std::vector<size_t>& other) : std::vector<Value>(other.size()), m_commonType(TYPE_NUMERICAL)
+    Array::Array(const std::vector<size_t>& other) : std::vector<Value>(other.size()), m_commonType(TYPE_NUMERICAL), m_packState(BOXED)
     {
         for (size_t i = 0; i < other.size(); i++)
         {
@@ -1458,8 +1459,16 @@ namespace mu
     /// \param other const std::vector<int64_t>&
     ///
     /////////////////////////////////////////////////
-    Array::Array(const std::vector<int64_t>& other) : std::vector<Value>(other.size()), m_commonType(TYPE_NUMERICAL)
+    Array::Array(const std::vector<int64_t>& other) : std::vector<Value>(), m_commonType(TYPE_NUMERICAL), m_packState(BOXED)
     {
+        if (other.size() >= NumArray::MIN_SIZE)
+        {
+            operator=(Array(NumArray(std::vector<int64_t>(other), I64)));
+            return;
+        }
+
+        std::vector<Value>::resize(other.size());
+
         for (size_t i = 0; i < other.size(); i++)
         {
             operator[](i) = Numerical(other[i]);
@@ -1474,7 +1483,7 @@ namespace mu
     /// \param other const std::vector<Numerical>&
     ///
     /////////////////////////////////////////////////
-    Array::Array(const std::vector<Numerical>& other) : std::vector<Value>(other.size()), m_commonType(TYPE_NUMERICAL)
+    Array::Array(const std::vector<Numerical>& other) : std::vector<Value>(other.size()), m_commonType(TYPE_NUMERICAL), m_packState(BOXED)
     {
         for (size_t i = 0; i < other.size(); i++)
         {
@@ -1490,7 +1499,7 @@ namespace mu
     /// \param other const std::vector<std::string>&
     ///
     /////////////////////////////////////////////////
-    Array::Array(const std::vector<std::string>& other) : std::vector<Value>(other.size()), m_commonType(TYPE_STRING)
+    Array::Array(const std::vector<std::string>& other) : std::vector<Value>(other.size()), m_commonType(TYPE_STRING), m_packState(BOXED)
     {
         for (size_t i = 0; i < other.size(); i++)
         {
@@ -1500,209 +1509,1095 @@ namespace mu
 
 
     /////////////////////////////////////////////////
-    /// \brief Make this array a 2-val generator
-    /// array.
+    /// \brief Make this array a 2-val generator
+    /// array.
+    ///
+    /// \param fst const Array&
+    /// \param lst const Array&
+    ///
+    /////////////////////////////////////////////////
+    Array::Array(const Array& fst, const Array& lst) : std::vector<Value>({fst,lst}), m_commonType(TYPE_GENERATOR), m_packState(BOXED)
+    { }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Make this array a 3-val generator
+    /// array.
+    ///
+    /// \param fst const Array&
+    /// \param inc const Array&
+    /// \param lst const Array&
+    ///
+    /////////////////////////////////////////////////
+    Array::Array(const Array& fst, const Array& inc, const Array& lst) : std::vector<Value>({fst,inc,lst}), m_commonType(TYPE_GENERATOR), m_packState(BOXED)
+    { }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Construct a packed Array, which uses
+    /// the passed NumArray as its storage.
+    ///
+    /// \param packed NumArray&&
+    ///
+    /////////////////////////////////////////////////
+    Array::Array(NumArray&& packed) : std::vector<Value>(), m_commonType(TYPE_NUMERICAL), m_packState(PACKED)
+    {
+        m_packed = std::make_shared<const NumArray>(std::move(packed));
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Assign an Array.
+    ///
+    /// \param other const Array&
+    /// \return Array&
+    ///
+    /////////////////////////////////////////////////
+    Array& Array::operator=(const Array& other)
+    {
+        //Timer t("Array::operator=(&)");
+        if (other.isPacked())
+        {
+            sharePacked(other);
+            return *this;
+        }
+
+        // The values are overwritten completely
+        if (m_packed)
+        {
+            m_packed.reset();
+            m_packState.store(BOXED, std::memory_order_release);
+        }
+
+        // Both Arrays are boxed from here on, i.e. the
+        // values may be accessed directly
+        const std::vector<Value>& vals = other;
+        std::vector<Value>& boxed = *this;
+
+        if (vals.size() == 1)
+        {
+            if (vals.front().isArray())
+                return operator=(vals.front().getArray());
+
+            boxed.resize(1);
+            boxed.front() = vals.front();
+        }
+        else
+        {
+            boxed.resize(vals.size());
+
+            //#pragma omp parallel for if(size() > 500)
+            for (size_t i = 0; i < vals.size(); i++)
+            {
+                boxed[i] = vals[i];
+            }
+        }
+
+        m_commonType = other.m_commonType;
+
+        return *this;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Move an Array.
+    ///
+    /// \param other Array&&
+    /// \return Array&
+    ///
+    /////////////////////////////////////////////////
+    Array& Array::operator=(Array&& other) noexcept
+    {
+        // Timer t("Array::operator=(&&)");
+        if (this == &other)
+            return *this;
+
+        if (other.isPacked())
+        {
+            sharePacked(other);
+            other.clear();
+            other.m_commonType = TYPE_VOID;
+            return *this;
+        }
+
+        std::vector<Value>& vals = other;
+
+        // Keep the unwrapping semantics of the copy
+        // assignment
+        if (vals.size() == 1 && vals.front().isArray())
+        {
+            Array unwrapped(std::move(vals.front().getArray()));
+            return operator=(std::move(unwrapped));
+        }
+
+        if (m_packed)
+        {
+            m_packed.reset();
+            m_packState.store(BOXED, std::memory_order_release);
+        }
+
+        std::vector<Value>::operator=(std::move(vals));
+        m_commonType = other.m_commonType;
+        other.m_commonType = TYPE_VOID;
+
+        return *this;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Share the packed storage of another
+    /// Array instead of copying its values.
+    ///
+    /// \param other const Array&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void Array::sharePacked(const Array& other)
+    {
+        if (this == &other)
+            return;
+
+        std::vector<Value>::clear();
+        m_packed = other.m_packed;
+        m_packState.store(PACKED, std::memory_order_release);
+        m_commonType = TYPE_NUMERICAL;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Create the boxed Values from the
+    /// packed storage. Const accesses may happen
+    /// concurrently, therefore the conversion is
+    /// guarded by a mutex and the state is checked
+    /// again after locking.
+    ///
+    /// \param keepPacked bool
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void Array::boxPacked(bool keepPacked) const
+    {
+        static std::mutex unpackMutex;
+        std::lock_guard<std::mutex> lock(unpackMutex);
+
+        uint8_t state = m_packState.load(std::memory_order_acquire);
+
+        if (state == PACKED)
+        {
+            // The boxed Values are a cache of the packed
+            // storage, i.e. creating them does not change
+            // the logical state of the Array
+            std::vector<Value>& boxed = const_cast<Array&>(*this);
+            boxed.clear();
+            boxed.reserve(m_packed->size());
+
+            for (size_t i = 0; i < m_packed->size(); i++)
+            {
+                boxed.emplace_back(m_packed->get(i));
+            }
+        }
+
+        if (state != BOXED)
+            m_packState.store(keepPacked ? PACKED_AND_BOXED : BOXED, std::memory_order_release);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Get the (general) data types of every
+    /// contained Value.
+    ///
+    /// \return std::vector<DataType>
+    ///
+    /////////////////////////////////////////////////
+    std::vector<DataType> Array::getType() const
+    {
+        if (isPacked())
+            return std::vector<DataType>(size(), TYPE_NUMERICAL);
+
+        std::vector<DataType> types;
+
+        for (size_t i = 0; i < size(); i++)
+        {
+            types.push_back(operator[](i).getType());
+
+            if (m_commonType == TYPE_VOID)
+                m_commonType = types.back();
+
+            if (m_commonType != types.back())
+                m_commonType = TYPE_MIXED;
+        }
+
+        return types;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Get the common (general) data type
+    /// representing all contained Values best.
+    ///
+    /// \return DataType
+    ///
+    /////////////////////////////////////////////////
+    DataType Array::getCommonType() const
+    {
+        if (m_commonType == TYPE_VOID && size())
+            getType();
+
+        return m_commonType;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Get the common (general) data type
+    /// representing all contained Values best as a
+    /// printable std::string.
+    ///
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+    std::string Array::getCommonTypeAsString() const
+    {
+        switch (getCommonType())
+        {
+            case TYPE_CATEGORY:
+                return "category";
+            case TYPE_NUMERICAL:
+            {
+                if (isPacked())
+                    return TypeInfo(m_packed->getType()).printType();
+
+                TypeInfo info = front().getNum().getInfo();
+
+                for (size_t i = 1; i < size(); i++)
+                {
+                    info.promote(operator[](i).getNum().getInfo());
+                }
+
+                return info.printType();
+            }
+            case TYPE_STRING:
+                return "string";
+            case TYPE_MIXED:
+                return "cluster";
+        }
+
+        return "void";
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Get the common (promoted)
+    /// NumericalType of all contained Values
+    /// assuming that all Values are Numericals.
+    ///
+    /// \return NumericalType
+    ///
+    /////////////////////////////////////////////////
+    NumericalType Array::getCommonNumericalType() const
+    {
+        if (isPacked())
+            return m_packed->getType();
+
+        TypeInfo info = front().getNum().getInfo();
+
+        for (size_t i = 1; i < size(); i++)
+        {
+            info.promote(operator[](i).getNum().getInfo());
+        }
+
+        return info.asType();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief True, if only a single value is
+    /// contained within this Array.
+    ///
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    bool Array::isScalar() const
+    {
+        return size() == 1u;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief True, if this Array represents a
+    /// default value (an empty array in this
+    /// implementation).
+    ///
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    bool Array::isDefault() const
+    {
+        return !size();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Construct an empty and invalid
+    /// NumArray.
+    /////////////////////////////////////////////////
+    NumArray::NumArray() : m_type(AUTO), m_storage(STORE_NONE), m_size(0)
+    { }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Construct a NumArray from an Array.
+    /// If the Array is not homogeneous numerical,
+    /// the resulting instance will be invalid.
+    ///
+    /// \param arr const Array&
+    ///
+    /////////////////////////////////////////////////
+    NumArray::NumArray(const Array& arr) : NumArray()
+    {
+        if (arr.isPacked())
+        {
+            *this = *arr.m_packed;
+            return;
+        }
+
+        if (!arr.size() || arr.front().m_type != TYPE_NUMERICAL)
+            return;
+
+        NumericalType type = arr.front().m_num.getType();
+        StorageType storage = STORE_INT;
+
+        // UI64 values exceed the range of int64_t and would
+        // be compared and converted with a wrong sign. They
+        // are left to the boxed algorithms of Numerical
+        if (type == UI64)
+            return;
+
+        if (type >= CF32)
+            storage = STORE_COMPLEX;
+        else if (type >= F32)
+            storage = STORE_FLOAT;
+
+        // Note: the remaining unsigned and the logical
+        // types fit into the int64_t storage
+        if (storage == STORE_INT)
+            m_ints.resize(arr.size());
+        else if (storage == STORE_FLOAT)
+            m_reals.resize(arr.size());
+        else
+            m_cmplx.resize(arr.size());
+
+        for (size_t i = 0; i < arr.size(); i++)
+        {
+            const Value& val = arr[i];
+
+            // Access the members directly, because this is
+            // the hot loop of all typed kernels
+            if (val.m_type != TYPE_NUMERICAL || val.m_num.getType() != type)
+            {
+                m_ints.clear();
+                m_reals.clear();
+                m_cmplx.clear();
+                return;
+            }
+
+            if (storage == STORE_INT)
+                m_ints[i] = val.m_num.asI64();
+            else if (storage == STORE_FLOAT)
+                m_reals[i] = val.m_num.asF64();
+            else
+                m_cmplx[i] = val.m_num.asCF64();
+        }
+
+        m_type = type;
+        m_storage = storage;
+        m_size = arr.size();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Construct an integer NumArray from
+    /// already computed values.
+    ///
+    /// \param vals std::vector<int64_t>&&
+    /// \param type NumericalType
+    ///
+    /////////////////////////////////////////////////
+    NumArray::NumArray(std::vector<int64_t>&& vals, NumericalType type)
+        : m_ints(std::move(vals)), m_type(type), m_storage(STORE_INT)
+    {
+        m_size = m_ints.size();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Construct a floating point NumArray
+    /// from already computed values.
+    ///
+    /// \param vals std::vector<double>&&
+    /// \param type NumericalType
+    ///
+    /////////////////////////////////////////////////
+    NumArray::NumArray(std::vector<double>&& vals, NumericalType type)
+        : m_reals(std::move(vals)), m_type(type), m_storage(STORE_FLOAT)
+    {
+        m_size = m_reals.size();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Return the typed representation of an
+    /// Array. Packed Arrays are referenced directly,
+    /// all others are converted into the passed
+    /// buffer, which might be invalid afterwards.
+    ///
+    /// \param arr const Array&
+    /// \param buffer NumArray&
+    /// \return const NumArray&
+    ///
+    /////////////////////////////////////////////////
+    const NumArray& NumArray::view(const Array& arr, NumArray& buffer)
+    {
+        if (arr.isPacked())
+            return *arr.m_packed;
+
+        buffer = NumArray(arr);
+        return buffer;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Copy a block of real numerical values
+    /// from the passed Array into the buffer as
+    /// doubles. Returns false, if the block contains
+    /// any complex or non-numerical value.
+    ///
+    /// \param arr const Array&
+    /// \param pos size_t
+    /// \param n size_t
+    /// \param buffer double*
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    bool NumArray::gatherReals(const Array& arr, size_t pos, size_t n, double* buffer)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            const Value& val = arr[pos+i];
+
+            if (val.m_type != TYPE_NUMERICAL || val.m_num.getType() >= CF32)
+                return false;
+
+            buffer[i] = val.m_num.asF64();
+        }
+
+        return true;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief True, if the NumArray represents a
+    /// homogeneous numerical Array.
+    ///
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    bool NumArray::isValid() const
+    {
+        return m_storage != STORE_NONE;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Return the number of elements.
+    ///
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+    size_t NumArray::size() const
+    {
+        return m_size;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Return the common NumericalType of all
+    /// elements.
+    ///
+    /// \return NumericalType
+    ///
+    /////////////////////////////////////////////////
+    NumericalType NumArray::getType() const
+    {
+        return m_type;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Return the type of the internal
+    /// buffer, i.e. which of ints(), reals() or
+    /// cmplx() contains the values.
+    ///
+    /// \return NumArray::StorageType
+    ///
+    /////////////////////////////////////////////////
+    NumArray::StorageType NumArray::getStorage() const
+    {
+        return m_storage;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Raw buffer of the integer storage.
+    ///
+    /// \return const int64_t*
+    ///
+    /////////////////////////////////////////////////
+    const int64_t* NumArray::ints() const
+    {
+        return m_ints.data();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Raw buffer of the floating point
+    /// storage.
+    ///
+    /// \return const double*
+    ///
+    /////////////////////////////////////////////////
+    const double* NumArray::reals() const
+    {
+        return m_reals.data();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Raw buffer of the complex storage.
+    ///
+    /// \return const std::complex<double>*
+    ///
+    /////////////////////////////////////////////////
+    const std::complex<double>* NumArray::cmplx() const
+    {
+        return m_cmplx.data();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Return the values of a non-complex
+    /// NumArray as a double buffer. Integer storages
+    /// are converted into the passed buffer.
+    ///
+    /// \param buffer std::vector<double>&
+    /// \return const double*
+    ///
+    /////////////////////////////////////////////////
+    const double* NumArray::asReals(std::vector<double>& buffer) const
+    {
+        if (m_storage == STORE_FLOAT)
+            return m_reals.data();
+
+        buffer.resize(m_size);
+
+        for (size_t i = 0; i < m_size; i++)
+        {
+            buffer[i] = m_ints[i];
+        }
+
+        return buffer.data();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Return the i-th element as a boxed
+    /// Numerical of the original type.
+    ///
+    /// \param i size_t
+    /// \return Numerical
+    ///
+    /////////////////////////////////////////////////
+    Numerical NumArray::get(size_t i) const
+    {
+        if (m_storage == STORE_COMPLEX)
+            return Numerical(m_cmplx[i], m_type);
+
+        if (m_storage == STORE_FLOAT)
+            return Numerical(std::complex<double>(m_reals[i]), m_type);
+
+        if (m_type == LOGICAL)
+            return Numerical(m_ints[i] != 0);
+
+        if (m_type <= UI64)
+            return Numerical((uint64_t)m_ints[i], m_type);
+
+        return Numerical(m_ints[i], m_type);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Convert the NumArray back into its
+    /// boxed Array representation.
+    ///
+    /// \return Array
+    ///
+    /////////////////////////////////////////////////
+    Array NumArray::toArray() const
+    {
+        Array ret;
+        ret.reserve(m_size);
+
+        for (size_t i = 0; i < m_size; i++)
+        {
+            ret.emplace_back(get(i));
+        }
+
+        return ret;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief True, if both NumArrays are valid and
+    /// can be combined element-wise, i.e. their
+    /// sizes are equal or one of them is a scalar.
+    ///
+    /// \param a const NumArray&
+    /// \param b const NumArray&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    bool NumArray::isCompatible(const NumArray& a, const NumArray& b)
+    {
+        return a.isValid()
+            && b.isValid()
+            && (a.size() == b.size() || a.size() == 1 || b.size() == 1);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief The typed operands of a binary
+    /// operator. Packed Arrays are referenced
+    /// directly, boxed Arrays are converted into the
+    /// local buffers.
+    /////////////////////////////////////////////////
+    struct NumOperands
+    {
+        NumArray bufA;
+        NumArray bufB;
+        const NumArray* a = nullptr;
+        const NumArray* b = nullptr;
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief Try to get the typed representations
+    /// of both Arrays for using the typed kernels.
+    /// Returns false, if the boxed fallback has to
+    /// be used.
+    ///
+    /// \param a const Array&
+    /// \param b const Array&
+    /// \param num NumOperands&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    static bool toNumArrays(const Array& a, const Array& b, NumOperands& num)
+    {
+        if (std::max(a.size(), b.size()) < NumArray::MIN_SIZE
+            || (a.size() != b.size() && a.size() != 1 && b.size() != 1))
+            return false;
+
+        num.a = &NumArray::view(a, num.bufA);
+
+        if (!num.a->isValid())
+            return false;
+
+        num.b = &NumArray::view(b, num.bufB);
+
+        return NumArray::isCompatible(*num.a, *num.b);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief True, if integer values within the
+    /// passed range keep the passed type when they
+    /// are boxed, i.e. if they can be packed using
+    /// this type.
     ///
-    /// \param fst const Array&
-    /// \param lst const Array&
+    /// \param type NumericalType
+    /// \param minVal int64_t
+    /// \param maxVal int64_t
+    /// \return bool
     ///
     /////////////////////////////////////////////////
-    Array::Array(const Array& fst, const Array& lst) : std::vector<Value>({fst,lst}), m_commonType(TYPE_GENERATOR)
-    { }
+    static bool fitsInto(NumericalType type, int64_t minVal, int64_t maxVal)
+    {
+        if (type == I64)
+            return true;
 
+        // UI64 is not representable by the typed kernels
+        // and logicals are not closed under arithmetics
+        if (type == LOGICAL || type == UI64 || type > I64)
+            return false;
 
-    /////////////////////////////////////////////////
-    /// \brief Make this array a 3-val generator
-    /// array.
-    ///
-    /// \param fst const Array&
-    /// \param inc const Array&
-    /// \param lst const Array&
-    ///
-    /////////////////////////////////////////////////
-    Array::Array(const Array& fst, const Array& inc, const Array& lst) : std::vector<Value>({fst,inc,lst}), m_commonType(TYPE_GENERATOR)
-    { }
+        // Numerical widens unsigned values depending on
+        // the constructor, only the common range is safe
+        int64_t maxRange = (1LL << (TypeInfo(type).m_bits-1)) - 1;
+        int64_t minRange = type < I8 ? 0 : -maxRange-1;
+
+        return minVal >= minRange && maxVal <= maxRange;
+    }
 
 
     /////////////////////////////////////////////////
-    /// \brief Assign an Array.
+    /// \brief Pack integer results using the passed
+    /// type. Results leaving the range of this type
+    /// are boxed, because Numerical widens their
+    /// type individually.
     ///
-    /// \param other const Array&
-    /// \return Array&
+    /// \param vals std::vector<int64_t>&&
+    /// \param type NumericalType
+    /// \return Array
     ///
     /////////////////////////////////////////////////
-    Array& Array::operator=(const Array& other)
+    static Array packInts(std::vector<int64_t>&& vals, NumericalType type)
     {
-        //Timer t("Array::operator=(&)");
-        if (other.size() == 1)
-        {
-            if (other.front().isArray())
-                return operator=(other.front().getArray());
+        if (vals.empty())
+            return Array();
 
-            resize(1);
-            front() = other.front();
-        }
-        else
-        {
-            resize(other.size());
+        auto range = std::minmax_element(vals.begin(), vals.end());
 
-            //#pragma omp parallel for if(size() > 500)
-            for (size_t i = 0; i < size(); i++)
-            {
-                operator[](i) = other[i];
-            }
-        }
+        if (fitsInto(type, *range.first, *range.second))
+            return Array(NumArray(std::move(vals), type));
 
-        m_commonType = other.m_commonType;
+        Array ret;
+        ret.reserve(vals.size());
 
-        return *this;
+        for (int64_t val : vals)
+        {
+            ret.emplace_back(Numerical(val, type));
+        }
+
+        return ret;
     }
 
 
     /////////////////////////////////////////////////
-    /// \brief Move an Array.
+    /// \brief Return the type, which
+    /// Numerical::autoType() selects for a real
+    /// value.
     ///
-    /// \param other Array&&
-    /// \return Array&
+    /// \param val double
+    /// \return NumericalType
     ///
     /////////////////////////////////////////////////
-    /*Array& Array::operator=(Array&& other)
+    static NumericalType autoTypeOf(double val)
     {
-       // Timer t("Array::operator=(&&)");
+        if (std::rint(val) != val)
+            return F64;
 
-        _M_impl._M_start = other._M_impl._M_start;
-        _M_impl._M_finish = other._M_impl._M_finish;
-        _M_impl._M_end_of_storage = other._M_impl._M_end_of_storage;
-        m_commonType = other.m_commonType;
+        if (val >= INT8_MIN && val <= INT8_MAX)
+            return I8;
 
-        other._M_impl._M_start = other._M_impl._M_finish = other._M_impl._M_end_of_storage = pointer();
+        if (val >= INT16_MIN && val <= INT16_MAX)
+            return I16;
 
-        return *this;
-    }*/
+        if (val >= INT32_MIN && val <= INT32_MAX)
+            return I32;
+
+        return I64;
+    }
 
 
     /////////////////////////////////////////////////
-    /// \brief Get the (general) data types of every
-    /// contained Value.
+    /// \brief Pack real results, which are typed by
+    /// Numerical::autoType(). This is only possible,
+    /// if all values select the same type, otherwise
+    /// they are boxed individually.
     ///
-    /// \return std::vector<DataType>
+    /// \param vals std::vector<double>&&
+    /// \return Array
     ///
     /////////////////////////////////////////////////
-    std::vector<DataType> Array::getType() const
+    static Array packAutoTyped(std::vector<double>&& vals)
     {
-        std::vector<DataType> types;
+        if (vals.empty())
+            return Array();
 
-        for (size_t i = 0; i < size(); i++)
+        NumericalType type = autoTypeOf(vals.front());
+
+        for (double val : vals)
         {
-            types.push_back(operator[](i).getType());
+            if (autoTypeOf(val) != type)
+            {
+                Array ret;
+                ret.reserve(vals.size());
 
-            if (m_commonType == TYPE_VOID)
-                m_commonType = types.back();
+                for (double v : vals)
+                {
+                    ret.emplace_back(Numerical::autoType(v));
+                }
 
-            if (m_commonType != types.back())
-                m_commonType = TYPE_MIXED;
+                return ret;
+            }
         }
 
-        return types;
+        if (type == F64)
+            return Array(NumArray(std::move(vals), F64));
+
+        return Array(NumArray(std::vector<int64_t>(vals.begin(), vals.end()), type));
     }
 
 
     /////////////////////////////////////////////////
-    /// \brief Get the common (general) data type
-    /// representing all contained Values best.
+    /// \brief Typed kernel for the element-wise
+    /// arithmetic operators +, - and *. Follows the
+    /// type promotion of Numerical.
     ///
-    /// \return DataType
+    /// \param a const NumArray&
+    /// \param b const NumArray&
+    /// \param op Op
+    /// \return Array
     ///
     /////////////////////////////////////////////////
-    DataType Array::getCommonType() const
+    template <class Op>
+    static Array numArithmetic(const NumArray& a, const NumArray& b, Op op)
     {
-        if (m_commonType == TYPE_VOID && size())
-            getType();
+        size_t elems = std::max(a.size(), b.size());
+        size_t sa = a.size() > 1;
+        size_t sb = b.size() > 1;
+        NumericalType promotion = TypeInfo(a.getType()).getPromotedType(TypeInfo(b.getType()));
 
-        return m_commonType;
+        if (promotion <= I64)
+        {
+            const int64_t* pa = a.ints();
+            const int64_t* pb = b.ints();
+            std::vector<int64_t> res(elems);
+
+            for (size_t i = 0; i < elems; i++)
+            {
+                res[i] = op(pa[i*sa], pb[i*sb]);
+            }
+
+            return packInts(std::move(res), promotion);
+        }
+        else if (promotion < CF32)
+        {
+            std::vector<double> bufA;
+            std::vector<double> bufB;
+            const double* pa = a.asReals(bufA);
+            const double* pb = b.asReals(bufB);
+            std::vector<double> res(elems);
+
+            for (size_t i = 0; i < elems; i++)
+            {
+                res[i] = op(pa[i*sa], pb[i*sb]);
+            }
+
+            return Array(NumArray(std::move(res), promotion));
+        }
+
+        Array ret;
+        ret.reserve(elems);
+
+        for (size_t i = 0; i < elems; i++)
+        {
+            ret.emplace_back(op(a.get(i*sa), b.get(i*sb)));
+        }
+
+        return ret;
     }
 
 
     /////////////////////////////////////////////////
-    /// \brief Get the common (general) data type
-    /// representing all contained Values best as a
-    /// printable std::string.
+    /// \brief Typed kernel for the element-wise
+    /// division.
     ///
-    /// \return std::string
+    /// \param a const NumArray&
+    /// \param b const NumArray&
+    /// \return Array
     ///
     /////////////////////////////////////////////////
-    std::string Array::getCommonTypeAsString() const
+    static Array numDivide(const NumArray& a, const NumArray& b)
     {
-        switch (getCommonType())
+        size_t elems = std::max(a.size(), b.size());
+        size_t sa = a.size() > 1;
+        size_t sb = b.size() > 1;
+
+        Array ret;
+
+        if (a.getStorage() != NumArray::STORE_COMPLEX && b.getStorage() != NumArray::STORE_COMPLEX)
         {
-            case TYPE_CATEGORY:
-                return "category";
-            case TYPE_NUMERICAL:
+            std::vector<double> bufA;
+            std::vector<double> bufB;
+            const double* pa = a.asReals(bufA);
+            const double* pb = b.asReals(bufB);
+            std::vector<double> res(elems);
+
+            for (size_t i = 0; i < elems; i++)
             {
-                TypeInfo info = front().getNum().getInfo();
+                res[i] = pa[i*sa] / pb[i*sb];
+            }
 
-                for (size_t i = 1; i < size(); i++)
-                {
-                    info.promote(operator[](i).getNum().getInfo());
-                }
+            // The imaginary part mirrors the complex division
+            // within Numerical, i.e. x/0 results in a complex NaN
+            if (std::none_of(pb, pb + b.size(), [](double v){return v == 0.0 || std::isnan(v);}))
+                return packAutoTyped(std::move(res));
 
-                return info.printType();
+            ret.reserve(elems);
+
+            for (size_t i = 0; i < elems; i++)
+            {
+                ret.emplace_back(Numerical::autoType(std::complex<double>(res[i], 0.0 / pb[i*sb])));
+            }
+        }
+        else
+        {
+            ret.reserve(elems);
+
+            for (size_t i = 0; i < elems; i++)
+            {
+                ret.emplace_back(a.get(i*sa) / b.get(i*sb));
             }
-            case TYPE_STRING:
-                return "string";
-            case TYPE_MIXED:
-                return "cluster";
         }
 
-        return "void";
+        return ret;
     }
 
 
     /////////////////////////////////////////////////
-    /// \brief Get the common (promoted)
-    /// NumericalType of all contained Values
-    /// assuming that all Values are Numericals.
+    /// \brief Typed kernel for the element-wise
+    /// comparison operators. The passed functor
+    /// combines the results of the less-than and the
+    /// equal comparison into the final result to
+    /// keep the semantics of Numerical.
     ///
-    /// \return NumericalType
+    /// \param a const NumArray&
+    /// \param b const NumArray&
+    /// \param cmp Cmp
+    /// \return Array
     ///
     /////////////////////////////////////////////////
-    NumericalType Array::getCommonNumericalType() const
+    template <class Cmp>
+    static Array numCompare(const NumArray& a, const NumArray& b, Cmp cmp)
     {
-        TypeInfo info = front().getNum().getInfo();
+        size_t elems = std::max(a.size(), b.size());
+        size_t sa = a.size() > 1;
+        size_t sb = b.size() > 1;
+        NumericalType promotion = TypeInfo(a.getType()).getPromotedType(TypeInfo(b.getType()));
+        std::vector<int64_t> res(elems);
 
-        for (size_t i = 1; i < size(); i++)
+        if (promotion <= I64)
         {
-            info.promote(operator[](i).getNum().getInfo());
+            const int64_t* pa = a.ints();
+            const int64_t* pb = b.ints();
+
+            for (size_t i = 0; i < elems; i++)
+            {
+                res[i] = cmp(pa[i*sa] < pb[i*sb], pa[i*sa] == pb[i*sb]);
+            }
         }
+        else if (promotion < CF32)
+        {
+            std::vector<double> bufA;
+            std::vector<double> bufB;
+            const double* pa = a.asReals(bufA);
+            const double* pb = b.asReals(bufB);
 
-        return info.asType();
+            for (size_t i = 0; i < elems; i++)
+            {
+                res[i] = cmp(pa[i*sa] < pb[i*sb], pa[i*sa] == pb[i*sb]);
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < elems; i++)
+            {
+                Numerical x = a.get(i*sa);
+                Numerical y = b.get(i*sb);
+                res[i] = cmp(x < y, x == y);
+            }
+        }
+
+        return Array(NumArray(std::move(res), LOGICAL));
     }
 
 
     /////////////////////////////////////////////////
-    /// \brief True, if only a single value is
-    /// contained within this Array.
+    /// \brief Typed kernel for the element-wise
+    /// power function.
     ///
-    /// \return bool
+    /// \param a const NumArray&
+    /// \param b const NumArray&
+    /// \return Array
     ///
     /////////////////////////////////////////////////
-    bool Array::isScalar() const
+    static Array numPow(const NumArray& a, const NumArray& b)
     {
-        return size() == 1u;
+        size_t elems = std::max(a.size(), b.size());
+        size_t sa = a.size() > 1;
+        size_t sb = b.size() > 1;
+
+        if (a.getStorage() != NumArray::STORE_COMPLEX && b.getStorage() == NumArray::STORE_INT)
+        {
+            std::vector<double> bufA;
+            const double* pa = a.asReals(bufA);
+            const int64_t* pb = b.ints();
+            std::vector<double> res(elems);
+
+            for (size_t i = 0; i < elems; i++)
+            {
+                res[i] = intPower(pa[i*sa], pb[i*sb]);
+            }
+
+            return packAutoTyped(std::move(res));
+        }
+
+        Array ret;
+        ret.reserve(elems);
+
+        for (size_t i = 0; i < elems; i++)
+        {
+            ret.emplace_back(a.get(i*sa).pow(b.get(i*sb)));
+        }
+
+        return ret;
     }
 
 
     /////////////////////////////////////////////////
-    /// \brief True, if this Array represents a
-    /// default value (an empty array in this
-    /// implementation).
+    /// \brief Typed kernel for the compound
+    /// assignments +=, -= and *=. Numerical does not
+    /// widen the type of in-place results, therefore
+    /// the typed result is only used, if it could be
+    /// packed with the promoted type. Returns false,
+    /// if the boxed in-place loop has to be used.
     ///
+    /// \param arr Array&
+    /// \param other const Array&
+    /// \param op Op
     /// \return bool
     ///
     /////////////////////////////////////////////////
-    bool Array::isDefault() const
+    template <class Op>
+    static bool numAssign(Array& arr, const Array& other, Op op)
     {
-        return !size();
+        // Avoid creating the operands for the frequent
+        // scalar case
+        if (arr.size() < NumArray::MIN_SIZE)
+            return false;
+
+        NumOperands num;
+
+        if (!toNumArrays(arr, other, num))
+            return false;
+
+        Array ret = numArithmetic(*num.a, *num.b, op);
+
+        if (!ret.isPacked())
+            return false;
+
+        arr = std::move(ret);
+        return true;
     }
 
 
@@ -1715,7 +2610,13 @@ namespace mu
     /////////////////////////////////////////////////
     Array Array::operator+(const Array& other) const
     {
+        NumOperands num;
+
+        if (toNumArrays(*this, other, num))
+            return numArithmetic(*num.a, *num.b, std::plus<>());
+
         Array ret;
+        ret.reserve(std::max(size(), other.size()));
 
         for (size_t i = 0; i < std::max(size(), other.size()); i++)
         {
@@ -1734,7 +2635,39 @@ namespace mu
     /////////////////////////////////////////////////
     Array Array::operator-() const
     {
+        if (size() >= NumArray::MIN_SIZE)
+        {
+            NumArray buffer;
+            const NumArray& numThis = NumArray::view(*this, buffer);
+
+            if (numThis.getStorage() == NumArray::STORE_FLOAT)
+            {
+                const double* vals = numThis.reals();
+                std::vector<double> res(numThis.size());
+
+                for (size_t i = 0; i < res.size(); i++)
+                {
+                    res[i] = -vals[i];
+                }
+
+                return Array(NumArray(std::move(res), numThis.getType()));
+            }
+            else if (numThis.getStorage() == NumArray::STORE_INT)
+            {
+                const int64_t* vals = numThis.ints();
+                std::vector<int64_t> res(numThis.size());
+
+                for (size_t i = 0; i < res.size(); i++)
+                {
+                    res[i] = -vals[i];
+                }
+
+                return packInts(std::move(res), numThis.getType());
+            }
+        }
+
         Array ret;
+        ret.reserve(size());
 
         for (size_t i = 0; i < size(); i++)
         {
@@ -1754,7 +2687,13 @@ namespace mu
     /////////////////////////////////////////////////
     Array Array::operator-(const Array& other) const
     {
+        NumOperands num;
+
+        if (toNumArrays(*this, other, num))
+            return numArithmetic(*num.a, *num.b, std::minus<>());
+
         Array ret;
+        ret.reserve(std::max(size(), other.size()));
 
         for (size_t i = 0; i < std::max(size(), other.size()); i++)
         {
@@ -1774,7 +2713,13 @@ namespace mu
     /////////////////////////////////////////////////
     Array Array::operator/(const Array& other) const
     {
+        NumOperands num;
+
+        if (toNumArrays(*this, other, num))
+            return numDivide(*num.a, *num.b);
+
         Array ret;
+        ret.reserve(std::max(size(), other.size()));
 
         for (size_t i = 0; i < std::max(size(), other.size()); i++)
         {
@@ -1794,7 +2739,13 @@ namespace mu
     /////////////////////////////////////////////////
     Array Array::operator*(const Array& other) const
     {
+        NumOperands num;
+
+        if (toNumArrays(*this, other, num))
+            return numArithmetic(*num.a, *num.b, std::multiplies<>());
+
         Array ret;
+        ret.reserve(std::max(size(), other.size()));
 
         for (size_t i = 0; i < std::max(size(), other.size()); i++)
         {
@@ -1816,7 +2767,7 @@ namespace mu
     {
         if (size() < other.size())
             operator=(operator+(other));
-        else
+        else if (!numAssign(*this, other, std::plus<>()))
         {
             for (size_t i = 0; i < size(); i++)
             {
@@ -1839,7 +2790,7 @@ namespace mu
     {
         if (size() < other.size())
             operator=(operator-(other));
-        else
+        else if (!numAssign(*this, other, std::minus<>()))
         {
             for (size_t i = 0; i < size(); i++)
             {
@@ -1860,7 +2811,9 @@ namespace mu
     /////////////////////////////////////////////////
     Array& Array::operator/=(const Array& other)
     {
-        if (size() < other.size())
+        // The in-place division equals the division
+        // operator, i.e. packed Arrays stay packed
+        if (size() < other.size() || isPacked() || other.isPacked())
             operator=(operator/(other));
         else
         {
@@ -1885,7 +2838,7 @@ namespace mu
     {
         if (size() < other.size())
             operator=(operator*(other));
-        else
+        else if (!numAssign(*this, other, std::multiplies<>()))
         {
             for (size_t i = 0; i < size(); i++)
             {
@@ -1906,7 +2859,13 @@ namespace mu
     /////////////////////////////////////////////////
     Array Array::pow(const Array& exponent) const
     {
+        NumOperands num;
+
+        if (toNumArrays(*this, exponent, num))
+            return numPow(*num.a, *num.b);
+
         Array ret;
+        ret.reserve(std::max(size(), exponent.size()));
 
         for (size_t i = 0; i < std::max(size(), exponent.size()); i++)
         {
@@ -1926,7 +2885,29 @@ namespace mu
     /////////////////////////////////////////////////
     Array Array::pow(const Numerical& exponent) const
     {
+        if (size() >= NumArray::MIN_SIZE && exponent.getInfo().m_flags & TypeInfo::TYPE_INT)
+        {
+            NumArray numBuffer;
+            const NumArray& numThis = NumArray::view(*this, numBuffer);
+
+            if (numThis.isValid() && numThis.getStorage() != NumArray::STORE_COMPLEX)
+            {
+                std::vector<double> buffer;
+                const double* vals = numThis.asReals(buffer);
+                int64_t n = exponent.asI64();
+                std::vector<double> res(numThis.size());
+
+                for (size_t i = 0; i < res.size(); i++)
+                {
+                    res[i] = intPower(vals[i], n);
+                }
+
+                return packAutoTyped(std::move(res));
+            }
+        }
+
         Array ret;
+        ret.reserve(size());
 
         for (size_t i = 0; i < size(); i++)
         {
@@ -1946,6 +2927,7 @@ namespace mu
     Array Array::operator!() const
     {
         Array ret;
+        ret.reserve(size());
 
         for (size_t i = 0; i < size(); i++)
         {
@@ -1965,7 +2947,13 @@ namespace mu
     /////////////////////////////////////////////////
     Array Array::operator==(const Array& other) const
     {
+        NumOperands num;
+
+        if (toNumArrays(*this, other, num))
+            return numCompare(*num.a, *num.b, [](bool, bool eq){return eq;});
+
         Array ret;
+        ret.reserve(std::max(size(), other.size()));
 
         for (size_t i = 0; i < std::max(size(), other.size()); i++)
         {
@@ -1985,7 +2973,13 @@ namespace mu
     /////////////////////////////////////////////////
     Array Array::operator!=(const Array& other) const
     {
+        NumOperands num;
+
+        if (toNumArrays(*this, other, num))
+            return numCompare(*num.a, *num.b, [](bool, bool eq){return !eq;});
+
         Array ret;
+        ret.reserve(std::max(size(), other.size()));
 
         for (size_t i = 0; i < std::max(size(), other.size()); i++)
         {
@@ -2005,7 +2999,13 @@ namespace mu
     /////////////////////////////////////////////////
     Array Array::operator<(const Array& other) const
     {
+        NumOperands num;
+
+        if (toNumArrays(*this, other, num))
+            return numCompare(*num.a, *num.b, [](bool lt, bool){return lt;});
+
         Array ret;
+        ret.reserve(std::max(size(), other.size()));
 
         for (size_t i = 0; i < std::max(size(), other.size()); i++)
         {
@@ -2025,7 +3025,13 @@ namespace mu
     /////////////////////////////////////////////////
     Array Array::operator<=(const Array& other) const
     {
+        NumOperands num;
+
+        if (toNumArrays(*this, other, num))
+            return numCompare(*num.a, *num.b, [](bool lt, bool eq){return lt || eq;});
+
         Array ret;
+        ret.reserve(std::max(size(), other.size()));
 
         for (size_t i = 0; i < std::max(size(), other.size()); i++)
         {
@@ -2045,7 +3051,13 @@ namespace mu
     /////////////////////////////////////////////////
     Array Array::operator>(const Array& other) const
     {
+        NumOperands num;
+
+        if (toNumArrays(*this, other, num))
+            return numCompare(*num.a, *num.b, [](bool lt, bool eq){return !(lt || eq);});
+
         Array ret;
+        ret.reserve(std::max(size(), other.size()));
 
         for (size_t i = 0; i < std::max(size(), other.size()); i++)
         {
@@ -2065,7 +3077,13 @@ namespace mu
     /////////////////////////////////////////////////
     Array Array::operator>=(const Array& other) const
     {
+        NumOperands num;
+
+        if (toNumArrays(*this, other, num))
+            return numCompare(*num.a, *num.b, [](bool lt, bool eq){return !lt || eq;});
+
         Array ret;
+        ret.reserve(std::max(size(), other.size()));
 
         for (size_t i = 0; i < std::max(size(), other.size()); i++)
         {
@@ -2086,6 +3104,7 @@ namespace mu
     Array Array::operator&&(const Array& other) const
     {
         Array ret;
+        ret.reserve(std::max(size(), other.size()));
 
         for (size_t i = 0; i < std::max(size(), other.size()); i++)
         {
@@ -2106,6 +3125,7 @@ namespace mu
     Array Array::operator||(const Array& other) const
     {
         Array ret;
+        ret.reserve(std::max(size(), other.size()));
 
         for (size_t i = 0; i < std::max(size(), other.size()); i++)
         {
@@ -2481,12 +3501,16 @@ namespace mu
     /////////////////////////////////////////////////
     Value& Array::get(size_t i)
     {
-        if (size() == 1u)
-            return front();
-        else if (size() <= i)
+        // Unpack only once for this hot path
+        unpack();
+        std::vector<Value>& vals = *this;
+
+        if (vals.size() == 1u)
+            return vals.front();
+        else if (vals.size() <= i)
             throw std::length_error("Element " + ::toString(i) + " is out of bounds.");
 
-        return operator[](i);
+        return vals[i];
     }
 
 
@@ -2499,12 +3523,16 @@ namespace mu
     /////////////////////////////////////////////////
     const Value& Array::get(size_t i) const
     {
-        if (size() == 1u)
-            return front();
-        else if (size() <= i)
+        // Unpack only once for this hot path
+        unpack();
+        const std::vector<Value>& vals = *this;
+
+        if (vals.size() == 1u)
+            return vals.front();
+        else if (vals.size() <= i)
             return m_default;
 
-        return operator[](i);
+        return vals[i];
     }
 
 
@@ -3068,7 +4096,12 @@ namespace mu
     /////////////////////////////////////////////////
     Array operator+(const Array& arr, const Value& v)
     {
+        // Use the typed kernels of the Array operators
+        if (arr.size() >= NumArray::MIN_SIZE && v.getType() == TYPE_NUMERICAL)
+            return arr + Array(v);
+
         Array ret;
+        ret.reserve(arr.size());
 
         for (const auto& a : arr)
         {
@@ -3089,7 +4122,12 @@ namespace mu
     /////////////////////////////////////////////////
     Array operator-(const Array& arr, const Value& v)
     {
+        // Use the typed kernels of the Array operators
+        if (arr.size() >= NumArray::MIN_SIZE && v.getType() == TYPE_NUMERICAL)
+            return arr - Array(v);
+
         Array ret;
+        ret.reserve(arr.size());
 
         for (const auto& a : arr)
         {
@@ -3110,7 +4148,12 @@ namespace mu
     /////////////////////////////////////////////////
     Array operator*(const Array& arr, const Value& v)
     {
+        // Use the typed kernels of the Array operators
+        if (arr.size() >= NumArray::MIN_SIZE && v.getType() == TYPE_NUMERICAL)
+            return arr * Array(v);
+
         Array ret;
+        ret.reserve(arr.size());
 
         for (const auto& a : arr)
         {
@@ -3131,7 +4174,12 @@ namespace mu
     /////////////////////////////////////////////////
     Array operator/(const Array& arr, const Value& v)
     {
+        // Use the typed kernels of the Array operators
+        if (arr.size() >= NumArray::MIN_SIZE && v.getType() == TYPE_NUMERICAL)
+            return arr / Array(v);
+
         Array ret;
+        ret.reserve(arr.size());
 
         for (const auto& a : arr)
         {
@@ -3152,7 +4200,12 @@ namespace mu
     /////////////////////////////////////////////////
     Array operator+(const Value& v, const Array& arr)
     {
+        // Use the typed kernels of the Array operators
+        if (arr.size() >= NumArray::MIN_SIZE && v.getType() == TYPE_NUMERICAL)
+            return Array(v) + arr;
+
         Array ret;
+        ret.reserve(arr.size());
 
         for (const auto& a : arr)
         {
@@ -3173,7 +4226,12 @@ namespace mu
     /////////////////////////////////////////////////
     Array operator-(const Value& v, const Array& arr)
     {
+        // Use the typed kernels of the Array operators
+        if (arr.size() >= NumArray::MIN_SIZE && v.getType() == TYPE_NUMERICAL)
+            return Array(v) - arr;
+
         Array ret;
+        ret.reserve(arr.size());
 
         for (const auto& a : arr)
         {
@@ -3208,7 +4266,12 @@ namespace mu
     /////////////////////////////////////////////////
     Array operator/(const Value& v, const Array& arr)
     {
+        // Use the typed kernels of the Array operators
+        if (arr.size() >= NumArray::MIN_SIZE && v.getType() == TYPE_NUMERICAL)
+            return Array(v) / arr;
+
         Array ret;
+        ret.reserve(arr.size());
 
         for (const auto& a : arr)
         {
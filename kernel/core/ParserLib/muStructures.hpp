@@ -20,6 +20,8 @@
 #define MUSTRUCTURES_HPP
 
 #include <vector>
+#include <memory>
+#include <atomic>
 
 #include "muTypes.hpp"
 #include "muApply.hpp"
@@ -29,6 +31,7 @@ namespace mu
     // Forward declaration of the Variable class
     class Variable;
     class Array;
+    class NumArray;
 
 
     /////////////////////////////////////////////////
@@ -37,13 +40,18 @@ namespace mu
     /// value (or any other value, which will be
     /// added to this implementation in the future,
     /// e.g. classes).
+    ///
+    /// \remark Numericals and strings are stored
+    /// inline (strings make use of the small string
+    /// optimisation of std::string), categories and
+    /// nested arrays are allocated on the heap.
     /////////////////////////////////////////////////
     class Value
     {
         public:
             Value();
             Value(const Value& data);
-            //Value(Value&& data);
+            Value(Value&& data) noexcept;
 
             Value(const Numerical& data);
             Value(const Category& data);
@@ -58,12 +66,13 @@ namespace mu
             Value(const std::complex<float>& value);
             Value(const std::complex<double>& value, bool autoType = true);
             Value(const std::string& sData);
+            Value(std::string&& sData);
             Value(const char* sData);
 
-            virtual ~Value();
+            ~Value();
 
             Value& operator=(const Value& other);
-            //Value& operator=(Value&& other);
+            Value& operator=(Value&& other) noexcept;
 
             DataType getType() const;
             std::string getTypeAsString() const;
@@ -120,12 +129,20 @@ namespace mu
             size_t getBytes() const;
 
         protected:
-            void* m_data;
+            union
+            {
+                Numerical m_num;
+                std::string m_str;
+                void* m_data;
+            };
+
             DataType m_type;
             static const std::string m_defString;
             static const Numerical m_defVal;
 
             DataType detectCommonType(const Value& other) const;
+
+            friend class NumArray;
     };
 
 
@@ -136,13 +153,20 @@ namespace mu
     /// std::vector with mu::Value as underlying
     /// template parameter and a bunch of customized
     /// operators.
+    ///
+    /// \remark Larger homogeneous numerical Arrays
+    /// are processed as NumArray instances within
+    /// the element-wise operators. Their results are
+    /// kept packed, i.e. the typed NumArray is the
+    /// storage of the Array and the boxed Values are
+    /// only created once they are accessed.
     /////////////////////////////////////////////////
-    class Array : public std::vector<Value> // Potential: have dedicated NumArray and StrArray variants or convert Value in an abstract class
+    class Array : public std::vector<Value> // Potential: have a dedicated StrArray variant or convert Value in an abstract class
     {
         public:
             Array();
             Array(const Array& other);
-            //Array(Array&& other) = default;
+            Array(Array&& other) noexcept;
 
             Array(size_t n, const Value& fillVal = Value());
             Array(const Value& singleton);
@@ -155,9 +179,60 @@ namespace mu
             Array(const std::vector<std::string>& other);
             Array(const Array& fst, const Array& lst);
             Array(const Array& fst, const Array& inc, const Array& lst);
+            explicit Array(NumArray&& packed);
 
             Array& operator=(const Array& other);
-            //Array& operator=(Array&& other);
+            Array& operator=(Array&& other) noexcept;
+
+            // The element access of std::vector is hidden,
+            // because packed Arrays have to be unpacked first
+            size_t size() const;
+            bool empty() const;
+            size_t capacity() const;
+
+            Value& operator[](size_t i);
+            const Value& operator[](size_t i) const;
+            Value& at(size_t i);
+            const Value& at(size_t i) const;
+            Value& front();
+            const Value& front() const;
+            Value& back();
+            const Value& back() const;
+            Value* data();
+            const Value* data() const;
+
+            iterator begin();
+            const_iterator begin() const;
+            iterator end();
+            const_iterator end() const;
+            const_iterator cbegin() const;
+            const_iterator cend() const;
+            reverse_iterator rbegin();
+            const_reverse_iterator rbegin() const;
+            reverse_iterator rend();
+            const_reverse_iterator rend() const;
+
+            void push_back(const Value& val);
+            void push_back(Value&& val);
+            template <class... Args>
+            Value& emplace_back(Args&&... args);
+            template <class... Args>
+            iterator insert(Args&&... args);
+            template <class... Args>
+            iterator erase(Args&&... args);
+            template <class... Args>
+            void assign(Args&&... args);
+            void pop_back();
+            void resize(size_t n);
+            void resize(size_t n, const Value& fillVal);
+            void reserve(size_t n);
+            void shrink_to_fit();
+            void clear();
+            void swap(Array& other);
+
+            bool isPacked() const;
+            void unpack() const;
+            void unpack();
 
             std::vector<DataType> getType() const;
             DataType getCommonType() const;
@@ -214,11 +289,383 @@ namespace mu
             bool isCommutative() const;
 
         protected:
+            enum PackState
+            {
+                BOXED,
+                PACKED,
+                PACKED_AND_BOXED
+            };
+
             mutable DataType m_commonType;
+            std::shared_ptr<const NumArray> m_packed;
+            mutable std::atomic<uint8_t> m_packState;
             static const Value m_default;
+
+            void sharePacked(const Array& other);
+            void dropPacked();
+            void boxPacked(bool keepPacked) const;
+
+            friend class NumArray;
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief This class is a typed and contiguous
+    /// representation of a homogeneous numerical
+    /// Array, i.e. an Array, where all Values share
+    /// the same NumericalType. The values are stored
+    /// unboxed as int64_t, double or
+    /// std::complex<double> depending on the type,
+    /// so that element-wise operations may run as
+    /// tight loops over the raw buffers.
+    ///
+    /// \remark Mixed, string, categorical,
+    /// clustered or UI64 Arrays are not represented
+    /// by this class, isValid() returns false in
+    /// these cases and the caller has to fall back
+    /// to the boxed algorithms.
+    /////////////////////////////////////////////////
+    class NumArray
+    {
+        public:
+            enum StorageType
+            {
+                STORE_NONE,
+                STORE_INT,
+                STORE_FLOAT,
+                STORE_COMPLEX
+            };
+
+            // Minimal number of elements, for which the typed
+            // kernels are faster than the boxed loops
+            static const size_t MIN_SIZE = 16;
+
+            NumArray();
+            NumArray(const Array& arr);
+            NumArray(std::vector<int64_t>&& vals, NumericalType type);
+            NumArray(std::vector<double>&& vals, NumericalType type);
+
+            bool isValid() const;
+            size_t size() const;
+            NumericalType getType() const;
+            StorageType getStorage() const;
+
+            const int64_t* ints() const;
+            const double* reals() const;
+            const std::complex<double>* cmplx() const;
+            const double* asReals(std::vector<double>& buffer) const;
+
+            Numerical get(size_t i) const;
+            Array toArray() const;
+
+            static const NumArray& view(const Array& arr, NumArray& buffer);
+            static bool isCompatible(const NumArray& a, const NumArray& b);
+            static bool gatherReals(const Array& arr, size_t pos, size_t n, double* buffer);
+
+        private:
+            std::vector<int64_t> m_ints;
+            std::vector<double> m_reals;
+            std::vector<std::complex<double>> m_cmplx;
+            NumericalType m_type;
+            StorageType m_storage;
+            size_t m_size;
     };
 
 
+    /////////////////////////////////////////////////
+    /// \brief True, if the values of this Array are
+    /// (also) available as a typed NumArray.
+    ///
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    inline bool Array::isPacked() const
+    {
+        return m_packState.load(std::memory_order_acquire) != BOXED;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Create the boxed Values of a packed
+    /// Array. The typed NumArray is kept, because
+    /// the values cannot change through const
+    /// accesses.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    inline void Array::unpack() const
+    {
+        if (m_packState.load(std::memory_order_acquire) == PACKED)
+            boxPacked(true);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Create the boxed Values of a packed
+    /// Array before they may be modified, which
+    /// invalidates the typed NumArray.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    inline void Array::unpack()
+    {
+        if (m_packState.load(std::memory_order_acquire) != BOXED)
+            boxPacked(false);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Replacements for the std::vector
+    /// interface. Sizes are answered from the packed
+    /// storage, every element access unpacks a
+    /// packed Array first and every structural
+    /// modification releases the packed storage.
+    /////////////////////////////////////////////////
+    inline size_t Array::size() const
+    {
+        if (m_packState.load(std::memory_order_acquire) == PACKED)
+            return m_packed->size();
+
+        return std::vector<Value>::size();
+    }
+
+    inline bool Array::empty() const
+    {
+        return !size();
+    }
+
+    inline size_t Array::capacity() const
+    {
+        unpack();
+        return std::vector<Value>::capacity();
+    }
+
+    inline Value& Array::operator[](size_t i)
+    {
+        unpack();
+        return std::vector<Value>::operator[](i);
+    }
+
+    inline const Value& Array::operator[](size_t i) const
+    {
+        unpack();
+        return std::vector<Value>::operator[](i);
+    }
+
+    inline Value& Array::at(size_t i)
+    {
+        unpack();
+        return std::vector<Value>::at(i);
+    }
+
+    inline const Value& Array::at(size_t i) const
+    {
+        unpack();
+        return std::vector<Value>::at(i);
+    }
+
+    inline Value& Array::front()
+    {
+        unpack();
+        return std::vector<Value>::front();
+    }
+
+    inline const Value& Array::front() const
+    {
+        unpack();
+        return std::vector<Value>::front();
+    }
+
+    inline Value& Array::back()
+    {
+        unpack();
+        return std::vector<Value>::back();
+    }
+
+    inline const Value& Array::back() const
+    {
+        unpack();
+        return std::vector<Value>::back();
+    }
+
+    inline Value* Array::data()
+    {
+        unpack();
+        return std::vector<Value>::data();
+    }
+
+    inline const Value* Array::data() const
+    {
+        unpack();
+        return std::vector<Value>::data();
+    }
+
+    inline Array::iterator Array::begin()
+    {
+        unpack();
+        return std::vector<Value>::begin();
+    }
+
+    inline Array::const_iterator Array::begin() const
+    {
+        unpack();
+        return std::vector<Value>::begin();
+    }
+
+    inline Array::iterator Array::end()
+    {
+        unpack();
+        return std::vector<Value>::end();
+    }
+
+    inline Array::const_iterator Array::end() const
+    {
+        unpack();
+        return std::vector<Value>::end();
+    }
+
+    inline Array::const_iterator Array::cbegin() const
+    {
+        return begin();
+    }
+
+    inline Array::const_iterator Array::cend() const
+    {
+        return end();
+    }
+
+    inline Array::reverse_iterator Array::rbegin()
+    {
+        unpack();
+        return std::vector<Value>::rbegin();
+    }
+
+    inline Array::const_reverse_iterator Array::rbegin() const
+    {
+        unpack();
+        return std::vector<Value>::rbegin();
+    }
+
+    inline Array::reverse_iterator Array::rend()
+    {
+        unpack();
+        return std::vector<Value>::rend();
+    }
+
+    inline Array::const_reverse_iterator Array::rend() const
+    {
+        unpack();
+        return std::vector<Value>::rend();
+    }
+
+    inline void Array::push_back(const Value& val)
+    {
+        dropPacked();
+        std::vector<Value>::push_back(val);
+    }
+
+    inline void Array::push_back(Value&& val)
+    {
+        dropPacked();
+        std::vector<Value>::push_back(std::move(val));
+    }
+
+    template <class... Args>
+    inline Value& Array::emplace_back(Args&&... args)
+    {
+        dropPacked();
+        return std::vector<Value>::emplace_back(std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    inline Array::iterator Array::insert(Args&&... args)
+    {
+        dropPacked();
+        return std::vector<Value>::insert(std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    inline Array::iterator Array::erase(Args&&... args)
+    {
+        dropPacked();
+        return std::vector<Value>::erase(std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    inline void Array::assign(Args&&... args)
+    {
+        dropPacked();
+        std::vector<Value>::assign(std::forward<Args>(args)...);
+    }
+
+    inline void Array::pop_back()
+    {
+        dropPacked();
+        std::vector<Value>::pop_back();
+    }
+
+    inline void Array::resize(size_t n)
+    {
+        dropPacked();
+        std::vector<Value>::resize(n);
+    }
+
+    inline void Array::resize(size_t n, const Value& fillVal)
+    {
+        dropPacked();
+        std::vector<Value>::resize(n, fillVal);
+    }
+
+    inline void Array::reserve(size_t n)
+    {
+        dropPacked();
+        std::vector<Value>::reserve(n);
+    }
+
+    inline void Array::shrink_to_fit()
+    {
+        dropPacked();
+        std::vector<Value>::shrink_to_fit();
+    }
+
+    inline void Array::clear()
+    {
+        m_packed.reset();
+        m_packState.store(BOXED, std::memory_order_release);
+        std::vector<Value>::clear();
+    }
+
+    inline void Array::swap(Array& other)
+    {
+        uint8_t state = m_packState.load(std::memory_order_acquire);
+        m_packState.store(other.m_packState.load(std::memory_order_acquire), std::memory_order_release);
+        other.m_packState.store(state, std::memory_order_release);
+        m_packed.swap(other.m_packed);
+        std::vector<Value>::swap(other);
+        std::swap(m_commonType, other.m_commonType);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Unpack the Array and release the
+    /// packed storage before the structure of the
+    /// Array is modified.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    inline void Array::dropPacked()
+    {
+        if (m_packed)
+        {
+            unpack();
+            m_packed.reset();
+        }
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief This class represents a variable which
     /// is an extension to mu::Array, where
@@ -0,0 +1,686 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2024  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <omp.h>
+#include "muParser.h"
+#include "muParserTemplateMagic.h"
+#include "../ui/language.hpp"
+#include "../structures.hpp"
+#include "../maths/functionimplementation.hpp"
+#include "../strings/functionimplementation.hpp"
+
+#define BENCH_FORMAT_VERSION 2
+#define BENCH_REPETITIONS 5
+#define BENCH_VECTOR_SIZE 100000
+#define BENCH_LOOP_LENGTH 1000
+
+Language _lang;
+
+
+/////////////////////////////////////////////////
+/// \brief Counts all heap allocations of the
+/// benchmark to be able to compare the
+/// allocation behaviour of the mu::Value and
+/// mu::Array implementations between builds.
+/////////////////////////////////////////////////
+static std::atomic<size_t> s_allocations(0);
+
+void* operator new(size_t nBytes)
+{
+    s_allocations++;
+
+    if (void* ptr = std::malloc(nBytes ? nBytes : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Parser specialisation, which exposes
+/// the default value identifier to be able to
+/// benchmark a stand-alone token reader.
+/////////////////////////////////////////////////
+class BenchmarkParser : public mu::Parser
+{
+    public:
+        using mu::Parser::IsVal;
+};
+
+
+/////////////////////////////////////////////////
+/// \brief A single benchmark result.
+/////////////////////////////////////////////////
+struct BenchmarkResult
+{
+    std::string m_group;
+    std::string m_name;
+    std::string m_expr;
+    size_t m_elements;
+    size_t m_iterations;
+    double m_nsPerIteration;
+    double m_allocsPerIteration;
+};
+
+
+/////////////////////////////////////////////////
+/// \brief This class runs the benchmark cases,
+/// calibrates their iteration count and collects
+/// their results for the JSON output.
+/////////////////////////////////////////////////
+class BenchmarkSuite
+{
+    private:
+        std::vector<BenchmarkResult> m_results;
+        std::string m_groupFilter;
+        double m_minDuration;
+
+    public:
+        BenchmarkSuite(const std::string& sGroupFilter, double minDuration)
+            : m_groupFilter(sGroupFilter), m_minDuration(minDuration) {}
+
+        bool isActive(const std::string& sGroup) const
+        {
+            return !m_groupFilter.length() || m_groupFilter == sGroup;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Run a single benchmark case. The
+        /// number of iterations is doubled until a single
+        /// measurement takes at least the minimal
+        /// duration. Afterwards, the best of multiple
+        /// repetitions is stored together with the
+        /// number of heap allocations per iteration.
+        ///
+        /// \param sGroup const std::string&
+        /// \param sName const std::string&
+        /// \param sExpr const std::string&
+        /// \param nElements size_t
+        /// \param benchCase Fun
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        template<class Fun>
+        void run(const std::string& sGroup, const std::string& sName, const std::string& sExpr, size_t nElements, Fun benchCase)
+        {
+            if (!isActive(sGroup))
+                return;
+
+            size_t nIterations = 1;
+            size_t nAllocations = 0;
+            double bestTime = 0.0;
+
+            // Warm up (fills the caches and triggers the
+            // compilation of hot expressions)
+            benchCase();
+
+            while (true)
+            {
+                auto startPoint = std::chrono::steady_clock::now();
+
+                for (size_t i = 0; i < nIterations; i++)
+                {
+                    benchCase();
+                }
+
+                std::chrono::duration<double> runTime = std::chrono::steady_clock::now() - startPoint;
+
+                if (runTime.count() >= m_minDuration || nIterations >= (1ull << 30))
+                {
+                    bestTime = runTime.count();
+                    break;
+                }
+
+                nIterations *= 2;
+            }
+
+            for (int n = 1; n < BENCH_REPETITIONS; n++)
+            {
+                size_t nStartAllocations = s_allocations;
+                auto startPoint = std::chrono::steady_clock::now();
+
+                for (size_t i = 0; i < nIterations; i++)
+                {
+                    benchCase();
+                }
+
+                std::chrono::duration<double> runTime = std::chrono::steady_clock::now() - startPoint;
+                nAllocations = s_allocations - nStartAllocations;
+                bestTime = std::min(bestTime, runTime.count());
+            }
+
+            m_results.push_back(BenchmarkResult{sGroup, sName, sExpr, nElements, nIterations, bestTime * 1e9 / nIterations,
+                                                double(nAllocations) / nIterations});
+            std::cerr << sGroup << "/" << sName << ": " << m_results.back().m_nsPerIteration << " ns" << std::endl;
+        }
+
+        void write(std::ostream& stream, const std::string& sVersion) const;
+};
+
+
+/////////////////////////////////////////////////
+/// \brief Escape a string for the JSON output.
+///
+/// \param sString const std::string&
+/// \return std::string
+///
+/////////////////////////////////////////////////
+static std::string jsonEscape(const std::string& sString)
+{
+    std::string sEscaped;
+
+    for (char c : sString)
+    {
+        switch (c)
+        {
+            case '"':
+                sEscaped += "\\\"";
+                break;
+            case '\\':
+                sEscaped += "\\\\";
+                break;
+            case '\n':
+                sEscaped += "\\n";
+                break;
+            case '\t':
+                sEscaped += "\\t";
+                break;
+            default:
+                if ((unsigned char)c < 0x20)
+                {
+                    std::ostringstream hex;
+                    hex << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c;
+                    sEscaped += hex.str();
+                }
+                else
+                    sEscaped += c;
+        }
+    }
+
+    return sEscaped;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Write the collected results as JSON to
+/// the passed stream.
+///
+/// \param stream std::ostream&
+/// \param sVersion const std::string&
+/// \return void
+///
+/////////////////////////////////////////////////
+void BenchmarkSuite::write(std::ostream& stream, const std::string& sVersion) const
+{
+    std::time_t now = std::time(nullptr);
+    char sTimeStamp[32];
+    std::strftime(sTimeStamp, sizeof(sTimeStamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    stream << "{\n";
+    stream << "  \"format\": " << BENCH_FORMAT_VERSION << ",\n";
+    stream << "  \"parser\": \"" << jsonEscape(sVersion) << "\",\n";
+    stream << "  \"timestamp\": \"" << sTimeStamp << "\",\n";
+    stream << "  \"threads\": " << omp_get_max_threads() << ",\n";
+    stream << "  \"value_size\": " << sizeof(mu::Value) << ",\n";
+    stream << "  \"avx2\": " << (mu::simd::hasAVX2() ? "true" : "false") << ",\n";
+    stream << "  \"sse41\": " << (mu::simd::hasSSE41() ? "true" : "false") << ",\n";
+    stream << "  \"results\": [";
+
+    stream << std::setprecision(6);
+
+    for (size_t i = 0; i < m_results.size(); i++)
+    {
+        const BenchmarkResult& res = m_results[i];
+        stream << (i ? ",\n" : "\n");
+        stream << "    {\"group\": \"" << jsonEscape(res.m_group)
+               << "\", \"name\": \"" << jsonEscape(res.m_name)
+               << "\", \"expression\": \"" << jsonEscape(res.m_expr)
+               << "\", \"elements\": " << res.m_elements
+               << ", \"iterations\": " << res.m_iterations
+               << ", \"ns_per_iteration\": " << res.m_nsPerIteration
+               << ", \"ns_per_element\": " << res.m_nsPerIteration / std::max(res.m_elements, (size_t)1)
+               << ", \"allocs_per_iteration\": " << res.m_allocsPerIteration
+               << ", \"allocs_per_element\": " << res.m_allocsPerIteration / std::max(res.m_elements, (size_t)1)
+               << "}";
+    }
+
+    stream << "\n  ]\n}\n";
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Declare the functions of the benchmark
+/// corpus in the passed parser instance.
+///
+/// \param _parser mu::Parser&
+/// \return void
+///
+/////////////////////////////////////////////////
+static void defineFunctions(mu::Parser& _parser)
+{
+    _parser.DefineFun("sin", numfnc_sin);
+    _parser.DefineFun("cos", numfnc_cos);
+    _parser.DefineFun("tan", numfnc_tan);
+    _parser.DefineFun("atan", numfnc_atan);
+    _parser.DefineFun("tanh", numfnc_tanh);
+    _parser.DefineFun("ln", numfnc_ln);
+    _parser.DefineFun("log10", numfnc_log10);
+    _parser.DefineFun("exp", numfnc_exp);
+    _parser.DefineFun("sqrt", numfnc_sqrt);
+    _parser.DefineFun("abs", numfnc_abs);
+    _parser.DefineFun("sign", numfnc_sign);
+    _parser.DefineFun("rint", numfnc_rint);
+
+    _parser.DefineScalarFun(numfnc_sin, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Sin>);
+    _parser.DefineScalarFun(numfnc_cos, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Cos>);
+    _parser.DefineScalarFun(numfnc_tan, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Tan>);
+    _parser.DefineScalarFun(numfnc_atan, mu::scalarImpl<mu::MathImpl<std::complex<double>>::ATan>);
+    _parser.DefineScalarFun(numfnc_tanh, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Tanh>);
+    _parser.DefineScalarFun(numfnc_ln, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Log>);
+    _parser.DefineScalarFun(numfnc_log10, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Log10>);
+    _parser.DefineScalarFun(numfnc_exp, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Exp>);
+    _parser.DefineScalarFun(numfnc_sqrt, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Sqrt>);
+
+    _parser.DefineFun("strlen", strfnc_strlen);
+    _parser.DefineFun("substr", strfnc_substr, true, 1);
+    _parser.DefineFun("firstch", strfnc_firstch);
+    _parser.DefineFun("lastch", strfnc_lastch);
+    _parser.DefineFun("to_string", strfnc_to_string);
+    _parser.DefineFun("strjoin", strfnc_strjoin, true, 2);
+    _parser.DefineFun("valtostr", strfnc_valtostr, true, 2);
+
+    _parser.DefinePostfixOprt("i", numfnc_imaginaryUnit);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief The fixed scalar expression corpus.
+/// Used for the tokenizer, RPN creation and the
+/// scalar evaluation benchmarks.
+/////////////////////////////////////////////////
+static const std::vector<std::string> SCALAR_CORPUS = {
+    "a*b+c",
+    "a+b*c-a/b",
+    "(a+b)*(a-b)/(c+1)",
+    "sin(a)^2+cos(a)^2",
+    "exp(-a*a/2)/sqrt(2*3.141592653589793)",
+    "a<b ? a*b : a/b",
+    "sqrt(abs(a-b))+ln(c+1)",
+    "atan(a/b)*tanh(c)+log10(a+b+c)",
+    "((a+1)*(b+2)*(c+3)+(a+4)*(b+5))/((c+6)*(a+7))",
+    "a*b*c+a*b+a*c+b*c+a+b+c+1"
+};
+
+
+/////////////////////////////////////////////////
+/// \brief The fixed element-wise expression
+/// corpus for the vector evaluation benchmarks.
+/////////////////////////////////////////////////
+static const std::vector<std::string> VECTOR_CORPUS = {
+    "x*y+z",
+    "x+y*z-x/y",
+    "sin(x)^2+cos(x)^2",
+    "exp(-x*x/2)/sqrt(2*3.141592653589793)",
+    "x<y ? x*y : x/y",
+    "sqrt(abs(x-y))+ln(z+1)",
+    "x*y*z+x*y+x*z+y*z+x+y+z+1"
+};
+
+
+/////////////////////////////////////////////////
+/// \brief The numerical functions, which are
+/// benchmarked directly on a real-valued
+/// mu::Array to measure their SIMD kernels.
+/////////////////////////////////////////////////
+static const std::vector<std::pair<std::string, mu::Array(*)(const mu::Array&)>> FUNCTION_CORPUS = {
+    {"sin", numfnc_sin},
+    {"cos", numfnc_cos},
+    {"tan", numfnc_tan},
+    {"asin", numfnc_asin},
+    {"acos", numfnc_acos},
+    {"atan", numfnc_atan},
+    {"sinh", numfnc_sinh},
+    {"cosh", numfnc_cosh},
+    {"tanh", numfnc_tanh},
+    {"exp", numfnc_exp},
+    {"ln", numfnc_ln},
+    {"log2", numfnc_log2},
+    {"log10", numfnc_log10},
+    {"sqrt", numfnc_sqrt},
+    {"abs", numfnc_abs},
+    {"sign", numfnc_sign},
+    {"floor", numfnc_floor},
+    {"roof", numfnc_roof},
+    {"rint", numfnc_rint}
+};
+
+
+/////////////////////////////////////////////////
+/// \brief The lines of the emulated loop body for
+/// the loop mode benchmarks. The variable k is
+/// the loop index.
+/////////////////////////////////////////////////
+static const std::vector<std::string> LOOP_CORPUS = {
+    "a*k+b",
+    "sqrt(k)*c-a",
+    "k<500 ? a*k : b/k",
+    "sin(k/100)^2+cos(k/100)^2"
+};
+
+
+/////////////////////////////////////////////////
+/// \brief The fixed string function corpus.
+/////////////////////////////////////////////////
+static const std::vector<std::string> STRING_CORPUS = {
+    "strlen(s)",
+    "substr(s, 3, 5)",
+    "firstch(s)+lastch(s)",
+    "to_string(a)",
+    "strjoin(sv, \",\")",
+    "valtostr(a, \" \", 8)",
+    "s+\" and \"+s",
+    "strlen(sv)+1"
+};
+
+
+int main(int argc, char* argv[])
+{
+    std::string sOutputFile;
+    std::string sGroup;
+    double minDuration = 0.05;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string sArg = argv[i];
+
+        if (sArg == "-o" && i+1 < argc)
+            sOutputFile = argv[++i];
+        else if (sArg == "-group" && i+1 < argc)
+            sGroup = argv[++i];
+        else if (sArg == "-duration" && i+1 < argc)
+            minDuration = std::stod(argv[++i]);
+        else
+        {
+            std::cerr << "Usage: parserbenchmark [-o FILE] [-group tokenize|rpn|scalar|vector|array|functions|loop|string] [-duration SECONDS]" << std::endl;
+            return 1;
+        }
+    }
+
+    BenchmarkSuite suite(sGroup, minDuration);
+
+    BenchmarkParser _parser;
+    defineFunctions(_parser);
+
+    mu::Variable a(mu::Value(1.5));
+    mu::Variable b(mu::Value(2.5));
+    mu::Variable c(mu::Value(0.75));
+    mu::Variable k(mu::Value(1.0));
+    mu::Variable s(std::string("Hello benchmark"));
+    mu::Variable sv(std::vector<std::string>({"alpha", "beta", "gamma", "delta"}));
+
+    std::vector<double> vX(BENCH_VECTOR_SIZE);
+    std::vector<double> vY(BENCH_VECTOR_SIZE);
+    std::vector<double> vZ(BENCH_VECTOR_SIZE);
+
+    // Keep all values within the real domain of
+    // all benchmarked functions
+    for (size_t i = 0; i < BENCH_VECTOR_SIZE; i++)
+    {
+        vX[i] = 0.1 + 0.8 * (i % 1000) / 1000.0;
+        vY[i] = 1.0 + (i % 97) / 97.0;
+        vZ[i] = 0.5 * i / BENCH_VECTOR_SIZE;
+    }
+
+    mu::Variable x(vX);
+    mu::Variable y(vY);
+    mu::Variable z(vZ);
+
+    _parser.DefineVar("a", &a);
+    _parser.DefineVar("b", &b);
+    _parser.DefineVar("c", &c);
+    _parser.DefineVar("k", &k);
+    _parser.DefineVar("s", &s);
+    _parser.DefineVar("sv", &sv);
+    _parser.DefineVar("x", &x);
+    _parser.DefineVar("y", &y);
+    _parser.DefineVar("z", &z);
+
+    try
+    {
+        // Tokenisation only: the token reader is
+        // driven until the end of the expression
+        if (suite.isActive("tokenize"))
+        {
+            mu::ParserTokenReader reader(&_parser);
+            reader.AddValIdent(BenchmarkParser::IsVal);
+
+            for (const std::string& sExpr : SCALAR_CORPUS)
+            {
+                suite.run("tokenize", "scalar", sExpr, 1, [&]()
+                          {
+                              reader.SetFormula(sExpr);
+                              while (reader.ReadNextToken().GetCode() != mu::cmEND)
+                                  ;
+                          });
+            }
+        }
+
+        // RPN creation: the shared expression cache
+        // has to be disabled to compile every time.
+        // The parser would skip an unchanged
+        // expression, therefore we alternate between
+        // two spellings of the same expression
+        if (suite.isActive("rpn"))
+        {
+            size_t nCapacity = mu::SharedExpressionCache::get().getCapacity();
+            mu::SharedExpressionCache::get().setCapacity(0);
+
+            for (const std::string& sExpr : SCALAR_CORPUS)
+            {
+                std::string sSpelling[2] = {sExpr, "(" + sExpr + ")"};
+                size_t n = 0;
+
+                suite.run("rpn", "compile", sExpr, 1, [&]()
+                          {
+                              _parser.SetExpr(sSpelling[n++ % 2]);
+                          });
+            }
+
+            mu::SharedExpressionCache::get().setCapacity(nCapacity);
+
+            for (const std::string& sExpr : SCALAR_CORPUS)
+            {
+                std::string sSpelling[2] = {sExpr, "(" + sExpr + ")"};
+                size_t n = 0;
+
+                suite.run("rpn", "shared-cache", sExpr, 1, [&]()
+                          {
+                              _parser.SetExpr(sSpelling[n++ % 2]);
+                          });
+            }
+        }
+
+        // Scalar evaluation of an already parsed
+        // expression with and without the compiled
+        // tier
+        if (suite.isActive("scalar"))
+        {
+            for (bool bJit : {false, true})
+            {
+                _parser.EnableJit(bJit);
+
+                for (const std::string& sExpr : SCALAR_CORPUS)
+                {
+                    _parser.SetExpr(sExpr);
+                    suite.run("scalar", bJit ? "jit" : "bytecode", sExpr, 1, [&]()
+                              {
+                                  _parser.Eval();
+                              });
+                }
+            }
+
+            _parser.EnableJit(false);
+        }
+
+        // Element-wise evaluation of vector variables
+        if (suite.isActive("vector"))
+        {
+            for (const std::string& sExpr : VECTOR_CORPUS)
+            {
+                _parser.SetExpr(sExpr);
+                suite.run("vector", "elementwise", sExpr, BENCH_VECTOR_SIZE, [&]()
+                          {
+                              _parser.Eval();
+                          });
+            }
+        }
+
+        // Arithmetic of the mu::Array class without
+        // the parser
+        if (suite.isActive("array"))
+        {
+            mu::Array arrX;
+            mu::Array arrY(vY);
+            mu::Array res;
+
+            suite.run("array", "construct", "Array(std::vector<double>)", BENCH_VECTOR_SIZE, [&](){arrX = mu::Array(vX);});
+            suite.run("array", "copy", "res = x", BENCH_VECTOR_SIZE, [&](){res = arrX;});
+            suite.run("array", "arithmetic", "x + y", BENCH_VECTOR_SIZE, [&](){res = arrX + arrY;});
+            suite.run("array", "arithmetic", "x - y", BENCH_VECTOR_SIZE, [&](){res = arrX - arrY;});
+            suite.run("array", "arithmetic", "x * y", BENCH_VECTOR_SIZE, [&](){res = arrX * arrY;});
+            suite.run("array", "arithmetic", "x / y", BENCH_VECTOR_SIZE, [&](){res = arrX / arrY;});
+            suite.run("array", "arithmetic", "x * 2.0", BENCH_VECTOR_SIZE, [&](){res = arrX * 2.0;});
+            suite.run("array", "compare", "x < y", BENCH_VECTOR_SIZE, [&](){res = arrX < arrY;});
+            suite.run("array", "power", "x^2", BENCH_VECTOR_SIZE, [&](){res = arrX.pow(mu::Numerical(2.0));});
+
+            res = arrX;
+            suite.run("array", "inplace", "res += y", BENCH_VECTOR_SIZE, [&](){res += arrY;});
+        }
+
+        // Numerical functions applied directly to a
+        // real-valued Array. The values of x are
+        // within the real domain of all functions
+        if (suite.isActive("functions"))
+        {
+            mu::Array arrX(vX);
+            mu::Array decimals(mu::Value(2.0));
+            mu::Array res;
+
+            for (const auto& func : FUNCTION_CORPUS)
+            {
+                suite.run("functions", func.first, func.first + "(x)", BENCH_VECTOR_SIZE, [&](){res = func.second(arrX);});
+            }
+
+            suite.run("functions", "round", "round(x,2)", BENCH_VECTOR_SIZE, [&](){res = numfnc_round(arrX, decimals);});
+        }
+
+        // Emulation of the loop mode as it is used
+        // by the flow control statements
+        if (suite.isActive("loop"))
+        {
+            std::string sLoop;
+
+            for (const std::string& sLine : LOOP_CORPUS)
+            {
+                sLoop += (sLoop.length() ? "; " : "") + sLine;
+            }
+
+            suite.run("loop", "for", sLoop, BENCH_LOOP_LENGTH * LOOP_CORPUS.size(), [&]()
+                      {
+                          _parser.ActivateLoopMode(LOOP_CORPUS.size());
+
+                          for (size_t i = 0; i < BENCH_LOOP_LENGTH; i++)
+                          {
+                              k = mu::Value((double)i+1);
+
+                              for (size_t n = 0; n < LOOP_CORPUS.size(); n++)
+                              {
+                                  _parser.SetIndex(n);
+
+                                  if (_parser.IsValidByteCode() == 1 && _parser.IsAlreadyParsed(LOOP_CORPUS[n]))
+                                      _parser.Eval();
+                                  else
+                                  {
+                                      _parser.SetExpr(LOOP_CORPUS[n]);
+                                      _parser.Eval();
+                                  }
+                              }
+                          }
+
+                          _parser.DeactivateLoopMode();
+                      });
+        }
+
+        // String functions
+        if (suite.isActive("string"))
+        {
+            for (const std::string& sExpr : STRING_CORPUS)
+            {
+                _parser.SetExpr(sExpr);
+                suite.run("string", "function", sExpr, 1, [&]()
+                          {
+                              _parser.Eval();
+                          });
+            }
+        }
+    }
+    catch (mu::ParserError& e)
+    {
+        std::cerr << "ERROR: " << e.GetMsg() << " in " << e.GetExpr() << std::endl;
+        return 1;
+    }
+
+    if (sOutputFile.length())
+    {
+        std::ofstream file(sOutputFile);
+
+        if (!file.good())
+        {
+            std::cerr << "ERROR: Cannot open " << sOutputFile << std::endl;
+            return 1;
+        }
+
+        suite.write(file, _parser.GetVersion());
+    }
+    else
+        suite.write(std::cout, _parser.GetVersion());
+
+    return 0;
+}
@@ -19,6 +19,7 @@
 
 #include <string>
 #include "muParser.h"
+#include "muParserTemplateMagic.h"
 #include "../ui/language.hpp"
 #include "../structures.hpp"
 #include "../maths/functionimplementation.hpp"
@@ -87,6 +88,26 @@ int main()
     _parser.DefineFun("sign", numfnc_sign);
     _parser.DefineFun("rint", numfnc_rint);
     _parser.DefineFun("abs", numfnc_abs);
+
+    // Scalar counterparts for the compiled expression tier
+    _parser.DefineScalarFun(numfnc_exp, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Exp>);
+    _parser.DefineScalarFun(numfnc_sqrt, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Sqrt>);
+    _parser.DefineScalarFun(numfnc_log2, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Log2>);
+    _parser.DefineScalarFun(numfnc_log10, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Log10>);
+    _parser.DefineScalarFun(numfnc_ln, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Log>);
+    _parser.DefineScalarFun(numfnc_sin, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Sin>);
+    _parser.DefineScalarFun(numfnc_cos, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Cos>);
+    _parser.DefineScalarFun(numfnc_tan, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Tan>);
+    _parser.DefineScalarFun(numfnc_asin, mu::scalarImpl<mu::MathImpl<std::complex<double>>::ASin>);
+    _parser.DefineScalarFun(numfnc_acos, mu::scalarImpl<mu::MathImpl<std::complex<double>>::ACos>);
+    _parser.DefineScalarFun(numfnc_atan, mu::scalarImpl<mu::MathImpl<std::complex<double>>::ATan>);
+    _parser.DefineScalarFun(numfnc_sinh, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Sinh>);
+    _parser.DefineScalarFun(numfnc_cosh, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Cosh>);
+    _parser.DefineScalarFun(numfnc_tanh, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Tanh>);
+    _parser.DefineScalarFun(numfnc_asinh, mu::scalarImpl<mu::MathImpl<std::complex<double>>::ASinh>);
+    _parser.DefineScalarFun(numfnc_acosh, mu::scalarImpl<mu::MathImpl<std::complex<double>>::ACosh>);
+    _parser.DefineScalarFun(numfnc_atanh, mu::scalarImpl<mu::MathImpl<std::complex<double>>::ATanh>);
+
     _parser.DefineFun("time", timfnc_time, false);
     _parser.DefineFun("date", timfnc_date, true, 2);
     _parser.DefineFun("as_date", timfnc_as_date, true, 2);
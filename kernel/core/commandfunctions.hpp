@@ -2107,6 +2107,9 @@ static CommandReturnValues saveDataObject(string& sCmd)
                 sFileName = _cache.generateFileName(".ndat");
         }
 
+        _cache.setbCompressNextFile(cmdParser.hasParam("compress"));
+        _cache.setbAsyncNextFile(cmdParser.hasParam("async"));
+
         if (_cache.saveFile(_access.getDataObject(), sFileName, nPrecision, sFileFormat))
         {
             if (_option.systemPrints())
@@ -2115,6 +2118,10 @@ static CommandReturnValues saveDataObject(string& sCmd)
         else
             throw SyntaxError(SyntaxError::CANNOT_SAVE_FILE, sCmd, sFileName, sFileName);
 
+        // Errors of background saves are reported by
+        // the main instance
+        _data.takePendingSaves(_cache);
+
         return COMMAND_PROCESSED;
     }
     else
@@ -3596,6 +3603,8 @@ static CommandReturnValues cmd_set(string& sCmd)
                         _functions.load(_option);
                     else if (iter->first == SETTING_B_DEBUGGER)
                         NumeReKernel::getInstance()->getDebugger().setActive(mSettings[SETTING_B_DEBUGGER].active());
+                    else if (iter->first == SETTING_B_PARSERJIT)
+                        _parser.EnableJit(mSettings[SETTING_B_PARSERJIT].active());
 
                     if (iter->second.isUiModifying())
                         NumeReKernel::modifiedSettings = true;
@@ -4756,6 +4765,20 @@ static CommandReturnValues cmd_load(string& sCmd)
                 sFileFormat = cmdParser.getParsedParameterValueAsString("fileformat", "", true, true);
 
             _data.setbLoadEmptyColsInNextFile(cmdParser.hasParam("keepdim") || cmdParser.hasParam("complete"));
+            _data.setbMapNextFile(cmdParser.hasParam("mapped"));
+
+            // Restrict the file to the selected columns
+            // and rows
+            VectorIndex vCols(0, VectorIndex::OPEN_END);
+            VectorIndex vRows(0, VectorIndex::OPEN_END);
+
+            if (cmdParser.hasParam("cols"))
+                vCols = VectorIndex(cmdParser.getParsedParameterValue("cols"));
+
+            if (cmdParser.hasParam("rows"))
+                vRows = VectorIndex(cmdParser.getParsedParameterValue("rows"));
+
+            _data.setProjectionOfNextFile(cmdParser.hasParam("cols") || cmdParser.hasParam("rows"), vCols, vRows);
 
             if ((cmdParser.hasParam("tocache") || cmdParser.hasParam("totable") || cmdParser.hasParam("target"))
                     && !cmdParser.hasParam("all"))
@@ -4763,9 +4786,15 @@ static CommandReturnValues cmd_load(string& sCmd)
                 // Single file directly to cache
                 std::string sTargetTable = getTargetTable(cmdParser.getParameterList());
 
+                _data.setbAsyncNextFile(cmdParser.hasParam("async"));
                 NumeRe::FileHeaderInfo info = _data.openFile(sFileName, true, cmdParser.hasParam("ignore") || cmdParser.hasParam("i"),
                                                              nArgument, sTargetTable, sFileFormat);
 
+                // The table is still loaded in the background
+                // and will be completed on its first access
+                if (_data.isPendingTable(info.sTableName))
+                    return COMMAND_PROCESSED;
+
                 if (!_data.isEmpty(info.sTableName))
                 {
                     if (_option.systemPrints())
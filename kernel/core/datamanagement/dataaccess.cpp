@@ -1756,6 +1756,149 @@ static std::string tableMethod_binsof(const std::string& sTableName, std::string
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Realizes the "groupby()" table method.
+/// Expects the key columns, the aggregations and
+/// optionally the aggregated columns and the name
+/// of the target table. Without aggregated
+/// columns, every aggregation is applied to all
+/// non-key columns.
+///
+/// \param sTableName const std::string&
+/// \param sMethodArguments std::string
+/// \param sResultVectorName const std::string&
+/// \return std::string
+///
+/////////////////////////////////////////////////
+static std::string tableMethod_groupBy(const std::string& sTableName, std::string sMethodArguments, const std::string& sResultVectorName)
+{
+    NumeReKernel* _kernel = NumeReKernel::getInstance();
+
+    int nResults = 0;
+    _kernel->getMemoryManager().updateDimensionVariables(sTableName);
+    _kernel->getParser().SetExpr(sMethodArguments);
+    mu::Array* v = _kernel->getParser().Eval(nResults);
+
+    if (nResults < 2)
+        throw SyntaxError(SyntaxError::TOO_FEW_ARGS, sTableName + "().groupby()", ".groupby(", ".groupby(");
+
+    VectorIndex vKeys(v[0]);
+    std::vector<int> vCols;
+    std::vector<Memory::GroupAggregation> vAggregations;
+    std::string sTarget = sTableName + "_grouped";
+
+    std::vector<Memory::GroupAggregation> vAggs;
+
+    for (size_t i = 0; i < v[1].size(); i++)
+    {
+        vAggs.push_back(Memory::stringToGroupAggregation(v[1][i].getStr()));
+
+        if (vAggs.back() == Memory::AGG_INVALID)
+            throw SyntaxError(SyntaxError::INVALID_MODE, sTableName + "().groupby()", ".groupby(", v[1][i].getStr());
+    }
+
+    if (!vAggs.size())
+        throw SyntaxError(SyntaxError::TOO_FEW_ARGS, sTableName + "().groupby()", ".groupby(", ".groupby(");
+
+    if (nResults > 2 && v[2].size() && !mu::isnan(v[2].front()))
+    {
+        // Aggregations and columns are paired. A single
+        // column or a single aggregation is shared
+        if (v[2].size() != 1 && vAggs.size() != 1 && v[2].size() != vAggs.size())
+            throw SyntaxError(SyntaxError::COL_COUNTS_DOESNT_MATCH, sTableName + "().groupby()", ".groupby(", ".groupby(");
+
+        for (size_t i = 0; i < std::max(v[1].size(), v[2].size()); i++)
+        {
+            vCols.push_back(v[2].get(i).getNum().asI64() - 1);
+            vAggregations.push_back(vAggs[std::min(i, vAggs.size()-1)]);
+        }
+    }
+    else
+    {
+        // Apply every aggregation to all non-key columns
+        vKeys.setOpenEndIndex(_kernel->getMemoryManager().getCols(sTableName)-1);
+
+        for (int j = 0; j < _kernel->getMemoryManager().getCols(sTableName); j++)
+        {
+            bool isKey = false;
+
+            for (size_t k = 0; k < vKeys.size(); k++)
+                isKey = isKey || vKeys[k] == j;
+
+            if (isKey)
+                continue;
+
+            for (Memory::GroupAggregation agg : vAggs)
+            {
+                vCols.push_back(j);
+                vAggregations.push_back(agg);
+            }
+        }
+    }
+
+    if (nResults > 3)
+        sTarget = v[3].front().getStr();
+
+    _kernel->getMemoryManager().groupBy(sTableName, sTarget, vKeys, VectorIndex(vCols), vAggregations);
+    _kernel->getParser().SetInternalVar(sResultVectorName, mu::Value(sTarget));
+    return sResultVectorName;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Realizes the "join()" table method.
+/// Expects the name of the other table, the key
+/// columns and optionally the key columns of the
+/// other table, the join type ("inner", "left"
+/// or "outer") and the name of the target table.
+///
+/// \param sTableName const std::string&
+/// \param sMethodArguments std::string
+/// \param sResultVectorName const std::string&
+/// \return std::string
+///
+/////////////////////////////////////////////////
+static std::string tableMethod_join(const std::string& sTableName, std::string sMethodArguments, const std::string& sResultVectorName)
+{
+    NumeReKernel* _kernel = NumeReKernel::getInstance();
+
+    int nResults = 0;
+    _kernel->getMemoryManager().updateDimensionVariables(sTableName);
+    _kernel->getParser().SetExpr(sMethodArguments);
+    mu::Array* v = _kernel->getParser().Eval(nResults);
+
+    if (nResults < 2)
+        throw SyntaxError(SyntaxError::TOO_FEW_ARGS, sTableName + "().join()", ".join(", ".join(");
+
+    std::string sOther = v[0].front().getStr();
+    VectorIndex vKeys(v[1]);
+    VectorIndex vOtherKeys(v[1]);
+    Memory::JoinType type = Memory::JOIN_INNER;
+    std::string sTarget = sTableName + "_joined";
+
+    if (sOther.find('(') != std::string::npos)
+        sOther.erase(sOther.find('('));
+
+    if (nResults > 2 && v[2].size() && !mu::isnan(v[2].front()))
+        vOtherKeys = VectorIndex(v[2]);
+
+    if (nResults > 3)
+    {
+        type = Memory::stringToJoinType(v[3].front().getStr());
+
+        if (type == Memory::JOIN_INVALID)
+            throw SyntaxError(SyntaxError::INVALID_MODE, sTableName + "().join()", ".join(", v[3].front().getStr());
+    }
+
+    if (nResults > 4)
+        sTarget = v[4].front().getStr();
+
+    _kernel->getMemoryManager().join(sTableName, sOther, sTarget, vKeys, vOtherKeys, type);
+    _kernel->getParser().SetInternalVar(sResultVectorName, mu::Value(sTarget));
+    return sResultVectorName;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Realizes the "rankof()" table method.
 ///
@@ -2110,6 +2253,8 @@ static std::map<std::string, TableMethod> getInplaceTableMethods()
     mTableMethods["anovaof"] = tableMethod_anova;
     mTableMethods["kmeansof"] = tableMethod_kmeans;
     mTableMethods["binsof"] = tableMethod_binsof;
+    mTableMethods["groupby"] = tableMethod_groupBy;
+    mTableMethods["join"] = tableMethod_join;
     mTableMethods["insertcells"] = tableMethod_insertBlock;
     mTableMethods["insertcols"] = tableMethod_insertCols;
     mTableMethods["insertrows"] = tableMethod_insertRows;
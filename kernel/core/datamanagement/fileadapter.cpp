@@ -20,11 +20,17 @@
 #include "../utils/tools.hpp"
 #include "../io/logger.hpp"
 #include "memory.hpp"
+#include "../../kernel.hpp"
 
 using namespace std;
 
 namespace NumeRe
 {
+    // The worker threads for loading and saving files
+    // in the background are shared by all instances
+    WorkerPool FileAdapter::m_workers(2);
+
+
     /////////////////////////////////////////////////
     /// \brief FileAdapted default constructor.
     /////////////////////////////////////////////////
@@ -32,6 +38,10 @@ namespace NumeRe
     {
         bLoadEmptyCols = false;
         bLoadEmptyColsInNextFile = false;
+        bMapNextFile = false;
+        bCompressNextFile = false;
+        bProjectNextFile = false;
+        bAsyncNextFile = false;
         sOutputFile = "";
         sDataFile = "";
         sPrefix = "data";
@@ -60,20 +70,18 @@ namespace NumeRe
     /// table.
     ///
     /// \param _mem Memory*
+    /// \param bKeepEmptyCols bool
     /// \return void
     ///
     /////////////////////////////////////////////////
-    void FileAdapter::condenseDataSet(Memory* _mem)
+    void FileAdapter::condenseDataSet(Memory* _mem, bool bKeepEmptyCols)
     {
         if (!_mem || !_mem->isValid())
             return;
 
         // Shall we ignore empty columns?
-        if (bLoadEmptyCols || bLoadEmptyColsInNextFile)
-        {
-            bLoadEmptyColsInNextFile = false;
+        if (bKeepEmptyCols)
             return;
-        }
 
         // Remove all obsolete cells and columns
         _mem->shrink();
@@ -92,13 +100,94 @@ namespace NumeRe
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief This static member function reads the
+    /// contents of the passed file to a new Memory
+    /// instance. The file instance is deleted in
+    /// every case. As it does not access any member
+    /// of the FileAdapter, it may also be called from
+    /// a worker thread.
+    ///
+    /// \param file GenericFile*
+    /// \param sFile const std::string&
+    /// \param bKeepEmptyCols bool
+    /// \param info FileHeaderInfo&
+    /// \return Memory*
+    ///
+    /////////////////////////////////////////////////
+    Memory* FileAdapter::readFileToMemory(GenericFile* file, const std::string& sFile, bool bKeepEmptyCols, FileHeaderInfo& info)
+    {
+        // Try to read the contents of the file. This may
+        // either result in a read error or the read method
+        // is not defined for this function
+        try
+        {
+            // Read the file
+            if (!file->read())
+                throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFile, SyntaxError::invalid_position, sFile);
+        }
+        catch (...)
+        {
+            delete file;
+            throw;
+        }
+
+        // Get the header information structure
+        info = file->getFileHeaderInformation();
+
+        if (!info.nCols || !info.nRows)
+        {
+            delete file;
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFile, SyntaxError::invalid_position, sFile);
+        }
+
+        Memory* _mem = new Memory();
+        _mem->resizeMemory(info.nRows, info.nCols);
+
+        // If the dimensions were not valid or the
+        // internal memory was not created, we cannot
+        // copy the data
+        if (!_mem->memArray.size())
+        {
+            delete file;
+            delete _mem;
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFile, SyntaxError::invalid_position, sFile);
+        }
+
+        // Copy them and delete the file instance
+        // afterwards
+        file->getData(&_mem->memArray);
+        delete file;
+
+        // Is it actually necessary to apply some automatic
+        // conversion to the data?
+        if (info.needsConversion)
+            _mem->convert();
+
+        condenseDataSet(_mem, bKeepEmptyCols);
+        _mem->createTableHeaders();
+        _mem->setSaveStatus(false);
+
+        NumeRe::TableMetaData meta;
+        meta.comment = info.sComment;
+        meta.source = sFile;
+
+        _mem->setMetaData(meta);
+
+        return _mem;
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief This member function loads the
     /// contents of the selected file to a new Memory
     /// class instance. This instance is either
     /// appended to the already existing instances or
     /// melted with an existing one, if the existing
-    /// one has the same name.
+    /// one has the same name. If the next file shall
+    /// be loaded asynchronously, the file is read by
+    /// a worker thread and the target table is only
+    /// registered as pending.
     ///
     /// \param _sFile std::string
     /// \param loadToCache bool
@@ -124,6 +213,11 @@ namespace NumeRe
 
         g_logger.info("Loading file '" + _sFile + "'. (Resolved as '" + sFile + "')");
 
+        // The asynchronous loading only applies to the
+        // next file
+        bool bAsync = bAsyncNextFile && loadToCache;
+        bAsyncNextFile = false;
+
         // Get an instance of the desired file type
         GenericFile* file = getFileByType(sFile, sFileFormat);
 
@@ -131,93 +225,110 @@ namespace NumeRe
         if (!file)
             throw SyntaxError(SyntaxError::CANNOT_READ_FILE, _sFile, SyntaxError::invalid_position, _sFile);
 
-        // Try to read the contents of the file. This may
-        // either result in a read error or the read method
-        // is not defined for this function
-        try
+        // NDAT files may be mapped into memory instead of
+        // being read completely
+        if (bMapNextFile)
         {
-            // Igor binary waves might contain three-dimensional
-            // waves. We select the roll-out mode in this case
-            if (file->getExtension() == "ibw" && _nHeadline == -1)
-                static_cast<IgorBinaryWave*>(file)->useXZSlicing();
+            if (NumeReDataFile* ndat = dynamic_cast<NumeReDataFile*>(file))
+                ndat->useMemoryMapping();
 
-            // Read the file
-            if (!file->read())
-                throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFile, SyntaxError::invalid_position, sFile);
+            bMapNextFile = false;
         }
-        catch (...)
-        {
-            delete file;
-            throw;
-        }
-
-        g_logger.debug("File read. Preparing memory.");
-
-        // Get the header information structure
-        info = file->getFileHeaderInformation();
 
-        if (!info.nCols || !info.nRows)
+        // NDAT files may be restricted to a subset of
+        // their columns and rows. All other files are
+        // read completely
+        if (bProjectNextFile)
         {
-            delete file;
-            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFile, SyntaxError::invalid_position, sFile);
+            if (NumeReDataFile* ndat = dynamic_cast<NumeReDataFile*>(file))
+                ndat->setProjection(vProjectedCols, vProjectedRows);
+            else
+                NumeReKernel::issueWarning("The options \"cols\" and \"rows\" are only supported for NDAT files. \""
+                                           + sFile + "\" is read completely.");
+
+            bProjectNextFile = false;
         }
 
-        Memory* _mem = new Memory();
-        _mem->resizeMemory(info.nRows, info.nCols);
+        // Igor binary waves might contain three-dimensional
+        // waves. We select the roll-out mode in this case
+        if (file->getExtension() == "ibw" && _nHeadline == -1)
+            static_cast<IgorBinaryWave*>(file)->useXZSlicing();
 
-        // If the dimensions were valid and the internal
-        // memory was created, copy the data to this
-        // memory
-        if (_mem->memArray.size())
-        {
-            // Copy them and delete the file instance
-            // afterwards
-            file->getData(&_mem->memArray);
-            delete file;
-            g_logger.debug("Data copied.");
+        // Shall we keep empty columns?
+        bool bKeepEmptyCols = bLoadEmptyCols || bLoadEmptyColsInNextFile;
+        bLoadEmptyColsInNextFile = false;
 
-            // Is it actually necessary to apply some automatic
-            // conversion to the data?
-            if (info.needsConversion)
+        if (bAsync)
+        {
+            // The name of the target table has to be known
+            // in advance. NDAT files store it in their
+            // header
+            try
+            {
+                if (sTargetTable.length())
+                    info.sTableName = sTargetTable;
+                else if (dynamic_cast<NumeReDataFile*>(file))
+                {
+                    NumeReDataFile header(sFile);
+                    header.readFileInformation();
+                    info.sTableName = header.getTableName();
+                }
+                else
+                    info.sTableName = file->getTableName();
+            }
+            catch (...)
             {
-                _mem->convert();
-                g_logger.debug("Data converted.");
+                delete file;
+                throw;
             }
 
-            condenseDataSet(_mem);
-            _mem->createTableHeaders();
-            _mem->setSaveStatus(false);
+            PendingTable pending;
+            pending.cancelled = std::make_shared<std::atomic<bool>>(false);
+            pending.sFileName = sFile;
+            pending.overrideTarget = overrideTarget;
+
+            std::shared_ptr<std::atomic<bool>> cancelled = pending.cancelled;
 
-            NumeRe::TableMetaData meta;
-            meta.comment = info.sComment;
-            meta.source = sFile;
+            pending.result = m_workers.schedule<std::unique_ptr<Memory>>([file, sFile, bKeepEmptyCols, cancelled]()
+                {
+                    // Do not read the file, if nobody is
+                    // waiting for it any more
+                    if (*cancelled)
+                    {
+                        delete file;
+                        return std::unique_ptr<Memory>();
+                    }
+
+                    FileHeaderInfo fileInfo;
+                    return std::unique_ptr<Memory>(readFileToMemory(file, sFile, bKeepEmptyCols, fileInfo));
+                });
+
+            addPendingTable(info.sTableName, std::move(pending));
+            g_logger.info("File is loaded in the background to '" + info.sTableName + "'.");
+
+            return info;
+        }
 
-            _mem->setMetaData(meta);
+        Memory* _mem = readFileToMemory(file, sFile, bKeepEmptyCols, info);
+        g_logger.debug("File read and copied to memory.");
 
-            // Melt or append the new instance. The
-            // melt() member function is responsible
-            // for freeing the passed memory.
-            if (loadToCache)
+        // Melt or append the new instance. The
+        // melt() member function is responsible
+        // for freeing the passed memory.
+        if (loadToCache)
+        {
+            if (sTargetTable.length())
             {
-                if (sTargetTable.length())
-                {
-                    melt(_mem, sTargetTable, overrideTarget);
-                    info.sTableName = sTargetTable;
-                }
-                else
-                    melt(_mem, info.sTableName, overrideTarget);
+                melt(_mem, sTargetTable, overrideTarget);
+                info.sTableName = sTargetTable;
             }
             else
-                melt(_mem, "data");
-
-            g_logger.info("File sucessfully loaded. Data file dimensions = {" + toString(info.nRows) + ", " + toString(info.nCols) + "}");
+                melt(_mem, info.sTableName, overrideTarget);
         }
         else
-        {
-            delete file;
-            delete _mem;
-            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFile, SyntaxError::invalid_position, sFile);
-        }
+            melt(_mem, "data");
+
+        g_logger.info("File sucessfully loaded. Data file dimensions = {" + toString(info.nRows) + ", " + toString(info.nCols) + "}");
 
         if (!loadToCache)
         {
@@ -259,7 +370,15 @@ namespace NumeRe
             setPath(sTemp, false, sExecutablePath);
         }
 
-        return saveLayer(sOutputFile, sTable, nPrecision, sFileFormat);
+        // The compression only applies to the next file
+        bool bCompress = bCompressNextFile;
+        bCompressNextFile = false;
+
+        // Same applies for the asynchronous saving
+        bool bAsync = bAsyncNextFile;
+        bAsyncNextFile = false;
+
+        return saveLayer(sOutputFile, sTable, nPrecision, sFileFormat, bCompress, bAsync);
     }
 
 
@@ -366,6 +485,72 @@ namespace NumeRe
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief Set, whether the next file shall be
+    /// mapped into memory instead of being read
+    /// completely (only supported for NDAT files).
+    ///
+    /// \param _bMapFile bool
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void FileAdapter::setbMapNextFile(bool _bMapFile)
+    {
+        bMapNextFile = _bMapFile;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Set, whether the columns of the next
+    /// saved file shall be compressed (only
+    /// supported for NDAT files).
+    ///
+    /// \param _bCompressFile bool
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void FileAdapter::setbCompressNextFile(bool _bCompressFile)
+    {
+        bCompressNextFile = _bCompressFile;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Set, whether only the selected columns
+    /// and the range of rows between the smallest
+    /// and the largest selected row shall be read
+    /// from the next file (only supported for NDAT
+    /// files).
+    ///
+    /// \param _bProject bool
+    /// \param _vCols const VectorIndex&
+    /// \param _vRows const VectorIndex&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void FileAdapter::setProjectionOfNextFile(bool _bProject, const VectorIndex& _vCols, const VectorIndex& _vRows)
+    {
+        bProjectNextFile = _bProject;
+        vProjectedCols = _vCols;
+        vProjectedRows = _vRows;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Set, whether the next file shall be
+    /// loaded or saved asynchronously by a worker
+    /// thread.
+    ///
+    /// \param _bAsync bool
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void FileAdapter::setbAsyncNextFile(bool _bAsync)
+    {
+        bAsyncNextFile = _bAsync;
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief This member function creates a file
     /// name from the file prefix and the time stamp.
@@ -22,13 +22,32 @@
 #include "../io/file.hpp"
 #include "../io/filesystem.hpp"
 #include "../settings.hpp"
+#include "../io/workerpool.hpp"
 
 #include <string>
+#include <memory>
+#include <future>
+#include <atomic>
 
 class Memory;
 
 namespace NumeRe
 {
+    /////////////////////////////////////////////////
+    /// \brief This structure represents a table,
+    /// which is currently loaded in the background.
+    /// The loaded Memory instance is available from
+    /// the future, once the loading is complete.
+    /////////////////////////////////////////////////
+    struct PendingTable
+    {
+        std::future<std::unique_ptr<Memory>> result;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+        std::string sFileName;
+        bool overrideTarget;
+    };
+
+
     /////////////////////////////////////////////////
     /// \brief This class represents the file input
     /// and output adapter for the MemoryManager
@@ -44,10 +63,19 @@ namespace NumeRe
             std::string sDataFile;
             bool bLoadEmptyCols;
             bool bLoadEmptyColsInNextFile;
+            bool bMapNextFile;
+            bool bCompressNextFile;
+            bool bProjectNextFile;
+            bool bAsyncNextFile;
+            VectorIndex vProjectedCols;
+            VectorIndex vProjectedRows;
+            static WorkerPool m_workers;
 
             std::string getDate();
-            void condenseDataSet(Memory* _mem);
-            virtual bool saveLayer(std::string _sFileName, const std::string& _sCache, unsigned short nPrecision, std::string sExt = "") = 0;
+            static void condenseDataSet(Memory* _mem, bool bKeepEmptyCols);
+            static Memory* readFileToMemory(GenericFile* file, const std::string& sFile, bool bKeepEmptyCols, FileHeaderInfo& info);
+            virtual bool saveLayer(std::string _sFileName, const std::string& _sCache, unsigned short nPrecision, std::string sExt = "", bool bCompress = false, bool bAsync = false) = 0;
+            virtual void addPendingTable(const std::string& sTable, PendingTable&& pending) = 0;
 
         public:
             FileAdapter();
@@ -62,6 +90,10 @@ namespace NumeRe
             void setPrefix(const std::string& _sPrefix);
             void setbLoadEmptyCols(bool _bLoadEmptyCols);
             void setbLoadEmptyColsInNextFile(bool _bLoadEmptyCols);
+            void setbMapNextFile(bool _bMapFile);
+            void setbCompressNextFile(bool _bCompressFile);
+            void setProjectionOfNextFile(bool _bProject, const VectorIndex& _vCols, const VectorIndex& _vRows);
+            void setbAsyncNextFile(bool _bAsync);
             std::string generateFileName(const std::string& sExtension = ".ndat");
             virtual void melt(Memory* _mem, const std::string& sTable, bool overrideTarget = false) = 0;
     };
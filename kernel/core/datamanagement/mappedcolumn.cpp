@@ -0,0 +1,755 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include <windows.h>
+#include "mappedcolumn.hpp"
+#include "tablecolumnimpl.hpp"
+
+
+
+/////////////////////////////////////////////////
+/// \brief Maps the selected file read-only into
+/// memory. If anything fails, the instance will
+/// be invalid instead of throwing, so that the
+/// caller may fall back to reading the file.
+///
+/// \param sFileName const std::string&
+///
+/////////////////////////////////////////////////
+MappedFile::MappedFile(const std::string& sFileName)
+    : m_sFileName(sFileName), m_hFile(INVALID_HANDLE_VALUE), m_hMapping(nullptr), m_data(nullptr), m_size(0)
+{
+    m_hFile = CreateFileA(sFileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                          FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+
+    if (m_hFile == INVALID_HANDLE_VALUE)
+        return;
+
+    LARGE_INTEGER fileSize;
+
+    // Empty files cannot be mapped
+    if (!GetFileSizeEx(m_hFile, &fileSize) || !fileSize.QuadPart)
+    {
+        close();
+        return;
+    }
+
+    m_hMapping = CreateFileMappingA(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (!m_hMapping)
+    {
+        close();
+        return;
+    }
+
+    // Map the whole file. This will only fail for
+    // files, which do not fit into the address space
+    m_data = static_cast<const char*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+
+    if (!m_data)
+    {
+        close();
+        return;
+    }
+
+    m_size = fileSize.QuadPart;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Destructor. Releases the mapping.
+/////////////////////////////////////////////////
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Unmaps the view and closes all
+/// handles.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void MappedFile::close()
+{
+    if (m_data)
+        UnmapViewOfFile(m_data);
+
+    if (m_hMapping)
+        CloseHandle(m_hMapping);
+
+    if (m_hFile != INVALID_HANDLE_VALUE)
+        CloseHandle(m_hFile);
+
+    m_data = nullptr;
+    m_hMapping = nullptr;
+    m_hFile = INVALID_HANDLE_VALUE;
+    m_size = 0;
+}
+
+
+
+
+
+
+/////////////////////////////////////////////////
+/// \brief Creates a column referencing nElems
+/// std::complex<double> values at the byte
+/// offset within the mapped file. Columns in the
+/// native layout of NDAT v5 files store F64
+/// values as plain doubles. The number of
+/// elements is limited to the end of the file.
+///
+/// \param file std::shared_ptr<MappedFile>
+/// \param offset size_t
+/// \param nElems size_t
+/// \param type ColumnType
+/// \param isNative bool
+///
+/////////////////////////////////////////////////
+MappedColumn::MappedColumn(std::shared_ptr<MappedFile> file, size_t offset, size_t nElems, ColumnType type, bool isNative)
+    : TableColumn(), m_file(file), m_mapped(nullptr), m_numElements(0), m_isNative(isNative)
+{
+    m_type = type;
+    m_elemSize = isNative && type == TYPE_VALUE_F64 ? sizeof(double) : sizeof(std::complex<double>);
+
+    if (m_file && m_file->isValid() && offset <= m_file->size())
+    {
+        m_mapped = m_file->data() + offset;
+        m_numElements = std::min(nElems, (m_file->size() - offset) / m_elemSize);
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Fill the span with a converted copy of
+/// the mapped rows [first, last).
+///
+/// \param first size_t
+/// \param last size_t
+/// \param span ColumnSpan<S>&
+/// \return void
+///
+/////////////////////////////////////////////////
+template<class S>
+void MappedColumn::mappedSpan(size_t first, size_t last, ColumnSpan<S>& span) const
+{
+    last = std::min(last, m_numElements);
+    first = std::min(first, last);
+
+    S* data = span.allocate(last - first);
+
+    for (size_t i = first; i < last; i++)
+    {
+        std::complex<double> val = readMapped(i);
+        toSpanValue(data[i-first], val);
+
+        if (!mu::isnan(val))
+            span.setValid(i-first);
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Creates an in-memory value column of
+/// the same type containing all mapped values.
+///
+/// \return TableColumn*
+///
+/////////////////////////////////////////////////
+TableColumn* MappedColumn::createCopy() const
+{
+    TableColumn* col = createValueTypeColumn(m_type, m_numElements);
+
+    for (size_t i = 0; i < m_numElements; i++)
+    {
+        col->setValue(i, readMapped(i));
+    }
+
+    col->assignMetaData(this);
+    return col;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Copies the mapped values into memory
+/// (if not already done) and releases the
+/// reference to the mapped file. Returns the
+/// in-memory column, which shall be used for all
+/// modifications.
+///
+/// \return TableColumn*
+///
+/////////////////////////////////////////////////
+TableColumn* MappedColumn::materialize()
+{
+    if (!m_column)
+    {
+        m_column.reset(createCopy());
+        m_file.reset();
+        m_mapped = nullptr;
+        m_numElements = 0;
+    }
+
+    return m_column.get();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the selected value as a string
+/// or a default value, if it does not exist.
+///
+/// \param elem size_t
+/// \return std::string
+///
+/////////////////////////////////////////////////
+std::string MappedColumn::getValueAsString(size_t elem) const
+{
+    return getValueAsInternalString(elem) + (m_sUnit.length() ? " " + m_sUnit : "");
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the contents as an internal
+/// string (i.e. without quotation marks and
+/// unit).
+///
+/// \param elem size_t
+/// \return std::string
+///
+/////////////////////////////////////////////////
+std::string MappedColumn::getValueAsInternalString(size_t elem) const
+{
+    if (m_column)
+        return m_column->getValueAsInternalString(elem);
+
+    if (elem < m_numElements)
+        return toString(readMapped(elem), 14);
+
+    return "nan";
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the contents as parser
+/// string (i.e. without quotation marks).
+///
+/// \param elem size_t
+/// \return std::string
+///
+/////////////////////////////////////////////////
+std::string MappedColumn::getValueAsParserString(size_t elem) const
+{
+    return getValueAsString(elem);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the contents as parser
+/// string (i.e. without quotation marks).
+///
+/// \param elem size_t
+/// \return std::string
+///
+/////////////////////////////////////////////////
+std::string MappedColumn::getValueAsStringLiteral(size_t elem) const
+{
+    if (elem < size())
+        return toString(getValue(elem), NumeReKernel::getInstance()->getSettings().getPrecision()) + (m_sUnit.length() ? " " + m_sUnit : "");
+
+    return "nan";
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the selected value as a
+/// numerical type or an invalid value, if it
+/// does not exist.
+///
+/// \param elem size_t
+/// \return std::complex<double>
+///
+/////////////////////////////////////////////////
+std::complex<double> MappedColumn::getValue(size_t elem) const
+{
+    if (m_column)
+        return m_column->getValue(elem);
+
+    if (elem < m_numElements)
+        return readMapped(elem);
+
+    return NAN;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the selected value as a
+/// mu::Value type or an invalid value, if it
+/// does not exist.
+///
+/// \param elem size_t
+/// \return mu::Value
+///
+/////////////////////////////////////////////////
+mu::Value MappedColumn::get(size_t elem) const
+{
+    if (m_column)
+        return m_column->get(elem);
+
+    if (elem < m_numElements)
+        return readMapped(elem);
+
+    return NAN;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the rows [first, last) as a
+/// span of real values. Refers directly to the
+/// mapped file, if the column stores native
+/// doubles and the block is suitably aligned.
+///
+/// \param first size_t
+/// \param last size_t
+/// \param span ColumnSpan<double>&
+/// \return void
+///
+/////////////////////////////////////////////////
+void MappedColumn::getSpan(size_t first, size_t last, ColumnSpan<double>& span) const
+{
+    if (m_column)
+        m_column->getSpan(first, last, span);
+    else if (m_elemSize == sizeof(double) && !(reinterpret_cast<uintptr_t>(m_mapped) % alignof(double)))
+    {
+        last = std::min(last, m_numElements);
+        first = std::min(first, last);
+
+        const double* data = reinterpret_cast<const double*>(m_mapped);
+        span.refer(data+first, last - first);
+
+        for (size_t i = first; i < last; i++)
+        {
+            if (!std::isnan(data[i]))
+                span.setValid(i-first);
+        }
+    }
+    else
+        mappedSpan(first, last, span);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the rows [first, last) as a
+/// span of integer values.
+///
+/// \param first size_t
+/// \param last size_t
+/// \param span ColumnSpan<int64_t>&
+/// \return void
+///
+/////////////////////////////////////////////////
+void MappedColumn::getSpan(size_t first, size_t last, ColumnSpan<int64_t>& span) const
+{
+    if (m_column)
+        m_column->getSpan(first, last, span);
+    else
+        mappedSpan(first, last, span);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the rows [first, last) as a
+/// span of complex values. Refers directly to
+/// the mapped file, if the column is complex and
+/// the block is suitably aligned.
+///
+/// \param first size_t
+/// \param last size_t
+/// \param span ColumnSpan<std::complex<double>>&
+/// \return void
+///
+/////////////////////////////////////////////////
+void MappedColumn::getSpan(size_t first, size_t last, ColumnSpan<std::complex<double>>& span) const
+{
+    if (m_column)
+        m_column->getSpan(first, last, span);
+    else if (m_type == TYPE_VALUE && !(reinterpret_cast<uintptr_t>(m_mapped) % alignof(std::complex<double>)))
+    {
+        last = std::min(last, m_numElements);
+        first = std::min(first, last);
+
+        const std::complex<double>* data = reinterpret_cast<const std::complex<double>*>(m_mapped);
+        span.refer(data+first, last - first);
+
+        for (size_t i = first; i < last; i++)
+        {
+            if (!mu::isnan(data[i]))
+                span.setValid(i-first);
+        }
+    }
+    else
+        mappedSpan(first, last, span);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Set a single string value. Will
+/// materialize the column.
+///
+/// \param elem size_t
+/// \param sValue const std::string&
+/// \return void
+///
+/////////////////////////////////////////////////
+void MappedColumn::setValue(size_t elem, const std::string& sValue)
+{
+    materialize()->setValue(elem, sValue);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Set a single numerical value. Will
+/// materialize the column.
+///
+/// \param elem size_t
+/// \param vValue const std::complex<double>&
+/// \return void
+///
+/////////////////////////////////////////////////
+void MappedColumn::setValue(size_t elem, const std::complex<double>& vValue)
+{
+    materialize()->setValue(elem, vValue);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Set a single mu::Value. Will
+/// materialize the column.
+///
+/// \param elem size_t
+/// \param val const mu::Value&
+/// \return void
+///
+/////////////////////////////////////////////////
+void MappedColumn::set(size_t elem, const mu::Value& val)
+{
+    materialize()->set(elem, val);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Creates a copy of the selected part of
+/// this column. Copying the whole mapped column
+/// only creates a new reference to the mapped
+/// file.
+///
+/// \param idx const VectorIndex&
+/// \return TableColumn*
+///
+/////////////////////////////////////////////////
+TableColumn* MappedColumn::copy(const VectorIndex& idx) const
+{
+    TableColumn* col;
+
+    if (m_column)
+        col = m_column->copy(idx);
+    else
+    {
+        idx.setOpenEndIndex(getNumFilledElements()-1);
+
+        if (idx.isExpanded() && idx.front() == 0 && idx.last() == (int)getNumFilledElements()-1)
+            col = new MappedColumn(m_file, m_mapped - m_file->data(), idx.size(), m_type, m_isNative);
+        else
+        {
+            col = createValueTypeColumn(m_type, idx.size());
+
+            for (size_t i = 0; i < idx.size(); i++)
+            {
+                col->setValue(i, getValue(idx[i]));
+            }
+        }
+    }
+
+    col->assignMetaData(this);
+    return col;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Assign another TableColumn's contents
+/// to this table column. The mapped file is not
+/// needed any more afterwards.
+///
+/// \param column const TableColumn*
+/// \return void
+///
+/////////////////////////////////////////////////
+void MappedColumn::assign(const TableColumn* column)
+{
+    if (column->m_type != m_type)
+        throw SyntaxError(SyntaxError::CANNOT_ASSIGN_COLUMN_OF_DIFFERENT_TYPE, m_sHeadLine, column->m_sHeadLine, typeToString(m_type) + "/" + typeToString(column->m_type));
+
+    m_column.reset(createValueTypeColumn(m_type));
+    m_column->assign(column);
+    m_file.reset();
+    m_mapped = nullptr;
+    m_numElements = 0;
+    assignMetaData(column);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Insert the contents of the passed
+/// column at the specified positions. Will
+/// materialize the column.
+///
+/// \param idx const VectorIndex&
+/// \param column const TableColumn*
+/// \return void
+///
+/////////////////////////////////////////////////
+void MappedColumn::insert(const VectorIndex& idx, const TableColumn* column)
+{
+    materialize()->insert(idx, column);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Delete the specified elements. Will
+/// materialize the column.
+///
+/// \param idx const VectorIndex&
+/// \return void
+///
+/////////////////////////////////////////////////
+void MappedColumn::deleteElements(const VectorIndex& idx)
+{
+    materialize()->deleteElements(idx);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Inserts as many as the selected
+/// elements at the desired position. Will
+/// materialize the column.
+///
+/// \param pos size_t
+/// \param elem size_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void MappedColumn::insertElements(size_t pos, size_t elem)
+{
+    materialize()->insertElements(pos, elem);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Appends the number of elements. Will
+/// materialize the column.
+///
+/// \param elem size_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void MappedColumn::appendElements(size_t elem)
+{
+    materialize()->appendElements(elem);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Removes the selected number of
+/// elements from the column and moving all
+/// following items forward. Will materialize the
+/// column.
+///
+/// \param pos size_t
+/// \param elem size_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void MappedColumn::removeElements(size_t pos, size_t elem)
+{
+    materialize()->removeElements(pos, elem);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Resizes the column. Shrinking a mapped
+/// column only reduces the referenced range,
+/// growing it will materialize the column.
+///
+/// \param elem size_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void MappedColumn::resize(size_t elem)
+{
+    if (!m_column && elem <= m_numElements)
+        m_numElements = elem;
+    else
+        materialize()->resize(elem);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns 0, if both elements are equal,
+/// -1 if element i is smaller than element j and
+/// 1 otherwise.
+///
+/// \param i int
+/// \param j int
+/// \param unused bool
+/// \return int
+///
+/////////////////////////////////////////////////
+int MappedColumn::compare(int i, int j, bool unused) const
+{
+    if (m_column)
+        return m_column->compare(i, j, unused);
+
+    if ((int)m_numElements <= std::max(i, j))
+        return 0;
+
+    std::complex<double> val_i = readMapped(i);
+    std::complex<double> val_j = readMapped(j);
+
+    if (val_i == val_j)
+        return 0;
+    else if (val_i.real() < val_j.real())
+        return -1;
+
+    return 1;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns true, if the selected element
+/// is a valid value.
+///
+/// \param elem int
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool MappedColumn::isValid(int elem) const
+{
+    if (m_column)
+        return m_column->isValid(elem);
+
+    if (elem < 0 || (size_t)elem >= m_numElements || mu::isnan(readMapped(elem)))
+        return false;
+
+    return true;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Interprets the value as a boolean.
+///
+/// \param elem int
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool MappedColumn::asBool(int elem) const
+{
+    if (m_column)
+        return m_column->asBool(elem);
+
+    if (elem < 0 || (size_t)elem >= m_numElements)
+        return false;
+
+    return readMapped(elem) != 0.0;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Return the number of elements in this
+/// column (will also count invalid ones).
+///
+/// \return size_t
+///
+/////////////////////////////////////////////////
+size_t MappedColumn::size() const
+{
+    if (m_column)
+        return m_column->size();
+
+    return m_numElements;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Return the number of bytes occupied by
+/// this column. The mapped values are not
+/// counted, because they are owned by the
+/// operating system's page cache.
+///
+/// \return size_t
+///
+/////////////////////////////////////////////////
+size_t MappedColumn::getBytes() const
+{
+    if (m_column)
+        return m_column->getBytes();
+
+    return m_sHeadLine.capacity() * sizeof(char);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the contents of this column
+/// converted to the new column type. Might even
+/// return itself.
+///
+/// \param type ColumnType
+/// \return TableColumn*
+///
+/////////////////////////////////////////////////
+TableColumn* MappedColumn::convert(ColumnType type)
+{
+    if (type == m_type)
+        return this;
+
+    if (m_column)
+    {
+        m_column->assignMetaData(this);
+        TableColumn* col = m_column->convert(type);
+
+        if (col == m_column.get())
+            return this;
+
+        return col;
+    }
+
+    if (TableColumn::isValueType(type))
+        return convertNumericType(type, this);
+
+    // All other conversions are done on an
+    // in-memory copy
+    TableColumn* tmp = createCopy();
+    TableColumn* col = tmp->convert(type);
+
+    if (col != tmp)
+        delete tmp;
+
+    return col;
+}
+
@@ -0,0 +1,176 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef MAPPEDCOLUMN_HPP
+#define MAPPEDCOLUMN_HPP
+
+#include "tablecolumn.hpp"
+#include <cstring>
+
+/////////////////////////////////////////////////
+/// \brief A read-only memory mapping of a whole
+/// file. The operating system will page in the
+/// mapped contents on demand. The mapping is
+/// released upon destruction.
+/////////////////////////////////////////////////
+class MappedFile
+{
+    private:
+        std::string m_sFileName;
+        void* m_hFile;
+        void* m_hMapping;
+        const char* m_data;
+        size_t m_size;
+
+        void close();
+
+    public:
+        MappedFile(const std::string& sFileName);
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        /////////////////////////////////////////////////
+        /// \brief Returns true, if the file could be
+        /// mapped into memory.
+        ///
+        /// \return bool
+        ///
+        /////////////////////////////////////////////////
+        bool isValid() const
+        {
+            return m_data != nullptr;
+        }
+
+        const char* data() const
+        {
+            return m_data;
+        }
+
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        const std::string& getFileName() const
+        {
+            return m_sFileName;
+        }
+};
+
+
+/////////////////////////////////////////////////
+/// \brief A numerical table column, whose values
+/// are not stored in memory but are read from a
+/// block of std::complex<double> values (or of
+/// double values for native F64 columns) in a
+/// memory-mapped file. The column is
+/// copy-on-write: the first modifying access
+/// materializes the values into a regular value
+/// column of the same type, which handles all
+/// further accesses.
+/////////////////////////////////////////////////
+class MappedColumn : public TableColumn
+{
+    private:
+        std::shared_ptr<MappedFile> m_file;
+        const char* m_mapped;
+        size_t m_numElements;
+        size_t m_elemSize;
+        bool m_isNative;
+        TblColPtr m_column;
+
+        /////////////////////////////////////////////////
+        /// \brief Reads a single value from the mapped
+        /// block. The block is not necessarily aligned,
+        /// therefore the value is copied bytewise.
+        ///
+        /// \param elem size_t
+        /// \return std::complex<double>
+        ///
+        /////////////////////////////////////////////////
+        std::complex<double> readMapped(size_t elem) const
+        {
+            double val[2] = {NAN, 0.0};
+            memcpy(val, m_mapped + elem*m_elemSize, m_elemSize);
+
+            if (m_type == TYPE_VALUE)
+                return std::complex<double>(val[0], val[1]);
+
+            return val[0];
+        }
+
+        template<class S>
+        void mappedSpan(size_t first, size_t last, ColumnSpan<S>& span) const;
+        TableColumn* createCopy() const;
+        TableColumn* materialize();
+
+    public:
+        MappedColumn(std::shared_ptr<MappedFile> file, size_t offset, size_t nElems, ColumnType type, bool isNative = false);
+        virtual ~MappedColumn() {}
+
+        /////////////////////////////////////////////////
+        /// \brief Returns true, as long as the values
+        /// are still read from the mapped file.
+        ///
+        /// \return bool
+        ///
+        /////////////////////////////////////////////////
+        bool isMapped() const
+        {
+            return !m_column;
+        }
+
+        virtual std::string getValueAsString(size_t elem) const override;
+        virtual std::string getValueAsInternalString(size_t elem) const override;
+        virtual std::string getValueAsParserString(size_t elem) const override;
+        virtual std::string getValueAsStringLiteral(size_t elem) const override;
+        virtual std::complex<double> getValue(size_t elem) const override;
+        virtual mu::Value get(size_t elem) const override;
+
+        virtual void getSpan(size_t first, size_t last, ColumnSpan<double>& span) const override;
+        virtual void getSpan(size_t first, size_t last, ColumnSpan<int64_t>& span) const override;
+        virtual void getSpan(size_t first, size_t last, ColumnSpan<std::complex<double>>& span) const override;
+
+        virtual void setValue(size_t elem, const std::string& sValue) override;
+        virtual void setValue(size_t elem, const std::complex<double>& vValue) override;
+        virtual void set(size_t elem, const mu::Value& val) override;
+
+        virtual TableColumn* copy(const VectorIndex& idx) const override;
+        virtual void assign(const TableColumn* column) override;
+        virtual void insert(const VectorIndex& idx, const TableColumn* column) override;
+        virtual void deleteElements(const VectorIndex& idx) override;
+
+        virtual void insertElements(size_t pos, size_t elem) override;
+        virtual void appendElements(size_t elem) override;
+        virtual void removeElements(size_t pos, size_t elem) override;
+        virtual void resize(size_t elem) override;
+
+        virtual int compare(int i, int j, bool unused) const override;
+        virtual bool isValid(int elem) const override;
+        virtual bool asBool(int elem) const override;
+
+        virtual size_t size() const override;
+        virtual size_t getBytes() const override;
+
+        virtual TableColumn* convert(ColumnType type = TableColumn::TYPE_NONE) override;
+};
+
+
+#endif // MAPPEDCOLUMN_HPP
+
@@ -21,6 +21,7 @@
 #include <gsl/gsl_sort.h>
 
 #include <regex>
+#include <unordered_map>
 
 #include "memory.hpp"
 #include "tablecolumnimpl.hpp"
@@ -1631,8 +1632,10 @@ std::vector<int> Memory::sortElements(const VectorIndex& _vLine, const VectorInd
             if (j && bReturnIndex)
                 continue;
 
-            // Sort the current column
-            if (!qSort(&vPrivateIndex[0], vPrivateIndex.size(), _vCol[j], 0, vPrivateIndex.size()-1, nSign))
+            // Sort the current column (use the generic
+            // quicksort, if no typed keys are available)
+            if (!multiKeySort(vPrivateIndex, std::vector<int>(1, _vCol[j]), nSign)
+                && !qSort(&vPrivateIndex[0], vPrivateIndex.size(), _vCol[j], 0, vPrivateIndex.size()-1, nSign))
                 throw SyntaxError(SyntaxError::CANNOT_SORT_CACHE, sSortingExpression, SyntaxError::invalid_position);
 
             // Abort after the first column, if
@@ -1684,23 +1687,45 @@ std::vector<int> Memory::sortElements(const VectorIndex& _vLine, const VectorInd
                     throw SyntaxError(SyntaxError::INVALID_INDEX, sSortingExpression, SyntaxError::invalid_position);
                 }
 
-                // Sort the current key list level
-                // independently
-                if (!qSort(&vIndex[0], vIndex.size(), _vCol[keys->cols[j]], 0, vIndex.size()-1, nSign))
+                // Collect the sorting keys: the current column
+                // and the first column of every subordinate level,
+                // which itself has subordinate columns
+                std::vector<int> vKeyCols(1, _vCol[keys->cols[j]]);
+
+                for (ColumnKeys* subKeyList = keys->subkeys; subKeyList && subKeyList->subkeys; subKeyList = subKeyList->subkeys)
                 {
-                    delete keys;
-                    throw SyntaxError(SyntaxError::CANNOT_SORT_CACHE, sSortingExpression, SyntaxError::invalid_position);
+                    if (subKeyList->cols.front() >= (int)_vCol.size() || subKeyList->cols.front() < 0)
+                    {
+                        delete keys;
+                        throw SyntaxError(SyntaxError::INVALID_INDEX, sSortingExpression, SyntaxError::invalid_position);
+                    }
+
+                    vKeyCols.push_back(_vCol[subKeyList->cols.front()]);
                 }
 
-                // Subkey list: sort the subordinate group
-                // depending on the higher-level key group
-                if (keys->subkeys && keys->subkeys->subkeys)
+                // Sort by all keys in a single pass. Fall back
+                // to the generic hierarchical quicksort, if no
+                // typed keys are available
+                if (!multiKeySort(vIndex, vKeyCols, nSign))
                 {
-                    if (!sortSubList(&vIndex[0], vIndex.size(), keys, 0, vIndex.size()-1, _vCol, nSign, getCols(false)))
+                    // Sort the current key list level
+                    // independently
+                    if (!qSort(&vIndex[0], vIndex.size(), _vCol[keys->cols[j]], 0, vIndex.size()-1, nSign))
                     {
                         delete keys;
                         throw SyntaxError(SyntaxError::CANNOT_SORT_CACHE, sSortingExpression, SyntaxError::invalid_position);
                     }
+
+                    // Subkey list: sort the subordinate group
+                    // depending on the higher-level key group
+                    if (keys->subkeys && keys->subkeys->subkeys)
+                    {
+                        if (!sortSubList(&vIndex[0], vIndex.size(), keys, 0, vIndex.size()-1, _vCol, nSign, getCols(false)))
+                        {
+                            delete keys;
+                            throw SyntaxError(SyntaxError::CANNOT_SORT_CACHE, sSortingExpression, SyntaxError::invalid_position);
+                        }
+                    }
                 }
 
                 // Break, if the index shall be returned
@@ -1825,6 +1850,140 @@ bool Memory::isValue(int line, int col)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Override for the virtual Sorter class
+/// member function. Extracts the typed sorting
+/// keys of the first nRows rows of the selected
+/// column. Categories are replaced by the rank
+/// of their names and strings are lowercased, if
+/// the sorting shall ignore the case.
+///
+/// \param col int
+/// \param nRows size_t
+/// \param key SortKey&
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool Memory::extractSortKey(int col, size_t nRows, SortKey& key)
+{
+    key.valid.assign(nRows, false);
+
+    // Non-existing columns only contain invalid keys
+    if (col < 0 || col >= (int)memArray.size() || !memArray[col])
+        return true;
+
+    const TableColumn* column = memArray[col].get();
+    size_t nSize = std::min(nRows, column->size());
+
+    if (column->m_type == TableColumn::TYPE_STRING)
+    {
+        key.type = SortKey::KEY_STRING;
+        key.stringKeys.resize(nRows);
+
+        for (size_t i = 0; i < nSize; i++)
+        {
+            if (!column->isValid(i))
+                continue;
+
+            key.valid[i] = true;
+            key.stringKeys[i] = bSortCaseInsensitive
+                ? toLowerCase(column->getValueAsInternalString(i))
+                : column->getValueAsInternalString(i);
+        }
+    }
+    else if (column->m_type == TableColumn::TYPE_CATEGORICAL)
+    {
+        // Rank the categories by their names once
+        std::vector<std::string> vCategories = static_cast<const CategoricalColumn*>(column)->getCategories();
+
+        if (bSortCaseInsensitive)
+        {
+            for (std::string& sCategory : vCategories)
+                sCategory = toLowerCase(sCategory);
+        }
+
+        std::vector<size_t> vOrder(vCategories.size());
+        std::vector<int64_t> vRank(vCategories.size());
+
+        for (size_t c = 0; c < vOrder.size(); c++)
+            vOrder[c] = c;
+
+        std::sort(vOrder.begin(), vOrder.end(), [&vCategories](size_t a, size_t b){return vCategories[a] < vCategories[b];});
+
+        for (size_t c = 0; c < vOrder.size(); c++)
+        {
+            // Equal names share their rank
+            vRank[vOrder[c]] = c && vCategories[vOrder[c]] == vCategories[vOrder[c-1]] ? vRank[vOrder[c-1]] : c;
+        }
+
+        key.type = SortKey::KEY_INT;
+        key.intKeys.resize(nRows);
+
+        for (size_t i = 0; i < nSize; i++)
+        {
+            if (!column->isValid(i))
+                continue;
+
+            key.valid[i] = true;
+            key.intKeys[i] = vRank[column->getValue(i).real()-1];
+        }
+    }
+    else if (column->m_type == TableColumn::TYPE_LOGICAL
+             || column->m_type == TableColumn::TYPE_VALUE_I8
+             || column->m_type == TableColumn::TYPE_VALUE_UI8
+             || column->m_type == TableColumn::TYPE_VALUE_I16
+             || column->m_type == TableColumn::TYPE_VALUE_UI16
+             || column->m_type == TableColumn::TYPE_VALUE_I32
+             || column->m_type == TableColumn::TYPE_VALUE_UI32
+             || column->m_type == TableColumn::TYPE_VALUE_I64)
+    {
+        ColumnSpan<int64_t> span;
+        column->getSpan(0, nSize, span);
+
+        key.type = SortKey::KEY_INT;
+        key.intKeys.assign(span.data(), span.data()+span.size());
+        key.intKeys.resize(nRows);
+
+        for (size_t i = 0; i < span.size(); i++)
+            key.valid[i] = span.isValid(i);
+    }
+    else if (column->m_type == TableColumn::TYPE_VALUE_UI64)
+    {
+        // Values above the range of double would collide
+        // as floating point keys. The integer span wraps
+        // them, i.e. casting back restores them exactly
+        ColumnSpan<int64_t> span;
+        column->getSpan(0, nSize, span);
+
+        key.type = SortKey::KEY_UINT;
+        key.uintKeys.resize(nRows);
+
+        for (size_t i = 0; i < span.size(); i++)
+        {
+            key.uintKeys[i] = (uint64_t)span[i];
+            key.valid[i] = span.isValid(i);
+        }
+    }
+    else if (TableColumn::isValueType(column->m_type) || column->m_type == TableColumn::TYPE_DATETIME)
+    {
+        // Complex values are sorted by their real part
+        ColumnSpan<double> span;
+        column->getSpan(0, nSize, span);
+
+        key.type = SortKey::KEY_FLOAT;
+        key.floatKeys.assign(span.data(), span.data()+span.size());
+        key.floatKeys.resize(nRows);
+
+        for (size_t i = 0; i < span.size(); i++)
+            key.valid[i] = span.isValid(i);
+    }
+    else
+        return false;
+
+    return true;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Create a copy-efficient table object
 /// from the data contents.
@@ -2288,10 +2447,11 @@ bool Memory::reorderRows(const VectorIndex& _vRows, const VectorIndex& _vNewOrde
 /// \param sTableName const string&
 /// \param nPrecision unsigned short
 /// \param sExt std::string
+/// \param bCompress bool
 /// \return bool
 ///
 /////////////////////////////////////////////////
-bool Memory::save(string _sFileName, const string& sTableName, unsigned short nPrecision, std::string sExt)
+bool Memory::save(string _sFileName, const string& sTableName, unsigned short nPrecision, std::string sExt, bool bCompress)
 {
     // Get an instance of the desired file type
     NumeRe::GenericFile* file = NumeRe::getFileByType(_sFileName, sExt);
@@ -2312,10 +2472,15 @@ bool Memory::save(string _sFileName, const string& sTableName, unsigned short nP
 
     // If the file type is a NumeRe data file, then
     // we can also set the comment associated with
-    // this memory page
+    // this memory page and activate the compression
     if (file->getExtension() == "ndat" || toLowerCase(sExt) == "ndat")
+    {
         static_cast<NumeRe::NumeReDataFile*>(file)->setComment(m_meta.comment);
 
+        if (bCompress)
+            static_cast<NumeRe::NumeReDataFile*>(file)->useCompression();
+    }
+
     // Try to write the data to the file. This might
     // either result in writing errors or the write
     // function is not defined for this file type
@@ -2405,81 +2570,161 @@ void Memory::deleteBulk(const VectorIndex& _vLine, const VectorIndex& _vCol)
 
 
 /////////////////////////////////////////////////
-/// \brief Driver code for simplifying the
-/// calculation of various stats using OpenMP, if
-/// possible.
+/// \brief Number of rows, which are read at once
+/// from a column via its span interface.
+/////////////////////////////////////////////////
+static const size_t SPAN_BLOCK_SIZE = 1 << 16;
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper to determine, whether the
+/// passed row index selects strictly consecutive
+/// and increasing rows starting at a non-negative
+/// position. Only those selections may be read
+/// as a single span. Every position is checked,
+/// because an expanded index may still contain
+/// explicitly stored, permuted indices in front of
+/// its open end.
 ///
 /// \param _vLine const VectorIndex&
-/// \param _vCol const VectorIndex&
-/// \param operation std::vector<StatsLogic>&
-/// \return void
+/// \return bool
 ///
 /////////////////////////////////////////////////
-void Memory::calculateStats(const VectorIndex& _vLine, const VectorIndex& _vCol, std::vector<StatsLogic>& operation) const
+static bool isConsecutiveRange(const VectorIndex& _vLine)
 {
-    constexpr size_t MINTHREADCOUNT = 16;
-    constexpr size_t MINELEMENTPERCOL = 1000;
+    size_t nLines = _vLine.size();
 
-    // Only apply multiprocessing, if there are really a lot of
-    // elements to process
-    if (operation.size() >= MINTHREADCOUNT && _vLine.size() >= MINELEMENTPERCOL)
+    if (!_vLine.isExpanded() || !nLines)
+        return false;
+
+    int first = _vLine.front();
+
+    if (first < 0)
+        return false;
+
+    for (size_t i = 1; i < nLines; i++)
     {
-        #pragma omp parallel for
-        for (size_t j = 0; j < _vCol.size(); j++)
-        {
-            if (_vCol[j] < 0)
-                continue;
+        if (_vLine[i] != first + (int)i)
+            return false;
+    }
 
-            int elems = getElemsInColumn(_vCol[j]);
+    return true;
+}
 
-            if (!elems)
-                continue;
 
-            for (size_t i = 0; i < _vLine.size(); i++)
-            {
-                if (_vLine[i] < 0)
-                    continue;
+/////////////////////////////////////////////////
+/// \brief Static helper to call the passed
+/// function for every valid element of the
+/// column, which is selected by the row index.
+/// Contiguous row selections are read in blocks
+/// via the span interface of the column, all
+/// other selections row by row. The function
+/// gets the position within the row index and the
+/// value and returns false to stop the iteration.
+///
+/// \param col const TableColumn*
+/// \param _vLine const VectorIndex&
+/// \param fun Fun
+/// \return void
+///
+/////////////////////////////////////////////////
+template<class T, class Fun>
+static void forEachValidElement(const TableColumn* col, const VectorIndex& _vLine, Fun fun)
+{
+    size_t nLines = _vLine.size();
+    size_t nElems = col->size();
+    ColumnSpan<T> span;
 
-                if (_vLine[i] >= elems)
-                {
-                    if (_vLine.isExpanded() && _vLine.isOrdered())
-                        break;
+    if (!nLines || !nElems)
+        return;
 
-                    continue;
-                }
+    int first = _vLine[0];
+
+    if (isConsecutiveRange(_vLine))
+    {
+        size_t last = std::min(first + nLines, nElems);
+
+        for (size_t block = first; block < last; block += SPAN_BLOCK_SIZE)
+        {
+            col->getSpan(block, std::min(block + SPAN_BLOCK_SIZE, last), span);
 
-                operation[j](readMem(_vLine[i], _vCol[j]).as_cmplx());
+            for (size_t i = 0; i < span.size(); i++)
+            {
+                if (span.isValid(i) && !fun(block - first + i, span[i]))
+                    return;
             }
         }
+
+        return;
     }
-    else
+
+    for (size_t i = 0; i < nLines; i++)
     {
-        for (size_t j = 0; j < _vCol.size(); j++)
-        {
-            if (_vCol[j] < 0)
-                continue;
+        if (_vLine[i] < 0 || _vLine[i] >= (int)nElems)
+            continue;
 
-            int elems = getElemsInColumn(_vCol[j]);
+        col->getSpan(_vLine[i], _vLine[i]+1, span);
 
-            if (!elems)
-                continue;
+        if (span.isValid(0) && !fun(i, span[0]))
+            return;
+    }
+}
 
-            for (size_t i = 0; i < _vLine.size(); i++)
-            {
-                if (_vLine[i] < 0)
-                    continue;
 
-                if (_vLine[i] >= elems)
-                {
-                    if (_vLine.isExpanded() && _vLine.isOrdered())
-                        break;
+/////////////////////////////////////////////////
+/// \brief Static helper to call the passed
+/// function for every valid numerical value of
+/// the column, which is selected by the row
+/// index. Complex columns are read as complex
+/// spans, all other ones as real spans.
+///
+/// \param col const TableColumn*
+/// \param _vLine const VectorIndex&
+/// \param fun Fun
+/// \return void
+///
+/////////////////////////////////////////////////
+template<class Fun>
+static void forEachValidValue(const TableColumn* col, const VectorIndex& _vLine, Fun fun)
+{
+    if (col->m_type == TableColumn::TYPE_VALUE_CF32 || col->m_type == TableColumn::TYPE_VALUE_CF64)
+        forEachValidElement<std::complex<double>>(col, _vLine, fun);
+    else
+        forEachValidElement<double>(col, _vLine, fun);
+}
 
-                    continue;
-                }
 
-                operation[j](readMem(_vLine[i], _vCol[j]).as_cmplx());
-            }
-        }
+/////////////////////////////////////////////////
+/// \brief Driver code for simplifying the
+/// calculation of various stats using OpenMP, if
+/// possible.
+///
+/// \param _vLine const VectorIndex&
+/// \param _vCol const VectorIndex&
+/// \param operation std::vector<StatsLogic>&
+/// \return void
+///
+/////////////////////////////////////////////////
+void Memory::calculateStats(const VectorIndex& _vLine, const VectorIndex& _vCol, std::vector<StatsLogic>& operation) const
+{
+    constexpr size_t MINTHREADCOUNT = 16;
+    constexpr size_t MINELEMENTPERCOL = 1000;
+
+    // Only apply multiprocessing, if there are really a lot of
+    // elements to process
+    #pragma omp parallel for if(operation.size() >= MINTHREADCOUNT && _vLine.size() >= MINELEMENTPERCOL)
+    for (size_t j = 0; j < _vCol.size(); j++)
+    {
+        if (_vCol[j] < 0 || !getElemsInColumn(_vCol[j]))
+            continue;
+
+        StatsLogic& logic = operation[j];
+
+        forEachValidValue(memArray[_vCol[j]].get(), _vLine, [&logic](size_t i, const std::complex<double>& val)
+                          {
+                              logic(val);
+                              return true;
+                          });
     }
 }
 
@@ -2498,6 +2743,50 @@ std::complex<double> Memory::std(const VectorIndex& _vLine, const VectorIndex& _
     if (!memArray.size())
         return NAN;
 
+    _vLine.setOpenEndIndex(getLines(false)-1);
+    _vCol.setOpenEndIndex(getCols(false)-1);
+
+    bool isComplex = false;
+
+    for (size_t j = 0; j < _vCol.size(); j++)
+    {
+        if (_vCol[j] >= 0 && _vCol[j] < (int)memArray.size() && memArray[_vCol[j]]
+            && (memArray[_vCol[j]]->m_type == TableColumn::TYPE_VALUE_CF32
+                || memArray[_vCol[j]]->m_type == TableColumn::TYPE_VALUE_CF64))
+        {
+            isComplex = true;
+            break;
+        }
+    }
+
+    if (!isComplex)
+    {
+        // Real-valued columns only need a single pass
+        std::vector<StatsAccumulator> vAcc(_vCol.size());
+
+        #pragma omp parallel for if(_vCol.size() > 1)
+        for (size_t j = 0; j < _vCol.size(); j++)
+        {
+            if (_vCol[j] < 0 || !getElemsInColumn(_vCol[j]))
+                continue;
+
+            StatsAccumulator& acc = vAcc[j];
+
+            forEachValidElement<double>(memArray[_vCol[j]].get(), _vLine, [&acc](size_t i, double val)
+                                        {
+                                            acc.push(val);
+                                            return true;
+                                        });
+        }
+
+        for (size_t j = 1; j < vAcc.size(); j++)
+        {
+            vAcc.front().merge(vAcc[j]);
+        }
+
+        return vAcc.size() ? std::sqrt(vAcc.front().variance()) : NAN;
+    }
+
     std::complex<double> dAvg = avg(_vLine, _vCol);
     std::complex<double> dStd = 0.0;
 
@@ -2687,35 +2976,37 @@ std::complex<double> Memory::num(const VectorIndex& _vLine, const VectorIndex& _
     if (!memArray.size())
         return 0;
 
-    int nInvalid = 0;
-
     int lines = getLines(false);
     int cols = getCols(false);
 
     _vLine.setOpenEndIndex(lines-1);
     _vCol.setOpenEndIndex(cols-1);
 
+    size_t nValid = 0;
+    int first = _vLine.front();
+    bool isRange = isConsecutiveRange(_vLine);
+
     for (size_t j = 0; j < _vCol.size(); j++)
     {
-        if (_vCol[j] < 0)
+        if (_vCol[j] < 0 || !getElemsInColumn(_vCol[j]))
             continue;
 
-        int elems = getElemsInColumn(_vCol[j]);
-
-        if (!elems)
+        // Consecutive rows can be counted directly
+        // from the validity bitmaps
+        if (isRange)
         {
-            nInvalid += _vLine.size();
+            nValid += memArray[_vCol[j]]->getNumValidElements(first, first + _vLine.size());
             continue;
         }
 
-        for (size_t i = 0; i < _vLine.size(); i++)
-        {
-            if (_vLine[i] < 0 || _vLine[i] >= elems || !isValidElement(_vLine[i], _vCol[j]))
-                nInvalid++;
-        }
+        forEachValidElement<double>(memArray[_vCol[j]].get(), _vLine, [&nValid](size_t i, double val)
+                                    {
+                                        nValid++;
+                                        return true;
+                                    });
     }
 
-    return (_vLine.size() * _vCol.size()) - nInvalid;
+    return nValid;
 }
 
 
@@ -2948,6 +3239,14 @@ std::complex<double> Memory::cnt(const VectorIndex& _vLine, const VectorIndex& _
             continue;
         }
 
+        // Consecutive rows only need the overlap with
+        // the column
+        if (isConsecutiveRange(_vLine))
+        {
+            nInvalid += _vLine.size() - std::max(0, std::min(_vLine.last()+1, elems) - _vLine.front());
+            continue;
+        }
+
         for (size_t i = 0; i < _vLine.size(); i++)
         {
             if (_vLine[i] < 0 || _vLine[i] >= elems)
@@ -3046,102 +3345,73 @@ std::complex<double> Memory::cmp(const VectorIndex& _vLine, const VectorIndex& _
             break;
     }
 
-    for (long long int j = 0; j < _vCol.size(); j++)
-    {
-        if (_vCol[j] < 0)
-            continue;
-
-        int elems = getElemsInColumn(_vCol[j]);
+    std::complex<double> dResult;
+    bool bFound = false;
 
-        if (!elems)
+    for (size_t j = 0; j < _vCol.size(); j++)
+    {
+        if (_vCol[j] < 0 || !getElemsInColumn(_vCol[j]))
             continue;
 
-        for (long long int i = 0; i < _vLine.size(); i++)
-        {
-            if (_vLine[i] < 0)
-                continue;
-
-            if (_vLine[i] >= elems)
-            {
-                if (_vLine.isExpanded() && _vLine.isOrdered())
-                    break;
-
-                continue;
-            }
+        forEachValidValue(memArray[_vCol[j]].get(), _vLine, [&](size_t i, const std::complex<double>& val)
+                          {
+                              if (mu::isnan(val))
+                                  return true;
+
+                              // Return the column position for single rows
+                              size_t nPos = _vLine[0] == _vLine[_vLine.size() - 1] ? j : i;
+
+                              if (val == dRef)
+                              {
+                                  dResult = nType & RETURN_VALUE ? val : std::complex<double>(nPos+1);
+                                  bFound = true;
+                                  return false;
+                              }
+                              else if (nType & RETURN_GE && val.real() > dRef.real())
+                              {
+                                  if (nType & RETURN_FIRST)
+                                  {
+                                      dResult = nType & RETURN_VALUE ? val.real() : nPos+1;
+                                      bFound = true;
+                                      return false;
+                                  }
+
+                                  if (nKeep == -1 || val.real() < dKeep)
+                                  {
+                                      dKeep = val.real();
+                                      nKeep = nPos;
+                                  }
+                              }
+                              else if (nType & RETURN_LE && val.real() < dRef.real())
+                              {
+                                  if (nType & RETURN_FIRST)
+                                  {
+                                      dResult = nType & RETURN_VALUE ? val.real() : nPos+1;
+                                      bFound = true;
+                                      return false;
+                                  }
+
+                                  if (nKeep == -1 || val.real() > dKeep)
+                                  {
+                                      dKeep = val.real();
+                                      nKeep = nPos;
+                                  }
+                              }
+
+                              return true;
+                          });
+
+        if (bFound)
+            return dResult;
+    }
 
-            std::complex<double> val = readMem(_vLine[i], _vCol[j]).getNum().asCF64();
-
-            if (mu::isnan(val))
-                continue;
-
-            if (val == dRef)
-            {
-                if (nType & RETURN_VALUE)
-                    return val;
-
-                if (_vLine[0] == _vLine[_vLine.size() - 1])
-                    return j+1;
-
-                return i+1;
-            }
-            else if (nType & RETURN_GE && val.real() > dRef.real())
-            {
-                if (nType & RETURN_FIRST)
-                {
-                    if (nType & RETURN_VALUE)
-                        return val.real();
-
-                    if (_vLine[0] == _vLine[_vLine.size() - 1])
-                        return j+1;
-
-                    return i+1;
-                }
-
-                if (nKeep == -1 || val.real() < dKeep)
-                {
-                    dKeep = val.real();
-                    if (_vLine[0] == _vLine[_vLine.size() - 1])
-                        nKeep = j;
-                    else
-                        nKeep = i;
-                }
-                else
-                    continue;
-            }
-            else if (nType & RETURN_LE && val.real() < dRef.real())
-            {
-                if (nType & RETURN_FIRST)
-                {
-                    if (nType & RETURN_VALUE)
-                        return val.real();
-
-                    if (_vLine[0] == _vLine[_vLine.size() - 1])
-                        return j+1;
-
-                    return i+1;
-                }
-
-                if (nKeep == -1 || val.real() > dKeep)
-                {
-                    dKeep = val.real();
-                    if (_vLine[0] == _vLine[_vLine.size() - 1])
-                        nKeep = j;
-                    else
-                        nKeep = i;
-                }
-                else
-                    continue;
-            }
-        }
-    }
-
-    if (nKeep == -1)
-        return NAN;
-    else if (nType & RETURN_VALUE)
-        return dKeep;
-    else
-        return nKeep+1;
-}
+    if (nKeep == -1)
+        return NAN;
+    else if (nType & RETURN_VALUE)
+        return dKeep;
+    else
+        return nKeep+1;
+}
 
 
 /////////////////////////////////////////////////
@@ -3170,43 +3440,22 @@ std::complex<double> Memory::med(const VectorIndex& _vLine, const VectorIndex& _
 
     for (size_t j = 0; j < _vCol.size(); j++)
     {
-        if (_vCol[j] < 0)
+        if (_vCol[j] < 0 || !getElemsInColumn(_vCol[j]))
             continue;
 
-        int elems = getElemsInColumn(_vCol[j]);
-
-        if (!elems)
-            continue;
+        forEachValidElement<double>(memArray[_vCol[j]].get(), _vLine, [&vData](size_t i, double val)
+                                    {
+                                        if (!std::isnan(val))
+                                            vData.push_back(val);
 
-        for (size_t i = 0; i < _vLine.size(); i++)
-        {
-            if (_vLine[i] < 0)
-                continue;
-
-            if (_vLine[i] >= elems)
-            {
-                if (_vLine.isExpanded() && _vLine.isOrdered())
-                    break;
-
-                continue;
-            }
-
-            std::complex<double> val = readMem(_vLine[i], _vCol[j]).getNum().asCF64();
-
-            if (!mu::isnan(val))
-                vData.push_back(val.real());
-        }
+                                        return true;
+                                    });
     }
 
     if (!vData.size())
         return NAN;
 
-    size_t nCount = qSortDouble(&vData[0], vData.size());
-
-    if (!nCount)
-        return NAN;
-
-    return gsl_stats_median_from_sorted_data(&vData[0], 1, nCount);
+    return selectQuantile(vData, 0.5);
 }
 
 
@@ -3238,6 +3487,51 @@ std::complex<double> Memory::pct(const VectorIndex& _vLine, const VectorIndex& _
     if (dPct.real() >= 1 || dPct.real() <= 0)
         return NAN;
 
+    for (size_t j = 0; j < _vCol.size(); j++)
+    {
+        if (_vCol[j] < 0 || !getElemsInColumn(_vCol[j]))
+            continue;
+
+        forEachValidElement<double>(memArray[_vCol[j]].get(), _vLine, [&vData](size_t i, double val)
+                                    {
+                                        if (!std::isnan(val))
+                                            vData.push_back(val);
+
+                                        return true;
+                                    });
+    }
+
+    if (!vData.size())
+        return NAN;
+
+    return selectQuantile(vData, dPct.real());
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Calculates the descriptive statistics
+/// of every selected column in a single pass
+/// over the data. The order statistics are
+/// selected at once from a single copy of the
+/// values per column. Columns are processed in
+/// parallel.
+///
+/// \param _vLine const VectorIndex&
+/// \param _vCol const VectorIndex&
+/// \return std::vector<ColumnStatistics>
+///
+/////////////////////////////////////////////////
+std::vector<ColumnStatistics> Memory::describe(const VectorIndex& _vLine, const VectorIndex& _vCol) const
+{
+    if (!memArray.size())
+        return std::vector<ColumnStatistics>();
+
+    _vLine.setOpenEndIndex(getLines(false)-1);
+    _vCol.setOpenEndIndex(getCols(false)-1);
+
+    std::vector<ColumnStatistics> vStats(_vCol.size());
+
+    #pragma omp parallel for if(_vCol.size() > 1)
     for (size_t j = 0; j < _vCol.size(); j++)
     {
         if (_vCol[j] < 0)
@@ -3248,36 +3542,52 @@ std::complex<double> Memory::pct(const VectorIndex& _vLine, const VectorIndex& _
         if (!elems)
             continue;
 
+        ColumnStatistics& stats = vStats[j];
+        StatsAccumulator acc;
+        std::vector<double> vData;
+
         for (size_t i = 0; i < _vLine.size(); i++)
         {
-            if (_vLine[i] < 0)
-                continue;
-
-            if (_vLine[i] >= elems)
-            {
-                if (_vLine.isExpanded() && _vLine.isOrdered())
-                    break;
-
-                continue;
-            }
+            if (_vLine[i] >= 0 && _vLine[i] < elems)
+                stats.m_cnt++;
+        }
 
-            std::complex<double> val = readMem(_vLine[i], _vCol[j]).getNum().asCF64();
+        vData.reserve(stats.m_cnt);
 
-            if (!mu::isnan(val))
-                vData.push_back(val.real());
-        }
-    }
+        forEachValidElement<double>(memArray[_vCol[j]].get(), _vLine, [&](size_t i, double val)
+                                    {
+                                        stats.m_num++;
 
-    if (!vData.size())
-        return NAN;
+                                        if (!std::isnan(val))
+                                        {
+                                            acc.push(val);
+                                            vData.push_back(val);
+                                        }
 
+                                        return true;
+                                    });
 
-    size_t nCount = qSortDouble(&vData[0], vData.size());
+        if (!acc.m_count)
+            continue;
 
-    if (!nCount)
-        return NAN;
+        stats.m_avg = acc.m_mean;
+        stats.m_std = std::sqrt(acc.variance());
+        stats.m_min = acc.m_min;
+        stats.m_max = acc.m_max;
+        stats.m_norm = std::sqrt(acc.sumOfSquares());
+        stats.m_confidence = std::count_if(vData.begin(), vData.end(),
+                                           [&stats](double val){return std::abs(val - stats.m_avg) <= stats.m_std;})
+                                / (double)stats.m_num;
+        stats.m_skew = acc.m_m3 / (acc.m_count * intPower(stats.m_std, 3));
+        stats.m_excess = acc.m_m4 / (acc.m_count * intPower(stats.m_std, 4)) - 3.0;
+
+        std::vector<double> vQuartiles = selectQuantiles(vData, {0.25, 0.5, 0.75});
+        stats.m_q1 = vQuartiles[0];
+        stats.m_med = vQuartiles[1];
+        stats.m_q3 = vQuartiles[2];
+    }
 
-    return gsl_stats_quantile_from_sorted_data(&vData[0], 1, nCount, dPct.real());
+    return vStats;
 }
 
 
@@ -3651,6 +3961,17 @@ std::vector<size_t> Memory::countIfEqual(const VectorIndex& _vCols, const mu::Ar
         {
             size_t count = 0;
 
+            // Categorical columns resolve a string only once
+            // and count the category ids afterwards
+            if (!val.isNumerical()
+                && val.getStr().length()
+                && memArray[_vCols[j]]->m_type == TableColumn::TYPE_CATEGORICAL)
+            {
+                const CategoricalColumn* col = static_cast<const CategoricalColumn*>(memArray[_vCols[j]].get());
+                vCounted.push_back(col->countCategory(col->findCategory(val.getStr())));
+                continue;
+            }
+
             for (size_t i = 0; i < memArray[_vCols[j]]->size(); i++)
             {
                 if (val.isNumerical()
@@ -4267,6 +4588,982 @@ std::vector<int64_t> Memory::getBins(size_t col, size_t nBins) const
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Converts the name of an aggregation
+/// into the corresponding enumeration value.
+///
+/// \param sAggregation const std::string&
+/// \return Memory::GroupAggregation
+///
+/////////////////////////////////////////////////
+Memory::GroupAggregation Memory::stringToGroupAggregation(const std::string& sAggregation)
+{
+    static const std::map<std::string, GroupAggregation> mAggregations = {{"sum", AGG_SUM},
+                                                                          {"avg", AGG_AVG},
+                                                                          {"std", AGG_STD},
+                                                                          {"min", AGG_MIN},
+                                                                          {"max", AGG_MAX},
+                                                                          {"med", AGG_MED},
+                                                                          {"count", AGG_COUNT},
+                                                                          {"first", AGG_FIRST},
+                                                                          {"last", AGG_LAST}};
+
+    auto iter = mAggregations.find(sAggregation);
+
+    if (iter != mAggregations.end())
+        return iter->second;
+
+    return AGG_INVALID;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Marks rows, which do not belong to any
+/// group.
+/////////////////////////////////////////////////
+static const size_t NO_GROUP = -1;
+
+
+/////////////////////////////////////////////////
+/// \brief Hash functor for using complex values
+/// as group keys.
+/////////////////////////////////////////////////
+struct GroupKeyHash
+{
+    size_t operator()(const std::complex<double>& val) const
+    {
+        return std::hash<double>()(val.real()) ^ (std::hash<double>()(val.imag()) << 1);
+    }
+};
+
+
+/////////////////////////////////////////////////
+/// \brief Assigns a dense code to every distinct
+/// key value. The codes follow the order of the
+/// first appearance. Integer keys are compared by
+/// their native value, other numerical keys by
+/// their complex value and all others by their
+/// internal string representation. Encoding
+/// multiple columns with the same instance (e.g.
+/// the key columns of two tables) results in
+/// comparable codes.
+/////////////////////////////////////////////////
+class KeyEncoder
+{
+    public:
+        enum KeyMode
+        {
+            KEY_INTEGER,
+            KEY_NUMERICAL,
+            KEY_STRING
+        };
+
+    private:
+        std::unordered_map<int64_t, size_t> m_intCodes;
+        std::unordered_map<uint64_t, size_t> m_bigCodes;
+        std::unordered_map<std::complex<double>, size_t, GroupKeyHash> m_numCodes;
+        std::unordered_map<std::string, size_t> m_strCodes;
+        KeyMode m_mode;
+
+        /////////////////////////////////////////////////
+        /// \brief Encodes the rows of an integer
+        /// column from its native values. Unsigned
+        /// values above the range of int64_t are
+        /// wrapped by the integer span and are
+        /// therefore kept in a separate map to avoid
+        /// collisions with negative values.
+        ///
+        /// \param col const TableColumn*
+        /// \param vCodes std::vector<size_t>&
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void encodeInteger(const TableColumn* col, std::vector<size_t>& vCodes)
+        {
+            size_t nRows = std::min(vCodes.size(), col->size());
+            bool isUnsigned = col->m_type == TableColumn::TYPE_VALUE_UI64;
+
+            if (!nRows)
+                return;
+
+            forEachValidElement<int64_t>(col, VectorIndex(0, (int)nRows-1), [&](size_t i, int64_t val)
+                                         {
+                                             if (isUnsigned && val < 0)
+                                                 vCodes[i] = m_bigCodes.emplace((uint64_t)val, size()).first->second;
+                                             else
+                                                 vCodes[i] = m_intCodes.emplace(val, size()).first->second;
+
+                                             return true;
+                                         });
+        }
+
+    public:
+        KeyEncoder(KeyMode mode) : m_mode(mode) {}
+
+        /////////////////////////////////////////////////
+        /// \brief Determines the mode for encoding the
+        /// passed key columns together. Integer keys
+        /// are only encoded natively, if all columns
+        /// are integer-typed.
+        ///
+        /// \param col const TableColumn*
+        /// \param otherCol const TableColumn*
+        /// \return KeyMode
+        ///
+        /////////////////////////////////////////////////
+        static KeyMode getMode(const TableColumn* col, const TableColumn* otherCol = nullptr)
+        {
+            if (col->m_type >= TableColumn::TYPE_CATEGORICAL
+                || (otherCol && otherCol->m_type >= TableColumn::TYPE_CATEGORICAL))
+                return KEY_STRING;
+
+            if (TableColumn::isIntegerType(col->m_type)
+                && (!otherCol || TableColumn::isIntegerType(otherCol->m_type)))
+                return KEY_INTEGER;
+
+            return KEY_NUMERICAL;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Encodes the rows of the passed
+        /// column. Invalid rows keep NO_GROUP.
+        ///
+        /// \param col const TableColumn*
+        /// \param vCodes std::vector<size_t>&
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void encode(const TableColumn* col, std::vector<size_t>& vCodes)
+        {
+            if (m_mode == KEY_INTEGER)
+            {
+                encodeInteger(col, vCodes);
+                return;
+            }
+
+            size_t nRows = std::min(vCodes.size(), col->size());
+
+            for (size_t i = 0; i < nRows; i++)
+            {
+                if (!col->isValid(i))
+                    continue;
+
+                if (m_mode == KEY_STRING)
+                    vCodes[i] = m_strCodes.emplace(col->getValueAsInternalString(i), m_strCodes.size()).first->second;
+                else
+                    vCodes[i] = m_numCodes.emplace(col->getValue(i), m_numCodes.size()).first->second;
+            }
+        }
+
+        size_t size() const
+        {
+            if (m_mode == KEY_INTEGER)
+                return m_intCodes.size() + m_bigCodes.size();
+
+            return m_mode == KEY_STRING ? m_strCodes.size() : m_numCodes.size();
+        }
+};
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper to assign a dense code to
+/// every distinct value of the passed key column.
+///
+/// \param col const TableColumn*
+/// \param vCodes std::vector<size_t>&
+/// \return size_t
+///
+/////////////////////////////////////////////////
+static size_t encodeGroupKeys(const TableColumn* col, std::vector<size_t>& vCodes)
+{
+    KeyEncoder encoder(KeyEncoder::getMode(col));
+    encoder.encode(col, vCodes);
+    return encoder.size();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper to combine the codes of
+/// an additional key column into the composite
+/// codes of the previous key columns. The map
+/// of combined codes may be shared between
+/// multiple calls to get comparable codes.
+///
+/// \param vCodes std::vector<size_t>&
+/// \param vKeyCodes const std::vector<size_t>&
+/// \param nKeyCodes size_t
+/// \param mCombined std::unordered_map<uint64_t, size_t>&
+/// \return void
+///
+/////////////////////////////////////////////////
+static void combineKeyCodes(std::vector<size_t>& vCodes, const std::vector<size_t>& vKeyCodes, size_t nKeyCodes, std::unordered_map<uint64_t, size_t>& mCombined)
+{
+    for (size_t i = 0; i < vCodes.size(); i++)
+    {
+        if (vCodes[i] == NO_GROUP || vKeyCodes[i] == NO_GROUP)
+            vCodes[i] = NO_GROUP;
+        else
+            vCodes[i] = mCombined.emplace((uint64_t)vCodes[i] * nKeyCodes + vKeyCodes[i], mCombined.size()).first->second;
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper to calculate a single
+/// aggregation of the passed column for every
+/// group. Selecting aggregations (first, last,
+/// min, max) keep the type of the column, count
+/// returns integers and all others (possibly
+/// complex) floating point values.
+///
+/// \param col const TableColumn*
+/// \param vGroups const std::vector<size_t>&
+/// \param nGroups size_t
+/// \param agg Memory::GroupAggregation
+/// \return TableColumn*
+///
+/////////////////////////////////////////////////
+static TableColumn* aggregateGroups(const TableColumn* col, const std::vector<size_t>& vGroups, size_t nGroups, Memory::GroupAggregation agg)
+{
+    if (!col)
+        return new F64ValueColumn(nGroups);
+
+    size_t nRows = std::min(vGroups.size(), col->size());
+    VectorIndex vRows(0, (int)nRows-1);
+    bool isNumerical = col->m_type < TableColumn::TYPE_CATEGORICAL;
+
+    switch (agg)
+    {
+        case Memory::AGG_FIRST:
+        case Memory::AGG_LAST:
+        case Memory::AGG_MIN:
+        case Memory::AGG_MAX:
+        {
+            std::vector<int> vSelected(nGroups, -1);
+            std::vector<double> vExtrema(nGroups, NAN);
+
+            for (size_t i = 0; i < nRows; i++)
+            {
+                size_t g = vGroups[i];
+
+                if (g == NO_GROUP || !col->isValid(i))
+                    continue;
+
+                if (vSelected[g] == -1 || agg == Memory::AGG_LAST)
+                {
+                    vSelected[g] = i;
+
+                    if (isNumerical)
+                        vExtrema[g] = col->getValue(i).real();
+                }
+                else if (agg == Memory::AGG_MIN || agg == Memory::AGG_MAX)
+                {
+                    int res;
+
+                    if (isNumerical)
+                    {
+                        double val = col->getValue(i).real();
+                        res = val < vExtrema[g] ? -1 : (val > vExtrema[g] ? 1 : 0);
+
+                        if ((agg == Memory::AGG_MIN && res < 0) || (agg == Memory::AGG_MAX && res > 0))
+                            vExtrema[g] = val;
+                    }
+                    else
+                        res = col->compare(i, vSelected[g], false);
+
+                    if ((agg == Memory::AGG_MIN && res < 0) || (agg == Memory::AGG_MAX && res > 0))
+                        vSelected[g] = i;
+                }
+            }
+
+            if (!nRows)
+                return new F64ValueColumn(nGroups);
+
+            // Use a single copied row as template to keep the
+            // column type, resize it to the number of groups
+            // and copy the selected rows one by one. Groups
+            // without any valid value stay invalid
+            TableColumn* res = col->copy(VectorIndex(0, 0));
+            res->resize(0);
+            res->resize(nGroups);
+
+            for (size_t g = 0; g < nGroups; g++)
+            {
+                if (vSelected[g] != -1)
+                    res->set(g, col->get(vSelected[g]));
+            }
+
+            return res;
+        }
+        case Memory::AGG_COUNT:
+        {
+            std::vector<size_t> vCount(nGroups, 0);
+
+            for (size_t i = 0; i < nRows; i++)
+            {
+                if (vGroups[i] != NO_GROUP && col->isValid(i))
+                    vCount[vGroups[i]]++;
+            }
+
+            TableColumn* res = new I64ValueColumn(nGroups);
+
+            for (size_t g = 0; g < nGroups; g++)
+            {
+                res->setValue(g, vCount[g]);
+            }
+
+            return res;
+        }
+        case Memory::AGG_SUM:
+        case Memory::AGG_AVG:
+        {
+            std::vector<std::complex<double>> vSum(nGroups, 0.0);
+            std::vector<size_t> vCount(nGroups, 0);
+
+            if (nRows)
+                forEachValidValue(col, vRows, [&](size_t i, const std::complex<double>& val)
+                                  {
+                                      if (vGroups[i] != NO_GROUP)
+                                      {
+                                          vSum[vGroups[i]] += val;
+                                          vCount[vGroups[i]]++;
+                                      }
+
+                                      return true;
+                                  });
+
+            TableColumn* res;
+
+            if (col->m_type == TableColumn::TYPE_VALUE_CF32 || col->m_type == TableColumn::TYPE_VALUE_CF64)
+                res = new ValueColumn(nGroups);
+            else
+                res = new F64ValueColumn(nGroups);
+
+            for (size_t g = 0; g < nGroups; g++)
+            {
+                if (agg == Memory::AGG_SUM)
+                    res->setValue(g, vSum[g]);
+                else if (vCount[g])
+                    res->setValue(g, vSum[g] / (double)vCount[g]);
+            }
+
+            return res;
+        }
+        case Memory::AGG_STD:
+        {
+            std::vector<StatsAccumulator> vAcc(nGroups);
+
+            if (nRows)
+                forEachValidElement<double>(col, vRows, [&](size_t i, double val)
+                                            {
+                                                if (vGroups[i] != NO_GROUP)
+                                                    vAcc[vGroups[i]].push(val);
+
+                                                return true;
+                                            });
+
+            TableColumn* res = new F64ValueColumn(nGroups);
+
+            for (size_t g = 0; g < nGroups; g++)
+            {
+                res->setValue(g, std::sqrt(vAcc[g].variance()));
+            }
+
+            return res;
+        }
+        case Memory::AGG_MED:
+        {
+            std::vector<std::vector<double>> vData(nGroups);
+
+            if (nRows)
+                forEachValidElement<double>(col, vRows, [&](size_t i, double val)
+                                            {
+                                                if (vGroups[i] != NO_GROUP && !std::isnan(val))
+                                                    vData[vGroups[i]].push_back(val);
+
+                                                return true;
+                                            });
+
+            TableColumn* res = new F64ValueColumn(nGroups);
+
+            for (size_t g = 0; g < nGroups; g++)
+            {
+                res->setValue(g, selectQuantile(vData[g], 0.5));
+            }
+
+            return res;
+        }
+        case Memory::AGG_INVALID:
+            break;
+    }
+
+    return new F64ValueColumn(nGroups);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Groups the rows of this table by the
+/// distinct value combinations of the key
+/// columns (split-apply-combine) and calculates
+/// the selected aggregations per group. The
+/// i-th aggregation is applied to the i-th
+/// column in _vCols. Rows with an invalid key
+/// are ignored. The groups are ordered by their
+/// first appearance. The returned table contains
+/// the key columns followed by one column per
+/// aggregation.
+///
+/// \param _vKeys const VectorIndex&
+/// \param _vCols const VectorIndex&
+/// \param vAggregations const std::vector<GroupAggregation>&
+/// \return Memory*
+///
+/////////////////////////////////////////////////
+Memory* Memory::groupBy(const VectorIndex& _vKeys, const VectorIndex& _vCols, const std::vector<GroupAggregation>& vAggregations) const
+{
+    static const char* AGGREGATIONNAMES[] = {"", "sum", "avg", "std", "min", "max", "med", "count", "first", "last"};
+
+    _vKeys.setOpenEndIndex(getCols(false)-1);
+    _vCols.setOpenEndIndex(getCols(false)-1);
+
+    if (!_vKeys.size())
+        throw SyntaxError(SyntaxError::TOO_FEW_COLS, "", SyntaxError::invalid_position);
+
+    for (size_t k = 0; k < _vKeys.size(); k++)
+    {
+        if (_vKeys[k] < 0 || _vKeys[k] >= (int)memArray.size() || !memArray[_vKeys[k]])
+            throw SyntaxError(SyntaxError::INVALID_INDEX, "", SyntaxError::invalid_position, _vKeys[k]+1);
+    }
+
+    // Resolve the aggregated columns and ensure that
+    // all numerical aggregations get numerical values
+    std::vector<const TableColumn*> vAggCols(vAggregations.size(), nullptr);
+
+    if (_vCols.size() != vAggregations.size())
+        throw SyntaxError(SyntaxError::COL_COUNTS_DOESNT_MATCH, "", SyntaxError::invalid_position);
+
+    for (size_t j = 0; j < vAggregations.size(); j++)
+    {
+        if (_vCols[j] < 0 || _vCols[j] >= (int)memArray.size())
+            throw SyntaxError(SyntaxError::INVALID_INDEX, "", SyntaxError::invalid_position, _vCols[j]+1);
+
+        vAggCols[j] = memArray[_vCols[j]].get();
+
+        if (vAggCols[j]
+            && vAggCols[j]->m_type >= TableColumn::TYPE_CATEGORICAL
+            && (vAggregations[j] == AGG_SUM
+                || vAggregations[j] == AGG_AVG
+                || vAggregations[j] == AGG_STD
+                || vAggregations[j] == AGG_MED))
+            throw SyntaxError(SyntaxError::WRONG_COLUMN_TYPE, "", SyntaxError::invalid_position, vAggCols[j]->m_sHeadLine);
+    }
+
+    size_t nRows = getLines(false);
+
+    // Encode the values of every key column
+    std::vector<std::vector<size_t>> vKeyCodes(_vKeys.size(), std::vector<size_t>(nRows, NO_GROUP));
+    std::vector<size_t> vKeyCounts(_vKeys.size());
+
+    #pragma omp parallel for if(_vKeys.size() > 1)
+    for (size_t k = 0; k < _vKeys.size(); k++)
+    {
+        vKeyCounts[k] = encodeGroupKeys(memArray[_vKeys[k]].get(), vKeyCodes[k]);
+    }
+
+    // Combine the codes of all keys into a single
+    // group id per row
+    std::vector<size_t>& vGroups = vKeyCodes.front();
+    size_t nGroups = vKeyCounts.front();
+
+    for (size_t k = 1; k < _vKeys.size(); k++)
+    {
+        std::unordered_map<uint64_t, size_t> mCombined;
+        combineKeyCodes(vGroups, vKeyCodes[k], vKeyCounts[k], mCombined);
+        nGroups = mCombined.size();
+    }
+
+    // Find the first row of every group to extract
+    // the key values
+    std::vector<int> vFirstRows(nGroups, -1);
+
+    for (size_t i = 0; i < nRows; i++)
+    {
+        if (vGroups[i] != NO_GROUP && vFirstRows[vGroups[i]] == -1)
+            vFirstRows[vGroups[i]] = i;
+    }
+
+    Memory* _mem = new Memory();
+    _mem->memArray.resize(_vKeys.size() + vAggregations.size());
+
+    for (size_t k = 0; k < _vKeys.size(); k++)
+    {
+        _mem->memArray[k].reset(memArray[_vKeys[k]]->copy(VectorIndex(vFirstRows)));
+    }
+
+    // Calculate all aggregations in parallel
+    #pragma omp parallel for if(vAggregations.size() > 1 && nRows >= 1000)
+    for (size_t j = 0; j < vAggregations.size(); j++)
+    {
+        TblColPtr& col = _mem->memArray[_vKeys.size()+j];
+        col.reset(aggregateGroups(vAggCols[j], vGroups, nGroups, vAggregations[j]));
+
+        if (vAggCols[j])
+        {
+            col->m_sHeadLine = AGGREGATIONNAMES[vAggregations[j]] + ("(" + vAggCols[j]->m_sHeadLine + ")");
+            col->m_sUnit = vAggregations[j] == AGG_COUNT ? "" : vAggCols[j]->m_sUnit;
+        }
+        else
+            col->m_sHeadLine = AGGREGATIONNAMES[vAggregations[j]];
+    }
+
+    _mem->m_meta.modify();
+    return _mem;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Converts the name of a join type into
+/// the corresponding enumeration value.
+///
+/// \param sJoinType const std::string&
+/// \return Memory::JoinType
+///
+/////////////////////////////////////////////////
+Memory::JoinType Memory::stringToJoinType(const std::string& sJoinType)
+{
+    if (sJoinType == "inner")
+        return JOIN_INNER;
+    else if (sJoinType == "left")
+        return JOIN_LEFT;
+    else if (sJoinType == "outer")
+        return JOIN_OUTER;
+
+    return JOIN_INVALID;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper to determine, whether the
+/// passed column type may be merged as a key of
+/// doubles. Integer keys are excluded, because
+/// they would lose their precision above 2^53.
+///
+/// \param type TableColumn::ColumnType
+/// \return bool
+///
+/////////////////////////////////////////////////
+static bool isMergeableKey(TableColumn::ColumnType type)
+{
+    return type == TableColumn::TYPE_VALUE_F32
+        || type == TableColumn::TYPE_VALUE_F64
+        || type == TableColumn::TYPE_DATETIME;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper to read the valid values
+/// of a real-valued key column together with
+/// their rows. Returns true, if the values are
+/// sorted ascendingly.
+///
+/// \param col const TableColumn*
+/// \param nRows size_t
+/// \param vRows std::vector<int>&
+/// \param vValues std::vector<double>&
+/// \return bool
+///
+/////////////////////////////////////////////////
+static bool readSortedKey(const TableColumn* col, size_t nRows, std::vector<int>& vRows, std::vector<double>& vValues)
+{
+    bool isSorted = true;
+
+    if (!nRows)
+        return isSorted;
+
+    forEachValidElement<double>(col, VectorIndex(0, (int)nRows-1), [&](size_t i, double val)
+                                {
+                                    if (vValues.size() && val < vValues.back())
+                                    {
+                                        isSorted = false;
+                                        return false;
+                                    }
+
+                                    vRows.push_back(i);
+                                    vValues.push_back(val);
+                                    return true;
+                                });
+
+    return isSorted;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper to join two tables by a
+/// single, ascendingly sorted key column using a
+/// merge of both keys. Creates the same row
+/// pairs in the same order as hashJoin().
+///
+/// \param nRows size_t
+/// \param vKeyRows const std::vector<int>&
+/// \param vKeyValues const std::vector<double>&
+/// \param nOtherRows size_t
+/// \param vOtherKeyRows const std::vector<int>&
+/// \param vOtherKeyValues const std::vector<double>&
+/// \param type Memory::JoinType
+/// \param vRows std::vector<int>&
+/// \param vOtherRows std::vector<int>&
+/// \return void
+///
+/////////////////////////////////////////////////
+static void mergeJoin(size_t nRows, const std::vector<int>& vKeyRows, const std::vector<double>& vKeyValues,
+                      size_t nOtherRows, const std::vector<int>& vOtherKeyRows, const std::vector<double>& vOtherKeyValues,
+                      Memory::JoinType type, std::vector<int>& vRows, std::vector<int>& vOtherRows)
+{
+    std::vector<bool> vMatched(nOtherRows, false);
+    size_t nKey = 0;
+    size_t nOtherKey = 0;
+
+    for (size_t i = 0; i < nRows; i++)
+    {
+        bool bMatched = false;
+
+        if (nKey < vKeyRows.size() && vKeyRows[nKey] == (int)i)
+        {
+            double val = vKeyValues[nKey++];
+
+            while (nOtherKey < vOtherKeyValues.size() && vOtherKeyValues[nOtherKey] < val)
+                nOtherKey++;
+
+            // Pair the row with all rows of the equal run
+            for (size_t j = nOtherKey; j < vOtherKeyValues.size() && vOtherKeyValues[j] == val; j++)
+            {
+                vRows.push_back(i);
+                vOtherRows.push_back(vOtherKeyRows[j]);
+                vMatched[vOtherKeyRows[j]] = true;
+                bMatched = true;
+            }
+        }
+
+        if (!bMatched && type != Memory::JOIN_INNER)
+        {
+            vRows.push_back(i);
+            vOtherRows.push_back(-1);
+        }
+    }
+
+    if (type == Memory::JOIN_OUTER)
+    {
+        for (size_t j = 0; j < nOtherRows; j++)
+        {
+            if (!vMatched[j])
+            {
+                vRows.push_back(-1);
+                vOtherRows.push_back(j);
+            }
+        }
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper to join two tables by
+/// their comparable key codes. The rows of the
+/// other table are bucketed by their codes, all
+/// rows of this table are probed in parallel.
+///
+/// \param vCodes const std::vector<size_t>&
+/// \param vOtherCodes const std::vector<size_t>&
+/// \param nCodes size_t
+/// \param type Memory::JoinType
+/// \param vRows std::vector<int>&
+/// \param vOtherRows std::vector<int>&
+/// \return void
+///
+/////////////////////////////////////////////////
+static void hashJoin(const std::vector<size_t>& vCodes, const std::vector<size_t>& vOtherCodes, size_t nCodes,
+                     Memory::JoinType type, std::vector<int>& vRows, std::vector<int>& vOtherRows)
+{
+    // Create the buckets. The rows in every bucket
+    // keep their order
+    std::vector<size_t> vBucketStart(nCodes+1, 0);
+
+    for (size_t code : vOtherCodes)
+    {
+        if (code != NO_GROUP)
+            vBucketStart[code+1]++;
+    }
+
+    for (size_t c = 0; c < nCodes; c++)
+    {
+        vBucketStart[c+1] += vBucketStart[c];
+    }
+
+    std::vector<int> vBucketRows(vBucketStart.back());
+    std::vector<size_t> vFill(vBucketStart.begin(), vBucketStart.end()-1);
+
+    for (size_t j = 0; j < vOtherCodes.size(); j++)
+    {
+        if (vOtherCodes[j] != NO_GROUP)
+            vBucketRows[vFill[vOtherCodes[j]]++] = j;
+    }
+
+    // Count the resulting rows for every probed row
+    std::vector<size_t> vOffsets(vCodes.size()+1, 0);
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < vCodes.size(); i++)
+    {
+        size_t nMatches = 0;
+
+        if (vCodes[i] != NO_GROUP)
+            nMatches = vBucketStart[vCodes[i]+1] - vBucketStart[vCodes[i]];
+
+        vOffsets[i+1] = nMatches || type == Memory::JOIN_INNER ? nMatches : 1;
+    }
+
+    for (size_t i = 0; i < vCodes.size(); i++)
+    {
+        vOffsets[i+1] += vOffsets[i];
+    }
+
+    vRows.resize(vOffsets.back());
+    vOtherRows.resize(vOffsets.back());
+
+    // Write the row pairs
+    #pragma omp parallel for
+    for (size_t i = 0; i < vCodes.size(); i++)
+    {
+        size_t pos = vOffsets[i];
+
+        if (pos == vOffsets[i+1])
+            continue;
+
+        if (vCodes[i] == NO_GROUP || vBucketStart[vCodes[i]] == vBucketStart[vCodes[i]+1])
+        {
+            vRows[pos] = i;
+            vOtherRows[pos] = -1;
+            continue;
+        }
+
+        for (size_t b = vBucketStart[vCodes[i]]; b < vBucketStart[vCodes[i]+1]; b++, pos++)
+        {
+            vRows[pos] = i;
+            vOtherRows[pos] = vBucketRows[b];
+        }
+    }
+
+    if (type == Memory::JOIN_OUTER)
+    {
+        std::vector<bool> vMatchedCodes(nCodes, false);
+
+        for (size_t code : vCodes)
+        {
+            if (code != NO_GROUP)
+                vMatchedCodes[code] = true;
+        }
+
+        for (size_t j = 0; j < vOtherCodes.size(); j++)
+        {
+            if (vOtherCodes[j] == NO_GROUP || !vMatchedCodes[vOtherCodes[j]])
+            {
+                vRows.push_back(-1);
+                vOtherRows.push_back(j);
+            }
+        }
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper to copy the joined rows
+/// of a column. A row of -1 has no counterpart in
+/// the column's table and stays invalid. The
+/// result always has one row per joined row,
+/// because VectorIndex would read exactly two
+/// missing rows as an invalid range.
+///
+/// \param col const TableColumn*
+/// \param vRows const std::vector<int>&
+/// \return TableColumn*
+///
+/////////////////////////////////////////////////
+static TableColumn* copyJoinedRows(const TableColumn* col, const std::vector<int>& vRows)
+{
+    if (std::find_if(vRows.begin(), vRows.end(), [](int row){return row >= 0;}) != vRows.end())
+        return col->copy(VectorIndex(vRows));
+
+    // No row has a counterpart: use a single copied row
+    // as template to keep the column type
+    TableColumn* res = col->copy(VectorIndex(0, 0));
+    res->resize(0);
+    res->resize(vRows.size());
+    return res;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Joins this table with another table by
+/// comparing the i-th key column of this table
+/// with the i-th key column of the other table.
+/// Uses a merge of the keys, if there is a
+/// single, real-valued and already sorted key in
+/// both tables, and a parallel hash join
+/// otherwise. The returned table contains all
+/// columns of this table followed by the non-key
+/// columns of the other table. The column types
+/// and units are preserved. Headlines existing in
+/// both tables get the suffixes "_1" and "_2".
+///
+/// \param other const Memory&
+/// \param _vKeys const VectorIndex&
+/// \param _vOtherKeys const VectorIndex&
+/// \param type JoinType
+/// \return Memory*
+///
+/////////////////////////////////////////////////
+Memory* Memory::join(const Memory& other, const VectorIndex& _vKeys, const VectorIndex& _vOtherKeys, JoinType type) const
+{
+    _vKeys.setOpenEndIndex(getCols(false)-1);
+    _vOtherKeys.setOpenEndIndex(other.getCols(false)-1);
+
+    if (!_vKeys.size())
+        throw SyntaxError(SyntaxError::TOO_FEW_COLS, "", SyntaxError::invalid_position);
+
+    if (_vKeys.size() != _vOtherKeys.size())
+        throw SyntaxError(SyntaxError::COL_COUNTS_DOESNT_MATCH, "", SyntaxError::invalid_position);
+
+    for (size_t k = 0; k < _vKeys.size(); k++)
+    {
+        if (_vKeys[k] < 0 || _vKeys[k] >= (int)memArray.size() || !memArray[_vKeys[k]])
+            throw SyntaxError(SyntaxError::INVALID_INDEX, "", SyntaxError::invalid_position, _vKeys[k]+1);
+
+        if (_vOtherKeys[k] < 0 || _vOtherKeys[k] >= (int)other.memArray.size() || !other.memArray[_vOtherKeys[k]])
+            throw SyntaxError(SyntaxError::INVALID_INDEX, "", SyntaxError::invalid_position, _vOtherKeys[k]+1);
+    }
+
+    size_t nRows = getLines(false);
+    size_t nOtherRows = other.getLines(false);
+    std::vector<int> vRows;
+    std::vector<int> vOtherRows;
+
+    const TableColumn* key = memArray[_vKeys[0]].get();
+    const TableColumn* otherKey = other.memArray[_vOtherKeys[0]].get();
+    bool isRealKey = isMergeableKey(key->m_type) && isMergeableKey(otherKey->m_type);
+
+    std::vector<int> vKeyRows, vOtherKeyRows;
+    std::vector<double> vKeyValues, vOtherKeyValues;
+
+    if (_vKeys.size() == 1
+        && isRealKey
+        && readSortedKey(key, nRows, vKeyRows, vKeyValues)
+        && readSortedKey(otherKey, nOtherRows, vOtherKeyRows, vOtherKeyValues))
+        mergeJoin(nRows, vKeyRows, vKeyValues, nOtherRows, vOtherKeyRows, vOtherKeyValues, type, vRows, vOtherRows);
+    else
+    {
+        // Encode the keys of both tables with a shared
+        // encoder per key column to get comparable codes
+        std::vector<std::vector<size_t>> vKeyCodes(_vKeys.size(), std::vector<size_t>(nRows, NO_GROUP));
+        std::vector<std::vector<size_t>> vOtherKeyCodes(_vKeys.size(), std::vector<size_t>(nOtherRows, NO_GROUP));
+        std::vector<size_t> vKeyCounts(_vKeys.size());
+
+        #pragma omp parallel for if(_vKeys.size() > 1)
+        for (size_t k = 0; k < _vKeys.size(); k++)
+        {
+            const TableColumn* col = memArray[_vKeys[k]].get();
+            const TableColumn* otherCol = other.memArray[_vOtherKeys[k]].get();
+
+            KeyEncoder encoder(KeyEncoder::getMode(col, otherCol));
+            encoder.encode(col, vKeyCodes[k]);
+            encoder.encode(otherCol, vOtherKeyCodes[k]);
+            vKeyCounts[k] = encoder.size();
+        }
+
+        size_t nCodes = vKeyCounts.front();
+
+        for (size_t k = 1; k < _vKeys.size(); k++)
+        {
+            std::unordered_map<uint64_t, size_t> mCombined;
+            combineKeyCodes(vKeyCodes.front(), vKeyCodes[k], vKeyCounts[k], mCombined);
+            combineKeyCodes(vOtherKeyCodes.front(), vOtherKeyCodes[k], vKeyCounts[k], mCombined);
+            nCodes = mCombined.size();
+        }
+
+        hashJoin(vKeyCodes.front(), vOtherKeyCodes.front(), nCodes, type, vRows, vOtherRows);
+    }
+
+    // Collect the columns of the result
+    std::vector<const TableColumn*> vColumns;
+    std::vector<bool> vIsOther;
+
+    for (size_t j = 0; j < memArray.size(); j++)
+    {
+        vColumns.push_back(memArray[j].get());
+        vIsOther.push_back(false);
+    }
+
+    for (size_t j = 0; j < other.memArray.size(); j++)
+    {
+        bool isKey = false;
+
+        for (size_t k = 0; k < _vOtherKeys.size(); k++)
+            isKey = isKey || _vOtherKeys[k] == (int)j;
+
+        if (!isKey)
+        {
+            vColumns.push_back(other.memArray[j].get());
+            vIsOther.push_back(true);
+        }
+    }
+
+    Memory* _mem = new Memory();
+    _mem->memArray.resize(vColumns.size());
+
+    #pragma omp parallel for
+    for (size_t j = 0; j < vColumns.size(); j++)
+    {
+        if (vColumns[j])
+            _mem->memArray[j].reset(copyJoinedRows(vColumns[j], vIsOther[j] ? vOtherRows : vRows));
+    }
+
+    // Disambiguate the headlines, which exist in both
+    // tables
+    for (size_t j = 0; j < vColumns.size(); j++)
+    {
+        if (!vIsOther[j] || !vColumns[j])
+            continue;
+
+        for (size_t i = 0; i < vColumns.size(); i++)
+        {
+            if (vIsOther[i] || !vColumns[i] || vColumns[i]->m_sHeadLine != vColumns[j]->m_sHeadLine)
+                continue;
+
+            _mem->memArray[i]->m_sHeadLine = vColumns[i]->m_sHeadLine + "_1";
+            _mem->memArray[j]->m_sHeadLine = vColumns[j]->m_sHeadLine + "_2";
+        }
+    }
+
+    // Rows, which only exist in the other table, get
+    // their key values from the other table
+    if (type == JOIN_OUTER)
+    {
+        for (size_t k = 0; k < _vKeys.size(); k++)
+        {
+            TableColumn* col = _mem->memArray[_vKeys[k]].get();
+            const TableColumn* otherCol = other.memArray[_vOtherKeys[k]].get();
+
+            for (size_t i = 0; i < vRows.size(); i++)
+            {
+                if (vRows[i] == -1)
+                    col->set(i, otherCol->get(vOtherRows[i]));
+            }
+        }
+    }
+
+    _mem->m_meta.modify();
+    return _mem;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief This method is the retouching main
 /// method. It will redirect the control into the
@@ -53,6 +53,28 @@ struct KMeansResult
     long double inertia;
 };
 
+/////////////////////////////////////////////////
+/// \brief Contains the descriptive statistics of
+/// a single column as calculated by
+/// Memory::describe().
+/////////////////////////////////////////////////
+struct ColumnStatistics
+{
+    double m_avg = NAN;
+    double m_std = NAN;
+    double m_med = NAN;
+    double m_q1 = NAN;
+    double m_q3 = NAN;
+    double m_min = NAN;
+    double m_max = NAN;
+    double m_norm = NAN;
+    double m_skew = NAN;
+    double m_excess = NAN;
+    double m_confidence = NAN; ///< Fraction of values within avg +/- std
+    size_t m_num = 0;
+    size_t m_cnt = 0;
+};
+
 /////////////////////////////////////////////////
 /// \brief This class represents a single table
 /// in memory, or a - so to say - single memory
@@ -84,6 +106,28 @@ class Memory : public Sorter
             INIT_KMEANSPP
         };
 
+        enum GroupAggregation
+        {
+            AGG_INVALID,
+            AGG_SUM,
+            AGG_AVG,
+            AGG_STD,
+            AGG_MIN,
+            AGG_MAX,
+            AGG_MED,
+            AGG_COUNT,
+            AGG_FIRST,
+            AGG_LAST
+        };
+
+        enum JoinType
+        {
+            JOIN_INVALID,
+            JOIN_INNER,
+            JOIN_LEFT,
+            JOIN_OUTER
+        };
+
 	private:
 	    friend class MemoryManager;
 	    friend class NumeRe::FileAdapter;
@@ -108,6 +152,7 @@ class Memory : public Sorter
 		void reorderColumn(const VectorIndex& vIndex, const VectorIndex& original, int col = 0);
 		virtual int compare(int i, int j, int col) override;
         virtual bool isValue(int line, int col) override;
+        virtual bool extractSortKey(int col, size_t nRows, SortKey& key) override;
 		void smoothingWindow1D(const VectorIndex& _vLine, const VectorIndex& _vCol, size_t i, size_t j, NumeRe::Filter* _filter, bool smoothLines);
 		void smoothingWindow2D(const VectorIndex& _vLine, const VectorIndex& _vCol, size_t i, size_t j, NumeRe::Filter* _filter);
 		void calculateStats(const VectorIndex& _vLine, const VectorIndex& _vCol, std::vector<StatsLogic>& operation) const;
@@ -168,7 +213,7 @@ class Memory : public Sorter
 		void setMetaData(const NumeRe::TableMetaData& meta);
 		void markModified();
 
-		bool save(std::string _sFileName, const std::string& sTableName, unsigned short nPrecision, std::string sExt = "");
+		bool save(std::string _sFileName, const std::string& sTableName, unsigned short nPrecision, std::string sExt = "", bool bCompress = false);
         bool getSaveStatus() const;
         void setSaveStatus(bool _bIsSaved);
         long long int getLastSaved() const;
@@ -204,6 +249,7 @@ class Memory : public Sorter
         std::complex<double> cmp(const VectorIndex& _vLine, const VectorIndex& _vCol, std::complex<double> dRef = 0.0, int _nType = 0) const;
         std::complex<double> med(const VectorIndex& _vLine, const VectorIndex& _vCol) const;
         std::complex<double> pct(const VectorIndex& _vLine, const VectorIndex& _vCol, std::complex<double> dPct = 0.5) const;
+        std::vector<ColumnStatistics> describe(const VectorIndex& _vLine, const VectorIndex& _vCol) const;
         std::vector<std::complex<double>> size(const VectorIndex& _everyIdx, const VectorIndex& _cellsIdx, int dir) const;
         std::vector<std::complex<double>> minpos(const VectorIndex& _everyIdx, const VectorIndex& _cellsIdx, int dir) const;
         std::vector<std::complex<double>> maxpos(const VectorIndex& _everyIdx, const VectorIndex& _cellsIdx, int dir) const;
@@ -216,6 +262,8 @@ class Memory : public Sorter
         std::vector<double> getRank(size_t col, const VectorIndex& _vIndex, RankingStrategy _strat) const;
         std::vector<std::complex<double>> getZScore(size_t col, const VectorIndex& _vIndex) const;
         std::vector<int64_t> getBins(size_t col, size_t nBins) const;
+        Memory* groupBy(const VectorIndex& _vKeys, const VectorIndex& _vCols, const std::vector<GroupAggregation>& vAggregations) const;
+        Memory* join(const Memory& other, const VectorIndex& _vKeys, const VectorIndex& _vOtherKeys, JoinType type) const;
 
         bool smooth(VectorIndex _vLine, VectorIndex _vCol, NumeRe::FilterSettings _settings, AppDir Direction = ALL);
         bool retouch(VectorIndex _vLine, VectorIndex _vCol, AppDir Direction = ALL);
@@ -225,6 +273,8 @@ class Memory : public Sorter
 
 
         static KmeansInit stringToKmeansInit(const std::string& init_type);
+        static GroupAggregation stringToGroupAggregation(const std::string& sAggregation);
+        static JoinType stringToJoinType(const std::string& sJoinType);
         KMeansResult getKMeans(const VectorIndex& colCategories, size_t nClusters, size_t maxIterations, Memory::KmeansInit init_method) const;
 };
 
@@ -116,6 +116,15 @@ MemoryManager::MemoryManager() : NumeRe::FileAdapter(), NumeRe::ClusterManager()
 /////////////////////////////////////////////////
 MemoryManager::~MemoryManager()
 {
+    // Files, which are still loaded in the background,
+    // are not needed any more
+    for (auto& iter : mPendingTables)
+    {
+        *iter.second.cancelled = true;
+    }
+
+    mPendingTables.clear();
+
     if (cache_file.is_open())
         cache_file.close();
 
@@ -141,6 +150,15 @@ void MemoryManager::removeTablesFromMemory()
 
         bSaveMutex = true;
 
+        // Cancel all loads, which are still running
+        // in the background
+        for (auto& iter : mPendingTables)
+        {
+            *iter.second.cancelled = true;
+        }
+
+        mPendingTables.clear();
+
 		// --> Speicher, wo denn noetig freigeben <--
 		for (size_t i = 0; i < vMemory.size(); i++)
             delete vMemory[i];
@@ -346,41 +364,96 @@ void MemoryManager::setCacheFileName(string _sFileName)
 /// \brief This member function saves the
 /// contents of this class to the cache file so
 /// that they may be restored after a restart.
+/// The tables are copied to copy-on-write
+/// snapshots first, which may be written by a
+/// worker thread without blocking the session.
 ///
+/// \param bInBackground bool
 /// \return bool
 ///
 /////////////////////////////////////////////////
-bool MemoryManager::saveToCacheFile()
+bool MemoryManager::saveToCacheFile(bool bInBackground)
 {
     if (bSaveMutex)
         return false;
 
-    bSaveMutex = true;
+    // Only one cache file may be written at a time.
+    // The background autosave does not wait for the
+    // previous one
+    if (m_cacheSave.valid())
+    {
+        if (bInBackground && m_cacheSave.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return false;
 
-    sCache_file = ValidFileName(sCache_file, ".cache");
+        finishCacheSave();
+    }
 
-    NumeRe::CacheFile cacheFile(sCache_file);
+    bSaveMutex = true;
 
-    cacheFile.setNumberOfTables(mCachesMap.size() - isTable("data"));
-    cacheFile.writeCacheHeader();
+    sCache_file = ValidFileName(sCache_file, ".cache");
 
-    int nLines;
-    int nCols;
+    std::vector<std::pair<std::string, std::shared_ptr<Memory>>> vSnapshots;
 
+    // Create the snapshots. They share the column
+    // buffers with the original tables
     for (auto iter = mCachesMap.begin(); iter != mCachesMap.end(); ++iter)
     {
         if (iter->first == "data")
             continue;
 
-        nLines = vMemory[iter->second.first]->getLines(false);
-        nCols = vMemory[iter->second.first]->getCols(false);
+        std::shared_ptr<Memory> snapshot = std::make_shared<Memory>();
+        *snapshot = *vMemory[iter->second.first];
+        vSnapshots.push_back(std::make_pair(iter->first, snapshot));
+    }
+
+    // The cache file has to be created in this thread
+    // and is closed, once the last table is written
+    std::shared_ptr<NumeRe::CacheFile> cacheFile = std::make_shared<NumeRe::CacheFile>(sCache_file);
+
+    std::function<void()> writer = [cacheFile = std::move(cacheFile), vSnapshots = std::move(vSnapshots)]() mutable
+        {
+            try
+            {
+                cacheFile->setNumberOfTables(vSnapshots.size());
+                cacheFile->writeCacheHeader();
+
+                for (const auto& snapshot : vSnapshots)
+                {
+                    int nLines = snapshot.second->getLines(false);
+                    int nCols = snapshot.second->getCols(false);
+
+                    cacheFile->setDimensions(nLines, nCols);
+                    cacheFile->setData(&snapshot.second->memArray, nLines, nCols);
+                    cacheFile->setTableName(snapshot.first);
+                    cacheFile->setComment(snapshot.second->m_meta.comment);
+
+                    cacheFile->write();
+                }
+            }
+            catch (...)
+            {
+                cacheFile.reset();
+                vSnapshots.clear();
+                throw;
+            }
 
-        cacheFile.setDimensions(nLines, nCols);
-        cacheFile.setData(&vMemory[iter->second.first]->memArray, nLines, nCols);
-        cacheFile.setTableName(iter->first);
-        cacheFile.setComment(vMemory[iter->second.first]->m_meta.comment);
+            cacheFile.reset();
+            vSnapshots.clear();
+        };
 
-        cacheFile.write();
+    if (bInBackground)
+        m_cacheSave = m_workers.schedule<void>(std::move(writer));
+    else
+    {
+        try
+        {
+            writer();
+        }
+        catch (...)
+        {
+            bSaveMutex = false;
+            throw;
+        }
     }
 
     setSaveStatus(true);
@@ -390,6 +463,69 @@ bool MemoryManager::saveToCacheFile()
 }
 
 
+/////////////////////////////////////////////////
+/// \brief This private member function waits
+/// for the cache file, which is written in the
+/// background, and logs the errors, which
+/// occured. The tables are marked as not being
+/// saved in this case.
+///
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool MemoryManager::finishCacheSave()
+{
+    if (!m_cacheSave.valid())
+        return true;
+
+    try
+    {
+        m_cacheSave.get();
+        return true;
+    }
+    catch (SyntaxError& e)
+    {
+        g_logger.error("Could not save tables to the cache file. Catched error code: " + toString((size_t)e.errorcode));
+    }
+    catch (...)
+    {
+        g_logger.error("Could not save tables to the cache file.");
+    }
+
+    setSaveStatus(false);
+    return false;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This member function waits for all
+/// background loads and saves to complete. It is
+/// used before the session is closed.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void MemoryManager::waitForPendingIO()
+{
+    while (mPendingTables.size())
+    {
+        std::string sTable = mPendingTables.begin()->first;
+
+        try
+        {
+            awaitPendingTable(sTable);
+        }
+        catch (...)
+        {
+            g_logger.error("Could not load '" + sTable + "' in the background.");
+        }
+    }
+
+    collectFinishedSaves(true);
+    finishCacheSave();
+}
+
+
 /////////////////////////////////////////////////
 /// \brief This member function wraps the loading
 /// of the tables from the cache file. It will
@@ -977,6 +1113,75 @@ void MemoryManager::copyTable(const std::string& source, const std::string& targ
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Groups the rows of a table by the
+/// values of the key columns, aggregates the
+/// selected columns per group and writes the
+/// result into the target table (which is
+/// created automatically, if needed).
+///
+/// \param sTable const std::string&
+/// \param sTarget const std::string&
+/// \param _vKeys const VectorIndex&
+/// \param _vCols const VectorIndex&
+/// \param vAggregations const std::vector<Memory::GroupAggregation>&
+/// \return size_t
+///
+/////////////////////////////////////////////////
+size_t MemoryManager::groupBy(const std::string& sTable, const std::string& sTarget, const VectorIndex& _vKeys,
+                              const VectorIndex& _vCols, const std::vector<Memory::GroupAggregation>& vAggregations)
+{
+    std::unique_ptr<Memory> groups(vMemory[findTable(sTable.substr(0, sTable.find('(')))]->groupBy(_vKeys, _vCols, vAggregations));
+
+    // Create the target table, if it does not exist
+    if (!exists(sTarget.substr(0, sTarget.find('('))))
+        addTable(sTarget, NumeReKernel::getInstance()->getSettings());
+
+    Memory* targetTable = vMemory[findTable(sTarget.substr(0, sTarget.find('(')))];
+
+    // The assignment shares the column buffers
+    *targetTable = *groups;
+
+    return groups->getLines(false);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Joins two tables by their key columns
+/// and writes the result into the target table
+/// (which is created automatically, if needed).
+///
+/// \param sTable const std::string&
+/// \param sOther const std::string&
+/// \param sTarget const std::string&
+/// \param _vKeys const VectorIndex&
+/// \param _vOtherKeys const VectorIndex&
+/// \param type Memory::JoinType
+/// \return size_t
+///
+/////////////////////////////////////////////////
+size_t MemoryManager::join(const std::string& sTable, const std::string& sOther, const std::string& sTarget,
+                           const VectorIndex& _vKeys, const VectorIndex& _vOtherKeys, Memory::JoinType type)
+{
+    if (!exists(sOther.substr(0, sOther.find('('))))
+        throw SyntaxError(SyntaxError::TABLE_DOESNT_EXIST, "", SyntaxError::invalid_position, sOther);
+
+    const Memory* otherTable = vMemory[findTable(sOther.substr(0, sOther.find('(')))];
+    std::unique_ptr<Memory> joined(vMemory[findTable(sTable.substr(0, sTable.find('(')))]->join(*otherTable, _vKeys, _vOtherKeys, type));
+
+    // Create the target table, if it does not exist
+    if (!exists(sTarget.substr(0, sTarget.find('('))))
+        addTable(sTarget, NumeReKernel::getInstance()->getSettings());
+
+    Memory* targetTable = vMemory[findTable(sTarget.substr(0, sTarget.find('(')))];
+
+    // The assignment shares the column buffers
+    *targetTable = *joined;
+
+    return joined->getLines(false);
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Copy some contents of one table to
 /// another one (and create the missing table
@@ -1046,28 +1251,222 @@ void MemoryManager::melt(Memory* _mem, const string& sTable, bool overrideTarget
     else
     {
         // Combine both tables
-        Memory* _existingMem = vMemory[mCachesMap[sTable].second];
+        appendColumns(vMemory[mCachesMap[sTable].second], _mem);
+
+        // Delete the passed instance (it is not
+        // needed any more).
+        delete _mem;
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This static private member function
+/// moves the columns of the second Memory
+/// instance to the end of the first one and
+/// combines their meta data.
+///
+/// \param _existingMem Memory*
+/// \param _mem Memory*
+/// \return void
+///
+/////////////////////////////////////////////////
+void MemoryManager::appendColumns(Memory* _existingMem, Memory* _mem)
+{
+    size_t nCols = _existingMem->memArray.size();
+
+    // Resize the existing table to fit the contents
+    // of both tables
+    _existingMem->resizeMemory(1, nCols + _mem->memArray.size());
+
+    // Move the contents
+    for (size_t j = 0; j < _mem->memArray.size(); j++)
+    {
+        if (_mem->memArray[j])
+            _existingMem->memArray[j+nCols].reset(_mem->memArray[j].release());
+    }
+
+    _existingMem->setSaveStatus(false);
+    _existingMem->nCalcLines = -1;
+    _existingMem->setMetaData(_existingMem->getMetaData().melt(_mem->getMetaData()));
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This member function registers a
+/// table, which is loaded in the background. The
+/// target table is created, if it does not exist
+/// yet, and is completed on the first access.
+///
+/// \param sTable const std::string&
+/// \param pending NumeRe::PendingTable&&
+/// \return void
+///
+/////////////////////////////////////////////////
+void MemoryManager::addPendingTable(const std::string& sTable, NumeRe::PendingTable&& pending)
+{
+    // A previous load to the same table has to be
+    // completed first
+    awaitPendingTable(sTable);
 
-        size_t nCols = _existingMem->memArray.size();
+    if (!exists(sTable))
+    {
+        mCachesMap[sTable] = std::make_pair(vMemory.size(), vMemory.size());
+        vMemory.push_back(new Memory());
+    }
 
-        // Resize the existing table to fit the contents
-        // of both tables
-        _existingMem->resizeMemory(1, nCols + _mem->memArray.size());
+    mPendingTables[sTable] = std::move(pending);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This member function waits until the
+/// selected table has been loaded in the
+/// background and moves the loaded contents to
+/// the target table. The user may abort the
+/// waiting. Errors, which occured during the
+/// loading, are rethrown here.
+///
+/// \param sTable const std::string&
+/// \return void
+///
+/////////////////////////////////////////////////
+void MemoryManager::awaitPendingTable(const std::string& sTable) const
+{
+    auto iter = mPendingTables.find(sTable);
 
-        // Move the contents
-        for (size_t j = 0; j < _mem->memArray.size(); j++)
+    if (iter == mPendingTables.end())
+        return;
+
+    // The table is no longer pending, even if the
+    // loading fails or is aborted
+    NumeRe::PendingTable pending = std::move(iter->second);
+    mPendingTables.erase(iter);
+
+    while (pending.result.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready)
+    {
+        if (NumeReKernel::GetAsyncCancelState())
         {
-            if (_mem->memArray[j])
-                _existingMem->memArray[j+nCols].reset(_mem->memArray[j].release());
+            *pending.cancelled = true;
+            throw SyntaxError(SyntaxError::PROCESS_ABORTED_BY_USER, "", SyntaxError::invalid_position);
         }
+    }
+
+    std::unique_ptr<Memory> _mem = pending.result.get();
+    auto cacheIter = mCachesMap.find(sTable);
+
+    if (!_mem || !_mem->memArray.size() || cacheIter == mCachesMap.end())
+        return;
 
+    Memory* _existingMem = vMemory[cacheIter->second.second];
+
+    // Either replace the contents of the target table
+    // or combine both tables
+    if (pending.overrideTarget || !_existingMem->memArray.size())
+    {
+        _existingMem->memArray.swap(_mem->memArray);
         _existingMem->setSaveStatus(false);
         _existingMem->nCalcLines = -1;
-        _existingMem->setMetaData(_existingMem->getMetaData().melt(_mem->getMetaData()));
+        _existingMem->setMetaData(_mem->getMetaData());
+    }
+    else
+        appendColumns(_existingMem, _mem.get());
 
-        // Delete the passed instance (it is not
-        // needed any more).
-        delete _mem;
+    g_logger.info("Table '" + sTable + "' loaded in the background from '" + pending.sFileName + "'.");
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This member function saves the
+/// selected table to a file. Asynchronous saves
+/// write a copy-on-write snapshot of the table
+/// in a worker thread.
+///
+/// \param _sFileName std::string
+/// \param _sTable const std::string&
+/// \param nPrecision unsigned short
+/// \param sExt std::string
+/// \param bCompress bool
+/// \param bAsync bool
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool MemoryManager::saveLayer(std::string _sFileName, const std::string& _sTable, unsigned short nPrecision, std::string sExt, bool bCompress, bool bAsync)
+{
+    _sFileName = ValidFileName(_sFileName, ".ndat", !sExt.length());
+
+    // Report the results of previous saves
+    collectFinishedSaves(false);
+
+    if (!bAsync)
+        return vMemory[findTable(_sTable)]->save(_sFileName, _sTable, nPrecision, sExt, bCompress);
+
+    std::shared_ptr<Memory> snapshot = std::make_shared<Memory>();
+    *snapshot = *vMemory[findTable(_sTable)];
+
+    vPendingSaves.push_back(m_workers.schedule<bool>([snapshot, _sFileName, _sTable, nPrecision, sExt, bCompress]()
+                                                     {
+                                                         return snapshot->save(_sFileName, _sTable, nPrecision, sExt, bCompress);
+                                                     }));
+
+    return true;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This member function takes over the
+/// background saves of another instance, whose
+/// errors shall be reported by this instance.
+/// This is necessary for temporary instances.
+///
+/// \param other MemoryManager&
+/// \return void
+///
+/////////////////////////////////////////////////
+void MemoryManager::takePendingSaves(MemoryManager& other)
+{
+    for (auto& pending : other.vPendingSaves)
+    {
+        vPendingSaves.push_back(std::move(pending));
+    }
+
+    other.vPendingSaves.clear();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This member function reports the
+/// errors of the finished background saves as
+/// warnings. If requested, it waits for all
+/// saves to complete.
+///
+/// \param bWait bool
+/// \return void
+///
+/////////////////////////////////////////////////
+void MemoryManager::collectFinishedSaves(bool bWait)
+{
+    auto iter = vPendingSaves.begin();
+
+    while (iter != vPendingSaves.end())
+    {
+        if (!bWait && iter->wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            ++iter;
+            continue;
+        }
+
+        try
+        {
+            iter->get();
+        }
+        catch (...)
+        {
+            getErrorType(std::current_exception());
+            NumeReKernel::issueWarning(getLastErrorMessage());
+        }
+
+        iter = vPendingSaves.erase(iter);
     }
 }
 
@@ -1357,6 +1756,16 @@ bool MemoryManager::deleteTable(const string& sTable)
     if (sTable == "table" || sTable == "string")
         return false;
 
+    // Cancel the loading of this table, if it is
+    // still running in the background
+    auto pending = mPendingTables.find(sTable);
+
+    if (pending != mPendingTables.end())
+    {
+        *pending->second.cancelled = true;
+        mPendingTables.erase(pending);
+    }
+
     for (auto iter = mCachesMap.begin(); iter != mCachesMap.end(); ++iter)
     {
         if (iter->first == sTable)
@@ -52,6 +52,9 @@ class MemoryManager : public NumeRe::FileAdapter, public NumeRe::ClusterManager
 		std::string sUserdefinedFuncs;
 		std::string sPredefinedCommands;
 		std::string sPluginCommands;
+		mutable std::map<std::string, NumeRe::PendingTable> mPendingTables;
+		std::vector<std::future<bool>> vPendingSaves;
+		std::future<void> m_cacheSave;
 
 		void reorderColumn(size_t _nLayer, const std::vector<int>& vIndex, long long int i1, long long int i2, long long int j1 = 0);
 		bool loadFromNewCacheFile();
@@ -59,10 +62,11 @@ class MemoryManager : public NumeRe::FileAdapter, public NumeRe::ClusterManager
 		VectorIndex parseEveryCell(std::string& sDir, const std::string& sType, const std::string& sTableName) const;
         std::vector<std::complex<double>> resolveMAF(const std::string& sTableName, std::string sDir, std::complex<double> (MemoryManager::*MAF)(const std::string&, const VectorIndex&, const VectorIndex&) const) const;
 
-        virtual bool saveLayer(std::string _sFileName, const std::string& _sTable, unsigned short nPrecision, std::string sExt = "") override
-		{
-			return vMemory[findTable(_sTable)]->save(ValidFileName(_sFileName, ".ndat", !sExt.length()), _sTable, nPrecision, sExt);
-		}
+        static void appendColumns(Memory* _existingMem, Memory* _mem);
+        void awaitPendingTable(const std::string& sTable) const;
+        bool finishCacheSave();
+        virtual bool saveLayer(std::string _sFileName, const std::string& _sTable, unsigned short nPrecision, std::string sExt = "", bool bCompress = false, bool bAsync = false) override;
+        virtual void addPendingTable(const std::string& sTable, NumeRe::PendingTable&& pending) override;
 
 		inline bool exists(const std::string& sTable) const
 		{
@@ -71,6 +75,9 @@ class MemoryManager : public NumeRe::FileAdapter, public NumeRe::ClusterManager
 
 		size_t mapStringViewFind(StringView view) const
 		{
+		    if (mPendingTables.size())
+                awaitPendingTable(view.to_string());
+
 		    for (auto iter = mCachesMap.begin(); iter != mCachesMap.end(); ++iter)
             {
                 if (view == iter->first)
@@ -89,6 +96,9 @@ class MemoryManager : public NumeRe::FileAdapter, public NumeRe::ClusterManager
 
 		size_t findTable(const std::string& sTable) const
 		{
+		    if (mPendingTables.size())
+                awaitPendingTable(sTable);
+
 		    auto iter = mCachesMap.find(sTable);
 
 		    if (iter == mCachesMap.end())
@@ -140,6 +150,11 @@ class MemoryManager : public NumeRe::FileAdapter, public NumeRe::ClusterManager
 		bool isTable(const std::string& sTable) const;
 		bool isTable(StringView sTable) const;
 
+		inline bool isPendingTable(const std::string& sTable) const
+		{
+		    return mPendingTables.find(sTable) != mPendingTables.end();
+		}
+
         bool isEmpty(const std::string& sTable) const
         {
             if (exists(sTable))
@@ -253,8 +268,11 @@ class MemoryManager : public NumeRe::FileAdapter, public NumeRe::ClusterManager
 		void setSaveStatus(bool _bIsSaved);
 		long long int getLastSaved() const;
 		void setCacheFileName(std::string _sFileName);
-		bool saveToCacheFile();
+		bool saveToCacheFile(bool bInBackground = false);
 		bool loadFromCacheFile();
+		void waitForPendingIO();
+		void collectFinishedSaves(bool bWait);
+		void takePendingSaves(MemoryManager& other);
 
         inline size_t getNumberOfTables() const
 		{
@@ -294,6 +312,8 @@ class MemoryManager : public NumeRe::FileAdapter, public NumeRe::ClusterManager
 			if ((sCache == "table" || sCache == "string") && !bForceRenaming)
 				throw SyntaxError(SyntaxError::CACHE_CANNOT_BE_RENAMED, "", SyntaxError::invalid_position, sCache);
 
+			awaitPendingTable(sCache);
+
 			mCachesMap[sNewName] = mCachesMap[sCache];
 			mCachesMap.erase(sCache);
 			setSaveStatus(false);
@@ -307,6 +327,9 @@ class MemoryManager : public NumeRe::FileAdapter, public NumeRe::ClusterManager
 			if (!isTable(sTable2))
 				throw SyntaxError(SyntaxError::CACHE_DOESNT_EXIST, "", SyntaxError::invalid_position, sTable2);
 
+            awaitPendingTable(sTable1);
+            awaitPendingTable(sTable2);
+
             size_t tab1 = mCachesMap[sTable1].second;
             size_t tab2 = mCachesMap[sTable2].second;
 
@@ -467,6 +490,11 @@ class MemoryManager : public NumeRe::FileAdapter, public NumeRe::ClusterManager
             return vMemory[findTable(sTable)]->getBins(col, nBins);
         }
 
+        size_t groupBy(const std::string& sTable, const std::string& sTarget, const VectorIndex& _vKeys,
+                       const VectorIndex& _vCols, const std::vector<Memory::GroupAggregation>& vAggregations);
+        size_t join(const std::string& sTable, const std::string& sOther, const std::string& sTarget,
+                    const VectorIndex& _vKeys, const VectorIndex& _vOtherKeys, Memory::JoinType type);
+
 
 
 		// DIMENSION ACCESS METHODS
@@ -1023,6 +1051,11 @@ class MemoryManager : public NumeRe::FileAdapter, public NumeRe::ClusterManager
 			return vMemory[findTable(_sCache)]->pct(VectorIndex(i1, i2), VectorIndex(j1, j2), dPct);
 		}
 
+		inline std::vector<ColumnStatistics> describe(const std::string& _sCache, const VectorIndex& _vLine, const VectorIndex& _vCol) const
+		{
+			return vMemory[findTable(_sCache)]->describe(_vLine, _vCol);
+		}
+
 };
 
 #endif
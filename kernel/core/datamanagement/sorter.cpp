@@ -19,6 +19,113 @@
 #include "sorter.hpp"
 #include "../utils/tools.hpp"
 #include "../../kernel.hpp"
+#include <omp.h>
+
+// Minimal number of elements per thread for the parallel sort
+#define PARALLEL_SORT_CHUNK 50000
+
+
+/////////////////////////////////////////////////
+/// \brief Stable parallel merge sort. Every
+/// thread sorts a chunk of the index, afterwards
+/// the chunks are merged pairwise in parallel.
+///
+/// \param vIndex std::vector<int>&
+/// \param comp Comp
+/// \return void
+///
+/////////////////////////////////////////////////
+template<class Comp>
+static void parallelStableSort(std::vector<int>& vIndex, Comp comp)
+{
+    int nChunks = std::min((int)(vIndex.size() / PARALLEL_SORT_CHUNK), omp_get_max_threads());
+
+    if (nChunks < 2)
+    {
+        std::stable_sort(vIndex.begin(), vIndex.end(), comp);
+        return;
+    }
+
+    std::vector<size_t> vBounds(nChunks+1);
+
+    for (int i = 0; i <= nChunks; i++)
+    {
+        vBounds[i] = vIndex.size() * i / nChunks;
+    }
+
+    #pragma omp parallel for
+    for (int i = 0; i < nChunks; i++)
+    {
+        std::stable_sort(vIndex.begin()+vBounds[i], vIndex.begin()+vBounds[i+1], comp);
+    }
+
+    for (int width = 1; width < nChunks; width *= 2)
+    {
+        #pragma omp parallel for
+        for (int i = 0; i < nChunks; i += 2*width)
+        {
+            if (i + width < nChunks)
+                std::inplace_merge(vIndex.begin()+vBounds[i],
+                                   vIndex.begin()+vBounds[i+width],
+                                   vIndex.begin()+vBounds[std::min(i+2*width, nChunks)],
+                                   comp);
+        }
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This public member function sorts the
+/// passed index by all passed columns at once.
+/// The first column is the primary key, all
+/// following are used to resolve ties. The typed
+/// keys are extracted once before sorting and the
+/// sorting itself is stable and runs in
+/// parallel. Returns false, if the derived class
+/// cannot provide the keys for a column. The
+/// caller has to fall back to qSort() in this
+/// case.
+///
+/// \param vIndex std::vector<int>&
+/// \param vCols const std::vector<int>&
+/// \param nSign int
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool Sorter::multiKeySort(std::vector<int>& vIndex, const std::vector<int>& vCols, int nSign)
+{
+    if (!vIndex.size() || !vCols.size())
+        return false;
+
+    auto minmax = std::minmax_element(vIndex.begin(), vIndex.end());
+
+    if (*minmax.first < 0)
+        return false;
+
+    size_t nRows = *minmax.second+1;
+    std::vector<SortKey> vKeys(vCols.size());
+
+    for (size_t k = 0; k < vCols.size(); k++)
+    {
+        if (!extractSortKey(vCols[k], nRows, vKeys[k]))
+            return false;
+    }
+
+    parallelStableSort(vIndex, [&vKeys, nSign](int i, int j)
+                       {
+                           for (const SortKey& key : vKeys)
+                           {
+                               int res = key.compare(i, j, nSign);
+
+                               if (res)
+                                   return res < 0;
+                           }
+
+                           return false;
+                       });
+
+    return true;
+}
 
 
 /////////////////////////////////////////////////
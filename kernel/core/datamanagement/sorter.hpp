@@ -17,11 +17,72 @@
 ******************************************************************************/
 
 #include <string>
+#include <vector>
+#include <cstdint>
 #include "../structures.hpp"
 
 #ifndef SORTER_HPP
 #define SORTER_HPP
 
+/////////////////////////////////////////////////
+/// \brief Typed sorting key of a single column,
+/// which is extracted once before sorting. The
+/// keys are indexed by the row number.
+/////////////////////////////////////////////////
+struct SortKey
+{
+    enum KeyType
+    {
+        KEY_INT,
+        KEY_UINT,
+        KEY_FLOAT,
+        KEY_STRING
+    };
+
+    KeyType type;
+    std::vector<int64_t> intKeys;
+    std::vector<uint64_t> uintKeys;
+    std::vector<double> floatKeys;
+    std::vector<std::string> stringKeys;
+    std::vector<uint8_t> valid;
+
+    SortKey() : type(KEY_FLOAT) {}
+
+    /////////////////////////////////////////////////
+    /// \brief Compares the keys of the rows i and
+    /// j. Invalid keys are sorted after all valid
+    /// keys independent on the sorting direction.
+    ///
+    /// \param i int
+    /// \param j int
+    /// \param nSign int
+    /// \return int
+    ///
+    /////////////////////////////////////////////////
+    int compare(int i, int j, int nSign) const
+    {
+        bool isValid_i = i < (int)valid.size() && valid[i];
+        bool isValid_j = j < (int)valid.size() && valid[j];
+
+        if (!isValid_i || !isValid_j)
+            return isValid_j - isValid_i;
+
+        switch (type)
+        {
+            case KEY_INT:
+                return nSign * ((intKeys[i] > intKeys[j]) - (intKeys[i] < intKeys[j]));
+            case KEY_UINT:
+                return nSign * ((uintKeys[i] > uintKeys[j]) - (uintKeys[i] < uintKeys[j]));
+            case KEY_FLOAT:
+                return nSign * ((floatKeys[i] > floatKeys[j]) - (floatKeys[i] < floatKeys[j]));
+            case KEY_STRING:
+                return nSign * stringKeys[i].compare(stringKeys[j]);
+        }
+
+        return 0;
+    }
+};
+
 /////////////////////////////////////////////////
 /// \brief Abstract parent class to implement
 /// the sorting functionality (using Quicksort)
@@ -38,12 +99,21 @@ class Sorter
         virtual int compare(int i, int j, int col) = 0; // -1 if  i < j, 0 for i == j and +1 for j > 0
         virtual bool isValue(int line, int col) = 0;
 
+        // Typed key extraction (optional, enables the multi-key sorting)
+        virtual bool extractSortKey(int col, size_t nRows, SortKey& key)
+        {
+            return false;
+        }
+
     public:
         virtual ~Sorter() {};
 
         // Quicksort interface function
         bool qSort(int* nIndex, int nElements, int nColumn, long long int nLeft, long long int nRight, int nSign);
 
+        // Stable multi-key sorting using typed keys
+        bool multiKeySort(std::vector<int>& vIndex, const std::vector<int>& vCols, int nSign);
+
         // Function for hierarchical sorting
         bool sortSubList(int* nIndex, int nElements, ColumnKeys* KeyList, long long int i1, long long int i2, const VectorIndex& _vCol, int nSign, long long int nColumns);
 
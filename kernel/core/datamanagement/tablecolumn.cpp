@@ -19,10 +19,349 @@
 #include "tablecolumn.hpp"
 #include "../ui/language.hpp"
 #include "../utils/tools.hpp"
+#include <bitset>
 
 extern Language _lang;
 
 
+/////////////////////////////////////////////////
+/// \brief Returns the number of set bits in the
+/// passed word.
+///
+/// \param word uint64_t
+/// \return size_t
+///
+/////////////////////////////////////////////////
+static inline size_t popCount(uint64_t word)
+{
+    return std::bitset<64>(word).count();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Appends the lowest nBits bits of the
+/// passed word.
+///
+/// \param bits uint64_t
+/// \param nBits size_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void Bitmap::append(uint64_t bits, size_t nBits)
+{
+    if (!nBits)
+        return;
+
+    if (nBits < 64)
+        bits &= (1ull << nBits) - 1;
+
+    size_t shift = m_size % 64;
+
+    if (!shift)
+        m_words.push_back(bits);
+    else
+    {
+        // Shared slices might contain set bits beyond
+        // their size
+        uint64_t& last = m_words.back();
+        last = (last & ((1ull << shift) - 1)) | (bits << shift);
+
+        if (shift + nBits > 64)
+            m_words.push_back(bits >> (64 - shift));
+    }
+
+    m_size += nBits;
+    m_count += popCount(bits);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Appends the bits [first, last) of
+/// another bitmap.
+///
+/// \param other const Bitmap&
+/// \param first size_t
+/// \param last size_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void Bitmap::appendRange(const Bitmap& other, size_t first, size_t last)
+{
+    for (size_t pos = first; pos < last; pos += 64)
+    {
+        append(other.getBits(pos), std::min<size_t>(64, last - pos));
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Appends nBits bits of the same value.
+///
+/// \param nBits size_t
+/// \param val bool
+/// \return void
+///
+/////////////////////////////////////////////////
+void Bitmap::appendFill(size_t nBits, bool val)
+{
+    while (nBits)
+    {
+        size_t n = std::min<size_t>(64, nBits);
+        append(val ? ~0ull : 0ull, n);
+        nBits -= n;
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns a bitmap containing the bits
+/// [first, last). If first is word aligned, the
+/// words are shared and not copied.
+///
+/// \param first size_t
+/// \param last size_t
+/// \return Bitmap
+///
+/////////////////////////////////////////////////
+Bitmap Bitmap::slice(size_t first, size_t last) const
+{
+    last = std::min(last, m_size);
+    first = std::min(first, last);
+
+    Bitmap bitmap;
+
+    if (first % 64)
+    {
+        bitmap.appendRange(*this, first, last);
+        return bitmap;
+    }
+
+    bitmap.m_words = m_words.slice(first / 64, (last + 63) / 64);
+    bitmap.m_size = last - first;
+    bitmap.m_count = count(first, last);
+
+    return bitmap;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the number of set bits in the
+/// range [first, last).
+///
+/// \param first size_t
+/// \param last size_t
+/// \return size_t
+///
+/////////////////////////////////////////////////
+size_t Bitmap::count(size_t first, size_t last) const
+{
+    last = std::min(last, m_size);
+
+    if (first >= last)
+        return 0;
+
+    if (!first && last == m_size)
+        return m_count;
+
+    size_t nCount = 0;
+
+    for (size_t pos = first; pos < last; pos += 64)
+    {
+        uint64_t bits = getBits(pos);
+
+        if (last - pos < 64)
+            bits &= (1ull << (last - pos)) - 1;
+
+        nCount += popCount(bits);
+    }
+
+    return nCount;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the position after the last
+/// set bit or zero, if no bit is set.
+///
+/// \return size_t
+///
+/////////////////////////////////////////////////
+size_t Bitmap::findLast() const
+{
+    for (size_t w = m_words.size(); w > 0; w--)
+    {
+        uint64_t word = m_words[w-1];
+
+        // Ignore the bits beyond the size
+        if (w == m_words.size() && m_size % 64)
+            word &= (1ull << (m_size % 64)) - 1;
+
+        if (!word)
+            continue;
+
+        size_t bit = 63;
+
+        while (!(word >> bit))
+            bit--;
+
+        return (w-1)*64 + bit + 1;
+    }
+
+    return 0;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the 64 bits starting at the
+/// passed position. Bits beyond the size are
+/// returned as zero.
+///
+/// \param pos size_t
+/// \return uint64_t
+///
+/////////////////////////////////////////////////
+uint64_t Bitmap::getBits(size_t pos) const
+{
+    size_t w = pos / 64;
+    size_t shift = pos % 64;
+
+    if (w >= m_words.size() || pos >= m_size)
+        return 0;
+
+    uint64_t bits = m_words[w] >> shift;
+
+    if (shift && w+1 < m_words.size())
+        bits |= m_words[w+1] << (64 - shift);
+
+    // Shared slices might contain set bits beyond
+    // their size
+    if (m_size - pos < 64)
+        bits &= (1ull << (m_size - pos)) - 1;
+
+    return bits;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Resizes the bitmap. New bits are set
+/// to the passed value.
+///
+/// \param nSize size_t
+/// \param val bool
+/// \return void
+///
+/////////////////////////////////////////////////
+void Bitmap::resize(size_t nSize, bool val)
+{
+    if (nSize >= m_size)
+    {
+        appendFill(nSize - m_size, val);
+        return;
+    }
+
+    m_count -= count(nSize, m_size);
+    m_words.resize((nSize + 63) / 64);
+    m_size = nSize;
+
+    if (m_size % 64)
+        m_words.back() &= (1ull << (m_size % 64)) - 1;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Inserts nBits bits of the passed value
+/// at the selected position.
+///
+/// \param pos size_t
+/// \param nBits size_t
+/// \param val bool
+/// \return void
+///
+/////////////////////////////////////////////////
+void Bitmap::insert(size_t pos, size_t nBits, bool val)
+{
+    if (pos >= m_size)
+    {
+        appendFill(pos - m_size + nBits, val);
+        return;
+    }
+
+    Bitmap bitmap;
+    bitmap.m_words.reserve((m_size + nBits + 63) / 64);
+    bitmap.appendRange(*this, 0, pos);
+    bitmap.appendFill(nBits, val);
+    bitmap.appendRange(*this, pos, m_size);
+
+    *this = std::move(bitmap);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Removes nBits bits starting at the
+/// selected position.
+///
+/// \param pos size_t
+/// \param nBits size_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void Bitmap::erase(size_t pos, size_t nBits)
+{
+    if (pos >= m_size)
+        return;
+
+    nBits = std::min(nBits, m_size - pos);
+
+    if (pos + nBits == m_size)
+    {
+        resize(pos);
+        return;
+    }
+
+    Bitmap bitmap;
+    bitmap.m_words.reserve((m_size - nBits + 63) / 64);
+    bitmap.appendRange(*this, 0, pos);
+    bitmap.appendRange(*this, pos + nBits, m_size);
+
+    *this = std::move(bitmap);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Removes all bits.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void Bitmap::clear()
+{
+    m_words.clear();
+    m_size = 0;
+    m_count = 0;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns true, if the passed index
+/// describes a non-empty, ascending and
+/// contiguous range of existing rows. Copies of
+/// such ranges may share the column buffers.
+///
+/// \param idx const VectorIndex&
+/// \param nSize size_t
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool TableColumn::isContiguousRange(const VectorIndex& idx, size_t nSize)
+{
+    return idx.isExpanded()
+        && idx.size() > 0
+        && idx.front() >= 0
+        && idx.last() == idx.front() + (int)idx.size() - 1
+        && idx.last() < (int)nSize;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Return the table column's contents as
 /// a vector of strings.
@@ -89,6 +428,86 @@ std::vector<std::complex<double>> TableColumn::getValue(const VectorIndex& idx)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Static helper for the generic span
+/// implementation, which converts the values
+/// element-wise using the virtual accessors.
+///
+/// \param col const TableColumn*
+/// \param first size_t
+/// \param last size_t
+/// \param span ColumnSpan<T>&
+/// \return void
+///
+/////////////////////////////////////////////////
+template<class T>
+static void fillSpanFromValues(const TableColumn* col, size_t first, size_t last, ColumnSpan<T>& span)
+{
+    last = std::min(last, col->size());
+    first = std::min(first, last);
+
+    T* data = span.allocate(last - first);
+
+    for (size_t i = first; i < last; i++)
+    {
+        toSpanValue(data[i-first], col->getValue(i));
+
+        if (col->isValid(i))
+            span.setValid(i-first);
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the rows [first, last) of this
+/// column as a span of real values. Column types
+/// with a suitable internal storage provide a
+/// faster implementation.
+///
+/// \param first size_t
+/// \param last size_t
+/// \param span ColumnSpan<double>&
+/// \return void
+///
+/////////////////////////////////////////////////
+void TableColumn::getSpan(size_t first, size_t last, ColumnSpan<double>& span) const
+{
+    fillSpanFromValues(this, first, last, span);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the rows [first, last) of this
+/// column as a span of integer values.
+///
+/// \param first size_t
+/// \param last size_t
+/// \param span ColumnSpan<int64_t>&
+/// \return void
+///
+/////////////////////////////////////////////////
+void TableColumn::getSpan(size_t first, size_t last, ColumnSpan<int64_t>& span) const
+{
+    fillSpanFromValues(this, first, last, span);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the rows [first, last) of this
+/// column as a span of complex values.
+///
+/// \param first size_t
+/// \param last size_t
+/// \param span ColumnSpan<std::complex<double>>&
+/// \return void
+///
+/////////////////////////////////////////////////
+void TableColumn::getSpan(size_t first, size_t last, ColumnSpan<std::complex<double>>& span) const
+{
+    fillSpanFromValues(this, first, last, span);
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Sets a string vector at the specified
 /// indices.
@@ -214,18 +633,9 @@ TableColumn* TableColumn::copy() const
 /////////////////////////////////////////////////
 void TableColumn::shrink()
 {
-    for (int i = size()-1; i >= 0; i--)
-    {
-        if (isValid(i))
-        {
-            resize(i+1);
-            return;
-        }
-    }
-
-    // If the code reaches this point, it is either empty
-    // or full of invalid values
-    resize(0);
+    // Will be zero, if the column is either empty or
+    // full of invalid values
+    resize(getNumFilledElements());
 }
 
 
@@ -249,6 +659,32 @@ size_t TableColumn::getNumFilledElements() const
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Return the number of valid elements
+/// in the range [first, last). Column types with
+/// a validity bitmap provide a faster
+/// implementation.
+///
+/// \param first size_t
+/// \param last size_t
+/// \return size_t
+///
+/////////////////////////////////////////////////
+size_t TableColumn::getNumValidElements(size_t first, size_t last) const
+{
+    last = std::min(last, size());
+    size_t nValid = 0;
+
+    for (size_t i = first; i < last; i++)
+    {
+        if (isValid(i))
+            nValid++;
+    }
+
+    return nValid;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Creates a default column headline for
 /// a column, which can be used without an
@@ -396,3 +832,18 @@ bool TableColumn::isValueType(TableColumn::ColumnType type)
     return type > TableColumn::VALUELIKE && type < TableColumn::VALUE_LAST;
 }
 
+
+/////////////////////////////////////////////////
+/// \brief Return, whether the passed type
+/// represents a signed or unsigned integer value
+/// type.
+///
+/// \param type TableColumn::ColumnType
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool TableColumn::isIntegerType(TableColumn::ColumnType type)
+{
+    return type >= TableColumn::TYPE_VALUE_UI8 && type <= TableColumn::TYPE_VALUE_I64;
+}
+
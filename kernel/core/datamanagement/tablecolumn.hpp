@@ -22,9 +22,475 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <complex>
+#include <cmath>
+#include <cstdint>
 #include "../ParserLib/muParserDef.h"
 #include "../structures.hpp"
 
+/////////////////////////////////////////////////
+/// \brief A reference-counted, copy-on-write
+/// storage for the values of a table column.
+/// Copies and slices share the underlying
+/// vector, which is only detached (i.e. copied)
+/// on the first modifying access. Read access
+/// has to use the const overloads to avoid
+/// detaching.
+/////////////////////////////////////////////////
+template<class T>
+class ColumnBuffer
+{
+    private:
+        std::shared_ptr<std::vector<T>> m_buffer;
+        size_t m_offset;
+        size_t m_size;
+
+        /////////////////////////////////////////////////
+        /// \brief Ensure that this instance is the only
+        /// owner of the underlying vector and that the
+        /// vector contains exactly the referenced
+        /// range.
+        ///
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void detach()
+        {
+            if (m_buffer.use_count() > 1)
+            {
+                m_buffer = std::make_shared<std::vector<T>>(m_buffer->begin()+m_offset, m_buffer->begin()+m_offset+m_size);
+                m_offset = 0;
+                return;
+            }
+
+            if (m_offset + m_size < m_buffer->size())
+                m_buffer->erase(m_buffer->begin()+m_offset+m_size, m_buffer->end());
+
+            if (m_offset)
+            {
+                m_buffer->erase(m_buffer->begin(), m_buffer->begin()+m_offset);
+                m_offset = 0;
+            }
+        }
+
+    public:
+        typedef typename std::vector<T>::iterator iterator;
+        typedef typename std::vector<T>::const_iterator const_iterator;
+
+        ColumnBuffer() : m_buffer(std::make_shared<std::vector<T>>()), m_offset(0), m_size(0) {}
+        ColumnBuffer(const ColumnBuffer& other) = default;
+        ColumnBuffer& operator=(const ColumnBuffer& other) = default;
+
+        /////////////////////////////////////////////////
+        /// \brief Returns a buffer sharing the range
+        /// [first, last) of this buffer without copying.
+        ///
+        /// \param first size_t
+        /// \param last size_t
+        /// \return ColumnBuffer
+        ///
+        /////////////////////////////////////////////////
+        ColumnBuffer slice(size_t first, size_t last) const
+        {
+            last = std::min(last, m_size);
+            first = std::min(first, last);
+
+            ColumnBuffer buffer(*this);
+            buffer.m_offset += first;
+            buffer.m_size = last - first;
+            return buffer;
+        }
+
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        bool empty() const
+        {
+            return !m_size;
+        }
+
+        const T& operator[](size_t i) const
+        {
+            return (*m_buffer)[m_offset+i];
+        }
+
+        T& operator[](size_t i)
+        {
+            detach();
+            return (*m_buffer)[i];
+        }
+
+        const T* data() const
+        {
+            return m_buffer->data()+m_offset;
+        }
+
+        const T& back() const
+        {
+            return (*m_buffer)[m_offset+m_size-1];
+        }
+
+        T& back()
+        {
+            detach();
+            return m_buffer->back();
+        }
+
+        const_iterator begin() const
+        {
+            return m_buffer->cbegin()+m_offset;
+        }
+
+        const_iterator end() const
+        {
+            return m_buffer->cbegin()+m_offset+m_size;
+        }
+
+        const_iterator cbegin() const
+        {
+            return begin();
+        }
+
+        const_iterator cend() const
+        {
+            return end();
+        }
+
+        iterator begin()
+        {
+            detach();
+            return m_buffer->begin();
+        }
+
+        iterator end()
+        {
+            detach();
+            return m_buffer->end();
+        }
+
+        iterator insert(const_iterator pos, size_t n, const T& val)
+        {
+            detach();
+            iterator iter = m_buffer->insert(pos, n, val);
+            m_size = m_buffer->size();
+            return iter;
+        }
+
+        template<class InputIt>
+        iterator insert(const_iterator pos, InputIt first, InputIt last)
+        {
+            detach();
+            iterator iter = m_buffer->insert(pos, first, last);
+            m_size = m_buffer->size();
+            return iter;
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            detach();
+            iterator iter = m_buffer->erase(first, last);
+            m_size = m_buffer->size();
+            return iter;
+        }
+
+        void push_back(const T& val)
+        {
+            detach();
+            m_buffer->push_back(val);
+            m_size++;
+        }
+
+        void reserve(size_t nSize)
+        {
+            detach();
+            m_buffer->reserve(nSize);
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Resize the buffer. Shrinking only
+        /// reduces the referenced range and does not
+        /// detach.
+        ///
+        /// \param nSize size_t
+        /// \param val const T&
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void resize(size_t nSize, const T& val = T())
+        {
+            if (nSize <= m_size)
+            {
+                m_size = nSize;
+                return;
+            }
+
+            detach();
+            m_buffer->resize(nSize, val);
+            m_size = nSize;
+        }
+
+        void clear()
+        {
+            m_buffer = std::make_shared<std::vector<T>>();
+            m_offset = 0;
+            m_size = 0;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Replace the contents with the passed
+        /// vector.
+        ///
+        /// \param vData std::vector<T>
+        /// \return ColumnBuffer&
+        ///
+        /////////////////////////////////////////////////
+        ColumnBuffer& operator=(std::vector<T> vData)
+        {
+            m_size = vData.size();
+            m_offset = 0;
+            m_buffer = std::make_shared<std::vector<T>>(std::move(vData));
+            return *this;
+        }
+};
+
+
+/////////////////////////////////////////////////
+/// \brief A packed array of bits. It is used as
+/// validity bitmap of the table columns and as
+/// storage of logical values. The number of set
+/// bits is cached, so that counting all of them
+/// is O(1). The words are stored in a
+/// ColumnBuffer and are therefore shared between
+/// copies.
+/////////////////////////////////////////////////
+class Bitmap
+{
+    private:
+        ColumnBuffer<uint64_t> m_words;
+        size_t m_size;
+        size_t m_count;
+
+        void append(uint64_t bits, size_t nBits);
+        void appendRange(const Bitmap& other, size_t first, size_t last);
+        void appendFill(size_t nBits, bool val);
+
+    public:
+        Bitmap() : m_size(0), m_count(0) {}
+
+        /////////////////////////////////////////////////
+        /// \brief Returns the bit at position i or
+        /// false, if i is out of range.
+        ///
+        /// \param i size_t
+        /// \return bool
+        ///
+        /////////////////////////////////////////////////
+        bool test(size_t i) const
+        {
+            return i < m_size && (m_words[i / 64] >> (i % 64)) & 1;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Sets the bit at position i, which has
+        /// to be in range.
+        ///
+        /// \param i size_t
+        /// \param val bool
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void set(size_t i, bool val)
+        {
+            uint64_t mask = 1ull << (i % 64);
+            uint64_t& word = m_words[i / 64];
+
+            if (bool(word & mask) == val)
+                return;
+
+            word ^= mask;
+
+            if (val)
+                m_count++;
+            else
+                m_count--;
+        }
+
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        size_t count() const
+        {
+            return m_count;
+        }
+
+        size_t getBytes() const
+        {
+            return m_words.size() * sizeof(uint64_t);
+        }
+
+        Bitmap slice(size_t first, size_t last) const;
+        size_t count(size_t first, size_t last) const;
+        size_t findLast() const;
+        uint64_t getBits(size_t pos) const;
+        void resize(size_t nSize, bool val = false);
+        void insert(size_t pos, size_t nBits, bool val = false);
+        void erase(size_t pos, size_t nBits);
+        void clear();
+};
+
+
+/////////////////////////////////////////////////
+/// \brief A read-only view on a contiguous block
+/// of rows of a TableColumn. It either refers
+/// directly to the storage of the column or to a
+/// converted copy owned by this instance. The
+/// validity of each row is stored in a bitmap.
+///
+/// \note The span is invalidated by any
+/// modification of the referenced column.
+/////////////////////////////////////////////////
+template<class T>
+class ColumnSpan
+{
+    private:
+        const T* m_data;
+        size_t m_size;
+        std::vector<T> m_buffer;
+        std::vector<uint64_t> m_validity;
+
+    public:
+        ColumnSpan() : m_data(nullptr), m_size(0) {}
+        ColumnSpan(const ColumnSpan&) = delete;
+        ColumnSpan& operator=(const ColumnSpan&) = delete;
+
+        /////////////////////////////////////////////////
+        /// \brief Refer to an external memory block.
+        /// All rows are marked as invalid.
+        ///
+        /// \param data const T*
+        /// \param nSize size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void refer(const T* data, size_t nSize)
+        {
+            m_data = data;
+            m_size = nSize;
+            m_validity.assign((nSize+63) / 64, 0);
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Prepare the internal buffer for
+        /// storing converted values and return a
+        /// pointer to it. All rows are marked as
+        /// invalid.
+        ///
+        /// \param nSize size_t
+        /// \return T*
+        ///
+        /////////////////////////////////////////////////
+        T* allocate(size_t nSize)
+        {
+            m_buffer.resize(nSize);
+            m_data = m_buffer.data();
+            m_size = nSize;
+            m_validity.assign((nSize+63) / 64, 0);
+            return m_buffer.data();
+        }
+
+        void setValid(size_t i)
+        {
+            m_validity[i / 64] |= 1ull << (i % 64);
+        }
+
+        bool isValid(size_t i) const
+        {
+            return m_validity[i / 64] & (1ull << (i % 64));
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Copy the validity of the rows
+        /// starting at first from the passed bitmap.
+        ///
+        /// \param bitmap const Bitmap&
+        /// \param first size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void setValidity(const Bitmap& bitmap, size_t first)
+        {
+            for (size_t w = 0; w < m_validity.size(); w++)
+            {
+                m_validity[w] = bitmap.getBits(first + 64*w);
+            }
+
+            if (m_size % 64)
+                m_validity.back() &= (1ull << (m_size % 64)) - 1;
+        }
+
+        const T& operator[](size_t i) const
+        {
+            return m_data[i];
+        }
+
+        const T* data() const
+        {
+            return m_data;
+        }
+
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        const std::vector<uint64_t>& getValidity() const
+        {
+            return m_validity;
+        }
+};
+
+
+/////////////////////////////////////////////////
+/// \brief Convert a single value of a column into
+/// the value type of a ColumnSpan. Complex values
+/// are reduced to their real part, invalid
+/// values become zero in integer spans.
+/////////////////////////////////////////////////
+template<class T>
+inline void toSpanValue(double& target, const T& val)
+{
+    target = val;
+}
+
+template<class T>
+inline void toSpanValue(double& target, const std::complex<T>& val)
+{
+    target = val.real();
+}
+
+template<class T>
+inline void toSpanValue(int64_t& target, const T& val)
+{
+    target = std::isnan(val) ? 0 : static_cast<int64_t>(val);
+}
+
+template<class T>
+inline void toSpanValue(int64_t& target, const std::complex<T>& val)
+{
+    toSpanValue(target, val.real());
+}
+
+template<class T>
+inline void toSpanValue(std::complex<double>& target, const T& val)
+{
+    target = std::complex<double>(val);
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Abstract table column, which allows
 /// using it to compose the data table in each
@@ -76,7 +542,11 @@ struct TableColumn
     virtual std::complex<double> getValue(size_t elem) const = 0;
     virtual mu::Value get(size_t elem) const = 0;
 
-    void setValue(const VectorIndex& idx, const std::vector<std::string>& vValue);
+    virtual void getSpan(size_t first, size_t last, ColumnSpan<double>& span) const;
+    virtual void getSpan(size_t first, size_t last, ColumnSpan<int64_t>& span) const;
+    virtual void getSpan(size_t first, size_t last, ColumnSpan<std::complex<double>>& span) const;
+
+    virtual void setValue(const VectorIndex& idx, const std::vector<std::string>& vValue);
     void setValue(const VectorIndex& idx, const std::vector<double>& vValue);
     void setValue(const VectorIndex& idx, const std::vector<std::complex<double>>& vValue);
     void setValue(const VectorIndex& idx, std::complex<double>* _dData, size_t _nNum);
@@ -105,7 +575,8 @@ struct TableColumn
 
     virtual size_t size() const = 0;
     virtual size_t getBytes() const = 0;
-    size_t getNumFilledElements() const;
+    virtual size_t getNumFilledElements() const;
+    virtual size_t getNumValidElements(size_t first, size_t last) const;
 
     virtual TableColumn* convert(ColumnType type = TableColumn::TYPE_NONE) = 0;
 
@@ -114,6 +585,8 @@ struct TableColumn
     static ColumnType stringToType(const std::string& sType);
     static std::vector<std::string> getTypesAsString();
     static bool isValueType(ColumnType type);
+    static bool isIntegerType(ColumnType type);
+    static bool isContiguousRange(const VectorIndex& idx, size_t nSize);
 };
 
 
@@ -26,11 +26,12 @@
 /// the conversion member functions to define the
 /// common type of all the values in a column.
 ///
-/// \param vVals const std::vector<std::string>&
+/// \param vVals const T&
 /// \return ConvertibleType
 ///
 /////////////////////////////////////////////////
-static ConvertibleType detectCommonType(const std::vector<std::string>& vVals, int &numFormat)
+template<class T>
+static ConvertibleType detectCommonType(const T& vVals, int &numFormat)
 {
     ConvertibleType convType = CONVTYPE_NONE;
     NumberFormatsVoter voter;
@@ -203,6 +204,32 @@ mu::Value DateTimeColumn::get(size_t elem) const
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Returns the rows [first, last) as a
+/// span of seconds since the epoch without
+/// copying the internal storage.
+///
+/// \param first size_t
+/// \param last size_t
+/// \param span ColumnSpan<double>&
+/// \return void
+///
+/////////////////////////////////////////////////
+void DateTimeColumn::getSpan(size_t first, size_t last, ColumnSpan<double>& span) const
+{
+    last = std::min(last, m_data.size());
+    first = std::min(first, last);
+
+    span.refer(m_data.data()+first, last - first);
+
+    for (size_t i = first; i < last; i++)
+    {
+        if (!std::isnan(m_data[i]))
+            span.setValid(i-first);
+    }
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Set a single mu::Value.
 ///
@@ -270,6 +297,15 @@ DateTimeColumn* DateTimeColumn::copy(const VectorIndex& idx) const
 {
     idx.setOpenEndIndex(size()-1);
 
+    // Contiguous ranges share the buffer
+    if (isContiguousRange(idx, size()))
+    {
+        DateTimeColumn* col = new DateTimeColumn();
+        col->assignMetaData(this);
+        col->m_data = m_data.slice(idx.front(), idx.last()+1);
+        return col;
+    }
+
     DateTimeColumn* col = new DateTimeColumn(idx.size());
     col->assignMetaData(this);
 
@@ -292,13 +328,18 @@ DateTimeColumn* DateTimeColumn::copy(const VectorIndex& idx) const
 /////////////////////////////////////////////////
 void DateTimeColumn::assign(const TableColumn* column)
 {
-    if (column->m_type == TableColumn::TYPE_DATETIME || column->m_type == TableColumn::TYPE_VALUE)
+    if (column->m_type == TableColumn::TYPE_DATETIME)
+    {
+        assignMetaData(column);
+        m_data = static_cast<const DateTimeColumn*>(column)->m_data;
+    }
+    else if (column->m_type == TableColumn::TYPE_VALUE)
     {
         assignMetaData(column);
         m_data.clear();
 
-        for (const auto& val : static_cast<const DateTimeColumn*>(column)->m_data)
-            m_data.push_back(val);
+        for (size_t i = 0; i < column->size(); i++)
+            m_data.push_back(column->getValue(i).real());
     }
     else
         throw SyntaxError(SyntaxError::CANNOT_ASSIGN_COLUMN_OF_DIFFERENT_TYPE, m_sHeadLine, column->m_sHeadLine, typeToString(m_type) + "/" + typeToString(column->m_type));
@@ -488,6 +529,10 @@ TableColumn* DateTimeColumn::convert(ColumnType type)
 {
     TableColumn* col = nullptr;
 
+    // Read-only access, which must not detach the
+    // shared buffer
+    const ColumnBuffer<double>& vData = m_data;
+
     switch (type)
     {
         //case TableColumn::TYPE_NONE: // Disabled for correct autoconversion
@@ -497,8 +542,8 @@ TableColumn* DateTimeColumn::convert(ColumnType type)
 
             for (size_t i = 0; i < m_data.size(); i++)
             {
-                if (!mu::isnan(m_data[i]))
-                    col->setValue(i, toString(to_timePoint(m_data[i]), 0));
+                if (!mu::isnan(vData[i]))
+                    col->setValue(i, toString(to_timePoint(vData[i]), 0));
             }
 
             break;
@@ -509,8 +554,8 @@ TableColumn* DateTimeColumn::convert(ColumnType type)
 
             for (size_t i = 0; i < m_data.size(); i++)
             {
-                if (!mu::isnan(m_data[i]))
-                    col->setValue(i, toString(to_timePoint(m_data[i]), 0));
+                if (!mu::isnan(vData[i]))
+                    col->setValue(i, toString(to_timePoint(vData[i]), 0));
             }
 
             break;
@@ -561,13 +606,8 @@ std::string LogicalColumn::getValueAsString(size_t elem) const
 /////////////////////////////////////////////////
 std::string LogicalColumn::getValueAsInternalString(size_t elem) const
 {
-    if (elem < m_data.size())
-    {
-        if (m_data[elem] == LOGICAL_FALSE)
-            return "false";
-        else if (m_data[elem] == LOGICAL_TRUE)
-            return "true";
-    }
+    if (m_valid.test(elem))
+        return m_values.test(elem) ? "true" : "false";
 
     return "nan";
 }
@@ -612,8 +652,8 @@ std::string LogicalColumn::getValueAsStringLiteral(size_t elem) const
 /////////////////////////////////////////////////
 std::complex<double> LogicalColumn::getValue(size_t elem) const
 {
-    if (elem < m_data.size() && m_data[elem] != LOGICAL_NAN)
-        return m_data[elem] ? 1.0 : 0.0;
+    if (m_valid.test(elem))
+        return m_values.test(elem) ? 1.0 : 0.0;
 
     return NAN;
 }
@@ -630,8 +670,8 @@ std::complex<double> LogicalColumn::getValue(size_t elem) const
 /////////////////////////////////////////////////
 mu::Value LogicalColumn::get(size_t elem) const
 {
-    if (elem < m_data.size() && m_data[elem] != LOGICAL_NAN)
-        return m_data[elem] != 0.0;
+    if (m_valid.test(elem))
+        return m_values.test(elem);
 
     return NAN;
 }
@@ -681,13 +721,14 @@ void LogicalColumn::setValue(size_t elem, const std::string& sValue)
 /////////////////////////////////////////////////
 void LogicalColumn::setValue(size_t elem, const std::complex<double>& vValue)
 {
-    if (elem >= m_data.size() && mu::isnan(vValue))
+    if (elem >= size() && mu::isnan(vValue))
         return;
 
-    if (elem >= m_data.size())
-        m_data.resize(elem+1, LOGICAL_NAN);
+    if (elem >= size())
+        resize(elem+1);
 
-    m_data[elem] = mu::isnan(vValue) ? LOGICAL_NAN : (vValue != 0.0 ? LOGICAL_TRUE : LOGICAL_FALSE);
+    m_valid.set(elem, !mu::isnan(vValue));
+    m_values.set(elem, !mu::isnan(vValue) && vValue != 0.0);
 }
 
 
@@ -704,13 +745,26 @@ LogicalColumn* LogicalColumn::copy(const VectorIndex& idx) const
 {
     idx.setOpenEndIndex(size()-1);
 
+    // Contiguous ranges share the bitmaps
+    if (isContiguousRange(idx, size()))
+    {
+        LogicalColumn* col = new LogicalColumn();
+        col->assignMetaData(this);
+        col->m_valid = m_valid.slice(idx.front(), idx.last()+1);
+        col->m_values = m_values.slice(idx.front(), idx.last()+1);
+        return col;
+    }
+
     LogicalColumn* col = new LogicalColumn(idx.size());
     col->assignMetaData(this);
 
     for (size_t i = 0; i < idx.size(); i++)
     {
-        if (idx[i] >= 0 && idx[i] < (int)m_data.size())
-            col->m_data[i] = m_data[idx[i]];
+        if (idx[i] >= 0 && m_valid.test(idx[i]))
+        {
+            col->m_valid.set(i, true);
+            col->m_values.set(i, m_values.test(idx[i]));
+        }
     }
 
     return col;
@@ -730,7 +784,8 @@ void LogicalColumn::assign(const TableColumn* column)
     if (column->m_type == TableColumn::TYPE_LOGICAL)
     {
         assignMetaData(column);
-        m_data = static_cast<const LogicalColumn*>(column)->m_data;
+        m_valid = static_cast<const LogicalColumn*>(column)->m_valid;
+        m_values = static_cast<const LogicalColumn*>(column)->m_values;
     }
     else
         throw SyntaxError(SyntaxError::CANNOT_ASSIGN_COLUMN_OF_DIFFERENT_TYPE, m_sHeadLine, column->m_sHeadLine, typeToString(m_type) + "/" + typeToString(column->m_type));
@@ -769,16 +824,20 @@ void LogicalColumn::deleteElements(const VectorIndex& idx)
     idx.setOpenEndIndex(size()-1);
 
     // Shortcut, if everything shall be deleted
-    if (idx.isExpanded() && idx.front() == 0 && idx.last() >= (int)m_data.size()-1)
+    if (idx.isExpanded() && idx.front() == 0 && idx.last() >= (int)size()-1)
     {
-        m_data.clear();
+        m_valid.clear();
+        m_values.clear();
         return;
     }
 
     for (size_t i = 0; i < idx.size(); i++)
     {
-        if (idx[i] >= 0 && idx[i] < (int)m_data.size())
-            m_data[idx[i]] = LOGICAL_NAN;
+        if (idx[i] >= 0 && idx[i] < (int)size())
+        {
+            m_valid.set(idx[i], false);
+            m_values.set(idx[i], false);
+        }
     }
 
     shrink();
@@ -798,8 +857,11 @@ void LogicalColumn::deleteElements(const VectorIndex& idx)
 /////////////////////////////////////////////////
 void LogicalColumn::insertElements(size_t pos, size_t elem)
 {
-    if (pos < m_data.size())
-        m_data.insert(m_data.begin()+pos, elem, LOGICAL_NAN);
+    if (pos < size())
+    {
+        m_valid.insert(pos, elem);
+        m_values.insert(pos, elem);
+    }
 }
 
 
@@ -812,7 +874,7 @@ void LogicalColumn::insertElements(size_t pos, size_t elem)
 /////////////////////////////////////////////////
 void LogicalColumn::appendElements(size_t elem)
 {
-    m_data.insert(m_data.end(), elem, LOGICAL_NAN);
+    resize(size()+elem);
 }
 
 
@@ -828,8 +890,11 @@ void LogicalColumn::appendElements(size_t elem)
 /////////////////////////////////////////////////
 void LogicalColumn::removeElements(size_t pos, size_t elem)
 {
-    if (pos < m_data.size())
-        m_data.erase(m_data.begin()+pos, m_data.begin()+pos+elem);
+    if (pos < size())
+    {
+        m_valid.erase(pos, elem);
+        m_values.erase(pos, elem);
+    }
 }
 
 
@@ -842,10 +907,8 @@ void LogicalColumn::removeElements(size_t pos, size_t elem)
 /////////////////////////////////////////////////
 void LogicalColumn::resize(size_t elem)
 {
-    if (!elem)
-        m_data.clear();
-    else
-        m_data.resize(elem, LOGICAL_NAN);
+    m_valid.resize(elem);
+    m_values.resize(elem);
 }
 
 
@@ -862,12 +925,16 @@ void LogicalColumn::resize(size_t elem)
 /////////////////////////////////////////////////
 int LogicalColumn::compare(int i, int j, bool unused) const
 {
-    if ((int)m_data.size() <= std::max(i, j))
+    if ((int)size() <= std::max(i, j))
         return 0;
 
-    if (m_data[i] == m_data[j])
+    // Invalid values are sorted before false and true
+    int val_i = m_valid.test(i) ? m_values.test(i) : -1;
+    int val_j = m_valid.test(j) ? m_values.test(j) : -1;
+
+    if (val_i == val_j)
         return 0;
-    else if (m_data[i] < m_data[j])
+    else if (val_i < val_j)
         return -1;
 
     return 1;
@@ -884,10 +951,7 @@ int LogicalColumn::compare(int i, int j, bool unused) const
 /////////////////////////////////////////////////
 bool LogicalColumn::isValid(int elem) const
 {
-    if (elem >= (int)m_data.size() || elem < 0 || m_data[elem] == LOGICAL_NAN)
-        return false;
-
-    return true;
+    return elem >= 0 && m_valid.test(elem);
 }
 
 
@@ -900,10 +964,7 @@ bool LogicalColumn::isValid(int elem) const
 /////////////////////////////////////////////////
 bool LogicalColumn::asBool(int elem) const
 {
-    if (elem < 0 || elem >= (int)m_data.size())
-        return false;
-
-    return m_data[elem] == LOGICAL_TRUE;
+    return elem >= 0 && m_values.test(elem);
 }
 
 
@@ -925,24 +986,24 @@ TableColumn* LogicalColumn::convert(ColumnType type)
         //case TableColumn::TYPE_NONE: // Disabled for correct autoconversion
         case TableColumn::TYPE_STRING:
         {
-            col = new StringColumn(m_data.size());
+            col = new StringColumn(size());
 
-            for (size_t i = 0; i < m_data.size(); i++)
+            for (size_t i = 0; i < size(); i++)
             {
-                if (m_data[i] != LOGICAL_NAN)
-                    col->setValue(i, m_data[i] == LOGICAL_TRUE ? "true" : "false");
+                if (m_valid.test(i))
+                    col->setValue(i, m_values.test(i) ? "true" : "false");
             }
 
             break;
         }
         case TableColumn::TYPE_CATEGORICAL:
         {
-            col = new CategoricalColumn(m_data.size());
+            col = new CategoricalColumn(size());
 
-            for (size_t i = 0; i < m_data.size(); i++)
+            for (size_t i = 0; i < size(); i++)
             {
-                if (m_data[i] != LOGICAL_NAN)
-                    col->setValue(i, m_data[i] == LOGICAL_TRUE ? "true" : "false");
+                if (m_valid.test(i))
+                    col->setValue(i, m_values.test(i) ? "true" : "false");
             }
 
             break;
@@ -954,12 +1015,12 @@ TableColumn* LogicalColumn::convert(ColumnType type)
             if (!TableColumn::isValueType(type))
                 return nullptr;
 
-            col = createValueTypeColumn(type, m_data.size());
+            col = createValueTypeColumn(type, size());
 
-            for (size_t i = 0; i < m_data.size(); i++)
+            for (size_t i = 0; i < size(); i++)
             {
-                if (m_data[i] != LOGICAL_NAN)
-                    col->setValue(i, m_data[i] == LOGICAL_TRUE ? 1.0 : 0.0);
+                if (m_valid.test(i))
+                    col->setValue(i, m_values.test(i) ? 1.0 : 0.0);
             }
         }
     }
@@ -1138,6 +1199,15 @@ StringColumn* StringColumn::copy(const VectorIndex& idx) const
 {
     idx.setOpenEndIndex(size()-1);
 
+    // Contiguous ranges share the buffer
+    if (isContiguousRange(idx, size()))
+    {
+        StringColumn* col = new StringColumn();
+        col->assignMetaData(this);
+        col->m_data = m_data.slice(idx.front(), idx.last()+1);
+        return col;
+    }
+
     StringColumn* col = new StringColumn(idx.size());
     col->assignMetaData(this);
 
@@ -1183,7 +1253,10 @@ void StringColumn::assign(const TableColumn* column)
 void StringColumn::insert(const VectorIndex& idx, const TableColumn* column)
 {
     if (column->m_type == TableColumn::TYPE_STRING)
-        TableColumn::setValue(idx, static_cast<const StringColumn*>(column)->m_data);
+    {
+        const ColumnBuffer<std::string>& vData = static_cast<const StringColumn*>(column)->m_data;
+        TableColumn::setValue(idx, std::vector<std::string>(vData.begin(), vData.end()));
+    }
     else
         throw SyntaxError(SyntaxError::CANNOT_ASSIGN_COLUMN_OF_DIFFERENT_TYPE, m_sHeadLine, column->m_sHeadLine, typeToString(m_type) + "/" + typeToString(column->m_type));
 }
@@ -1382,9 +1455,13 @@ TableColumn* StringColumn::convert(ColumnType type)
 {
     TableColumn* col = nullptr;
 
+    // Read-only access, which must not detach the
+    // shared buffer
+    const ColumnBuffer<std::string>& vData = m_data;
+
     // Determine first, if a conversion is possible
     int numFormat = 0;
-    ConvertibleType convType = detectCommonType(m_data, numFormat);
+    ConvertibleType convType = detectCommonType(vData, numFormat);
 
     switch (type)
     {
@@ -1418,7 +1495,7 @@ TableColumn* StringColumn::convert(ColumnType type)
         case TableColumn::TYPE_CATEGORICAL:
         {
             col = new CategoricalColumn(m_data.size());
-            col->setValue(VectorIndex(0, VectorIndex::OPEN_END), m_data);
+            col->setValue(VectorIndex(0, VectorIndex::OPEN_END), std::vector<std::string>(vData.begin(), vData.end()));
             col->assignMetaData(this);
             return col;
         }
@@ -1446,15 +1523,15 @@ TableColumn* StringColumn::convert(ColumnType type)
 
     for (size_t i = 0; i < m_data.size(); i++)
     {
-        if (!m_data[i].length() || toLowerCase(m_data[i]) == "nan" || m_data[i] == "---")
+        if (!vData[i].length() || toLowerCase(vData[i]) == "nan" || vData[i] == "---")
             col->setValue(i, NAN);
-        else if (toLowerCase(m_data[i]) == "inf")
+        else if (toLowerCase(vData[i]) == "inf")
             col->setValue(i, INFINITY);
-        else if (toLowerCase(m_data[i]) == "-inf")
+        else if (toLowerCase(vData[i]) == "-inf")
             col->setValue(i, -INFINITY);
         else if (convType == CONVTYPE_VALUE)
         {
-            std::string strval = m_data[i];
+            std::string strval = vData[i];
             strChangeNumberFormat(strval, numFormat);
             col->setValue(i, !isConvertible(strval, CONVTYPE_VALUE)
                              ? StrToLogical(strval)
@@ -1462,13 +1539,13 @@ TableColumn* StringColumn::convert(ColumnType type)
         }
         else if (convType == CONVTYPE_LOGICAL)
         {
-            std::string strval = m_data[i];
+            std::string strval = vData[i];
             replaceAll(strval, ",", ".");
             col->setValue(i, StrToLogical(strval));
         }
         else if (convType == CONVTYPE_DATE_TIME)
         {
-            col->setValue(i, to_double(StrToTime(m_data[i])));
+            col->setValue(i, to_double(StrToTime(vData[i])));
         }
     }
 
@@ -1480,6 +1557,234 @@ TableColumn* StringColumn::convert(ColumnType type)
 
 
 
+/////////////////////////////////////////////////
+/// \brief Returns the ids [first, last) sharing
+/// the storage of this instance.
+///
+/// \param first size_t
+/// \param last size_t
+/// \return CategoryIdArray
+///
+/////////////////////////////////////////////////
+CategoryIdArray CategoryIdArray::slice(size_t first, size_t last) const
+{
+    CategoryIdArray ids;
+    ids.m_width = m_width;
+
+    switch (m_width)
+    {
+        case sizeof(uint8_t):
+            ids.m_ids8 = m_ids8.slice(first, last);
+            break;
+        case sizeof(uint16_t):
+            ids.m_ids16 = m_ids16.slice(first, last);
+            break;
+        default:
+            ids.m_ids32 = m_ids32.slice(first, last);
+    }
+
+    return ids;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Counts the occurences of the passed id
+/// directly within the typed storage.
+///
+/// \param id uint32_t
+/// \return size_t
+///
+/////////////////////////////////////////////////
+size_t CategoryIdArray::count(uint32_t id) const
+{
+    switch (m_width)
+    {
+        case sizeof(uint8_t):
+            return id > UINT8_MAX ? 0 : std::count(m_ids8.data(), m_ids8.data()+m_ids8.size(), (uint8_t)id);
+        case sizeof(uint16_t):
+            return id > UINT16_MAX ? 0 : std::count(m_ids16.data(), m_ids16.data()+m_ids16.size(), (uint16_t)id);
+    }
+
+    return std::count(m_ids32.data(), m_ids32.data()+m_ids32.size(), id);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Widens the storage, if the passed id
+/// does not fit into the current width. Already
+/// stored ids are converted.
+///
+/// \param maxId uint32_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void CategoryIdArray::widen(uint32_t maxId)
+{
+    size_t width = sizeof(uint32_t);
+
+    if (maxId <= UINT8_MAX)
+        width = sizeof(uint8_t);
+    else if (maxId <= UINT16_MAX)
+        width = sizeof(uint16_t);
+
+    if (width <= m_width)
+        return;
+
+    if (width == sizeof(uint16_t))
+    {
+        m_ids16 = std::vector<uint16_t>(m_ids8.cbegin(), m_ids8.cend());
+        m_ids8.clear();
+    }
+    else if (m_width == sizeof(uint8_t))
+    {
+        m_ids32 = std::vector<uint32_t>(m_ids8.cbegin(), m_ids8.cend());
+        m_ids8.clear();
+    }
+    else
+    {
+        m_ids32 = std::vector<uint32_t>(m_ids16.cbegin(), m_ids16.cend());
+        m_ids16.clear();
+    }
+
+    m_width = width;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Resizes the storage. New elements are
+/// missing values.
+///
+/// \param nSize size_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void CategoryIdArray::resize(size_t nSize)
+{
+    switch (m_width)
+    {
+        case sizeof(uint8_t):
+            m_ids8.resize(nSize, 0);
+            break;
+        case sizeof(uint16_t):
+            m_ids16.resize(nSize, 0);
+            break;
+        default:
+            m_ids32.resize(nSize, 0);
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Inserts the selected number of missing
+/// values at the passed position.
+///
+/// \param pos size_t
+/// \param nElems size_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void CategoryIdArray::insert(size_t pos, size_t nElems)
+{
+    switch (m_width)
+    {
+        case sizeof(uint8_t):
+            m_ids8.insert(m_ids8.begin()+pos, nElems, 0);
+            break;
+        case sizeof(uint16_t):
+            m_ids16.insert(m_ids16.begin()+pos, nElems, 0);
+            break;
+        default:
+            m_ids32.insert(m_ids32.begin()+pos, nElems, 0);
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Removes the selected number of ids
+/// starting at the passed position.
+///
+/// \param pos size_t
+/// \param nElems size_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void CategoryIdArray::erase(size_t pos, size_t nElems)
+{
+    nElems = std::min(nElems, size()-pos);
+
+    switch (m_width)
+    {
+        case sizeof(uint8_t):
+            m_ids8.erase(m_ids8.begin()+pos, m_ids8.begin()+pos+nElems);
+            break;
+        case sizeof(uint16_t):
+            m_ids16.erase(m_ids16.begin()+pos, m_ids16.begin()+pos+nElems);
+            break;
+        default:
+            m_ids32.erase(m_ids32.begin()+pos, m_ids32.begin()+pos+nElems);
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Removes all ids and returns to the
+/// smallest width.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void CategoryIdArray::clear()
+{
+    m_ids8.clear();
+    m_ids16.clear();
+    m_ids32.clear();
+    m_width = sizeof(uint8_t);
+}
+
+
+
+
+
+/////////////////////////////////////////////////
+/// \brief Appends a new category and registers
+/// it in the category index. Returns the
+/// zero-based id of the new category.
+///
+/// \param sCategory const std::string&
+/// \return int
+///
+/////////////////////////////////////////////////
+int CategoricalColumn::addCategory(const std::string& sCategory)
+{
+    m_categories.push_back(sCategory);
+    m_categoryIndex.emplace(sCategory, m_categories.size()-1);
+    m_data.widen(m_categories.size());
+    return m_categories.size()-1;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Rebuilds the category index from the
+/// list of categories. Duplicates are resolved
+/// to their first occurence.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void CategoricalColumn::rebuildIndex()
+{
+    m_categoryIndex.clear();
+    m_categoryIndex.reserve(m_categories.size());
+
+    for (size_t i = 0; i < m_categories.size(); i++)
+    {
+        m_categoryIndex.emplace(m_categories[i], i);
+    }
+
+    m_data.widen(m_categories.size());
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Returns the selected value or an empty
 /// string, if the value does not exist.
@@ -1490,8 +1795,8 @@ TableColumn* StringColumn::convert(ColumnType type)
 /////////////////////////////////////////////////
 std::string CategoricalColumn::getValueAsString(size_t elem) const
 {
-    if (elem < m_data.size() && m_data[elem] != CATEGORICAL_NAN)
-        return toString(m_data[elem]+1);
+    if (elem < m_data.size() && getId(elem) != CATEGORICAL_NAN)
+        return toString(getId(elem)+1);
 
     return "nan";
 }
@@ -1507,8 +1812,8 @@ std::string CategoricalColumn::getValueAsString(size_t elem) const
 /////////////////////////////////////////////////
 std::string CategoricalColumn::getValueAsInternalString(size_t elem) const
 {
-    if (elem < m_data.size() && m_data[elem] != CATEGORICAL_NAN)
-        return m_categories[m_data[elem]];
+    if (elem < m_data.size() && getId(elem) != CATEGORICAL_NAN)
+        return m_categories[getId(elem)];
 
     return "";
 }
@@ -1552,8 +1857,8 @@ std::string CategoricalColumn::getValueAsStringLiteral(size_t elem) const
 /////////////////////////////////////////////////
 std::complex<double> CategoricalColumn::getValue(size_t elem) const
 {
-    if (elem < m_data.size() && m_data[elem] != CATEGORICAL_NAN)
-        return m_data[elem]+1;
+    if (elem < m_data.size() && getId(elem) != CATEGORICAL_NAN)
+        return getId(elem)+1;
 
     return NAN;
 }
@@ -1570,8 +1875,8 @@ std::complex<double> CategoricalColumn::getValue(size_t elem) const
 /////////////////////////////////////////////////
 mu::Value CategoricalColumn::get(size_t elem) const
 {
-    if (elem < m_data.size() && m_data[elem] != CATEGORICAL_NAN)
-        return mu::Category(m_data[elem]+1, m_categories[m_data[elem]]);
+    if (elem < m_data.size() && getId(elem) != CATEGORICAL_NAN)
+        return mu::Category(getId(elem)+1, m_categories[getId(elem)]);
 
     return NAN;
 }
@@ -1608,26 +1913,91 @@ void CategoricalColumn::setValue(size_t elem, const std::string& sValue)
         return;
 
     if (elem >= m_data.size())
-        m_data.resize(elem+1, CATEGORICAL_NAN);
+        m_data.resize(elem+1);
 
     if (!sValue.length())
     {
-        m_data[elem] = CATEGORICAL_NAN;
+        setId(elem, CATEGORICAL_NAN);
         return;
     }
 
-    auto iter = std::find(m_categories.begin(), m_categories.end(), sValue);
+    int id = findCategory(sValue);
 
-    if (iter != m_categories.end())
-        m_data[elem] = iter - m_categories.begin();
-    else
+    if (id == CATEGORICAL_NAN)
+        id = addCategory(sValue);
+
+    setId(elem, id);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Set a vector of string values at the
+/// specified indices. The categories are
+/// resolved before the ids are written, so that
+/// the id storage is widened at most once.
+///
+/// \param idx const VectorIndex&
+/// \param vValue const std::vector<std::string>&
+/// \return void
+///
+/////////////////////////////////////////////////
+void CategoricalColumn::setValue(const VectorIndex& idx, const std::vector<std::string>& vValue)
+{
+    size_t nCount = std::min(idx.size(), vValue.size());
+
+    std::vector<int> vIds(nCount, CATEGORICAL_NAN);
+    int maxRow = -1;
+
+    for (size_t i = 0; i < nCount; i++)
     {
-        m_categories.push_back(sValue);
-        m_data[elem] = m_categories.size()-1;
+        if (idx[i] < 0)
+            continue;
+
+        if (vValue[i].length())
+        {
+            vIds[i] = findCategory(vValue[i]);
+
+            if (vIds[i] == CATEGORICAL_NAN)
+                vIds[i] = addCategory(vValue[i]);
+
+            // Only non-empty values enlarge the column
+            maxRow = std::max(maxRow, idx[i]);
+        }
+    }
+
+    if (maxRow >= (int)m_data.size())
+        m_data.resize(maxRow+1);
+
+    for (size_t i = 0; i < nCount; i++)
+    {
+        if (idx[i] >= 0 && idx[i] < (int)m_data.size())
+            setId(idx[i], vIds[i]);
     }
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Appends a vector of string values to
+/// the end of the column. Empty strings are
+/// appended as missing values. Meant for
+/// importers, which collect a whole column
+/// before storing it.
+///
+/// \param vValues const std::vector<std::string>&
+/// \return void
+///
+/////////////////////////////////////////////////
+void CategoricalColumn::appendValues(const std::vector<std::string>& vValues)
+{
+    if (!vValues.size())
+        return;
+
+    size_t nFirst = m_data.size();
+    m_data.resize(nFirst + vValues.size());
+    setValue(VectorIndex(nFirst, nFirst + vValues.size()-1), vValues);
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Set a single numerical value.
 ///
@@ -1642,12 +2012,12 @@ void CategoricalColumn::setValue(size_t elem, const std::complex<double>& vValue
         return;
 
     if (elem >= m_data.size())
-        m_data.resize(elem+1, CATEGORICAL_NAN);
+        m_data.resize(elem+1);
 
     if (isInt(vValue) && (size_t)intCast(vValue) <= m_categories.size())
-        m_data[elem] = intCast(vValue)-1;
+        setId(elem, intCast(vValue)-1);
     else if (mu::isnan(vValue))
-        m_data[elem] = CATEGORICAL_NAN;
+        setId(elem, CATEGORICAL_NAN);
     else
         setValue(elem, toString(vValue, NumeReKernel::getInstance()->getSettings().getPrecision()));
 }
@@ -1666,15 +2036,27 @@ CategoricalColumn* CategoricalColumn::copy(const VectorIndex& idx) const
 {
     idx.setOpenEndIndex(size()-1);
 
+    // Contiguous ranges share the id buffer
+    if (isContiguousRange(idx, size()))
+    {
+        CategoricalColumn* col = new CategoricalColumn();
+        col->assignMetaData(this);
+        col->m_categories = m_categories;
+        col->m_categoryIndex = m_categoryIndex;
+        col->m_data = m_data.slice(idx.front(), idx.last()+1);
+        return col;
+    }
+
     CategoricalColumn* col = new CategoricalColumn(idx.size());
     col->assignMetaData(this);
+    col->m_categories = m_categories;
+    col->m_categoryIndex = m_categoryIndex;
+    col->m_data.widen(m_categories.size());
 
     for (size_t i = 0; i < idx.size(); i++)
     {
         if (idx[i] >= 0 && idx[i] < (int)m_data.size())
-            col->m_data[i] = m_data[idx[i]];
-
-        col->m_categories = m_categories;
+            col->m_data.set(i, m_data.get(idx[i]));
     }
 
     return col;
@@ -1696,6 +2078,7 @@ void CategoricalColumn::assign(const TableColumn* column)
         assignMetaData(column);
         m_data = static_cast<const CategoricalColumn*>(column)->m_data;
         m_categories = static_cast<const CategoricalColumn*>(column)->m_categories;
+        m_categoryIndex = static_cast<const CategoricalColumn*>(column)->m_categoryIndex;
     }
     else
         throw SyntaxError(SyntaxError::CANNOT_ASSIGN_COLUMN_OF_DIFFERENT_TYPE, m_sHeadLine, column->m_sHeadLine, typeToString(m_type) + "/" + typeToString(column->m_type));
@@ -1716,7 +2099,7 @@ void CategoricalColumn::insert(const VectorIndex& idx, const TableColumn* column
     if (column->m_type == TableColumn::TYPE_CATEGORICAL)
     {
         mergeCategories(static_cast<const CategoricalColumn*>(column)->m_categories);
-        TableColumn::setValue(idx, column->getValueAsInternalString(VectorIndex(0, VectorIndex::OPEN_END)));
+        setValue(idx, column->getValueAsInternalString(VectorIndex(0, VectorIndex::OPEN_END)));
     }
     else
         throw SyntaxError(SyntaxError::CANNOT_ASSIGN_COLUMN_OF_DIFFERENT_TYPE, m_sHeadLine, column->m_sHeadLine, typeToString(m_type) + "/" + typeToString(column->m_type));
@@ -1741,6 +2124,7 @@ void CategoricalColumn::deleteElements(const VectorIndex& idx)
     {
         m_data.clear();
         m_categories.clear();
+        m_categoryIndex.clear();
         return;
     }
 
@@ -1748,7 +2132,7 @@ void CategoricalColumn::deleteElements(const VectorIndex& idx)
     {
         if (idx[i] >= 0 && idx[i] < (int)m_data.size())
         {
-            m_data[idx[i]] = CATEGORICAL_NAN;
+            setId(idx[i], CATEGORICAL_NAN);
         }
     }
 
@@ -1770,7 +2154,7 @@ void CategoricalColumn::deleteElements(const VectorIndex& idx)
 void CategoricalColumn::insertElements(size_t pos, size_t elem)
 {
     if (pos < m_data.size())
-        m_data.insert(m_data.begin()+pos, elem, CATEGORICAL_NAN);
+        m_data.insert(pos, elem);
 }
 
 
@@ -1783,7 +2167,7 @@ void CategoricalColumn::insertElements(size_t pos, size_t elem)
 /////////////////////////////////////////////////
 void CategoricalColumn::appendElements(size_t elem)
 {
-    m_data.insert(m_data.end(), elem, CATEGORICAL_NAN);
+    m_data.insert(m_data.size(), elem);
 }
 
 
@@ -1800,7 +2184,7 @@ void CategoricalColumn::appendElements(size_t elem)
 void CategoricalColumn::removeElements(size_t pos, size_t elem)
 {
     if (pos < m_data.size())
-        m_data.erase(m_data.begin()+pos, m_data.begin()+pos+elem);
+        m_data.erase(pos, elem);
 }
 
 
@@ -1816,7 +2200,7 @@ void CategoricalColumn::resize(size_t elem)
     if (!elem)
         m_data.clear();
     else
-        m_data.resize(elem, CATEGORICAL_NAN);
+        m_data.resize(elem);
 }
 
 
@@ -1838,16 +2222,16 @@ int CategoricalColumn::compare(int i, int j, bool caseinsensitive) const
 
     if (caseinsensitive)
     {
-        if (toLowerCase(m_categories[m_data[i]]) == toLowerCase(m_categories[m_data[j]]))
+        if (toLowerCase(m_categories[getId(i)]) == toLowerCase(m_categories[getId(j)]))
             return 0;
-        else if (toLowerCase(m_categories[m_data[i]]) < toLowerCase(m_categories[m_data[j]]))
+        else if (toLowerCase(m_categories[getId(i)]) < toLowerCase(m_categories[getId(j)]))
             return -1;
     }
     else
     {
-        if (m_categories[m_data[i]] == m_categories[m_data[j]])
+        if (m_categories[getId(i)] == m_categories[getId(j)])
             return 0;
-        else if (m_categories[m_data[i]] < m_categories[m_data[j]])
+        else if (m_categories[getId(i)] < m_categories[getId(j)])
             return -1;
     }
 
@@ -1865,7 +2249,7 @@ int CategoricalColumn::compare(int i, int j, bool caseinsensitive) const
 /////////////////////////////////////////////////
 bool CategoricalColumn::isValid(int elem) const
 {
-    if (elem >= (int)m_data.size() || elem < 0 || m_data[elem] == CATEGORICAL_NAN)
+    if (elem >= (int)m_data.size() || elem < 0 || getId(elem) == CATEGORICAL_NAN)
         return false;
 
     return true;
@@ -1884,7 +2268,7 @@ bool CategoricalColumn::asBool(int elem) const
     if (elem < 0 || elem >= (int)m_data.size())
         return false;
 
-    return m_data[elem] != CATEGORICAL_NAN && m_categories[m_data[elem]].length() != 0;
+    return getId(elem) != CATEGORICAL_NAN && m_categories[getId(elem)].length() != 0;
 }
 
 
@@ -1902,7 +2286,7 @@ size_t CategoricalColumn::getBytes() const
     for (const auto& val : m_categories)
         bytes += val.capacity() * sizeof(char);
 
-    return size() * sizeof(int) + bytes + m_sHeadLine.capacity() * sizeof(char);
+    return size() * m_data.width() + bytes + m_sHeadLine.capacity() * sizeof(char);
 }
 
 
@@ -1983,27 +2367,29 @@ TableColumn* CategoricalColumn::convert(ColumnType type)
 
     for (size_t i = 0; i < m_data.size(); i++)
     {
-        if (m_data[i] == CATEGORICAL_NAN || toLowerCase(m_categories[m_data[i]]) == "nan" || m_categories[m_data[i]] == "---")
+        int id = getId(i);
+
+        if (id == CATEGORICAL_NAN || toLowerCase(m_categories[id]) == "nan" || m_categories[id] == "---")
             col->setValue(i, NAN);
-        else if (toLowerCase(m_categories[m_data[i]]) == "inf")
+        else if (toLowerCase(m_categories[id]) == "inf")
             col->setValue(i, INFINITY);
-        else if (toLowerCase(m_categories[m_data[i]]) == "-inf")
+        else if (toLowerCase(m_categories[id]) == "-inf")
             col->setValue(i, -INFINITY);
         else if (convType == CONVTYPE_VALUE)
         {
-            std::string strval = m_categories[m_data[i]];
+            std::string strval = m_categories[id];
             strChangeNumberFormat(strval, NumFormat);
             col->setValue(i, StrToCmplx(strval));
         }
         else if (convType == CONVTYPE_LOGICAL)
         {
-            std::string strval = m_categories[m_data[i]];
+            std::string strval = m_categories[id];
             replaceAll(strval, ",", ".");
             col->setValue(i, StrToLogical(strval));
         }
         else if (convType == CONVTYPE_DATE_TIME)
         {
-            col->setValue(i, to_double(StrToTime(m_categories[m_data[i]])));
+            col->setValue(i, to_double(StrToTime(m_categories[id])));
         }
     }
 
@@ -2026,6 +2412,7 @@ void CategoricalColumn::setCategories(const std::vector<std::string>& vCategorie
     if (!m_categories.size())
     {
         m_categories = vCategories;
+        rebuildIndex();
         return;
     }
 
@@ -2033,15 +2420,24 @@ void CategoricalColumn::setCategories(const std::vector<std::string>& vCategorie
     std::vector<int> vMap(m_categories.size(), -1);
     std::vector<int> vFreeList;
 
+    // Index the new categories (first occurence wins)
+    std::unordered_map<std::string, int> mNewIndex;
+    mNewIndex.reserve(vCategories.size());
+
+    for (size_t i = 0; i < vCategories.size(); i++)
+    {
+        mNewIndex.emplace(vCategories[i], i);
+    }
+
     // Create a mapping for the old categories in the set of
     // new categories. Their order might be different and some
     // might be missing. Move those to the end of the index
     for (size_t i = 0; i < m_categories.size(); i++)
     {
-        auto iter = std::find(vCategories.begin(), vCategories.end(), m_categories[i]);
+        auto iter = mNewIndex.find(m_categories[i]);
 
-        if (iter != vCategories.end())
-            vMap[i] = std::distance(vCategories.begin(), iter);
+        if (iter != mNewIndex.end())
+            vMap[i] = iter->second;
         else if (vCategories.size() < vMap.size())
         {
             bool assigned = false;
@@ -2106,10 +2502,13 @@ void CategoricalColumn::setCategories(const std::vector<std::string>& vCategorie
         m_categories[i] = vCategories[i];
     }
 
+    rebuildIndex();
+
     // Remap all existing ids to their new values
-    for (int& val : m_data)
+    for (size_t i = 0; i < m_data.size(); i++)
     {
-        val = vMap[val];
+        if (getId(i) != CATEGORICAL_NAN)
+            setId(i, vMap[getId(i)]);
     }
 }
 
@@ -2127,8 +2526,8 @@ void CategoricalColumn::mergeCategories(const std::vector<std::string>& vCategor
     // Append a category, if it is missing
     for (const auto& cat : vCategories)
     {
-        if (std::find(m_categories.begin(), m_categories.end(), cat) == m_categories.end())
-            m_categories.push_back(cat);
+        if (findCategory(cat) == CATEGORICAL_NAN)
+            addCategory(cat);
     }
 }
 
@@ -2143,7 +2542,46 @@ void CategoricalColumn::mergeCategories(const std::vector<std::string>& vCategor
 /////////////////////////////////////////////////
 bool CategoricalColumn::isCategory(const std::string& candidate) const
 {
-    return std::find(m_categories.begin(), m_categories.end(), candidate) != m_categories.end();
+    return m_categoryIndex.find(candidate) != m_categoryIndex.end();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the zero-based id of the passed
+/// category or -1, if it is not a category of
+/// this column.
+///
+/// \param candidate const std::string&
+/// \return int
+///
+/////////////////////////////////////////////////
+int CategoricalColumn::findCategory(const std::string& candidate) const
+{
+    auto iter = m_categoryIndex.find(candidate);
+
+    if (iter != m_categoryIndex.end())
+        return iter->second;
+
+    return CATEGORICAL_NAN;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Counts the elements belonging to the
+/// passed zero-based category (as returned by
+/// findCategory()). Missing values are never
+/// counted.
+///
+/// \param id int
+/// \return size_t
+///
+/////////////////////////////////////////////////
+size_t CategoricalColumn::countCategory(int id) const
+{
+    if (id < 0 || id >= (int)m_categories.size())
+        return 0;
+
+    return m_data.count(id+1);
 }
 
 
@@ -20,6 +20,7 @@
 #define TABLECOLUMNIMPL_HPP
 
 #include "tablecolumn.hpp"
+#include <unordered_map>
 #include "../utils/tools.hpp"
 #include "../ui/error.hpp"
 #include "../../kernel.hpp"
@@ -42,16 +43,94 @@ template <class T, TableColumn::ColumnType COLTYPE>
 class GenericValueColumn : public TableColumn
 {
     protected:
-        std::vector<T> m_data;
+        ColumnBuffer<T> m_data;
         const T INVALID_VALUE = std::is_integral<T>::value ? 0 : NAN;// (T(1.1) == 1.1 ? NAN : 0);
-        size_t m_numElements;
+        Bitmap m_valid;
+
+        /////////////////////////////////////////////////
+        /// \brief Let this column share the rows
+        /// [first, last) of the passed column without
+        /// copying them.
+        ///
+        /// \param column const GenericValueColumn*
+        /// \param first size_t
+        /// \param last size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void shareRange(const GenericValueColumn* column, size_t first, size_t last)
+        {
+            m_data = column->m_data.slice(first, last);
+            m_valid = column->m_valid.slice(first, last);
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Mark all valid rows of the span
+        /// [first, last) in the span's bitmap.
+        ///
+        /// \param first size_t
+        /// \param last size_t
+        /// \param span ColumnSpan<S>&
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        template<class S>
+        void markValidRows(size_t first, size_t last, ColumnSpan<S>& span) const
+        {
+            span.setValidity(m_valid, first);
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Fill the span with a converted copy
+        /// of the rows [first, last).
+        ///
+        /// \param first size_t
+        /// \param last size_t
+        /// \param span ColumnSpan<S>&
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        template<class S>
+        void convertSpan(size_t first, size_t last, ColumnSpan<S>& span) const
+        {
+            last = std::min(last, m_data.size());
+            first = std::min(first, last);
+
+            S* data = span.allocate(last - first);
+
+            for (size_t i = first; i < last; i++)
+            {
+                toSpanValue(data[i-first], m_data[i]);
+            }
+
+            markValidRows(first, last, span);
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Let the span refer directly to the
+        /// internal storage for the rows [first, last).
+        ///
+        /// \param first size_t
+        /// \param last size_t
+        /// \param span ColumnSpan<T>&
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void convertSpan(size_t first, size_t last, ColumnSpan<T>& span) const
+        {
+            last = std::min(last, m_data.size());
+            first = std::min(first, last);
+
+            span.refer(m_data.data()+first, last - first);
+            markValidRows(first, last, span);
+        }
 
     public:
         /////////////////////////////////////////////////
         /// \brief Default constructor. Sets only the
         ///  type of the column.
         /////////////////////////////////////////////////
-        GenericValueColumn() : TableColumn(), m_numElements(0)
+        GenericValueColumn() : TableColumn()
         {
             m_type = COLTYPE;
         }
@@ -94,7 +173,7 @@ class GenericValueColumn : public TableColumn
         /////////////////////////////////////////////////
         virtual std::string getValueAsInternalString(size_t elem) const override
         {
-            if (elem < m_data.size())
+            if (m_valid.test(elem))
                 return toString(std::complex<double>(m_data[elem]), 14);
 
             return "nan";
@@ -124,7 +203,7 @@ class GenericValueColumn : public TableColumn
         virtual std::string getValueAsStringLiteral(size_t elem) const override
         {
 #warning FIXME (numere#6#11/09/23): Using the explicit constructor is a hack
-            if (elem < m_data.size())
+            if (m_valid.test(elem))
                 return toString(std::complex<double>(m_data[elem]), NumeReKernel::getInstance()->getSettings().getPrecision()) + (this->m_sUnit.length() ? " " + this->m_sUnit : "");
 
             return "nan";
@@ -141,7 +220,7 @@ class GenericValueColumn : public TableColumn
         /////////////////////////////////////////////////
         virtual std::complex<double> getValue(size_t elem) const override
         {
-            if (elem < m_data.size())
+            if (m_valid.test(elem))
                 return m_data[elem];
 
             return NAN;
@@ -158,12 +237,60 @@ class GenericValueColumn : public TableColumn
         /////////////////////////////////////////////////
         virtual mu::Value get(size_t elem) const override
         {
-            if (elem < m_data.size())
+            if (m_valid.test(elem))
                 return m_data[elem];
 
             return NAN;
         }
 
+        /////////////////////////////////////////////////
+        /// \brief Returns the rows [first, last) as a
+        /// span of real values without copying, if the
+        /// internal type is double.
+        ///
+        /// \param first size_t
+        /// \param last size_t
+        /// \param span ColumnSpan<double>&
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        virtual void getSpan(size_t first, size_t last, ColumnSpan<double>& span) const override
+        {
+            convertSpan(first, last, span);
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Returns the rows [first, last) as a
+        /// span of integer values without copying, if
+        /// the internal type is int64_t.
+        ///
+        /// \param first size_t
+        /// \param last size_t
+        /// \param span ColumnSpan<int64_t>&
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        virtual void getSpan(size_t first, size_t last, ColumnSpan<int64_t>& span) const override
+        {
+            convertSpan(first, last, span);
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Returns the rows [first, last) as a
+        /// span of complex values without copying, if
+        /// the internal type is std::complex<double>.
+        ///
+        /// \param first size_t
+        /// \param last size_t
+        /// \param span ColumnSpan<std::complex<double>>&
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        virtual void getSpan(size_t first, size_t last, ColumnSpan<std::complex<double>>& span) const override
+        {
+            convertSpan(first, last, span);
+        }
+
         virtual void setValue(size_t elem, const std::complex<double>& vValue) = 0;
 
         /////////////////////////////////////////////////
@@ -211,8 +338,19 @@ class GenericValueColumn : public TableColumn
             if (column->m_type == m_type)
             {
                 assignMetaData(column);
-                m_data = static_cast<const GenericValueColumn*>(column)->m_data;
-                m_numElements = static_cast<const GenericValueColumn*>(column)->m_numElements;
+
+                // Columns of the same type might be
+                // implemented differently (e.g. mapped)
+                if (const GenericValueColumn* col = dynamic_cast<const GenericValueColumn*>(column))
+                {
+                    m_data = col->m_data;
+                    m_valid = col->m_valid;
+                }
+                else
+                {
+                    resize(0);
+                    TableColumn::setValue(VectorIndex(0, VectorIndex::OPEN_END), column->TableColumn::getValue(VectorIndex(0, VectorIndex::OPEN_END)));
+                }
             }
             else
                 throw SyntaxError(SyntaxError::CANNOT_ASSIGN_COLUMN_OF_DIFFERENT_TYPE, m_sHeadLine, column->m_sHeadLine, typeToString(m_type) + "/" + typeToString(column->m_type));
@@ -230,7 +368,7 @@ class GenericValueColumn : public TableColumn
         virtual void insert(const VectorIndex& idx, const TableColumn* column) override
         {
             if (column->m_type == m_type)
-                TableColumn::setValue(idx, static_cast<const GenericValueColumn*>(column)->TableColumn::getValue(VectorIndex(0, VectorIndex::OPEN_END)));
+                TableColumn::setValue(idx, column->TableColumn::getValue(VectorIndex(0, VectorIndex::OPEN_END)));
             else
                 throw SyntaxError(SyntaxError::CANNOT_ASSIGN_COLUMN_OF_DIFFERENT_TYPE, m_sHeadLine, column->m_sHeadLine, typeToString(m_type) + "/" + typeToString(column->m_type));
         }
@@ -252,20 +390,19 @@ class GenericValueColumn : public TableColumn
             if (idx.isExpanded() && idx.front() == 0 && idx.last() >= (int)m_data.size()-1)
             {
                 m_data.clear();
-                m_numElements = 0;
+                m_valid.clear();
                 return;
             }
 
             for (size_t i = 0; i < idx.size(); i++)
             {
                 if (idx[i] >= 0 && idx[i] < (int)m_data.size())
+                {
                     m_data[idx[i]] = INVALID_VALUE;
+                    m_valid.set(idx[i], false);
+                }
             }
 
-            // Update the number of elements
-            if (idx.isExpanded() && idx.last() >= (int)m_data.size()-1)
-                m_numElements = std::min(m_numElements, (size_t)idx.front());
-
             shrink();
         }
 
@@ -285,9 +422,7 @@ class GenericValueColumn : public TableColumn
             if (pos < m_data.size())
             {
                 m_data.insert(m_data.begin()+pos, elem, INVALID_VALUE);
-
-                if (pos < m_numElements)
-                    m_numElements += elem;
+                m_valid.insert(pos, elem);
             }
         }
 
@@ -301,6 +436,7 @@ class GenericValueColumn : public TableColumn
         virtual void appendElements(size_t elem) override
         {
             m_data.insert(m_data.end(), elem, INVALID_VALUE);
+            m_valid.resize(m_data.size());
         }
 
         /////////////////////////////////////////////////
@@ -318,9 +454,7 @@ class GenericValueColumn : public TableColumn
             if (pos < m_data.size())
             {
                 m_data.erase(m_data.begin()+pos, m_data.begin()+pos+elem);
-
-                if (pos < m_numElements)
-                    m_numElements -= std::min(m_numElements - pos, elem);
+                m_valid.erase(pos, elem);
             }
         }
 
@@ -334,11 +468,40 @@ class GenericValueColumn : public TableColumn
         virtual void resize(size_t elem) override
         {
             if (!elem)
+            {
                 m_data.clear();
+                m_valid.clear();
+            }
             else
+            {
                 m_data.resize(elem, INVALID_VALUE);
+                m_valid.resize(elem);
+            }
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Sets a value in its native type
+        /// without converting it through a complex
+        /// value first. Used by the file readers.
+        ///
+        /// \param elem size_t
+        /// \param val const T&
+        /// \param isValid bool
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void setNative(size_t elem, const T& val, bool isValid)
+        {
+            if (elem >= m_data.size())
+            {
+                if (!isValid)
+                    return;
+
+                resize(elem+1);
+            }
 
-            m_numElements = std::min(m_numElements, elem);
+            m_data[elem] = isValid ? val : INVALID_VALUE;
+            m_valid.set(elem, isValid);
         }
 
         /////////////////////////////////////////////////
@@ -351,10 +514,35 @@ class GenericValueColumn : public TableColumn
         /////////////////////////////////////////////////
         virtual bool isValid(int elem) const override
         {
-            if ((size_t)elem >= std::min(m_numElements, m_data.size()) || elem < 0 || mu::isnan(m_data[elem]))
-                return false;
+            return elem >= 0 && m_valid.test(elem);
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Return the number of filled elements
+        /// by searching the last bit in the validity
+        /// bitmap.
+        ///
+        /// \return size_t
+        ///
+        /////////////////////////////////////////////////
+        virtual size_t getNumFilledElements() const override
+        {
+            return m_valid.findLast();
+        }
 
-            return true;
+        /////////////////////////////////////////////////
+        /// \brief Return the number of valid elements
+        /// in the range [first, last) from the validity
+        /// bitmap.
+        ///
+        /// \param first size_t
+        /// \param last size_t
+        /// \return size_t
+        ///
+        /////////////////////////////////////////////////
+        virtual size_t getNumValidElements(size_t first, size_t last) const override
+        {
+            return m_valid.count(first, last);
         }
 
         /////////////////////////////////////////////////
@@ -366,7 +554,7 @@ class GenericValueColumn : public TableColumn
         /////////////////////////////////////////////////
         virtual bool asBool(int elem) const override
         {
-            if (elem < 0 || (size_t)elem >= std::min(m_numElements, m_data.size()))
+            if (elem < 0 || !m_valid.test(elem))
                 return false;
 
             return m_data[elem] != T(0.0);
@@ -394,7 +582,7 @@ class GenericValueColumn : public TableColumn
 
                     for (size_t i = 0; i < m_data.size(); i++)
                     {
-                        if (!mu::isnan(m_data[i]))
+                        if (m_valid.test(i))
                             col->setValue(i, toString(getValue(i), NumeReKernel::getInstance()->getSettings().getPrecision()));
                     }
 
@@ -406,7 +594,7 @@ class GenericValueColumn : public TableColumn
 
                     for (size_t i = 0; i < m_data.size(); i++)
                     {
-                        if (!mu::isnan(m_data[i]))
+                        if (m_valid.test(i))
                             col->setValue(i, toString(getValue(i), NumeReKernel::getInstance()->getSettings().getPrecision()));
                     }
 
@@ -418,7 +606,7 @@ class GenericValueColumn : public TableColumn
 
                     for (size_t i = 0; i < m_data.size(); i++)
                     {
-                        if (!mu::isnan(m_data[i]))
+                        if (m_valid.test(i))
                             col->setValue(i, getValue(i));
                     }
 
@@ -430,7 +618,7 @@ class GenericValueColumn : public TableColumn
 
                     for (size_t i = 0; i < m_data.size(); i++)
                     {
-                        if (!mu::isnan(m_data[i]))
+                        if (m_valid.test(i))
                             col->setValue(i, getValue(i));
                     }
 
@@ -460,7 +648,7 @@ class GenericValueColumn : public TableColumn
         /////////////////////////////////////////////////
         virtual size_t getBytes() const override
         {
-            return size() * sizeof(T) + m_sHeadLine.capacity() * sizeof(char);
+            return size() * sizeof(T) + m_valid.getBytes() + m_sHeadLine.capacity() * sizeof(char);
         }
 
         /////////////////////////////////////////////////
@@ -516,10 +704,10 @@ class BaseFloatColumn : public GenericValueColumn<T, COLTYPE>
                 return;
 
             if (elem >= this->m_data.size())
-                this->m_data.resize(elem+1, this->INVALID_VALUE);
+                this->resize(elem+1);
 
             this->m_data[elem] = vValue.real();
-            this->m_numElements = std::max(elem+1, this->m_numElements);
+            this->m_valid.set(elem, !mu::isnan(this->m_data[elem]));
         }
 
         /////////////////////////////////////////////////
@@ -535,6 +723,15 @@ class BaseFloatColumn : public GenericValueColumn<T, COLTYPE>
         {
             idx.setOpenEndIndex(this->getNumFilledElements()-1);
 
+            // Contiguous ranges share the buffers
+            if (this->isContiguousRange(idx, this->size()))
+            {
+                BaseFloatColumn* col = new BaseFloatColumn();
+                col->assignMetaData(this);
+                col->shareRange(this, idx.front(), idx.last()+1);
+                return col;
+            }
+
             BaseFloatColumn* col = new BaseFloatColumn(idx.size());
             col->assignMetaData(this);
 
@@ -611,10 +808,10 @@ class BaseComplexColumn : public GenericValueColumn<T, COLTYPE>
                 return;
 
             if (elem >= this->m_data.size())
-                this->m_data.resize(elem+1, this->INVALID_VALUE);
+                this->resize(elem+1);
 
             this->m_data[elem] = vValue;
-            this->m_numElements = std::max(elem+1, this->m_numElements);
+            this->m_valid.set(elem, !mu::isnan(this->m_data[elem]));
         }
 
         /////////////////////////////////////////////////
@@ -630,6 +827,15 @@ class BaseComplexColumn : public GenericValueColumn<T, COLTYPE>
         {
             idx.setOpenEndIndex(this->getNumFilledElements()-1);
 
+            // Contiguous ranges share the buffers
+            if (this->isContiguousRange(idx, this->size()))
+            {
+                BaseComplexColumn* col = new BaseComplexColumn();
+                col->assignMetaData(this);
+                col->shareRange(this, idx.front(), idx.last()+1);
+                return col;
+            }
+
             BaseComplexColumn* col = new BaseComplexColumn(idx.size());
             col->assignMetaData(this);
 
@@ -707,14 +913,46 @@ class BaseIntColumn : public GenericValueColumn<T, COLTYPE>
                 return;
 
             if (elem >= this->m_data.size())
-                this->m_data.resize(elem+1, this->INVALID_VALUE);
+                this->resize(elem+1);
 
             this->m_data[elem] = mu::isnan(vValue) ? this->INVALID_VALUE : genericIntCast<T>(vValue);
+            this->m_valid.set(elem, !mu::isnan(vValue));
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Set a single mu::Value. Integers,
+        /// which fit into a 64 bit column, are stored
+        /// natively, because the conversion into a
+        /// complex value would lose their precision
+        /// above 2^53.
+        ///
+        /// \param elem size_t
+        /// \param val const mu::Value&
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        virtual void set(size_t elem, const mu::Value& val) override
+        {
+            if (sizeof(T) == 8 && val.isNumerical())
+            {
+                const mu::Numerical& num = val.getNum();
+
+                if (num.getType() >= mu::UI8 && num.getType() <= mu::UI64
+                    && (std::is_unsigned<T>::value || num.asUI64() <= (uint64_t)INT64_MAX))
+                {
+                    this->setNative(elem, (T)num.asUI64(), true);
+                    return;
+                }
+
+                if (num.getType() >= mu::I8 && num.getType() <= mu::I64
+                    && (std::is_signed<T>::value || num.asI64() >= 0))
+                {
+                    this->setNative(elem, (T)num.asI64(), true);
+                    return;
+                }
+            }
 
-            if (mu::isnan(vValue) && this->m_numElements == elem+1)
-                this->m_numElements--;
-            else if (!mu::isnan(vValue))
-                this->m_numElements = std::max(this->m_numElements, elem+1);
+            GenericValueColumn<T, COLTYPE>::set(elem, val);
         }
 
         /////////////////////////////////////////////////
@@ -731,6 +969,15 @@ class BaseIntColumn : public GenericValueColumn<T, COLTYPE>
             long long int nNumElements = this->getNumFilledElements();
             idx.setOpenEndIndex(nNumElements-1);
 
+            // Contiguous ranges share the buffers
+            if (this->isContiguousRange(idx, nNumElements))
+            {
+                BaseIntColumn* col = new BaseIntColumn();
+                col->assignMetaData(this);
+                col->shareRange(this, idx.front(), idx.last()+1);
+                return col;
+            }
+
             BaseIntColumn* col = new BaseIntColumn(idx.size());
             col->assignMetaData(this);
 
@@ -793,7 +1040,7 @@ using ValueColumn = BaseComplexColumn<std::complex<double>, TableColumn::TYPE_VA
 class DateTimeColumn : public TableColumn
 {
     private:
-        std::vector<double> m_data;
+        ColumnBuffer<double> m_data;
 
     public:
         /////////////////////////////////////////////////
@@ -826,6 +1073,9 @@ class DateTimeColumn : public TableColumn
         virtual std::complex<double> getValue(size_t elem) const override;
         virtual mu::Value get(size_t elem) const override;
 
+        using TableColumn::getSpan;
+        virtual void getSpan(size_t first, size_t last, ColumnSpan<double>& span) const override;
+
         virtual void set(size_t elem, const mu::Value& val) override;
         virtual void setValue(size_t elem, const std::string& sValue) override;
         virtual void setValue(size_t elem, const std::complex<double>& vValue) override;
@@ -874,19 +1124,14 @@ class DateTimeColumn : public TableColumn
 
 /////////////////////////////////////////////////
 /// \brief A table column containing logical
-/// values.
+/// values. The values and their validity are
+/// packed into two bitmaps.
 /////////////////////////////////////////////////
 class LogicalColumn : public TableColumn
 {
     private:
-        enum LogicalValue
-        {
-            LOGICAL_NAN = -1,
-            LOGICAL_FALSE = 0,
-            LOGICAL_TRUE = 1
-        };
-
-        std::vector<LogicalValue> m_data;
+        Bitmap m_valid;
+        Bitmap m_values;
 
     public:
         /////////////////////////////////////////////////
@@ -937,6 +1182,34 @@ class LogicalColumn : public TableColumn
         virtual bool isValid(int elem) const override;
         virtual bool asBool(int elem) const override;
 
+        /////////////////////////////////////////////////
+        /// \brief Return the number of filled elements
+        /// by searching the last bit in the validity
+        /// bitmap.
+        ///
+        /// \return size_t
+        ///
+        /////////////////////////////////////////////////
+        virtual size_t getNumFilledElements() const override
+        {
+            return m_valid.findLast();
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Return the number of valid elements
+        /// in the range [first, last) from the validity
+        /// bitmap.
+        ///
+        /// \param first size_t
+        /// \param last size_t
+        /// \return size_t
+        ///
+        /////////////////////////////////////////////////
+        virtual size_t getNumValidElements(size_t first, size_t last) const override
+        {
+            return m_valid.count(first, last);
+        }
+
         /////////////////////////////////////////////////
         /// \brief Return the number of bytes occupied by
         /// this column.
@@ -946,7 +1219,7 @@ class LogicalColumn : public TableColumn
         /////////////////////////////////////////////////
         virtual size_t getBytes() const override
         {
-            return size() * sizeof(LogicalValue) + m_sHeadLine.capacity() * sizeof(char);
+            return m_valid.getBytes() + m_values.getBytes() + m_sHeadLine.capacity() * sizeof(char);
         }
 
         /////////////////////////////////////////////////
@@ -958,7 +1231,7 @@ class LogicalColumn : public TableColumn
         /////////////////////////////////////////////////
         virtual size_t size() const override
         {
-            return m_data.size();
+            return m_valid.size();
         }
 
         virtual TableColumn* convert(ColumnType type = TableColumn::TYPE_NONE) override;
@@ -972,7 +1245,7 @@ class LogicalColumn : public TableColumn
 class StringColumn : public TableColumn
 {
     private:
-        std::vector<std::string> m_data;
+        ColumnBuffer<std::string> m_data;
 
     public:
         /////////////////////////////////////////////////
@@ -1041,6 +1314,113 @@ class StringColumn : public TableColumn
 };
 
 
+/////////////////////////////////////////////////
+/// \brief Compact storage for category ids. The
+/// width of a single id (one, two or four bytes)
+/// follows the number of categories and is
+/// widened on demand. The id 0 marks a missing
+/// value, all other ids are the one-based
+/// category numbers.
+/////////////////////////////////////////////////
+class CategoryIdArray
+{
+    private:
+        ColumnBuffer<uint8_t> m_ids8;
+        ColumnBuffer<uint16_t> m_ids16;
+        ColumnBuffer<uint32_t> m_ids32;
+        size_t m_width;
+
+    public:
+        CategoryIdArray() : m_width(sizeof(uint8_t)) {}
+
+        /////////////////////////////////////////////////
+        /// \brief Returns the number of stored ids.
+        ///
+        /// \return size_t
+        ///
+        /////////////////////////////////////////////////
+        size_t size() const
+        {
+            switch (m_width)
+            {
+                case sizeof(uint8_t):
+                    return m_ids8.size();
+                case sizeof(uint16_t):
+                    return m_ids16.size();
+            }
+
+            return m_ids32.size();
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Returns the number of bytes used per
+        /// id.
+        ///
+        /// \return size_t
+        ///
+        /////////////////////////////////////////////////
+        size_t width() const
+        {
+            return m_width;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Returns the id at the selected
+        /// position.
+        ///
+        /// \param i size_t
+        /// \return uint32_t
+        ///
+        /////////////////////////////////////////////////
+        uint32_t get(size_t i) const
+        {
+            switch (m_width)
+            {
+                case sizeof(uint8_t):
+                    return m_ids8[i];
+                case sizeof(uint16_t):
+                    return m_ids16[i];
+            }
+
+            return m_ids32[i];
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Sets the id at the selected position.
+        /// Widens the storage, if the id does not fit.
+        ///
+        /// \param i size_t
+        /// \param id uint32_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void set(size_t i, uint32_t id)
+        {
+            widen(id);
+
+            switch (m_width)
+            {
+                case sizeof(uint8_t):
+                    m_ids8[i] = id;
+                    return;
+                case sizeof(uint16_t):
+                    m_ids16[i] = id;
+                    return;
+            }
+
+            m_ids32[i] = id;
+        }
+
+        CategoryIdArray slice(size_t first, size_t last) const;
+        size_t count(uint32_t id) const;
+        void widen(uint32_t maxId);
+        void resize(size_t nSize);
+        void insert(size_t pos, size_t nElems);
+        void erase(size_t pos, size_t nElems);
+        void clear();
+};
+
+
 /////////////////////////////////////////////////
 /// \brief A table column containing categorical
 /// values.
@@ -1050,8 +1430,40 @@ class CategoricalColumn : public TableColumn
     private:
         enum {CATEGORICAL_NAN = -1};
 
-        std::vector<int> m_data;
+        CategoryIdArray m_data;
         std::vector<std::string> m_categories;
+        std::unordered_map<std::string, int> m_categoryIndex;
+
+        /////////////////////////////////////////////////
+        /// \brief Returns the zero-based category of
+        /// the selected element or CATEGORICAL_NAN.
+        ///
+        /// \param elem size_t
+        /// \return int
+        ///
+        /////////////////////////////////////////////////
+        int getId(size_t elem) const
+        {
+            return (int)m_data.get(elem) - 1;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Sets the zero-based category of the
+        /// selected element. CATEGORICAL_NAN marks it
+        /// as missing.
+        ///
+        /// \param elem size_t
+        /// \param id int
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void setId(size_t elem, int id)
+        {
+            m_data.set(elem, id+1);
+        }
+
+        int addCategory(const std::string& sCategory);
+        void rebuildIndex();
 
     public:
         /////////////////////////////////////////////////
@@ -1087,6 +1499,8 @@ class CategoricalColumn : public TableColumn
         virtual void set(size_t elem, const mu::Value& val) override;
         virtual void setValue(size_t elem, const std::string& sValue) override;
         virtual void setValue(size_t elem, const std::complex<double>& vValue) override;
+        virtual void setValue(const VectorIndex& idx, const std::vector<std::string>& vValue) override;
+        void appendValues(const std::vector<std::string>& vValues);
 
         virtual CategoricalColumn* copy(const VectorIndex& idx) const override;
         virtual void assign(const TableColumn* column) override;
@@ -1134,6 +1548,8 @@ class CategoricalColumn : public TableColumn
         void setCategories(const std::vector<std::string>& vCategories);
         void mergeCategories(const std::vector<std::string>& vCategories);
         bool isCategory(const std::string& candidate) const;
+        int findCategory(const std::string& candidate) const;
+        size_t countCategory(int id) const;
 };
 
 void promote_if_needed(TblColPtr& col, size_t colNo, TableColumn::ColumnType other);
@@ -0,0 +1,501 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "blockcodec.hpp"
+#include <cstring>
+#include <vector>
+
+namespace NumeRe
+{
+    static const uint64_t PRIME64_1 = 11400714785074694791ULL;
+    static const uint64_t PRIME64_2 = 14029467366897019727ULL;
+    static const uint64_t PRIME64_3 = 1609587929392839161ULL;
+    static const uint64_t PRIME64_4 = 9650029242287828579ULL;
+    static const uint64_t PRIME64_5 = 2870177450012600261ULL;
+
+
+    static inline uint64_t rotl64(uint64_t x, int r)
+    {
+        return (x << r) | (x >> (64 - r));
+    }
+
+
+    static inline uint64_t read64(const unsigned char* p)
+    {
+        uint64_t val;
+        memcpy(&val, p, sizeof(val));
+        return val;
+    }
+
+
+    static inline uint32_t read32(const unsigned char* p)
+    {
+        uint32_t val;
+        memcpy(&val, p, sizeof(val));
+        return val;
+    }
+
+
+    static inline uint64_t xxhRound(uint64_t acc, uint64_t input)
+    {
+        acc += input * PRIME64_2;
+        acc = rotl64(acc, 31);
+        return acc * PRIME64_1;
+    }
+
+
+    static inline uint64_t xxhMergeRound(uint64_t acc, uint64_t val)
+    {
+        acc ^= xxhRound(0, val);
+        return acc * PRIME64_1 + PRIME64_4;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Creates a new hash state using the
+    /// passed seed.
+    ///
+    /// \param seed uint64_t
+    ///
+    /////////////////////////////////////////////////
+    Xxh64::Xxh64(uint64_t seed)
+    {
+        reset(seed);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Resets the hash state.
+    ///
+    /// \param seed uint64_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void Xxh64::reset(uint64_t seed)
+    {
+        m_seed = seed;
+        m_acc[0] = seed + PRIME64_1 + PRIME64_2;
+        m_acc[1] = seed + PRIME64_2;
+        m_acc[2] = seed;
+        m_acc[3] = seed - PRIME64_1;
+        m_totalLength = 0;
+        m_bufferSize = 0;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Adds the passed bytes to the hash.
+    ///
+    /// \param data const void*
+    /// \param nBytes size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void Xxh64::update(const void* data, size_t nBytes)
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        const unsigned char* pEnd = p + nBytes;
+        m_totalLength += nBytes;
+
+        // Fill the buffer first
+        if (m_bufferSize)
+        {
+            size_t nFill = std::min(nBytes, sizeof(m_buffer) - m_bufferSize);
+            memcpy(m_buffer + m_bufferSize, p, nFill);
+            m_bufferSize += nFill;
+            p += nFill;
+
+            if (m_bufferSize < sizeof(m_buffer))
+                return;
+
+            for (size_t i = 0; i < 4; i++)
+                m_acc[i] = xxhRound(m_acc[i], read64(m_buffer + 8*i));
+
+            m_bufferSize = 0;
+        }
+
+        // Process all complete stripes directly
+        while (pEnd - p >= 32)
+        {
+            for (size_t i = 0; i < 4; i++)
+                m_acc[i] = xxhRound(m_acc[i], read64(p + 8*i));
+
+            p += 32;
+        }
+
+        // Keep the remainder
+        memcpy(m_buffer, p, pEnd - p);
+        m_bufferSize = pEnd - p;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the hash of all bytes added so
+    /// far. The state is not modified.
+    ///
+    /// \return uint64_t
+    ///
+    /////////////////////////////////////////////////
+    uint64_t Xxh64::digest() const
+    {
+        uint64_t h;
+
+        if (m_totalLength >= 32)
+        {
+            h = rotl64(m_acc[0], 1) + rotl64(m_acc[1], 7) + rotl64(m_acc[2], 12) + rotl64(m_acc[3], 18);
+
+            for (size_t i = 0; i < 4; i++)
+                h = xxhMergeRound(h, m_acc[i]);
+        }
+        else
+            h = m_seed + PRIME64_5;
+
+        h += m_totalLength;
+
+        const unsigned char* p = m_buffer;
+        const unsigned char* pEnd = m_buffer + m_bufferSize;
+
+        while (pEnd - p >= 8)
+        {
+            h ^= xxhRound(0, read64(p));
+            h = rotl64(h, 27) * PRIME64_1 + PRIME64_4;
+            p += 8;
+        }
+
+        if (pEnd - p >= 4)
+        {
+            h ^= (uint64_t)read32(p) * PRIME64_1;
+            h = rotl64(h, 23) * PRIME64_2 + PRIME64_3;
+            p += 4;
+        }
+
+        while (p < pEnd)
+        {
+            h ^= (*p) * PRIME64_5;
+            h = rotl64(h, 11) * PRIME64_1;
+            p++;
+        }
+
+        h ^= h >> 33;
+        h *= PRIME64_2;
+        h ^= h >> 29;
+        h *= PRIME64_3;
+        h ^= h >> 32;
+
+        return h;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the hash of the passed block.
+    ///
+    /// \param data const void*
+    /// \param nBytes size_t
+    /// \param seed uint64_t
+    /// \return uint64_t
+    ///
+    /////////////////////////////////////////////////
+    uint64_t Xxh64::hash(const void* data, size_t nBytes, uint64_t seed)
+    {
+        Xxh64 hasher(seed);
+        hasher.update(data, nBytes);
+        return hasher.digest();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Formats the hash as hexadecimal
+    /// string with a fixed length of 16 characters.
+    ///
+    /// \param hash uint64_t
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+    std::string Xxh64::toHex(uint64_t hash)
+    {
+        const char* DIGITS = "0123456789abcdef";
+        std::string sHex(16, '0');
+
+        for (int i = 15; i >= 0; i--)
+        {
+            sHex[i] = DIGITS[hash & 0xF];
+            hash >>= 4;
+        }
+
+        return sHex;
+    }
+
+
+    // Constants of the LZ block format. The last
+    // bytes of a block are always stored as
+    // literals
+    static const size_t LZ_MINMATCH = 4;
+    static const size_t LZ_LASTLITERALS = 5;
+    static const size_t LZ_MFLIMIT = 12;
+    static const size_t LZ_MAXOFFSET = 65535;
+    static const size_t LZ_HASHBITS = 16;
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to append a length,
+    /// which does not fit into the token, as a
+    /// sequence of bytes.
+    ///
+    /// \param sDst std::string&
+    /// \param nLength size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void appendLength(std::string& sDst, size_t nLength)
+    {
+        while (nLength >= 255)
+        {
+            sDst += (char)255;
+            nLength -= 255;
+        }
+
+        sDst += (char)nLength;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to append a sequence of
+    /// literals followed by a match. A match length
+    /// of zero marks the last sequence.
+    ///
+    /// \param sDst std::string&
+    /// \param pLiterals const char*
+    /// \param nLiterals size_t
+    /// \param nOffset size_t
+    /// \param nMatchLength size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void appendSequence(std::string& sDst, const char* pLiterals, size_t nLiterals, size_t nOffset, size_t nMatchLength)
+    {
+        size_t nMatchToken = nMatchLength ? nMatchLength - LZ_MINMATCH : 0;
+        sDst += (char)((std::min(nLiterals, (size_t)15) << 4) | std::min(nMatchToken, (size_t)15));
+
+        if (nLiterals >= 15)
+            appendLength(sDst, nLiterals - 15);
+
+        sDst.append(pLiterals, nLiterals);
+
+        if (!nMatchLength)
+            return;
+
+        sDst += (char)(nOffset & 0xFF);
+        sDst += (char)(nOffset >> 8);
+
+        if (nMatchToken >= 15)
+            appendLength(sDst, nMatchToken - 15);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Compresses the passed block using a
+    /// greedy LZ77 compressor, which writes the LZ4
+    /// block format.
+    ///
+    /// \param src const char*
+    /// \param nBytes size_t
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+    std::string lzCompress(const char* src, size_t nBytes)
+    {
+        std::string sDst;
+        sDst.reserve(nBytes / 2 + 16);
+
+        std::vector<size_t> vHashTable(1 << LZ_HASHBITS, 0);
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(src);
+        size_t nAnchor = 0;
+        size_t i = 0;
+
+        while (nBytes > LZ_MFLIMIT && i + LZ_MFLIMIT < nBytes)
+        {
+            uint32_t seq = read32(p + i);
+            uint32_t h = (seq * 2654435761U) >> (32 - LZ_HASHBITS);
+            size_t nCandidate = vHashTable[h];
+            vHashTable[h] = i+1;
+
+            // The table stores positions + 1 to mark
+            // empty slots with zero
+            if (!nCandidate
+                || i - (nCandidate-1) > LZ_MAXOFFSET
+                || read32(p + nCandidate-1) != seq)
+            {
+                i++;
+                continue;
+            }
+
+            size_t nRef = nCandidate-1;
+            size_t nLength = LZ_MINMATCH;
+
+            while (i + nLength < nBytes - LZ_LASTLITERALS && p[nRef + nLength] == p[i + nLength])
+                nLength++;
+
+            appendSequence(sDst, src + nAnchor, i - nAnchor, i - nRef, nLength);
+            i += nLength;
+            nAnchor = i;
+        }
+
+        appendSequence(sDst, src + nAnchor, nBytes - nAnchor, 0, 0);
+        return sDst;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Decompresses a block created by
+    /// lzCompress() into the passed buffer, which
+    /// has to have exactly the decompressed size.
+    /// Returns false, if the block is corrupted.
+    ///
+    /// \param src const char*
+    /// \param nBytes size_t
+    /// \param dst char*
+    /// \param nDstBytes size_t
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    bool lzDecompress(const char* src, size_t nBytes, char* dst, size_t nDstBytes)
+    {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(src);
+        size_t ip = 0;
+        size_t op = 0;
+
+        while (ip < nBytes)
+        {
+            unsigned char token = p[ip++];
+            size_t nLiterals = token >> 4;
+
+            if (nLiterals == 15)
+            {
+                unsigned char b;
+
+                do
+                {
+                    if (ip >= nBytes)
+                        return false;
+
+                    b = p[ip++];
+                    nLiterals += b;
+                } while (b == 255);
+            }
+
+            if (ip + nLiterals > nBytes || op + nLiterals > nDstBytes)
+                return false;
+
+            memcpy(dst + op, src + ip, nLiterals);
+            ip += nLiterals;
+            op += nLiterals;
+
+            // The last sequence contains only literals
+            if (ip == nBytes)
+                break;
+
+            if (ip + 2 > nBytes)
+                return false;
+
+            size_t nOffset = p[ip] | (p[ip+1] << 8);
+            ip += 2;
+
+            if (!nOffset || nOffset > op)
+                return false;
+
+            size_t nLength = token & 0xF;
+
+            if (nLength == 15)
+            {
+                unsigned char b;
+
+                do
+                {
+                    if (ip >= nBytes)
+                        return false;
+
+                    b = p[ip++];
+                    nLength += b;
+                } while (b == 255);
+            }
+
+            nLength += LZ_MINMATCH;
+
+            if (op + nLength > nDstBytes)
+                return false;
+
+            // Matches may overlap with the output
+            for (size_t k = 0; k < nLength; k++, op++)
+                dst[op] = dst[op - nOffset];
+        }
+
+        return op == nDstBytes;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Groups the bytes of all elements of
+    /// the passed width by their significance. This
+    /// makes numerical data compressible. Remaining
+    /// bytes are copied.
+    ///
+    /// \param src const char*
+    /// \param dst char*
+    /// \param nBytes size_t
+    /// \param nWidth size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void shuffleBytes(const char* src, char* dst, size_t nBytes, size_t nWidth)
+    {
+        size_t nElems = nWidth ? nBytes / nWidth : 0;
+
+        for (size_t b = 0; b < nWidth; b++)
+        {
+            for (size_t i = 0; i < nElems; i++)
+                dst[b*nElems + i] = src[i*nWidth + b];
+        }
+
+        memcpy(dst + nElems*nWidth, src + nElems*nWidth, nBytes - nElems*nWidth);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Reverts shuffleBytes().
+    ///
+    /// \param src const char*
+    /// \param dst char*
+    /// \param nBytes size_t
+    /// \param nWidth size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void unshuffleBytes(const char* src, char* dst, size_t nBytes, size_t nWidth)
+    {
+        size_t nElems = nWidth ? nBytes / nWidth : 0;
+
+        for (size_t b = 0; b < nWidth; b++)
+        {
+            for (size_t i = 0; i < nElems; i++)
+                dst[i*nWidth + b] = src[b*nElems + i];
+        }
+
+        memcpy(dst + nElems*nWidth, src + nElems*nWidth, nBytes - nElems*nWidth);
+    }
+}
+
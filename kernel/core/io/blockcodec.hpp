@@ -0,0 +1,59 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef BLOCKCODEC_HPP
+#define BLOCKCODEC_HPP
+
+#include <string>
+#include <cstdint>
+
+namespace NumeRe
+{
+    /////////////////////////////////////////////////
+    /// \brief Incremental implementation of the
+    /// XXH64 hash function. Data may be passed in
+    /// arbitrary pieces, the digest is identical to
+    /// hashing all data at once.
+    /////////////////////////////////////////////////
+    class Xxh64
+    {
+        private:
+            uint64_t m_acc[4];
+            uint64_t m_seed;
+            uint64_t m_totalLength;
+            unsigned char m_buffer[32];
+            size_t m_bufferSize;
+
+        public:
+            Xxh64(uint64_t seed = 0);
+            void reset(uint64_t seed = 0);
+            void update(const void* data, size_t nBytes);
+            uint64_t digest() const;
+
+            static uint64_t hash(const void* data, size_t nBytes, uint64_t seed = 0);
+            static std::string toHex(uint64_t hash);
+    };
+
+    std::string lzCompress(const char* src, size_t nBytes);
+    bool lzDecompress(const char* src, size_t nBytes, char* dst, size_t nDstBytes);
+
+    void shuffleBytes(const char* src, char* dst, size_t nBytes, size_t nWidth);
+    void unshuffleBytes(const char* src, char* dst, size_t nBytes, size_t nWidth);
+}
+
+#endif // BLOCKCODEC_HPP
@@ -20,14 +20,16 @@
 #include <libzygo.hpp>
 
 #include <set>
+#include <omp.h>
+#include <fast_float/fast_float.h>
 #include <algorithm> // contains std::find_if for datetime detection
 
 #include "file.hpp"
+#include "xmlpullparser.hpp"
 #include "../datamanagement/tablecolumnimpl.hpp"
 #include "IgorLib/ReadWave.h"
 #include "BasicExcel.hpp"
 #include "../utils/tools.hpp"
-#include "../../../externals/tinyxml2/tinyxml2.h"
 #include "../ui/language.hpp"
 #include "../version.h"
 #include "../../kernel.hpp"
@@ -1139,6 +1141,357 @@ namespace NumeRe
     }
 
 
+    // Number of rows per chunk in NDAT v5 files
+    static const uint32_t NDAT_CHUNKROWS = 65536;
+
+    // The codecs of the chunks in NDAT v5 files
+    enum NdatChunkCodec
+    {
+        NDAT_RAW,
+        NDAT_LZ,
+        NDAT_SHUFFLED_LZ
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to append a numerical
+    /// field to a block, which is written later.
+    ///
+    /// \param sBlock std::string&
+    /// \param num T
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    template <typename T>
+    static void appendNumField(std::string& sBlock, T num)
+    {
+        sBlock.append((const char*)&num, sizeof(T));
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to append a string field
+    /// to a block, which is written later. Uses the
+    /// same layout as writeStringField().
+    ///
+    /// \param sBlock std::string&
+    /// \param sString const std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void appendStringField(std::string& sBlock, const std::string& sString)
+    {
+        appendNumField<uint32_t>(sBlock, sString.length());
+        sBlock += sString;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper returning the width of
+    /// the scalar components of the native layout
+    /// of the passed column type. This width is used
+    /// to shuffle the bytes before compressing. Non-
+    /// native types return zero.
+    ///
+    /// \param type TableColumn::ColumnType
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+    static size_t getNativeWidth(TableColumn::ColumnType type)
+    {
+        switch (type)
+        {
+            case TableColumn::TYPE_VALUE_I8:
+            case TableColumn::TYPE_VALUE_UI8:
+            case TableColumn::TYPE_LOGICAL:
+                return 1;
+            case TableColumn::TYPE_VALUE_I16:
+            case TableColumn::TYPE_VALUE_UI16:
+                return 2;
+            case TableColumn::TYPE_VALUE_I32:
+            case TableColumn::TYPE_VALUE_UI32:
+            case TableColumn::TYPE_VALUE_F32:
+            case TableColumn::TYPE_VALUE_CF32:
+                return 4;
+            case TableColumn::TYPE_VALUE_I64:
+            case TableColumn::TYPE_VALUE_UI64:
+            case TableColumn::TYPE_VALUE_F64:
+            case TableColumn::TYPE_VALUE:
+            case TableColumn::TYPE_DATETIME:
+                return 8;
+            default:
+                return 0;
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to encode the rows
+    /// [first, last) of a column in the native type
+    /// T. Integral types append a validity bitmap,
+    /// all other types mark invalid values as NaN.
+    ///
+    /// \param col const TableColumn*
+    /// \param first size_t
+    /// \param last size_t
+    /// \param sRaw std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    template <class T, class S>
+    static void encodeNative(const TableColumn* col, size_t first, size_t last, std::string& sRaw)
+    {
+        ColumnSpan<S> span;
+        col->getSpan(first, last, span);
+
+        size_t nElems = last - first;
+        sRaw.assign(nElems*sizeof(T) + (std::is_integral<T>::value ? (nElems+7) / 8 : 0), '\0');
+        char* pValid = &sRaw[0] + nElems*sizeof(T);
+
+        for (size_t i = 0; i < nElems; i++)
+        {
+            bool isValid = i < span.size() && span.isValid(i);
+            T val;
+
+            if constexpr (std::is_integral<T>::value)
+            {
+                val = isValid ? T(span[i]) : T(0);
+
+                if (isValid)
+                    pValid[i / 8] |= 1 << (i % 8);
+            }
+            else
+                val = isValid ? T(span[i]) : T(NAN);
+
+            memcpy(&sRaw[i*sizeof(T)], &val, sizeof(T));
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to encode the rows
+    /// [first, last) of a numerical, date-time or
+    /// logical column in its native layout.
+    ///
+    /// \param col const TableColumn*
+    /// \param first size_t
+    /// \param last size_t
+    /// \param sRaw std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void encodeNativeChunk(const TableColumn* col, size_t first, size_t last, std::string& sRaw)
+    {
+        switch (col->m_type)
+        {
+            case TableColumn::TYPE_VALUE_I8:
+                return encodeNative<int8_t, int64_t>(col, first, last, sRaw);
+            case TableColumn::TYPE_VALUE_UI8:
+                return encodeNative<uint8_t, int64_t>(col, first, last, sRaw);
+            case TableColumn::TYPE_VALUE_I16:
+                return encodeNative<int16_t, int64_t>(col, first, last, sRaw);
+            case TableColumn::TYPE_VALUE_UI16:
+                return encodeNative<uint16_t, int64_t>(col, first, last, sRaw);
+            case TableColumn::TYPE_VALUE_I32:
+                return encodeNative<int32_t, int64_t>(col, first, last, sRaw);
+            case TableColumn::TYPE_VALUE_UI32:
+                return encodeNative<uint32_t, int64_t>(col, first, last, sRaw);
+            case TableColumn::TYPE_VALUE_I64:
+                return encodeNative<int64_t, int64_t>(col, first, last, sRaw);
+            case TableColumn::TYPE_VALUE_UI64:
+                return encodeNative<uint64_t, int64_t>(col, first, last, sRaw);
+            case TableColumn::TYPE_VALUE_F32:
+                return encodeNative<float, double>(col, first, last, sRaw);
+            case TableColumn::TYPE_VALUE_F64:
+            case TableColumn::TYPE_DATETIME:
+                return encodeNative<double, double>(col, first, last, sRaw);
+            case TableColumn::TYPE_VALUE_CF32:
+                return encodeNative<std::complex<float>, std::complex<double>>(col, first, last, sRaw);
+            case TableColumn::TYPE_VALUE:
+                return encodeNative<std::complex<double>, std::complex<double>>(col, first, last, sRaw);
+            case TableColumn::TYPE_LOGICAL:
+                return encodeNative<uint8_t, double>(col, first, last, sRaw);
+            default:
+                sRaw.clear();
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to encode the rows
+    /// [first, last) of a string or categorical
+    /// column as a sequence of string fields.
+    ///
+    /// \param col const TableColumn*
+    /// \param first size_t
+    /// \param last size_t
+    /// \param sRaw std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void encodeStringChunk(const TableColumn* col, size_t first, size_t last, std::string& sRaw)
+    {
+        sRaw.clear();
+
+        for (size_t i = first; i < last; i++)
+        {
+            appendStringField(sRaw, col->getValueAsInternalString(i));
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to read the native
+    /// values of a chunk. Value columns receive
+    /// their values without any conversion, all
+    /// other columns are set via setValue(). Only
+    /// the elements [nFrom,nTo) of the chunk are
+    /// written to the column starting at first.
+    /// Returns false, if the chunk is too short.
+    ///
+    /// \param col TableColumn*
+    /// \param first size_t
+    /// \param sRaw const std::string&
+    /// \param nElems size_t
+    /// \param nFrom size_t
+    /// \param nTo size_t
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    template <class T, TableColumn::ColumnType COLTYPE>
+    static bool decodeNative(TableColumn* col, size_t first, const std::string& sRaw, size_t nElems, size_t nFrom, size_t nTo)
+    {
+        if (sRaw.length() < nElems*sizeof(T) + (std::is_integral<T>::value ? (nElems+7) / 8 : 0))
+            return false;
+
+        const unsigned char* pValid = reinterpret_cast<const unsigned char*>(sRaw.data()) + nElems*sizeof(T);
+        GenericValueColumn<T, COLTYPE>* valCol = nullptr;
+
+        if constexpr (COLTYPE != TableColumn::TYPE_NONE)
+            valCol = static_cast<GenericValueColumn<T, COLTYPE>*>(col);
+
+        for (size_t i = nFrom; i < nTo; i++)
+        {
+            T val;
+            memcpy(&val, sRaw.data() + i*sizeof(T), sizeof(T));
+            bool isValid;
+
+            if constexpr (std::is_integral<T>::value)
+                isValid = (pValid[i / 8] >> (i % 8)) & 1;
+            else
+                isValid = !mu::isnan(std::complex<double>(val));
+
+            if (!isValid)
+                continue;
+
+            if constexpr (COLTYPE != TableColumn::TYPE_NONE)
+                valCol->setNative(first+i-nFrom, val, true);
+            else
+                col->setValue(first+i-nFrom, std::complex<double>(val));
+        }
+
+        return true;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to read the elements
+    /// [nFrom,nTo) of a chunk, which was encoded by
+    /// encodeNativeChunk(), into the column.
+    ///
+    /// \param col TableColumn*
+    /// \param first size_t
+    /// \param sRaw const std::string&
+    /// \param nElems size_t
+    /// \param nFrom size_t
+    /// \param nTo size_t
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    static bool decodeNativeChunk(TableColumn* col, size_t first, const std::string& sRaw, size_t nElems, size_t nFrom, size_t nTo)
+    {
+        switch (col->m_type)
+        {
+            case TableColumn::TYPE_VALUE_I8:
+                return decodeNative<int8_t, TableColumn::TYPE_VALUE_I8>(col, first, sRaw, nElems, nFrom, nTo);
+            case TableColumn::TYPE_VALUE_UI8:
+                return decodeNative<uint8_t, TableColumn::TYPE_VALUE_UI8>(col, first, sRaw, nElems, nFrom, nTo);
+            case TableColumn::TYPE_VALUE_I16:
+                return decodeNative<int16_t, TableColumn::TYPE_VALUE_I16>(col, first, sRaw, nElems, nFrom, nTo);
+            case TableColumn::TYPE_VALUE_UI16:
+                return decodeNative<uint16_t, TableColumn::TYPE_VALUE_UI16>(col, first, sRaw, nElems, nFrom, nTo);
+            case TableColumn::TYPE_VALUE_I32:
+                return decodeNative<int32_t, TableColumn::TYPE_VALUE_I32>(col, first, sRaw, nElems, nFrom, nTo);
+            case TableColumn::TYPE_VALUE_UI32:
+                return decodeNative<uint32_t, TableColumn::TYPE_VALUE_UI32>(col, first, sRaw, nElems, nFrom, nTo);
+            case TableColumn::TYPE_VALUE_I64:
+                return decodeNative<int64_t, TableColumn::TYPE_VALUE_I64>(col, first, sRaw, nElems, nFrom, nTo);
+            case TableColumn::TYPE_VALUE_UI64:
+                return decodeNative<uint64_t, TableColumn::TYPE_VALUE_UI64>(col, first, sRaw, nElems, nFrom, nTo);
+            case TableColumn::TYPE_VALUE_F32:
+                return decodeNative<float, TableColumn::TYPE_VALUE_F32>(col, first, sRaw, nElems, nFrom, nTo);
+            case TableColumn::TYPE_VALUE_F64:
+                return decodeNative<double, TableColumn::TYPE_VALUE_F64>(col, first, sRaw, nElems, nFrom, nTo);
+            case TableColumn::TYPE_VALUE_CF32:
+                return decodeNative<std::complex<float>, TableColumn::TYPE_VALUE_CF32>(col, first, sRaw, nElems, nFrom, nTo);
+            case TableColumn::TYPE_VALUE:
+                return decodeNative<std::complex<double>, TableColumn::TYPE_VALUE>(col, first, sRaw, nElems, nFrom, nTo);
+            case TableColumn::TYPE_DATETIME:
+                return decodeNative<double, TableColumn::TYPE_NONE>(col, first, sRaw, nElems, nFrom, nTo);
+            case TableColumn::TYPE_LOGICAL:
+                return decodeNative<uint8_t, TableColumn::TYPE_NONE>(col, first, sRaw, nElems, nFrom, nTo);
+            default:
+                return false;
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to read the elements
+    /// [nFrom,nTo) of a chunk, which was encoded by
+    /// encodeStringChunk(), into the column.
+    ///
+    /// \param col TableColumn*
+    /// \param first size_t
+    /// \param sRaw const std::string&
+    /// \param nElems size_t
+    /// \param nFrom size_t
+    /// \param nTo size_t
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    static bool decodeStringChunk(TableColumn* col, size_t first, const std::string& sRaw, size_t nElems, size_t nFrom, size_t nTo)
+    {
+        std::vector<std::string> vStrings;
+        vStrings.reserve(nTo-nFrom);
+        size_t pos = 0;
+
+        for (size_t i = 0; i < nElems; i++)
+        {
+            uint32_t nLength;
+
+            if (pos + sizeof(nLength) > sRaw.length())
+                return false;
+
+            memcpy(&nLength, sRaw.data() + pos, sizeof(nLength));
+            pos += sizeof(nLength);
+
+            if (pos + nLength > sRaw.length())
+                return false;
+
+            if (i >= nFrom && i < nTo)
+                vStrings.push_back(sRaw.substr(pos, nLength));
+
+            pos += nLength;
+        }
+
+        if (vStrings.size())
+            col->setValue(VectorIndex(first, first+vStrings.size()-1), vStrings);
+
+        return true;
+    }
+
+
     //////////////////////////////////////////////
     // class NumeReDataFile
     //////////////////////////////////////////////
@@ -1146,7 +1499,8 @@ namespace NumeRe
     NumeReDataFile::NumeReDataFile(const std::string& filename)
         : GenericFile(filename),
         isLegacy(false), timeStamp(0), versionMajor(0), versionMinor(0),
-        versionBuild(0), fileVersionRead(1.0f)
+        versionBuild(0), fileVersionRead(1.0f), nFileEnd(0), useMapping(false),
+        useCompressedColumns(false), isCorrupted(false), isProjected(false)
     {
         needsConversion = false;
     }
@@ -1168,6 +1522,15 @@ namespace NumeRe
         versionMinor = file.versionMinor;
         versionBuild = file.versionBuild;
         fileVersionRead = file.fileVersionRead;
+        useMapping = file.useMapping;
+        useCompressedColumns = file.useCompressedColumns;
+        isCorrupted = file.isCorrupted;
+        nFileEnd = file.nFileEnd;
+        isProjected = file.isProjected;
+        vProjectedCols = file.vProjectedCols;
+        vProjectedRows = file.vProjectedRows;
+        vColumnInfo = file.vColumnInfo;
+        mappedFile = file.mappedFile;
     }
 
 
@@ -1198,31 +1561,41 @@ namespace NumeRe
 
         writeNumField(fileSpecVersionMajor);
         writeNumField(fileSpecVersionMinor);
+
+        // Placeholders for the checksum and the file
+        // end, which are updated in writeFile()
         checkPos = tellp();
-        writeStringField("SHA-256:" + sha256(""));
-        writeNumField<uint32_t>(10);
+        writeStringField("XXH64:" + Xxh64::toHex(0));
+        writeNumField<uint64_t>(0);
         checkStart = tellp();
-        writeStringField(getTableName());
-        writeStringField(sComment);
+        checksum.reset();
+
+        // The remaining header is composed in memory
+        // to hash it while writing
+        std::string sBlock;
+        appendStringField(sBlock, getTableName());
+        appendStringField(sBlock, sComment);
 
         // The following fields are placeholders
         // for further changes. They may be filled
         // in future versions and will be ignored
         // in older versions of NumeRe
-        writeStringField("FTYPE=LLINT");
-        int64_t t = _time64(0);
-        writeNumBlock<int64_t>(&t, 1);
-        writeStringField("FTYPE=DOUBLE");
-        writeNumBlock<double>(nullptr, 0);
-        writeStringField("FTYPE=DOUBLE");
-        writeNumBlock<double>(nullptr, 0);
-        writeStringField("FTYPE=DOUBLE");
-        writeNumBlock<double>(nullptr, 0);
+        appendStringField(sBlock, "FTYPE=LLINT");
+        appendNumField<int64_t>(sBlock, 1);
+        appendNumField<int64_t>(sBlock, _time64(0));
+        appendStringField(sBlock, "FTYPE=DOUBLE");
+        appendNumField<int64_t>(sBlock, 0);
+        appendStringField(sBlock, "FTYPE=DOUBLE");
+        appendNumField<int64_t>(sBlock, 0);
+        appendStringField(sBlock, "FTYPE=DOUBLE");
+        appendNumField<int64_t>(sBlock, 0);
 
         // Finally, write the dimensions of the
         // target data
-        writeNumField(nRows);
-        writeNumField(nCols);
+        appendNumField(sBlock, nRows);
+        appendNumField(sBlock, nCols);
+
+        writeHashed(sBlock);
     }
 
 
@@ -1271,19 +1644,34 @@ namespace NumeRe
         // Write the file header
         writeHeader();
 
-        // Write the columns
+        // Write the columns and remember their
+        // positions
+        std::vector<uint64_t> vColumnPos;
+
         for (TblColPtr& col : *fileData)
+        {
+            vColumnPos.push_back(tellp());
             writeColumn(col);
+        }
 
-        size_t posEnd = tellp();
+        // Write the column index as footer. It enables
+        // reading single columns without parsing all
+        // preceding ones
+        std::string sIndex;
+
+        for (uint64_t pos : vColumnPos)
+            appendNumField(sIndex, pos);
 
-        seekp(checkStart);
-        std::string checkSum = sha256(fFileStream, checkStart, posEnd-checkStart);
+        writeHashed(sIndex);
+
+        size_t posEnd = tellp();
 
-        // Update the checksum and file end
+        // Update the checksum and file end. The
+        // checksum was calculated while writing, so
+        // the file does not have to be read again
         seekp(checkPos);
-        writeStringField("SHA-256:" + checkSum);
-        writeNumField<uint32_t>(posEnd);
+        writeStringField("XXH64:" + Xxh64::toHex(checksum.digest()));
+        writeNumField<uint64_t>(posEnd);
 
         // Go back to the end
         seekp(posEnd);
@@ -1292,6 +1680,11 @@ namespace NumeRe
 
     /////////////////////////////////////////////////
     /// \brief Writes a single column to the file.
+    /// The column is split into chunks of
+    /// NDAT_CHUNKROWS rows, which are encoded (and
+    /// compressed, if requested) in parallel. A
+    /// directory of the chunks is appended after
+    /// the payload.
     ///
     /// \param col const TblColPtr&
     /// \return void
@@ -1299,65 +1692,161 @@ namespace NumeRe
     /////////////////////////////////////////////////
     void NumeReDataFile::writeColumn(const TblColPtr& col)
     {
-        if (!col)
+        std::string sBlock;
+
+        if (!col || col->m_type == TableColumn::TYPE_NONE)
         {
-            writeStringField("");
-            writeStringField("DTYPE=NONE");
+            appendStringField(sBlock, col ? col->m_sHeadLine : "");
+            appendStringField(sBlock, "DTYPE=NONE");
+            writeHashed(sBlock);
             return;
         }
 
-        writeStringField(col->m_sHeadLine + (col->m_sUnit.length() ? " [" + col->m_sUnit + "]" : ""));
+        size_t nWidth = getNativeWidth(col->m_type);
+        bool isNative = nWidth > 0;
 
-        if (TableColumn::isValueType(col->m_type)
-            || col->m_type == TableColumn::TYPE_DATETIME
-            || col->m_type == TableColumn::TYPE_LOGICAL)
-        {
-            // All these colums write complex values
-            writeStringField("DTYPE=COMPLEX");
+        appendStringField(sBlock, col->m_sHeadLine + (col->m_sUnit.length() ? " [" + col->m_sUnit + "]" : ""));
 
-            // Note the type of the column
-            writeStringField("CTYPE="+toUpperCase(TableColumn::typeToString(col->m_type)));
+        // Numerical, date-time and logical columns are
+        // stored in their native layout, strings and
+        // categories as string fields
+        appendStringField(sBlock, isNative ? "DTYPE=NATIVE" : "DTYPE=STRING");
+        appendStringField(sBlock, "CTYPE=" + toUpperCase(TableColumn::typeToString(col->m_type)));
 
-            uint32_t lenPos = tellp();
-            // Store the position of the next column
-            writeNumField<uint32_t>(lenPos);
+        size_t nElems = col->size();
+        size_t nChunks = (nElems + NDAT_CHUNKROWS - 1) / NDAT_CHUNKROWS;
+        appendNumField<int64_t>(sBlock, nElems);
+        appendNumField<uint32_t>(sBlock, NDAT_CHUNKROWS);
+        appendNumField<uint64_t>(sBlock, nChunks);
 
-            std::vector<std::complex<double>> values = col->getValue(VectorIndex(0, VectorIndex::OPEN_END));
-            writeNumBlock<std::complex<double>>(&values[0], values.size());
+        // Placeholder for the position of the chunk
+        // directory
+        size_t nDirField = sBlock.length();
+        appendNumField<uint64_t>(sBlock, 0);
 
-            uint32_t endPos = tellp();
-            seekp(lenPos);
-            writeNumField<uint32_t>(endPos-lenPos);
-            seekp(endPos);
-        }
-        else if (col->m_type == TableColumn::TYPE_STRING
-                 || col->m_type == TableColumn::TYPE_CATEGORICAL)
+        size_t nBlockStart = tellp();
+        fFileStream.write(sBlock.data(), sBlock.length());
+
+        std::string sDirectory;
+        size_t nBatch = 4 * omp_get_max_threads();
+        std::vector<std::string> vStored(nBatch);
+        std::vector<uint8_t> vCodec(nBatch);
+        std::vector<uint64_t> vRawSize(nBatch);
+
+        // Encode the chunks batch-wise in parallel and
+        // write them sequentially afterwards
+        for (size_t nFirstChunk = 0; nFirstChunk < nChunks; nFirstChunk += nBatch)
         {
-            // All these colums write strings as values
-            writeStringField("DTYPE=STRING");
+            size_t nCount = std::min(nBatch, nChunks - nFirstChunk);
 
-            // Note the type of the column
-            if (col->m_type == TableColumn::TYPE_STRING)
-                writeStringField("CTYPE=STRING");
-            else if (col->m_type == TableColumn::TYPE_CATEGORICAL)
-                writeStringField("CTYPE=CATEGORICAL");
+            #pragma omp parallel for if(nCount > 1)
+            for (size_t k = 0; k < nCount; k++)
+            {
+                size_t first = (nFirstChunk + k) * NDAT_CHUNKROWS;
+                size_t last = std::min(first + NDAT_CHUNKROWS, nElems);
+                std::string sRaw;
 
-            uint32_t lenPos = tellp();
-            // Store the position of the next column
-            writeNumField<uint32_t>(lenPos);
+                if (isNative)
+                    encodeNativeChunk(col.get(), first, last, sRaw);
+                else
+                    encodeStringChunk(col.get(), first, last, sRaw);
 
-            std::vector<std::string> values = col->getValueAsInternalString(VectorIndex(0, VectorIndex::OPEN_END));
-            writeStringBlock(&values[0], values.size());
+                vRawSize[k] = sRaw.length();
+                vCodec[k] = NDAT_RAW;
 
-            uint32_t endPos = tellp();
-            seekp(lenPos);
-            writeNumField<uint32_t>(endPos-lenPos);
-            seekp(endPos);
-        }
-        else if (col->m_type == TableColumn::TYPE_NONE)
-        {
-            writeStringField("DTYPE=NONE");
+                if (useCompressedColumns)
+                {
+                    // Grouping the bytes of equal significance
+                    // results in longer matches for numbers
+                    if (nWidth > 1)
+                    {
+                        std::string sShuffled(sRaw.length(), '\0');
+                        shuffleBytes(sRaw.data(), &sShuffled[0], sRaw.length(), nWidth);
+                        sShuffled = lzCompress(sShuffled.data(), sShuffled.length());
+
+                        if (sShuffled.length() < sRaw.length())
+                        {
+                            sRaw.swap(sShuffled);
+                            vCodec[k] = NDAT_SHUFFLED_LZ;
+                        }
+                    }
+                    else
+                    {
+                        std::string sCompressed = lzCompress(sRaw.data(), sRaw.length());
+
+                        if (sCompressed.length() < sRaw.length())
+                        {
+                            sRaw.swap(sCompressed);
+                            vCodec[k] = NDAT_LZ;
+                        }
+                    }
+                }
+
+                vStored[k].swap(sRaw);
+            }
+
+            for (size_t k = 0; k < nCount; k++)
+            {
+                fFileStream.write(vStored[k].data(), vStored[k].length());
+
+                appendNumField<uint8_t>(sDirectory, vCodec[k]);
+                appendNumField<uint64_t>(sDirectory, vRawSize[k]);
+                appendNumField<uint64_t>(sDirectory, vStored[k].length());
+                appendNumField<uint64_t>(sDirectory, Xxh64::hash(vStored[k].data(), vStored[k].length()));
+
+                std::string().swap(vStored[k]);
+            }
         }
+
+        // Update the position of the chunk directory
+        uint64_t nDirPos = tellp();
+        memcpy(&sBlock[nDirField], &nDirPos, sizeof(nDirPos));
+        seekp(nBlockStart + nDirField);
+        writeNumField<uint64_t>(nDirPos);
+        seekp(nDirPos);
+
+        // The payload is covered by the chunk
+        // checksums in the directory
+        checksum.update(sBlock.data(), sBlock.length());
+        writeHashed(sDirectory);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Writes a block of metadata to the file
+    /// and updates the file checksum with it.
+    ///
+    /// \param sBlock const std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void NumeReDataFile::writeHashed(const std::string& sBlock)
+    {
+        fFileStream.write(sBlock.data(), sBlock.length());
+        checksum.update(sBlock.data(), sBlock.length());
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Reads the already parsed range [nStart,
+    /// nEnd) of the file again and updates the file
+    /// checksum with it. Only used for the small
+    /// metadata blocks. The stream is left at nEnd.
+    ///
+    /// \param nStart size_t
+    /// \param nEnd size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void NumeReDataFile::hashRange(size_t nStart, size_t nEnd)
+    {
+        if (nEnd <= nStart)
+            return;
+
+        std::string sBlock(nEnd - nStart, '\0');
+        seekg(nStart);
+        fFileStream.read(&sBlock[0], sBlock.length());
+        checksum.update(sBlock.data(), sBlock.length());
     }
 
 
@@ -1408,21 +1897,36 @@ namespace NumeRe
         if (fileVerMajor > fileSpecVersionMajor)
             throw SyntaxError(SyntaxError::INSUFFICIENT_NUMERE_VERSION, sFileName, SyntaxError::invalid_position, sFileName);
 
-        // Read checksum
-        if (fileVersionRead >= 4.0)
+        // Read checksum. Version 5.0 hashes the
+        // metadata while reading, the chunks carry
+        // their own checksums
+        if (fileVersionRead >= 5.0)
+        {
+            sChecksum = readStringField();
+            nFileEnd = readNumField<uint64_t>();
+            checkStart = tellg();
+            checksum.reset();
+            isCorrupted = false;
+        }
+        else if (fileVersionRead >= 4.0)
         {
             std::string sha_check = readStringField();
             uint32_t fileEnd = readNumField<uint32_t>();
 
             size_t checkStart = tellg();
 
-            std::string sha = "SHA-256:" + sha256(fFileStream, checkStart, fileEnd-checkStart);
+            // Hashing would read the whole file, which is
+            // exactly what a mapped file shall avoid
+            if (!useMapping)
+            {
+                std::string sha = "SHA-256:" + sha256(fFileStream, checkStart, fileEnd-checkStart);
 
-            // Is it corrupted?
-            if (sha_check != sha)
-                NumeReKernel::issueWarning(_lang.get("COMMON_DATAFILE_CORRUPTED", sFileName));
+                // Is it corrupted?
+                if (sha_check != sha)
+                    NumeReKernel::issueWarning(_lang.get("COMMON_DATAFILE_CORRUPTED", sFileName));
 
-            seekg(checkStart);
+                seekg(checkStart);
+            }
         }
 
         // Read the table name and the comment
@@ -1469,6 +1973,9 @@ namespace NumeRe
         // Read the dimensions of the table
         nRows = readNumField<int64_t>();
         nCols = readNumField<int64_t>();
+
+        if (fileVersionRead >= 5.0)
+            hashRange(checkStart, tellg());
     }
 
 
@@ -1510,8 +2017,17 @@ namespace NumeRe
 
         // Read the file header and determine,
         // whether the file is in legacy mode
+        size_t nFileStart = tellg();
         readHeader();
 
+        // Only read the selected columns and rows,
+        // if a projection was requested
+        if (isProjected)
+        {
+            readProjectedFile(nFileStart);
+            return;
+        }
+
         // If the file is in legacy mode, read
         // the remaining file in legacy mode as
         // well
@@ -1524,18 +2040,48 @@ namespace NumeRe
         // Create empty storage
         createStorage();
 
-        // Version 3.0 introduces column-like layout and v4.0 added
-        // more columns and improved backwards compatibility
+        // Version 3.0 introduces column-like layout, v4.0 added
+        // more columns and improved backwards compatibility and
+        // v5.0 stores native, chunked columns
         if (fileVersionRead >= 4.00)
         {
+            // Map the file, if requested. If the mapping
+            // fails, the file is read as usual
+            if (useMapping)
+            {
+                mappedFile.reset(new MappedFile(sFileName));
+
+                if (!mappedFile->isValid())
+                    mappedFile.reset();
+            }
+
             if (fileData)
             {
                 for (TblColPtr& col : *fileData)
                 {
-                    readColumnV4(col);
+                    if (fileVersionRead >= 5.00)
+                        readColumnV5(col);
+                    else
+                        readColumnV4(col);
                 }
             }
 
+            // Hash the column index and compare the
+            // checksum, which was calculated while
+            // reading
+            if (fileVersionRead >= 5.00)
+            {
+                size_t nIndexStart = tellg();
+
+                if (nFileEnd != nIndexStart + (fileVersionRead >= 5.01 ? nCols*sizeof(uint64_t) : 0))
+                    isCorrupted = true;
+                else
+                    hashRange(nIndexStart, nFileEnd);
+
+                if (isCorrupted || sChecksum != "XXH64:" + Xxh64::toHex(checksum.digest()))
+                    NumeReKernel::issueWarning(_lang.get("COMMON_DATAFILE_CORRUPTED", sFileName));
+            }
+
             return;
         }
         else if (fileVersionRead >= 3.00)
@@ -1617,108 +2163,538 @@ namespace NumeRe
             col->setValue(VectorIndex(0, VectorIndex::OPEN_END), std::vector<std::complex<double>>(values, values+size));
             delete[] values;
         }
-        else if (sDataType == "DTYPE=DATETIME")
+        else if (sDataType == "DTYPE=DATETIME")
+        {
+            col.reset(new DateTimeColumn);
+            col->m_sHeadLine = headAndUnit.first;
+            col->m_sUnit = headAndUnit.second;
+            int64_t size = 0;
+            std::complex<double>* values = readNumBlock<std::complex<double>>(size);
+            col->setValue(VectorIndex(0, VectorIndex::OPEN_END), std::vector<std::complex<double>>(values, values+size));
+            delete[] values;
+        }
+        else if (sDataType == "DTYPE=STRING")
+        {
+            col.reset(new StringColumn);
+            col->m_sHeadLine = headAndUnit.first;
+            col->m_sUnit = headAndUnit.second;
+            int64_t size = 0;
+            std::string* strings = readStringBlock(size);
+            col->setValue(VectorIndex(0, VectorIndex::OPEN_END), std::vector<std::string>(strings, strings+size));
+            delete[] strings;
+        }
+        else if (sDataType == "DTYPE=CATEGORICAL")
+        {
+            col.reset(new CategoricalColumn);
+            col->m_sHeadLine = headAndUnit.first;
+            col->m_sUnit = headAndUnit.second;
+            int64_t size = 0;
+            std::string* strings = readStringBlock(size);
+            col->setValue(VectorIndex(0, VectorIndex::OPEN_END), std::vector<std::string>(strings, strings+size));
+            delete[] strings;
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Reads a single column from file in v4
+    /// format.
+    ///
+    /// \param col TblColPtr&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void NumeReDataFile::readColumnV4(TblColPtr& col)
+    {
+        std::pair<std::string,std::string> headAndUnit = findAndParseUnit(readStringField());
+        std::string sDataType = readStringField();
+
+        if (sDataType == "DTYPE=NONE")
+            return;
+
+        if (sDataType == "DTYPE=COMPLEX")
+        {
+            // Get the actual column type
+            std::string sColType = readStringField();
+            TableColumn::ColumnType type = TableColumn::stringToType(toLowerCase(sColType.substr(sColType.find('=')+1)));
+
+            // Jump over the colum end information
+            readNumField<uint32_t>();
+
+            // Complex and double columns can directly refer
+            // to the mapped file, because their values are
+            // stored in the same layout
+            if (mappedFile && (type == TableColumn::TYPE_VALUE || type == TableColumn::TYPE_VALUE_F64))
+            {
+                int64_t size = readNumField<int64_t>();
+                size_t offset = tellg();
+
+                col.reset(new MappedColumn(mappedFile, offset, size, type));
+                col->m_sHeadLine = headAndUnit.first;
+                col->m_sUnit = headAndUnit.second;
+
+                seekg(offset + size*sizeof(std::complex<double>));
+                return;
+            }
+
+            // Create the column for the corresponding CTYPE
+            if (sColType == "CTYPE=DATETIME")
+                col.reset(new DateTimeColumn);
+            else if (sColType == "CTYPE=LOGICAL")
+                col.reset(new LogicalColumn);
+            else if (type != TableColumn::TYPE_NONE)
+                col.reset(createValueTypeColumn(type));
+            else // All others fall back to a generic value column
+                col.reset(new ValueColumn);
+
+            col->m_sHeadLine = headAndUnit.first;
+            col->m_sUnit = headAndUnit.second;
+            int64_t size = 0;
+            std::complex<double>* values = readNumBlock<std::complex<double>>(size);
+            col->setValue(VectorIndex(0, VectorIndex::OPEN_END), std::vector<std::complex<double>>(values, values+size));
+            delete[] values;
+        }
+        else if (sDataType == "DTYPE=STRING")
+        {
+            // Get the actual column type
+            std::string sColType = readStringField();
+
+            // Jump over the colum end information
+            readNumField<uint32_t>();
+
+            // Create the column for the corresponding CTYPE
+            if (sColType == "CTYPE=STRING")
+                col.reset(new StringColumn);
+            else if (sColType == "CTYPE=CATEGORICAL")
+                col.reset(new CategoricalColumn);
+            else // All others fall back to a generic string column
+                col.reset(new StringColumn);
+
+            col->m_sHeadLine = headAndUnit.first;
+            col->m_sUnit = headAndUnit.second;
+            int64_t size = 0;
+            std::string* strings = readStringBlock(size);
+            col->setValue(VectorIndex(0, VectorIndex::OPEN_END), std::vector<std::string>(strings, strings+size));
+            delete[] strings;
+        }
+        else
+        {
+            // In all other cases: just jump over this column
+            seekg(readNumField<uint32_t>());
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Reads a single column from file in v5
+    /// format. The chunks are read batch-wise,
+    /// verified and decompressed in parallel and
+    /// decoded into the column afterwards. Only the
+    /// chunks containing the rows [nFirstRow,nEndRow)
+    /// are read from the file.
+    ///
+    /// \param col TblColPtr&
+    /// \param nFirstRow size_t
+    /// \param nEndRow size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void NumeReDataFile::readColumnV5(TblColPtr& col, size_t nFirstRow, size_t nEndRow)
+    {
+        size_t nBlockStart = tellg();
+        std::pair<std::string,std::string> headAndUnit = findAndParseUnit(readStringField());
+        std::string sDataType = readStringField();
+
+        if (sDataType == "DTYPE=NONE")
+        {
+            hashRange(nBlockStart, tellg());
+            return;
+        }
+
+        // Get the actual column type and the layout
+        std::string sColType = readStringField();
+        TableColumn::ColumnType type = TableColumn::stringToType(toLowerCase(sColType.substr(sColType.find('=')+1)));
+        int64_t nElems = readNumField<int64_t>();
+        uint32_t nChunkRows = readNumField<uint32_t>();
+        uint64_t nChunks = readNumField<uint64_t>();
+        uint64_t nDirPos = readNumField<uint64_t>();
+        size_t nPayloadStart = tellg();
+        hashRange(nBlockStart, nPayloadStart);
+
+        if (nElems < 0 || !nChunkRows || nChunks != uint64_t(nElems + nChunkRows - 1) / nChunkRows)
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+        // Read the chunk directory
+        seekg(nDirPos);
+        std::vector<uint8_t> vCodec(nChunks);
+        std::vector<uint64_t> vRawSize(nChunks);
+        std::vector<uint64_t> vStoredSize(nChunks);
+        std::vector<uint64_t> vChunkSum(nChunks);
+        uint64_t nPayloadSize = 0;
+        bool isRaw = true;
+
+        for (size_t c = 0; c < nChunks; c++)
+        {
+            vCodec[c] = readNumField<uint8_t>();
+            vRawSize[c] = readNumField<uint64_t>();
+            vStoredSize[c] = readNumField<uint64_t>();
+            vChunkSum[c] = readNumField<uint64_t>();
+            isRaw = isRaw && vCodec[c] == NDAT_RAW;
+            nPayloadSize += vStoredSize[c];
+
+            // A compressed chunk cannot expand by more
+            // than the maximal ratio of the codec
+            if (vRawSize[c] > 256 * vStoredSize[c] + 16)
+                throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+        }
+
+        size_t nColumnEnd = tellg();
+        hashRange(nDirPos, nColumnEnd);
+
+        if (!fFileStream.good() || nDirPos < nPayloadStart || nPayloadSize != nDirPos - nPayloadStart)
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+        bool isNative = sDataType == "DTYPE=NATIVE";
+
+        // Restrict the requested rows to the column
+        nEndRow = std::min<size_t>(nEndRow, nElems);
+        nFirstRow = std::min(nFirstRow, nEndRow);
+
+        // Uncompressed double and complex columns can
+        // directly refer to the mapped file, because
+        // their chunks form a contiguous array
+        if (mappedFile && isNative && isRaw && nEndRow > nFirstRow
+            && (type == TableColumn::TYPE_VALUE || type == TableColumn::TYPE_VALUE_F64))
+        {
+            size_t nElemSize = type == TableColumn::TYPE_VALUE ? sizeof(std::complex<double>) : sizeof(double);
+            col.reset(new MappedColumn(mappedFile, nPayloadStart + nFirstRow*nElemSize, nEndRow-nFirstRow, type, true));
+            col->m_sHeadLine = headAndUnit.first;
+            col->m_sUnit = headAndUnit.second;
+            return;
+        }
+
+        // Create the column for the corresponding CTYPE
+        if (isNative && type == TableColumn::TYPE_DATETIME)
+            col.reset(new DateTimeColumn(nEndRow-nFirstRow));
+        else if (isNative && type == TableColumn::TYPE_LOGICAL)
+            col.reset(new LogicalColumn(nEndRow-nFirstRow));
+        else if (isNative && TableColumn::isValueType(type))
+            col.reset(createValueTypeColumn(type, nEndRow-nFirstRow));
+        else if (sDataType == "DTYPE=STRING" && type == TableColumn::TYPE_CATEGORICAL)
+            col.reset(new CategoricalColumn);
+        else if (sDataType == "DTYPE=STRING")
+            col.reset(new StringColumn);
+        else
+        {
+            // In all other cases: just jump over this column
+            seekg(nColumnEnd);
+            return;
+        }
+
+        col->m_sHeadLine = headAndUnit.first;
+        col->m_sUnit = headAndUnit.second;
+
+        size_t nWidth = getNativeWidth(type);
+        size_t nBatch = 4 * omp_get_max_threads();
+        std::vector<std::string> vStored(nBatch);
+        std::vector<uint8_t> vValid(nBatch);
+
+        // Only the chunks containing the requested
+        // rows are read. Jump over the preceding ones
+        size_t nChunkBegin = nFirstRow / nChunkRows;
+        size_t nChunkEnd = (nEndRow + nChunkRows - 1) / nChunkRows;
+        uint64_t nChunkPos = nPayloadStart;
+
+        for (size_t c = 0; c < nChunkBegin; c++)
+            nChunkPos += vStoredSize[c];
+
+        seekg(nChunkPos);
+
+        for (size_t nFirstChunk = nChunkBegin; nFirstChunk < nChunkEnd; nFirstChunk += nBatch)
+        {
+            size_t nCount = std::min<size_t>(nBatch, nChunkEnd - nFirstChunk);
+
+            // Read the stored chunks sequentially
+            for (size_t k = 0; k < nCount; k++)
+            {
+                vStored[k].resize(vStoredSize[nFirstChunk+k]);
+                fFileStream.read(&vStored[k][0], vStored[k].length());
+            }
+
+            // Verify and decompress them in parallel
+            #pragma omp parallel for if(nCount > 1)
+            for (size_t k = 0; k < nCount; k++)
+            {
+                size_t c = nFirstChunk + k;
+                vValid[k] = Xxh64::hash(vStored[k].data(), vStored[k].length()) == vChunkSum[c];
+
+                if (!vValid[k] || vCodec[c] == NDAT_RAW)
+                    continue;
+
+                std::string sRaw(vRawSize[c], '\0');
+
+                if (vCodec[c] > NDAT_SHUFFLED_LZ
+                    || !lzDecompress(vStored[k].data(), vStored[k].length(), &sRaw[0], sRaw.length()))
+                {
+                    vValid[k] = false;
+                    continue;
+                }
+
+                if (vCodec[c] == NDAT_SHUFFLED_LZ)
+                {
+                    vStored[k].resize(sRaw.length());
+                    unshuffleBytes(sRaw.data(), &vStored[k][0], sRaw.length(), nWidth);
+                }
+                else
+                    vStored[k].swap(sRaw);
+            }
+
+            // Decode them into the column
+            for (size_t k = 0; k < nCount; k++)
+            {
+                size_t first = (nFirstChunk + k) * nChunkRows;
+                size_t nRowsInChunk = std::min<size_t>(nChunkRows, nElems - first);
+                size_t nFrom = std::max(first, nFirstRow) - first;
+                size_t nTo = std::min(first + nRowsInChunk, nEndRow) - first;
+
+                if (!vValid[k]
+                    || !(isNative ? decodeNativeChunk(col.get(), first + nFrom - nFirstRow, vStored[k], nRowsInChunk, nFrom, nTo)
+                                  : decodeStringChunk(col.get(), first + nFrom - nFirstRow, vStored[k], nRowsInChunk, nFrom, nTo)))
+                    isCorrupted = true;
+
+                std::string().swap(vStored[k]);
+            }
+        }
+
+        seekg(nColumnEnd);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Reads the description of the column
+    /// at the current position without reading its
+    /// values. The stream is left at the end of the
+    /// column.
+    ///
+    /// \param info FileColumnInfo&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void NumeReDataFile::readColumnInfoV5(FileColumnInfo& info)
+    {
+        std::pair<std::string,std::string> headAndUnit = findAndParseUnit(readStringField());
+        info.sHeadLine = headAndUnit.first;
+        info.sUnit = headAndUnit.second;
+        info.type = TableColumn::TYPE_NONE;
+        info.nRows = 0;
+
+        if (readStringField() == "DTYPE=NONE")
+            return;
+
+        std::string sColType = readStringField();
+        info.type = TableColumn::stringToType(toLowerCase(sColType.substr(sColType.find('=')+1)));
+        info.nRows = readNumField<int64_t>();
+        readNumField<uint32_t>();
+        uint64_t nChunks = readNumField<uint64_t>();
+        uint64_t nDirPos = readNumField<uint64_t>();
+
+        // Jump over the payload and the chunk directory
+        seekg(nDirPos + nChunks * (sizeof(uint8_t) + 3*sizeof(uint64_t)));
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the positions of all columns
+    /// in a v5 file. Must be called directly after
+    /// reading the header. Files since v5.1 contain
+    /// a column index as footer, v5.0 files are
+    /// traversed column by column without reading
+    /// their values.
+    ///
+    /// \return std::vector<uint64_t>
+    ///
+    /////////////////////////////////////////////////
+    std::vector<uint64_t> NumeReDataFile::readColumnIndex()
+    {
+        size_t nColumnStart = tellg();
+        std::vector<uint64_t> vColumnPos(nCols);
+
+        if (fileVersionRead >= 5.01)
+        {
+            if (nFileEnd < nColumnStart + nCols*sizeof(uint64_t))
+                throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+            seekg(nFileEnd - nCols*sizeof(uint64_t));
+
+            for (int64_t j = 0; j < nCols; j++)
+            {
+                vColumnPos[j] = readNumField<uint64_t>();
+
+                if (vColumnPos[j] < nColumnStart || vColumnPos[j] >= nFileEnd)
+                    throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+            }
+
+            return vColumnPos;
+        }
+
+        FileColumnInfo info;
+
+        for (int64_t j = 0; j < nCols; j++)
+        {
+            vColumnPos[j] = tellg();
+            readColumnInfoV5(info);
+        }
+
+        if (!fFileStream.good())
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+        return vColumnPos;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Reads only the selected columns and
+    /// the selected range of rows. v5 files jump
+    /// directly to the selected columns and chunks,
+    /// older files are read completely and cut
+    /// afterwards. As only parts of the file are
+    /// read, only the checksums of the read chunks
+    /// are verified.
+    ///
+    /// \param nFileStart size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void NumeReDataFile::readProjectedFile(size_t nFileStart)
+    {
+        // Determine the selected columns and the
+        // range of rows between the smallest and the
+        // largest selected row
+        std::vector<size_t> vCols;
+        vProjectedCols.setOpenEndIndex(nCols-1);
+        vProjectedRows.setOpenEndIndex(nRows-1);
+
+        for (size_t i = 0; i < vProjectedCols.size(); i++)
+        {
+            // Columns, which do not exist in the file,
+            // cannot be read
+            if (vProjectedCols[i] < 0 || vProjectedCols[i] >= nCols)
+                throw SyntaxError(SyntaxError::INVALID_INDEX, sFileName, SyntaxError::invalid_position,
+                                  "cols=" + toString(vProjectedCols[i]+1) + " (" + toString(nCols) + " columns)");
+
+            vCols.push_back(vProjectedCols[i]);
+        }
+
+        size_t nFirstRow = std::max(vProjectedRows.min(), 0);
+        size_t nEndRow = std::max<int64_t>(std::min<int64_t>(vProjectedRows.max()+1, nRows), nFirstRow);
+
+        // Older files do not contain a column index.
+        // They are read completely and cut afterwards
+        if (isLegacy || fileVersionRead < 5.00)
         {
-            col.reset(new DateTimeColumn);
-            col->m_sHeadLine = headAndUnit.first;
-            col->m_sUnit = headAndUnit.second;
-            int64_t size = 0;
-            std::complex<double>* values = readNumBlock<std::complex<double>>(size);
-            col->setValue(VectorIndex(0, VectorIndex::OPEN_END), std::vector<std::complex<double>>(values, values+size));
-            delete[] values;
+            isProjected = false;
+            seekg(nFileStart);
+            readFile();
+            isProjected = true;
+
+            if (!fileData)
+                return;
+
+            TableColumnArray* projectedData = new TableColumnArray(vCols.size());
+
+            for (size_t j = 0; j < vCols.size(); j++)
+            {
+                if (fileData->at(vCols[j]) && nEndRow > nFirstRow)
+                    projectedData->at(j).reset(fileData->at(vCols[j])->copy(VectorIndex(nFirstRow, nEndRow-1)));
+            }
+
+            clearStorage();
+            fileData = projectedData;
+            nCols = vCols.size();
+            nRows = nEndRow - nFirstRow;
+            return;
         }
-        else if (sDataType == "DTYPE=STRING")
+
+        std::vector<uint64_t> vColumnPos = readColumnIndex();
+
+        // Map the file, if requested. If the mapping
+        // fails, the file is read as usual
+        if (useMapping)
         {
-            col.reset(new StringColumn);
-            col->m_sHeadLine = headAndUnit.first;
-            col->m_sUnit = headAndUnit.second;
-            int64_t size = 0;
-            std::string* strings = readStringBlock(size);
-            col->setValue(VectorIndex(0, VectorIndex::OPEN_END), std::vector<std::string>(strings, strings+size));
-            delete[] strings;
+            mappedFile.reset(new MappedFile(sFileName));
+
+            if (!mappedFile->isValid())
+                mappedFile.reset();
         }
-        else if (sDataType == "DTYPE=CATEGORICAL")
+
+        nCols = vCols.size();
+        nRows = nEndRow - nFirstRow;
+        createStorage();
+
+        for (size_t j = 0; j < vCols.size(); j++)
         {
-            col.reset(new CategoricalColumn);
-            col->m_sHeadLine = headAndUnit.first;
-            col->m_sUnit = headAndUnit.second;
-            int64_t size = 0;
-            std::string* strings = readStringBlock(size);
-            col->setValue(VectorIndex(0, VectorIndex::OPEN_END), std::vector<std::string>(strings, strings+size));
-            delete[] strings;
+            seekg(vColumnPos[vCols[j]]);
+            readColumnV5(fileData->at(j), nFirstRow, nEndRow);
         }
+
+        if (isCorrupted)
+            NumeReKernel::issueWarning(_lang.get("COMMON_DATAFILE_CORRUPTED", sFileName));
+
+        seekg(nFileEnd);
     }
 
 
     /////////////////////////////////////////////////
-    /// \brief Reads a single column from file in v4
-    /// format.
+    /// \brief Reads the header and the description
+    /// of all columns of the file. The values of v5
+    /// files are not read. The description is
+    /// returned via getFileHeaderInformation().
     ///
-    /// \param col TblColPtr&
     /// \return void
     ///
     /////////////////////////////////////////////////
-    void NumeReDataFile::readColumnV4(TblColPtr& col)
+    void NumeReDataFile::readFileSchema()
     {
-        std::pair<std::string,std::string> headAndUnit = findAndParseUnit(readStringField());
-        std::string sDataType = readStringField();
+        if (!is_open())
+            open(std::ios::binary | std::ios::in);
 
-        if (sDataType == "DTYPE=NONE")
-            return;
+        size_t nFileStart = tellg();
+        readHeader();
+        vColumnInfo.clear();
 
-        if (sDataType == "DTYPE=COMPLEX")
+        if (!isLegacy && fileVersionRead >= 5.00)
         {
-            // Get the actual column type
-            std::string sColType = readStringField();
-            TableColumn::ColumnType type = TableColumn::stringToType(toLowerCase(sColType.substr(sColType.find('=')+1)));
+            std::vector<uint64_t> vColumnPos = readColumnIndex();
+            vColumnInfo.resize(nCols);
 
-            // Jump over the colum end information
-            readNumField<uint32_t>();
-
-            // Create the column for the corresponding CTYPE
-            if (sColType == "CTYPE=DATETIME")
-                col.reset(new DateTimeColumn);
-            else if (sColType == "CTYPE=LOGICAL")
-                col.reset(new LogicalColumn);
-            else if (type != TableColumn::TYPE_NONE)
-                col.reset(createValueTypeColumn(type));
-            else // All others fall back to a generic value column
-                col.reset(new ValueColumn);
+            for (int64_t j = 0; j < nCols; j++)
+            {
+                seekg(vColumnPos[j]);
+                readColumnInfoV5(vColumnInfo[j]);
+            }
 
-            col->m_sHeadLine = headAndUnit.first;
-            col->m_sUnit = headAndUnit.second;
-            int64_t size = 0;
-            std::complex<double>* values = readNumBlock<std::complex<double>>(size);
-            col->setValue(VectorIndex(0, VectorIndex::OPEN_END), std::vector<std::complex<double>>(values, values+size));
-            delete[] values;
+            return;
         }
-        else if (sDataType == "DTYPE=STRING")
-        {
-            // Get the actual column type
-            std::string sColType = readStringField();
 
-            // Jump over the colum end information
-            readNumField<uint32_t>();
+        // Older files do not describe their columns
+        // separately and have to be read completely
+        seekg(nFileStart);
+        readFile();
 
-            // Create the column for the corresponding CTYPE
-            if (sColType == "CTYPE=STRING")
-                col.reset(new StringColumn);
-            else if (sColType == "CTYPE=CATEGORICAL")
-                col.reset(new CategoricalColumn);
-            else // All others fall back to a generic string column
-                col.reset(new StringColumn);
+        if (!fileData)
+            return;
 
-            col->m_sHeadLine = headAndUnit.first;
-            col->m_sUnit = headAndUnit.second;
-            int64_t size = 0;
-            std::string* strings = readStringBlock(size);
-            col->setValue(VectorIndex(0, VectorIndex::OPEN_END), std::vector<std::string>(strings, strings+size));
-            delete[] strings;
-        }
-        else
+        vColumnInfo.resize(fileData->size());
+
+        for (size_t j = 0; j < fileData->size(); j++)
         {
-            // In all other cases: just jump over this column
-            seekg(readNumField<uint32_t>());
+            if (!fileData->at(j))
+                continue;
+
+            vColumnInfo[j].sHeadLine = fileData->at(j)->m_sHeadLine;
+            vColumnInfo[j].sUnit = fileData->at(j)->m_sUnit;
+            vColumnInfo[j].type = fileData->at(j)->m_type;
+            vColumnInfo[j].nRows = fileData->at(j)->size();
         }
     }
 
@@ -1926,6 +2902,8 @@ namespace NumeRe
         versionMajor = file.versionMajor;
         versionMinor = file.versionMinor;
         versionBuild = file.versionBuild;
+        useMapping = file.useMapping;
+        mappedFile = file.mappedFile;
 
         return *this;
     }
@@ -2000,7 +2978,7 @@ namespace NumeRe
     void CacheFile::readSome()
     {
         reset();
-        uint32_t pos = tellg();
+        uint64_t pos = tellg();
 
         if (std::find(vFileIndex.begin(), vFileIndex.end(), pos) == vFileIndex.end())
             throw SyntaxError(SyntaxError::CANNOT_READ_FILE, "numere.cache", "numere.cache");
@@ -2083,15 +3061,29 @@ namespace NumeRe
         // Create the file index array. This array
         // may be used to support memory paging
         // in a future version of NumeRe
-        vFileIndex = std::vector<uint32_t>(nNumberOfTables, 0u);
+        vFileIndex = std::vector<uint64_t>(nNumberOfTables, 0u);
 
         // Read the file index information in
         // the file to the newly created file
-        // index array
+        // index array. Version 5.0 uses 64 bit
+        // offsets
         int64_t size = 0;
-        uint32_t* nIndex = readNumBlock<uint32_t>(size);
-        copyArray(nIndex, &vFileIndex[0], nNumberOfTables);
-        delete[] nIndex;
+
+        if (fileVerMajor >= 5)
+        {
+            uint64_t* nIndex = readNumBlock<uint64_t>(size);
+            copyArray(nIndex, &vFileIndex[0], std::min<int64_t>(size, nNumberOfTables));
+            delete[] nIndex;
+        }
+        else
+        {
+            uint32_t* nIndex = readNumBlock<uint32_t>(size);
+
+            for (int64_t i = 0; i < std::min<int64_t>(size, nNumberOfTables); i++)
+                vFileIndex[i] = nIndex[i];
+
+            delete[] nIndex;
+        }
     }
 
 
@@ -2307,79 +3299,436 @@ namespace NumeRe
 
 
     /////////////////////////////////////////////////
-    /// \brief Simple helper function to count the
-    /// quotation marks in a line of text.
+    /// \brief Byte range of a record or a cell
+    /// within the buffer of a CSV file. The last
+    /// position is not part of the range.
+    /////////////////////////////////////////////////
+    struct CsvRange
+    {
+        size_t first;
+        size_t last;
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief The types, which are detected from
+    /// the sampled cells of a CSV column and decide,
+    /// how the cells are parsed.
+    /////////////////////////////////////////////////
+    enum CsvColumnType
+    {
+        CSV_STRING,
+        CSV_VALUE,
+        CSV_VALUE_DECIMALCOMMA,
+        CSV_DATETIME
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to determine the ranges
+    /// of all non-empty records in the buffer. Line
+    /// breaks within quoted cells do not end a
+    /// record. The buffer is split into chunks,
+    /// which are scanned in parallel: the first pass
+    /// counts the quotation marks to know, whether a
+    /// chunk starts within a quoted cell, the second
+    /// one collects the line breaks.
+    ///
+    /// \param pData const char*
+    /// \param nSize size_t
+    /// \return std::vector<CsvRange>
+    ///
+    /////////////////////////////////////////////////
+    static std::vector<CsvRange> findRecords(const char* pData, size_t nSize)
+    {
+        const size_t MINCHUNKSIZE = 1 << 20;
+        size_t nChunks = std::max(std::min((size_t)omp_get_max_threads() * 4, nSize / MINCHUNKSIZE), (size_t)1);
+        size_t nChunkSize = nSize / nChunks + 1;
+
+        std::vector<size_t> vQmarks(nChunks, 0);
+
+        #pragma omp parallel for if(nChunks > 1)
+        for (size_t c = 0; c < nChunks; c++)
+        {
+            size_t nEnd = std::min((c+1)*nChunkSize, nSize);
+
+            if (c*nChunkSize < nEnd)
+                vQmarks[c] = std::count(pData + c*nChunkSize, pData + nEnd, '"');
+        }
+
+        std::vector<bool> vStartsQuoted(nChunks, false);
+
+        for (size_t c = 1; c < nChunks; c++)
+        {
+            vStartsQuoted[c] = vStartsQuoted[c-1] != bool(vQmarks[c-1] % 2);
+        }
+
+        std::vector<std::vector<size_t>> vLineBreaks(nChunks);
+
+        #pragma omp parallel for if(nChunks > 1)
+        for (size_t c = 0; c < nChunks; c++)
+        {
+            bool inQuotation = vStartsQuoted[c];
+            size_t nEnd = std::min((c+1)*nChunkSize, nSize);
+
+            for (size_t i = c*nChunkSize; i < nEnd; i++)
+            {
+                if (pData[i] == '"')
+                    inQuotation = !inQuotation;
+                else if (pData[i] == '\n' && !inQuotation)
+                    vLineBreaks[c].push_back(i);
+            }
+        }
+
+        // Combine the line breaks to records, strip
+        // the trailing whitespaces and ignore empty
+        // lines
+        std::vector<CsvRange> vRecords;
+        size_t nStart = 0;
+
+        auto addRecord = [&](size_t nEnd)
+            {
+                while (nEnd > nStart && (pData[nEnd-1] == ' ' || pData[nEnd-1] == '\t' || pData[nEnd-1] == '\r'))
+                    nEnd--;
+
+                if (nEnd > nStart)
+                    vRecords.push_back({nStart, nEnd});
+            };
+
+        for (const std::vector<size_t>& vChunk : vLineBreaks)
+        {
+            for (size_t nLineBreak : vChunk)
+            {
+                addRecord(nLineBreak);
+                nStart = nLineBreak+1;
+            }
+        }
+
+        addRecord(nSize);
+
+        return vRecords;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to split a record into
+    /// its cells considering quotation marks.
     ///
-    /// \param sLine const std::string&
-    /// \return size_t
+    /// \param pData const char*
+    /// \param record const CsvRange&
+    /// \param cSep char
+    /// \param vCells std::vector<CsvRange>&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void splitRecord(const char* pData, const CsvRange& record, char cSep, std::vector<CsvRange>& vCells)
+    {
+        vCells.clear();
+        bool inQuotation = false;
+        size_t nStart = record.first;
+
+        for (size_t i = record.first; i < record.last; i++)
+        {
+            if (pData[i] == '"')
+                inQuotation = !inQuotation;
+            else if (pData[i] == cSep && !inQuotation)
+            {
+                vCells.push_back({nStart, i});
+                nStart = i+1;
+            }
+        }
+
+        vCells.push_back({nStart, record.last});
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to copy a range of the
+    /// buffer into a string. Windows line endings
+    /// are replaced by simple line breaks.
+    ///
+    /// \param pData const char*
+    /// \param range const CsvRange&
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+    static std::string rangeToString(const char* pData, const CsvRange& range)
+    {
+        std::string sString(pData + range.first, range.last - range.first);
+
+        if (sString.find('\r') != std::string::npos)
+            replaceAll(sString, "\r\n", "\n");
+
+        return sString;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to get the contents of
+    /// a cell as a string. Surrounding quotation
+    /// marks are removed and escaped quotation marks
+    /// are decoded.
+    ///
+    /// \param pData const char*
+    /// \param cell const CsvRange&
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+    static std::string getCellString(const char* pData, const CsvRange& cell)
+    {
+        if (cell.last - cell.first >= 2 && pData[cell.first] == '"' && pData[cell.last-1] == '"')
+        {
+            std::string sCell = rangeToString(pData, {cell.first+1, cell.last-1});
+            replaceAll(sCell, "\"\"", "\"");
+            return sCell;
+        }
+
+        return rangeToString(pData, cell);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to remove surrounding
+    /// whitespaces and quotation marks from a cell.
+    ///
+    /// \param pData const char*
+    /// \param cell CsvRange
+    /// \return CsvRange
+    ///
+    /////////////////////////////////////////////////
+    static CsvRange trimCell(const char* pData, CsvRange cell)
+    {
+        while (cell.first < cell.last && (pData[cell.first] == ' ' || pData[cell.first] == '\t'))
+            cell.first++;
+
+        while (cell.last > cell.first && (pData[cell.last-1] == ' ' || pData[cell.last-1] == '\t'))
+            cell.last--;
+
+        if (cell.last - cell.first >= 2 && pData[cell.first] == '"' && pData[cell.last-1] == '"')
+            return trimCell(pData, {cell.first+1, cell.last-1});
+
+        return cell;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to detect cells, which
+    /// represent missing values.
+    ///
+    /// \param pData const char*
+    /// \param cell const CsvRange&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    static bool isMissingCell(const char* pData, const CsvRange& cell)
+    {
+        size_t nLen = cell.last - cell.first;
+        const char* pCell = pData + cell.first;
+
+        return !nLen
+            || (nLen == 3 && !strncmp(pCell, "---", 3))
+            || (nLen == 2 && tolower(pCell[0]) == 'n' && tolower(pCell[1]) == 'a')
+            || (nLen == 3 && tolower(pCell[0]) == 'n' && pCell[1] == '/' && tolower(pCell[2]) == 'a');
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to parse a trimmed cell
+    /// into a floating point value using the passed
+    /// decimal sign. Returns false, if the cell is
+    /// not a plain number.
+    ///
+    /// \param pData const char*
+    /// \param cell const CsvRange&
+    /// \param cDecimal char
+    /// \param dValue double&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    static bool parseCsvValue(const char* pData, const CsvRange& cell, char cDecimal, double& dValue)
+    {
+        const char* pStart = pData + cell.first;
+        const char* pEnd = pData + cell.last;
+
+        if (pStart < pEnd && *pStart == '+')
+            pStart++;
+
+        if (pStart >= pEnd)
+            return false;
+
+        if (cDecimal == ',')
+        {
+            // Replace the decimal comma in a local copy.
+            // Dots are thousands separators and are not
+            // handled here
+            char buffer[64];
+            size_t nLen = pEnd - pStart;
+
+            if (nLen >= sizeof(buffer) || std::find(pStart, pEnd, '.') != pEnd)
+                return false;
+
+            std::replace_copy(pStart, pEnd, buffer, ',', '.');
+            fast_float::from_chars_result res = fast_float::from_chars(buffer, buffer + nLen, dValue);
+            return res.ec == std::errc() && res.ptr == buffer + nLen;
+        }
+
+        if (std::find(pStart, pEnd, ',') != pEnd)
+            return false;
+
+        fast_float::from_chars_result res = fast_float::from_chars(pStart, pEnd, dValue);
+        return res.ec == std::errc() && res.ptr == pEnd;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper to detect the type of a
+    /// column from a sample of its cells. Only plain
+    /// numbers and date-time values are detected,
+    /// everything else (including numbers with
+    /// thousands separators) is left to the
+    /// automatic conversion of string columns.
+    ///
+    /// \param pData const char*
+    /// \param vCells const std::vector<CsvRange>&
+    /// \return CsvColumnType
     ///
     /////////////////////////////////////////////////
-    static size_t countQmarks(const std::string& sLine)
+    static CsvColumnType detectColumnType(const char* pData, const std::vector<CsvRange>& vCells)
     {
-        size_t qmarks = 0;
+        bool isValue = true;
+        bool isDateTime = true;
+        bool hasDot = false;
+        bool hasComma = false;
+        bool hasDecimalComma = false;
+        size_t nValid = 0;
+
+        for (const CsvRange& cell : vCells)
+        {
+            if (isMissingCell(pData, cell))
+                continue;
+
+            nValid++;
+
+            if (isValue)
+            {
+                const char* pStart = pData + cell.first;
+                const char* pEnd = pData + cell.last;
+                const char* pComma = std::find(pStart, pEnd, ',');
+                double dValue;
+
+                if (pComma != pEnd)
+                {
+                    hasComma = true;
+
+                    // Exactly three digits after a comma might
+                    // also be a thousands separator
+                    const char* pDigits = pComma+1;
+
+                    while (pDigits < pEnd && isdigit(*pDigits))
+                        pDigits++;
+
+                    hasDecimalComma = hasDecimalComma || pDigits - pComma - 1 != 3;
+                }
 
-        for (size_t i = 0; i < sLine.length(); i++)
-        {
-            qmarks += (sLine[i] == '"');
+                hasDot = hasDot || std::find(pStart, pEnd, '.') != pEnd;
+                isValue = !(hasComma && hasDot) && parseCsvValue(pData, cell, hasComma ? ',' : '.', dValue);
+            }
+
+            if (isDateTime)
+                isDateTime = isConvertible(rangeToString(pData, cell), CONVTYPE_DATE_TIME);
+
+            if (!isValue && !isDateTime)
+                return CSV_STRING;
         }
 
-        return qmarks;
+        if (!nValid)
+            return CSV_STRING;
+
+        if (isValue && !hasComma)
+            return CSV_VALUE;
+
+        if (isValue && hasDecimalComma)
+            return CSV_VALUE_DECIMALCOMMA;
+
+        if (isDateTime)
+            return CSV_DATETIME;
+
+        return CSV_STRING;
     }
 
 
     /////////////////////////////////////////////////
     /// \brief This member function is used to read
-    /// the target file to memory.
+    /// the target file to memory. The file is mapped
+    /// into memory and the records are determined in
+    /// parallel. The column types are detected from
+    /// a sample of rows and the cells are parsed in
+    /// parallel directly into typed columns. Columns,
+    /// which do not fit their detected type, are
+    /// read as strings and converted afterwards.
     ///
     /// \return void
     ///
     /////////////////////////////////////////////////
     void CommaSeparatedValues::readFile()
     {
-        // Open the file stream in text mode
-        open(std::ios::in);
+        // Map the file into memory. If this is not
+        // possible, we read it completely instead
+        MappedFile mappedFile(sFileName);
+        std::string sBuffer;
+        const char* pData = mappedFile.data();
+        size_t nSize = mappedFile.size();
+
+        if (!mappedFile.isValid())
+        {
+            open(std::ios::in | std::ios::binary);
+            fFileStream.seekg(0, std::ios::end);
+            sBuffer.resize(fFileStream.tellg());
+            fFileStream.seekg(0, std::ios::beg);
+            fFileStream.read(sBuffer.data(), sBuffer.length());
+            pData = sBuffer.data();
+            nSize = sBuffer.length();
+        }
+
+        // Skip an UTF-8 byte order mark
+        if (nSize >= 3 && !strncmp(pData, "\xEF\xBB\xBF", 3))
+        {
+            pData += 3;
+            nSize -= 3;
+        }
 
         // Create the needed variabels
-		char cSep = 0;
-        long long int nLine = 0;
-		long long int nComment = 0;
-		std::vector<std::string> vHeadLine;
+        char cSep = 0;
+        long long int nComment = 0;
+        std::vector<std::string> vHeadLine;
+
+        // Determine the ranges of all non-empty
+        // records. Cells, which are spread over
+        // multiple lines, are part of a single
+        // record
+        std::vector<CsvRange> vRecords = findRecords(pData, nSize);
+
+        // Ensure that there is at least one
+        // line available
+        if (!vRecords.size())
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
 
-		// Read the whole file to a vector and
-		// get the number of lines available in
-		// the data file
-		std::vector<std::string> vFileData = readTextFile(true);
+        // The separator and the number of columns
+        // are determined from the first lines
+        std::vector<std::string> vFileData;
 
-		// Combine all cells, which are spread over
-		// multiple lines into a single row by checking
-		// for unterminated quotation marks
-		for (size_t i = 0; i < vFileData.size(); i++)
+        for (size_t i = 0; i < std::min(vRecords.size(), (size_t)100); i++)
         {
-            while (countQmarks(vFileData[i]) % 2 && i+1 < vFileData.size())
-            {
-                // Insert a linebreak, if there's actual text to be separated
-                if (vFileData[i].back() != '"' && vFileData[i+1].front() != '"')
-                    vFileData[i] += "\n";
-
-                vFileData[i] += vFileData[i+1];
-                vFileData.erase(vFileData.begin()+i+1);
-            }
+            vFileData.push_back(rangeToString(pData, vRecords[i]));
         }
 
-		nLine = vFileData.size();
-
-		// Ensure that there is at least one
-		// line available
-		if (!nLine)
-            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
-
         // Determine, which character is used
         // as cell separator
-		cSep = findSeparator(vFileData);
+        cSep = findSeparator(vFileData);
 
-		// Ensure that we were able to determine
-		// the separator
-		if (!cSep)
+        // Ensure that we were able to determine
+        // the separator
+        if (!cSep)
             throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
 
         // Count the number of columns available
@@ -2421,38 +3770,175 @@ namespace NumeRe
                 StripSpaces(vHeadLine[n]);
             }
 
-            // Clear the first line, if the tokens were
-            // not erased before
+            // Note that the first line contains
+            // the table heads
             if (vTokens.size())
-            {
-                vFileData[0].clear();
                 nComment++;
-            }
         }
 
         // Store the number of lines of the file,
-        // which contain numeric data, in the rows
-        // variable
-        if (nComment)
-            nRows = nLine - 1;
-        else
-            nRows = nLine;
+        // which contain data, in the rows variable
+        nRows = vRecords.size() - nComment;
+
+        // Detect the column types from a sample of
+        // rows distributed over the whole file
+        std::vector<CsvColumnType> vTypes(nCols, CSV_STRING);
+        std::vector<std::vector<CsvRange>> vSampledCells(nCols);
+        std::vector<CsvRange> vCells;
+        size_t nSampleRows = std::min((size_t)nRows, (size_t)1000);
+
+        for (size_t s = 0; s < nSampleRows; s++)
+        {
+            splitRecord(pData, vRecords[nComment + s*nRows / nSampleRows], cSep, vCells);
+
+            for (size_t j = 0; j < std::min(vCells.size(), (size_t)nCols); j++)
+            {
+                vSampledCells[j].push_back(trimCell(pData, vCells[j]));
+            }
+        }
+
+        for (long long int j = 0; j < nCols; j++)
+        {
+            vTypes[j] = detectColumnType(pData, vSampledCells[j]);
+        }
+
+        // Parse all cells in parallel into buffers
+        // for each column. Columns, which contain
+        // cells not fitting their detected type, are
+        // marked as failed
+        std::vector<std::vector<double>> vValues(nCols);
+        std::vector<std::vector<std::string>> vStrings(nCols);
+        std::vector<char> vFailed(nCols, false);
+
+        for (long long int j = 0; j < nCols; j++)
+        {
+            if (vTypes[j] == CSV_STRING)
+                vStrings[j].resize(nRows);
+            else
+                vValues[j].resize(nRows, NAN);
+        }
+
+        #pragma omp parallel private(vCells)
+        {
+            #pragma omp for
+            for (long long int i = 0; i < nRows; i++)
+            {
+                splitRecord(pData, vRecords[i+nComment], cSep, vCells);
+
+                for (size_t j = 0; j < std::min(vCells.size(), (size_t)nCols); j++)
+                {
+                    if (vTypes[j] == CSV_STRING)
+                    {
+                        vStrings[j][i] = getCellString(pData, vCells[j]);
+                        continue;
+                    }
+
+                    CsvRange cell = trimCell(pData, vCells[j]);
+
+                    if (isMissingCell(pData, cell))
+                        continue;
+
+                    bool success = true;
+
+                    if (vTypes[j] == CSV_DATETIME)
+                    {
+                        std::string sCell = rangeToString(pData, cell);
+                        success = isConvertible(sCell, CONVTYPE_DATE_TIME);
+
+                        if (success)
+                            vValues[j][i] = to_double(StrToTime(sCell));
+                    }
+                    else
+                        success = parseCsvValue(pData, cell, vTypes[j] == CSV_VALUE_DECIMALCOMMA ? ',' : '.', vValues[j][i]);
+
+                    if (!success)
+                    {
+                        #pragma omp atomic write
+                        vFailed[j] = true;
+                    }
+                }
+            }
+        }
+
+        // Read the failed columns again as strings
+        std::vector<size_t> vFailedCols;
+
+        for (long long int j = 0; j < nCols; j++)
+        {
+            if (vFailed[j])
+            {
+                vFailedCols.push_back(j);
+                vTypes[j] = CSV_STRING;
+                std::vector<double>().swap(vValues[j]);
+                vStrings[j].resize(nRows);
+            }
+        }
+
+        if (vFailedCols.size())
+        {
+            #pragma omp parallel private(vCells)
+            {
+                #pragma omp for
+                for (long long int i = 0; i < nRows; i++)
+                {
+                    splitRecord(pData, vRecords[i+nComment], cSep, vCells);
+
+                    for (size_t j : vFailedCols)
+                    {
+                        if (j < vCells.size())
+                            vStrings[j][i] = getCellString(pData, vCells[j]);
+                    }
+                }
+            }
+        }
 
         // Prepare the internal storage
         createStorage();
 
-        // We start with string-only and try to
-        // convert them later
+        // Create the columns from the buffers. String
+        // columns are converted automatically after
+        // reading
+        #pragma omp parallel for
         for (long long int j = 0; j < nCols; j++)
         {
-            fileData->at(j).reset(new StringColumn);
+            TableColumn* col;
+
+            if (vTypes[j] == CSV_STRING)
+            {
+                col = new StringColumn;
+
+                for (long long int i = 0; i < nRows; i++)
+                {
+                    if (vStrings[j][i].length())
+                        col->setValue(i, vStrings[j][i]);
+                }
+
+                std::vector<std::string>().swap(vStrings[j]);
+            }
+            else
+            {
+                if (vTypes[j] == CSV_DATETIME)
+                    col = new DateTimeColumn(nRows);
+                else
+                    col = new F64ValueColumn(nRows);
+
+                for (long long int i = 0; i < nRows; i++)
+                {
+                    if (!std::isnan(vValues[j][i]))
+                        col->setValue(i, vValues[j][i]);
+                }
+
+                std::vector<double>().swap(vValues[j]);
+            }
+
+            fileData->at(j).reset(col);
         }
 
         // Copy the already decoded table heads to
         // the internal storage or create a dummy
         // column head, if the data contains only
         // one column
-		if (nComment)
+        if (nComment)
         {
             for (long long int j = 0; j < nCols; j++)
             {
@@ -2461,40 +3947,17 @@ namespace NumeRe
                 fileData->at(j)->m_sUnit = headAndUnit.second;
             }
         }
-		else
-		{
-		    // If the file contains only one column,
-		    // then we'll use the file name as table
-		    // column head
-			if (nCols == 1)
-			{
+        else
+        {
+            // If the file contains only one column,
+            // then we'll use the file name as table
+            // column head
+            if (nCols == 1)
+            {
                 if (sFileName.find('/') == std::string::npos)
                     fileData->at(0)->m_sHeadLine = sFileName.substr(0, sFileName.rfind('.'));
                 else
                     fileData->at(0)->m_sHeadLine = sFileName.substr(sFileName.rfind('/')+1, sFileName.rfind('.')-1-sFileName.rfind('/'));
-			}
-		}
-
-		// Decode now the whole data table into single
-		// tokens, which can be distributed into their
-		// corresponding cells
-		for (size_t i = nComment; i < vFileData.size(); i++)
-        {
-            // Ignore empty lines
-            if (!vFileData[i].length())
-                continue;
-
-            // Tokenize the current line
-            std::vector<std::string> vTokens = tokenize(vFileData[i], std::string(1, cSep), GenericFile::CONSIDER_QMARKS);
-
-            // Decode each token
-            for (size_t j = 0; j < vTokens.size(); j++)
-            {
-                // Ensure that enough space is available
-                if (j >= nCols)
-                    break;
-
-                fileData->at(j)->setValue(i-nComment, vTokens[j]);
             }
         }
     }
@@ -3745,6 +5208,190 @@ namespace NumeRe
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief Static helper function returning a
+    /// chunk source for the XmlPullParser, which
+    /// inflates the currently opened item of the
+    /// passed zip file.
+    ///
+    /// \param _zip Zipfile&
+    /// \return XmlPullParser::ChunkSource
+    ///
+    /////////////////////////////////////////////////
+    static XmlPullParser::ChunkSource getZipItemSource(Zipfile& _zip)
+    {
+        return [&_zip](char* buffer, size_t nLength){return _zip.readItem(buffer, nLength);};
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to parse a
+    /// numerical spreadsheet value.
+    ///
+    /// \param sValue const std::string&
+    /// \param dValue double&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    static bool parseSpreadSheetValue(const std::string& sValue, double& dValue)
+    {
+        const char* pStart = sValue.data();
+        const char* pEnd = sValue.data() + sValue.length();
+
+        if (pStart < pEnd && *pStart == '+')
+            pStart++;
+
+        if (pStart >= pEnd)
+            return false;
+
+        fast_float::from_chars_result res = fast_float::from_chars(pStart, pEnd, dValue);
+        return res.ec == std::errc() && res.ptr == pEnd;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to convert a
+    /// numerical or date-time spreadsheet value into
+    /// a string, which is understood by the
+    /// automatic conversion of string columns.
+    ///
+    /// \param dValue double
+    /// \param isDateTime bool
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+    static std::string toSpreadSheetString(double dValue, bool isDateTime)
+    {
+        if (isDateTime)
+            return toString(to_timePoint(dValue), GET_MILLISECONDS | GET_FULL_PRECISION | GET_UNBIASED_TIME);
+
+        return toString(dValue, 15);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to replace a
+    /// numerical or date-time spreadsheet column
+    /// with a string column containing the same
+    /// values.
+    ///
+    /// \param col TblColPtr&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void toSpreadSheetStringColumn(TblColPtr& col)
+    {
+        bool isDateTimeCol = col->m_type == TableColumn::TYPE_DATETIME;
+        TableColumn* strCol = new StringColumn(col->size());
+
+        for (size_t i = 0; i < col->size(); i++)
+        {
+            if (col->isValid(i))
+                strCol->setValue(i, toSpreadSheetString(col->getValue(i).real(), isDateTimeCol));
+        }
+
+        col.reset(strCol);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to store a
+    /// numerical or date-time value in the passed
+    /// spreadsheet column. The column is created
+    /// with the passed size, if it does not exist
+    /// yet. A column, which already contains values
+    /// of another type, is turned into a string
+    /// column and left to the automatic conversion.
+    ///
+    /// \param col TblColPtr&
+    /// \param nRows size_t
+    /// \param nRow size_t
+    /// \param dValue double
+    /// \param isDateTime bool
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void setSpreadSheetValue(TblColPtr& col, size_t nRows, size_t nRow, double dValue, bool isDateTime)
+    {
+        if (!col)
+        {
+            if (isDateTime)
+                col.reset(new DateTimeColumn(nRows));
+            else
+                col.reset(new F64ValueColumn(nRows));
+        }
+
+        if ((col->m_type == TableColumn::TYPE_DATETIME) == isDateTime && col->m_type != TableColumn::TYPE_STRING)
+        {
+            col->setValue(nRow, dValue);
+            return;
+        }
+
+        if (col->m_type != TableColumn::TYPE_STRING)
+            toSpreadSheetStringColumn(col);
+
+        col->setValue(nRow, toSpreadSheetString(dValue, isDateTime));
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to store a
+    /// string in the passed spreadsheet column. A
+    /// column, which already contains numerical or
+    /// date-time values, is turned into a string
+    /// column and left to the automatic conversion.
+    ///
+    /// \param col TblColPtr&
+    /// \param nRow size_t
+    /// \param sValue const std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void setSpreadSheetString(TblColPtr& col, size_t nRow, const std::string& sValue)
+    {
+        if (!col)
+            col.reset(new StringColumn);
+        else if (col->m_type != TableColumn::TYPE_STRING)
+            toSpreadSheetStringColumn(col);
+
+        col->setValue(nRow, sValue);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to complete the
+    /// columns of a streamed spreadsheet. Missing
+    /// columns are created as empty string columns,
+    /// the preallocated rows are removed and the
+    /// collected table column heads are separated
+    /// from their units. The number of rows is
+    /// extended to the longest column.
+    ///
+    /// \param fileData TableColumnArray&
+    /// \param vHeadLines const std::vector<std::string>&
+    /// \param nRows int64_t&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void finalizeSpreadSheet(TableColumnArray& fileData, const std::vector<std::string>& vHeadLines, int64_t& nRows)
+    {
+        for (size_t j = 0; j < fileData.size(); j++)
+        {
+            TblColPtr& col = fileData[j];
+
+            if (!col)
+                col.reset(new StringColumn);
+            else
+                col->shrink();
+
+            std::pair<std::string,std::string> headAndUnit = findAndParseUnit(vHeadLines[j]);
+            col->m_sHeadLine = headAndUnit.first;
+            col->m_sUnit = headAndUnit.second;
+            nRows = (int64_t)col->size() > nRows ? col->size() : nRows;
+        }
+    }
+
+
     //////////////////////////////////////////////
     // class OpenDocumentSpreadSheet
     //////////////////////////////////////////////
@@ -3761,103 +5408,193 @@ namespace NumeRe
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to read the
+    /// text of an ODS cell, whose start element has
+    /// just been read. The paragraphs are joined
+    /// with line breaks and the space, tabulator and
+    /// line break elements are resolved. Annotations
+    /// are ignored. Returns false, if the cell does
+    /// not contain any paragraph.
+    ///
+    /// \param parser XmlPullParser&
+    /// \param sText std::string&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    static bool readOdsCellText(XmlPullParser& parser, std::string& sText)
+    {
+        size_t nCellDepth = parser.getDepth();
+        size_t nParagraphDepth = 0;
+        size_t nParagraphs = 0;
+        XmlPullParser::Event event;
+        sText.clear();
+
+        while ((event = parser.next()) != XmlPullParser::END_DOCUMENT)
+        {
+            if (event == XmlPullParser::END_ELEMENT)
+            {
+                if (parser.getDepth() == nCellDepth)
+                    break;
+
+                if (parser.getDepth() == nParagraphDepth)
+                    nParagraphDepth = 0;
+            }
+            else if (event == XmlPullParser::TEXT)
+            {
+                if (nParagraphDepth)
+                    sText += parser.getText();
+            }
+            else if (parser.getName() == "office:annotation")
+                parser.skipElement();
+            else if (!nParagraphDepth)
+            {
+                if (parser.getName() == "text:p")
+                {
+                    if (nParagraphs++)
+                        sText += "\n";
+
+                    nParagraphDepth = parser.getDepth();
+                }
+            }
+            else if (parser.getName() == "text:s")
+                sText.append(std::max(parser.getIntAttribute("text:c", 1), 1LL), ' ');
+            else if (parser.getName() == "text:tab")
+                sText += "\t";
+            else if (parser.getName() == "text:line-break")
+                sText += "\n";
+        }
+
+        return nParagraphs > 0;
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief This member function is used to read
     /// the targed file into the internal storage.
     /// ODS is a ZIP file containing the data
-    /// formatted as XML.
+    /// formatted as XML. The XML file is inflated
+    /// chunk-wise and pull-parsed twice: once to
+    /// determine the table sizes and once to read
+    /// the cells directly into the columns.
     ///
     /// \return void
     ///
     /////////////////////////////////////////////////
     void OpenDocumentSpreadSheet::readFile()
     {
-        std::string sODS;
+        Zipfile _zip;
 
-        // Get the contents of the embedded
-        // XML file
-        sODS = getZipFileItem("content.xml");
+        // Open the file in ZIP mode
+        if (!_zip.open(sFileName))
+            throw SyntaxError(SyntaxError::DATAFILE_NOT_EXIST, sFileName, SyntaxError::invalid_position, sFileName);
 
-        // Ensure that the embedded file is
-        // not empty
-        if (!sODS.length())
-            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
-
-        // Parse the XML file
-        tinyxml2::XMLDocument odsDocument;
-        odsDocument.Parse(sODS.c_str());
-
-        // Ensure again that the file is not empty and that
-        // the necessary elements are present
-        if (!odsDocument.FirstChildElement()
-            || !odsDocument.FirstChildElement()->FirstChildElement("office:body")
-            || !odsDocument.FirstChildElement()->FirstChildElement("office:body")->FirstChildElement()
-            || !odsDocument.FirstChildElement()->FirstChildElement("office:body")->FirstChildElement()->FirstChildElement("table:table"))
+        // Ensure that the embedded XML file
+        // exists
+        if (!_zip.openItem("content.xml"))
             throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
 
         std::vector<size_t> vTableSizes;
         std::vector<size_t> vCommentRows;
-
-        // Get the contained table section
-        tinyxml2::XMLElement* table = odsDocument.FirstChildElement()->FirstChildElement("office:body")
-                                                                     ->FirstChildElement()
-                                                                     ->FirstChildElement("table:table");
+        size_t nTableRows = 0;
 
         // Find the column count of every table as well as the needed number of
         // table head lines
-        do
         {
-            tinyxml2::XMLElement* row = table->FirstChildElement("table:table-row");
-            vTableSizes.push_back(0);
-            vCommentRows.push_back(0);
+            XmlPullParser parser(getZipItemSource(_zip));
+            XmlPullParser::Event event;
+            size_t nTableDepth = 0;
+            size_t nRowDepth = 0;
+            size_t nCellDepth = 0;
             bool isString = true;
+            bool isStringCell = true;
+            bool hasChildElement = false;
             size_t rowCount = 0;
+            size_t nRepeatSum = 0;
+            size_t nLastRepeat = 0;
 
-            // Read every row
-            while (row)
+            while ((event = parser.next()) != XmlPullParser::END_DOCUMENT)
             {
-                tinyxml2::XMLElement* cell = row->FirstChildElement();
-                size_t cellcount = 0;
-                rowCount++;
-
-                // Examine each cell
-                while (cell)
+                if (event == XmlPullParser::START_ELEMENT)
                 {
-                    // Interpret the repeating statement only if this is not the last cell
-                    // in this row
-                    if (cell->NextSiblingElement())
-                        cellcount += cell->IntAttribute("table:number-columns-repeated", 1);
-                    else
-                        cellcount++;
-
-                    if (!(cell->Attribute("office:value-type", "string")
-                        || cell->Attribute("table:number-columns-repeated")
-                        || !cell->FirstChildElement()))
-                        isString = false;
+                    if (nCellDepth)
+                        hasChildElement = true;
+                    else if (!nTableDepth)
+                    {
+                        if (parser.getName() == "table:table")
+                        {
+                            nTableDepth = parser.getDepth();
+                            vTableSizes.push_back(0);
+                            vCommentRows.push_back(0);
+                            isString = true;
+                            rowCount = 0;
+                        }
+                    }
+                    else if (!nRowDepth)
+                    {
+                        // Rows may also be part of header
+                        // rows or row groups
+                        if (parser.getName() == "table:table-row")
+                        {
+                            nRowDepth = parser.getDepth();
+                            nRepeatSum = 0;
+                            nLastRepeat = 0;
+                            rowCount++;
+                        }
+                    }
+                    else if (parser.getDepth() == nRowDepth+1)
+                    {
+                        // Examine each cell
+                        nCellDepth = parser.getDepth();
+                        nLastRepeat = parser.getIntAttribute("table:number-columns-repeated", 1);
+                        nRepeatSum += nLastRepeat;
+                        isStringCell = parser.getAttribute("office:value-type") == "string"
+                            || parser.findAttribute("table:number-columns-repeated");
+                        hasChildElement = false;
+                    }
+                }
+                else if (event == XmlPullParser::END_ELEMENT)
+                {
+                    if (parser.getDepth() == nCellDepth)
+                    {
+                        if (!(isStringCell || !hasChildElement))
+                            isString = false;
 
-                    cell = cell->NextSiblingElement();
-                }
+                        nCellDepth = 0;
+                    }
+                    else if (parser.getDepth() == nRowDepth)
+                    {
+                        // Interpret the repeating statement only if this is not the last cell
+                        // in this row
+                        size_t cellcount = nLastRepeat ? nRepeatSum - nLastRepeat + 1 : 0;
 
-                // Count comment rows
-                if (isString)
-                    vCommentRows.back()++;
+                        // Count comment rows
+                        if (isString)
+                            vCommentRows.back()++;
 
-                // Use the maximal number of cells
-                if (cellcount > vTableSizes.back())
-                    vTableSizes.back() = cellcount;
+                        // Use the maximal number of cells
+                        if (cellcount > vTableSizes.back())
+                            vTableSizes.back() = cellcount;
 
-                row = row->NextSiblingElement("table:table-row");
-            }
+                        nRowDepth = 0;
+                    }
+                    else if (parser.getDepth() == nTableDepth)
+                    {
+                        // String lines are only used complete as comments, if their consecutive number is
+                        // smaller than 4 or 10% of the total number of rows (whichever is larger)
+                        // Otherwise only the first line is used
+                        if (vCommentRows.back())
+                        {
+                            if (vCommentRows.back() >= std::max(4.0, 0.1*rowCount))
+                                vCommentRows.back() = 1;
+                        }
 
-            // String lines are only used complete as comments, if their consecutive number is
-            // smaller than 4 or 10% of the total number of rows (whichever is larger)
-            // Otherwise only the first line is used
-            if (vCommentRows.back())
-            {
-                if (vCommentRows.back() >= std::max(4.0, 0.1*rowCount))
-                    vCommentRows.back() = 1;
+                        nTableRows = std::max(nTableRows, rowCount - std::min(rowCount, vCommentRows.back()));
+                        nTableDepth = 0;
+                    }
+                }
             }
-        } while ((table = table->NextSiblingElement("table:table")));
+        }
 
         // Find the total amount of needed columns
         nCols = std::accumulate(vTableSizes.begin(), vTableSizes.end(), 0);
@@ -3867,85 +5604,120 @@ namespace NumeRe
         if (!nCols)
             throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
 
-        // Prepare the table column array and create string columns
+        // Prepare the table column array. The columns
+        // are created with the type of their first
+        // value
         createStorage();
 
-        for (long long int i = 0; i < nCols; i++)
-            fileData->at(i).reset(new StringColumn);
-
-        // Return to the first table
-        table = odsDocument.FirstChildElement()->FirstChildElement("office:body")
-                                               ->FirstChildElement()
-                                               ->FirstChildElement("table:table");
+        std::vector<std::string> vHeadLines(nCols);
 
-        size_t nTableId = 0;
-        size_t nOffSet = 0;
+        // Return to the beginning of the XML file
+        if (!_zip.openItem("content.xml"))
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
 
         // Read and parse every table in the file
-        do
         {
-            tinyxml2::XMLElement* row = table->FirstChildElement("table:table-row");
+            XmlPullParser parser(getZipItemSource(_zip));
+            XmlPullParser::Event event;
+            size_t nTableDepth = 0;
+            size_t nRowDepth = 0;
+            size_t nTableId = 0;
+            size_t nOffSet = 0;
             size_t rowCount = 0;
+            size_t colCount = 0;
+            std::string sText;
+            double dValue;
 
-            // Read every row
-            while (row)
+            while ((event = parser.next()) != XmlPullParser::END_DOCUMENT)
             {
-                tinyxml2::XMLElement* cell = row->FirstChildElement();
-                int colCount = 0;
-
-                // Examine each cell
-                while (cell)
+                if (event == XmlPullParser::START_ELEMENT)
                 {
-                    // Does this row still belong to the previously identified
-                    // table headlines?
-                    if (vCommentRows[nTableId])
+                    if (!nTableDepth)
                     {
-                        // Ensure that it contains the text element and write
-                        // that to the current columns headline
-                        if (cell->FirstChildElement("text:p"))
+                        if (parser.getName() == "table:table" && nTableId < vTableSizes.size())
                         {
-                            if (fileData->at(colCount + nOffSet)->m_sHeadLine.length())
-                                fileData->at(colCount + nOffSet)->m_sHeadLine += "\n";
-
-                            fileData->at(colCount + nOffSet)->m_sHeadLine += utf8parser(cell->FirstChildElement("text:p")->GetText());
+                            nTableDepth = parser.getDepth();
+                            rowCount = 0;
                         }
                     }
-                    else
+                    else if (!nRowDepth)
                     {
-                        // Some data types need some special pre-processing
-                        if (cell->Attribute("office:value-type", "string"))
-                            fileData->at(colCount + nOffSet)->setValue(rowCount, utf8parser(cell->FirstChildElement()->GetText()));
-                        else if (cell->Attribute("office:value-type", "boolean"))
-                            fileData->at(colCount + nOffSet)->setValue(rowCount, cell->Attribute("office:boolean-value"));
-                        else if (cell->FirstChildElement("text:p"))
-                            fileData->at(colCount + nOffSet)->setValue(rowCount, cell->FirstChildElement("text:p")->GetText());
+                        if (parser.getName() == "table:table-row")
+                        {
+                            nRowDepth = parser.getDepth();
+                            colCount = 0;
+                        }
                     }
+                    else if (parser.getDepth() == nRowDepth+1)
+                    {
+                        size_t nRepeat = parser.getIntAttribute("table:number-columns-repeated", 1);
+                        std::string sValueType = parser.getAttribute("office:value-type");
+                        std::string sOfficeValue = parser.getAttribute(sValueType == "boolean" ? "office:boolean-value" : "office:value");
+                        bool hasText = readOdsCellText(parser, sText);
 
-                    colCount += cell->IntAttribute("table:number-columns-repeated", 1);
-                    cell = cell->NextSiblingElement();
-                }
+                        if (colCount + nOffSet < (size_t)nCols)
+                        {
+                            // Does this row still belong to the previously identified
+                            // table headlines?
+                            if (vCommentRows[nTableId])
+                            {
+                                // Ensure that it contains the text element and write
+                                // that to the current columns headline
+                                if (hasText)
+                                {
+                                    if (vHeadLines[colCount + nOffSet].length())
+                                        vHeadLines[colCount + nOffSet] += "\n";
 
-                if (vCommentRows[nTableId])
-                    vCommentRows[nTableId]--;
-                else
-                    rowCount++;
+                                    vHeadLines[colCount + nOffSet] += utf8parser(sText);
+                                }
+                            }
+                            else
+                            {
+                                TblColPtr& col = fileData->at(colCount + nOffSet);
 
-                row = row->NextSiblingElement("table:table-row");
-            }
+                                // Some data types need some special pre-processing
+                                if (sValueType == "string")
+                                {
+                                    if (hasText)
+                                        setSpreadSheetString(col, rowCount, utf8parser(sText));
+                                }
+                                else if (sValueType == "boolean")
+                                    setSpreadSheetString(col, rowCount, sOfficeValue);
+                                else if ((sValueType == "float" || sValueType == "percentage" || sValueType == "currency")
+                                         && parseSpreadSheetValue(sOfficeValue, dValue))
+                                    setSpreadSheetValue(col, nTableRows, rowCount, dValue, false);
+                                else if (hasText)
+                                    setSpreadSheetString(col, rowCount, sText);
+                            }
+                        }
+
+                        colCount += nRepeat;
+                    }
+                }
+                else if (event == XmlPullParser::END_ELEMENT)
+                {
+                    if (parser.getDepth() == nRowDepth)
+                    {
+                        if (vCommentRows[nTableId])
+                            vCommentRows[nTableId]--;
+                        else
+                            rowCount++;
 
-            nOffSet += vTableSizes[nTableId];
-            nTableId++;
-        } while ((table = table->NextSiblingElement("table:table")));
+                        nRowDepth = 0;
+                    }
+                    else if (parser.getDepth() == nTableDepth)
+                    {
+                        nOffSet += vTableSizes[nTableId];
+                        nTableId++;
+                        nTableDepth = 0;
+                    }
+                }
+            }
+        }
 
         // Now calculate the total number of rows in this data set and
         // separate column headers and their units
-        for (TblColPtr& col : *fileData)
-        {
-            std::pair<std::string,std::string> headAndUnit = findAndParseUnit(col->m_sHeadLine);
-            col->m_sHeadLine = headAndUnit.first;
-            col->m_sUnit = headAndUnit.second;
-            nRows = col->size() > nRows ? col->size() : nRows;
-        }
+        finalizeSpreadSheet(*fileData, vHeadLines, nRows);
     }
 
 
@@ -4346,68 +6118,165 @@ namespace NumeRe
             || (formatString.find("m") != std::string::npos && !isTimeFormat(formatString));
     }
 
+    /////////////////////////////////////////////////
+    /// \brief This structure is a compact pool for
+    /// the shared strings of an XLSX workbook. All
+    /// strings are stored in a single buffer and
+    /// are addressed by their end offsets.
+    /////////////////////////////////////////////////
+    struct SharedStringPool
+    {
+        std::string m_sBuffer;
+        std::vector<size_t> m_vEnds;
+
+        /////////////////////////////////////////////////
+        /// \brief Append a new string to the pool.
+        ///
+        /// \param sString const std::string&
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void add(const std::string& sString)
+        {
+            m_sBuffer += sString;
+            m_vEnds.push_back(m_sBuffer.length());
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Get the string with the passed index
+        /// or an empty string, if the index is not
+        /// part of the pool.
+        ///
+        /// \param i long long int
+        /// \return std::string
+        ///
+        /////////////////////////////////////////////////
+        std::string get(long long int i) const
+        {
+            if (i < 0 || i >= (long long int)m_vEnds.size())
+                return "";
+
+            size_t nStart = i ? m_vEnds[i-1] : 0;
+            return m_sBuffer.substr(nStart, m_vEnds[i] - nStart);
+        }
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to read the
+    /// text of a rich text or an inline string
+    /// element in an XLSX file, whose start element
+    /// has just been read. The text of all runs is
+    /// concatenated, phonetic runs are ignored.
+    ///
+    /// \param parser XmlPullParser&
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+    static std::string readXlsxStringItem(XmlPullParser& parser)
+    {
+        size_t nDepth = parser.getDepth();
+        std::string sText;
+        XmlPullParser::Event event;
+
+        while ((event = parser.next()) != XmlPullParser::END_DOCUMENT)
+        {
+            if (event == XmlPullParser::END_ELEMENT && parser.getDepth() == nDepth)
+                break;
+
+            if (event != XmlPullParser::START_ELEMENT)
+                continue;
+
+            if (parser.getLocalName() == "t")
+                sText += parser.readElementText();
+            else if (parser.getLocalName() == "rPh")
+                parser.skipElement();
+        }
+
+        return sText;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to append a
+    /// string to a table column head, if it is not
+    /// already equal to it.
+    ///
+    /// \param sHeadLine std::string&
+    /// \param sEntry const std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void appendSpreadSheetHeadLine(std::string& sHeadLine, const std::string& sEntry)
+    {
+        if (!sHeadLine.length())
+            sHeadLine = sEntry;
+        else if (sHeadLine != sEntry)
+            sHeadLine += "\n" + sEntry;
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief This member function is used to read
     /// the data from the XLSX spreadsheet into the
     /// internal storage. XLSX is a ZIP file
-    /// containing the data formatted as XML.
+    /// containing the data formatted as XML. The
+    /// XML files are inflated chunk-wise and
+    /// pull-parsed, so that the cells are read
+    /// directly into the columns. The shared
+    /// strings are kept in a compact string pool.
     ///
     /// \return void
     ///
     /////////////////////////////////////////////////
     void XLSXSpreadSheet::readFile()
     {
+        enum CellFormat
+        {
+            FMT_NONE,
+            FMT_DATE,
+            FMT_TIME
+        };
+
+        struct SheetInfo
+        {
+            int nRowmin = 0, nRowmax = 0;
+            int nColmin = 0, nColmax = 0;
+            long long int nCommentLines = 0;
+            bool isEmpty = true;
+        };
+
         size_t nSheets = 0;
         long long int nExcelLines = 0;
         long long int nExcelCols = 0;
         long long int nOffset = 0;
-        int nRow = 0, nCol = 0;
-        int nRowmin = 0, nRowmax = 0;
-        int nColmin = 0, nColmax = 0;
-        bool bBreakSignal = false;
 
         const int MAXXLSXCOLS = 16384;
 
-        std::vector<long long int> vCommentLines;
-        std::string sEntry;
-        std::string sSheetContent;
-        std::string sStringsContent;
-        std::string sCellLocation;
-
-        // We use TinyXML-2 as XML libary in this case
-        tinyxml2::XMLDocument _workbook;
-        tinyxml2::XMLDocument _sheet;
-        tinyxml2::XMLDocument _strings;
-        tinyxml2::XMLDocument _styles;
-        tinyxml2::XMLNode* _node;
-        tinyxml2::XMLElement* _element;
-        tinyxml2::XMLElement* _stringelement;
-
-        // Get the content of the workbool XML file
-        sEntry = getZipFileItem("xl/workbook.xml");
+        std::vector<SheetInfo> vSheets;
+        XmlPullParser::Event event;
+        Zipfile _zip;
+
+        // Open the file in ZIP mode
+        if (!_zip.open(sFileName))
+            throw SyntaxError(SyntaxError::DATAFILE_NOT_EXIST, sFileName, SyntaxError::invalid_position, sFileName);
 
         // Ensure that a workbook XML is available
-        if (!sEntry.length())
+        if (!_zip.openItem("xl/workbook.xml"))
             throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
 
         // Parse the file to obtain the number of
         // sheets, which are associated with this
         // workbook
-        _workbook.Parse(sEntry.c_str());
-
-        // Ensure that we could parse the file correctly
-        if (_workbook.ErrorID())
-            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
-
-        // Search the first child of the "sheets" node
-        // in the current workbook and count all siblings
-        _node = _workbook.FirstChildElement()->FirstChildElement("sheets")->FirstChild();
-
-        if (_node)
-            nSheets++;
+        {
+            XmlPullParser parser(getZipItemSource(_zip));
 
-        while ((_node = _node->NextSibling()))
-            nSheets++;
+            while ((event = parser.next()) != XmlPullParser::END_DOCUMENT)
+            {
+                if (event == XmlPullParser::START_ELEMENT && parser.getDepth() == 3 && parser.getLocalName() == "sheet")
+                    nSheets++;
+            }
+        }
 
         // Ensure that we have at least one sheet in
         // the workbook
@@ -4415,358 +6284,396 @@ namespace NumeRe
             throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
 
         // Walk through the sheets and extract the
-        // dimension info
+        // dimension info. Only the beginning of the
+        // sheet data is read in this step
         for (size_t i = 0; i < nSheets; i++)
         {
-            // Get the file contents of the current
-            // sheet
-            sSheetContent = getZipFileItem("xl/worksheets/sheet"+toString(i+1)+".xml");
-
-            // Ensure that the sheet is not empty
-            if (!sSheetContent.length())
+            // Ensure that the sheet exists
+            if (!_zip.openItem("xl/worksheets/sheet"+toString(i+1)+".xml"))
                 throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
 
-            // Parse the sheet and catch parsing
-            // errors
-            _sheet.Parse(sSheetContent.c_str());
-
-            if (_sheet.ErrorID())
-                throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
-
-            // Get the dimensions of the current sheet
-            _element = _sheet.FirstChildElement()->FirstChildElement("dimension");
-            sCellLocation = _element->Attribute("ref");
-
-            // Determine the dimensions of this sheet
-            evalIndices(sCellLocation.substr(0, sCellLocation.find(':')), nRowmin, nColmin);
-            evalIndices(sCellLocation.substr(sCellLocation.find(':') + 1), nRowmax, nColmax);
-            tinyxml2::XMLElement* cols = _sheet.FirstChildElement()->FirstChildElement("cols");
+            XmlPullParser parser(getZipItemSource(_zip));
+            vSheets.push_back(SheetInfo());
+            SheetInfo& sheet = vSheets.back();
+            bool hasDimension = false;
+            bool isInSheetData = false;
+            bool bBreakSignal = false;
+            int currentRow = 0;
 
-            // We use the columns identifiers to check and probably
-            // update the necessary columns
-            if (cols && cols->FirstChildElement())
+            while (!bBreakSignal && (event = parser.next()) != XmlPullParser::END_DOCUMENT)
             {
-                cols = cols->FirstChildElement();
+                if (event == XmlPullParser::END_ELEMENT && isInSheetData && parser.getLocalName() == "sheetData")
+                    break;
+
+                if (event != XmlPullParser::START_ELEMENT)
+                    continue;
 
-                do
+                if (!isInSheetData)
                 {
-                    if (cols->IntAttribute("max") > nColmax+1
-                        && (nColmax+1 + 100 >= MAXXLSXCOLS || cols->IntAttribute("max") != MAXXLSXCOLS))
-                        nColmax = cols->IntAttribute("max")-1;
+                    // Determine the dimensions of this sheet
+                    if (parser.getLocalName() == "dimension")
+                    {
+                        std::string sCellLocation = parser.getAttribute("ref");
+                        evalIndices(sCellLocation.substr(0, sCellLocation.find(':')), sheet.nRowmin, sheet.nColmin);
+                        evalIndices(sCellLocation.substr(sCellLocation.find(':') + 1), sheet.nRowmax, sheet.nColmax);
+                        hasDimension = true;
+                    }
+                    else if (parser.getLocalName() == "col")
+                    {
+                        // We use the columns identifiers to check and probably
+                        // update the necessary columns
+                        int nMax = parser.getIntAttribute("max");
 
-                } while ((cols = cols->NextSiblingElement()));
-            }
+                        if (nMax > sheet.nColmax+1
+                            && (sheet.nColmax+1 + 100 >= MAXXLSXCOLS || nMax != MAXXLSXCOLS))
+                            sheet.nColmax = nMax-1;
+                    }
+                    else if (parser.getLocalName() == "sheetData")
+                    {
+                        if (!hasDimension)
+                            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
 
-            vCommentLines.push_back(0);
+                        isInSheetData = true;
+                    }
 
-            // Search the data section of the sheet
-            _node = _sheet.FirstChildElement()->FirstChildElement("sheetData")->FirstChild();
+                    continue;
+                }
 
-            if (!_node)
-                continue;
+                if (parser.getLocalName() != "row")
+                    continue;
 
-            // Find pure textual lines in the current
-            // sheet, which will be used as table column
-            // heads
-            do
-            {
-                // Find the next cell
-                int currentRow = _node->ToElement()->IntAttribute("r");
-                _element = _node->ToElement()->FirstChildElement("c");
+                // Find pure textual lines in the current
+                // sheet, which will be used as table column
+                // heads
+                sheet.isEmpty = false;
+                currentRow = parser.getIntAttribute("r", currentRow+1);
+                size_t nRowDepth = parser.getDepth();
 
-                // Row does not contain any cells
-                if (!_element)
+                while ((event = parser.next()) != XmlPullParser::END_DOCUMENT)
                 {
-                    vCommentLines[i] = currentRow;
-                    continue;
-                }
+                    if (event == XmlPullParser::END_ELEMENT && parser.getDepth() == nRowDepth)
+                        break;
 
-                size_t cellCount = 0;
+                    if (event != XmlPullParser::START_ELEMENT || parser.getLocalName() != "c")
+                        continue;
 
-                do
-                {
-                    cellCount++;
+                    const std::string* sType = parser.findAttribute("t");
+                    size_t nCellDepth = parser.getDepth();
+                    bool hasChildElement = false;
 
-                    if (_element->Attribute("t"))
+                    // If the attribute signalizes a
+                    // non-string element, we abort here
+                    if (sType && *sType != "s" && *sType != "inlineStr")
+                        bBreakSignal = true;
+
+                    while ((event = parser.next()) != XmlPullParser::END_DOCUMENT)
                     {
-                        // If the attribute signalizes a
-                        // non-string element, we abort here
-                        if (_element->Attribute("t") != std::string("s"))
-                        {
-                            bBreakSignal = true;
+                        if (event == XmlPullParser::END_ELEMENT && parser.getDepth() == nCellDepth)
                             break;
+
+                        if (event == XmlPullParser::START_ELEMENT)
+                        {
+                            hasChildElement = true;
+                            parser.skipElement();
                         }
                     }
-                    else if (_element->FirstChildElement()) // Ensure that the cell is not empty
-                    {
+
+                    // Ensure that the cell is not empty
+                    if (!sType && hasChildElement)
                         bBreakSignal = true;
+
+                    if (bBreakSignal)
                         break;
-                    }
                 }
-                while ((_element = _element->NextSiblingElement()));
 
                 // Only use the first row as headline candidates
                 if (!bBreakSignal)
-                    vCommentLines[i] = currentRow;
-
-                // Search for the first nearly complete line of strings
-                if (bBreakSignal)// || 4/3.0 * cellCount >= nColmax-nColmin+1)
-                    break;
+                    sheet.nCommentLines = currentRow;
             }
-            while ((_node = _node->NextSibling()));
-
-            bBreakSignal = false;
 
             // String lines are only used complete as comments, if their consecutive number is
             // smaller than 4 or 10% of the total number of rows (whichever is larger)
             // Otherwise only the first line is used
-            if (vCommentLines[i])
+            if (sheet.nCommentLines)
             {
-                if (vCommentLines[i] - nRowmin >= std::max(4.0, 0.1*(nRowmax-nRowmin+1)))
-                    vCommentLines[i] = nRowmin;
+                if (sheet.nCommentLines - sheet.nRowmin >= std::max(4.0, 0.1*(sheet.nRowmax-sheet.nRowmin+1)))
+                    sheet.nCommentLines = sheet.nRowmin;
             }
 
+            if (sheet.isEmpty)
+                continue;
+
             // Calculate the maximal number of needed
             // rows to store all sheets next to each
             // other
-            if (nExcelLines < nRowmax-nRowmin+1-vCommentLines[i])
-                nExcelLines = nRowmax-nRowmin+1-vCommentLines[i];
+            if (nExcelLines < sheet.nRowmax-sheet.nRowmin+1-sheet.nCommentLines)
+                nExcelLines = sheet.nRowmax-sheet.nRowmin+1-sheet.nCommentLines;
 
             // Add the number of columns to the total
             // number of columns
-            nExcelCols += nColmax-nColmin+1;
+            nExcelCols += sheet.nColmax-sheet.nColmin+1;
 
-            g_logger.debug("headlines=" + toString(vCommentLines[i]));
+            g_logger.debug("headlines=" + toString(sheet.nCommentLines));
         }
 
         // Set the dimensions of the final table
         nRows = nExcelLines;
         nCols = nExcelCols;
 
-        // Allocate the memory
+        // Allocate the memory. The columns are created
+        // with the type of their first value
         createStorage();
 
-        // We create a text-only table first
-        for (long long int j = 0; j < nCols; j++)
-        {
-            fileData->at(j).reset(new StringColumn);
-        }
+        if (!fileData)
+            return;
 
-        // Walk through the sheets and extract the
-        // contents to memory
-        //
-        // Get the contents of the shared strings
-        // XML file and parse it
-        sStringsContent = getZipFileItem("xl/sharedStrings.xml");
-        _strings.Parse(sStringsContent.c_str());
-        std::string sStylesContent = getZipFileItem("xl/styles.xml");
-        _styles.Parse(sStylesContent.c_str());
-        tinyxml2::XMLElement* cellXfs = _styles.FirstChildElement()->FirstChildElement("cellXfs");
+        std::vector<std::string> vHeadLines(nCols);
 
         // Initialize Set with Standard Excel Time IDs: 18..21, 45..47
         static const std::set<int> vStandardTimeIds = {18, 19, 20, 21, 45, 46, 47};
         // Initialize Set with Standard Excel Date IDs (14..17):
         static const std::set<int> vStandardDateIds = {14, 15, 16, 17, 22};
 
-        // Parse through styles.xml to get numfmts
-        // Iterate through nodes
-        tinyxml2::XMLElement* numFmts = _styles.FirstChildElement()->FirstChildElement("numFmts");
-
         // Empty set to store numFmts ID that corresponds to Time
         std::set<int> vTimeIds;
         // Empty set to store numFmts ID that corresponds to Date
         std::set<int> vDateIds;
+        // The number format IDs of the cell styles
+        std::vector<int> vStyleFormatIds;
 
-        // Dynamically check _styles.xml for numFmtId
-        if (numFmts)
+        // Parse through styles.xml to get numfmts
+        // and the cell styles
+        if (_zip.openItem("xl/styles.xml"))
         {
-            numFmts = numFmts->FirstChildElement();
+            XmlPullParser parser(getZipItemSource(_zip));
+            bool isInCellXfs = false;
 
-            while (numFmts)
+            while ((event = parser.next()) != XmlPullParser::END_DOCUMENT)
             {
-                int id = numFmts->IntAttribute("numFmtId");
-                std::string formatString = numFmts->Attribute("formatCode");
+                if (event == XmlPullParser::END_ELEMENT && parser.getLocalName() == "cellXfs")
+                    isInCellXfs = false;
+
+                if (event != XmlPullParser::START_ELEMENT)
+                    continue;
 
-                // Detect time format, if yes, push Id to empty set
-                if (isTimeFormat(formatString))
-                    vTimeIds.insert(id); // Insert into set
+                if (parser.getLocalName() == "numFmt")
+                {
+                    int id = parser.getIntAttribute("numFmtId");
+                    std::string formatString = parser.getAttribute("formatCode");
 
-                // Detect date format, if yes, push Id to empty set
-                if (isDateFormat(formatString))
-                    vDateIds.insert(id); // Insert into set
+                    // Detect time format, if yes, push Id to empty set
+                    if (isTimeFormat(formatString))
+                        vTimeIds.insert(id); // Insert into set
 
-                numFmts = numFmts->NextSiblingElement();
+                    // Detect date format, if yes, push Id to empty set
+                    if (isDateFormat(formatString))
+                        vDateIds.insert(id); // Insert into set
+                }
+                else if (parser.getLocalName() == "cellXfs")
+                    isInCellXfs = true;
+                else if (isInCellXfs && parser.getLocalName() == "xf")
+                    vStyleFormatIds.push_back(parser.getIntAttribute("numFmtId", -1));
             }
         }
 
-        // Go through all sheets
-        for (size_t i = 0; i < nSheets; i++)
+        // Decode the date and time formats of all
+        // cell styles
+        std::vector<CellFormat> vCellFormats(vStyleFormatIds.size(), FMT_NONE);
+
+        for (size_t n = 0; n < vStyleFormatIds.size(); n++)
         {
-            // Get the file contents of the current
-            // sheet and parse it
-            sSheetContent = getZipFileItem("xl/worksheets/sheet"+toString(i+1)+".xml");
-            _sheet.Parse(sSheetContent.c_str());
+            int styleId = vStyleFormatIds[n];
+
+            // Check if styleId is in vTimeIds or vStandardTimeIds sets
+            bool isTime = vTimeIds.find(styleId) != vTimeIds.end()
+                || vStandardTimeIds.find(styleId) != vStandardTimeIds.end();
+            bool isDate = vDateIds.find(styleId) != vDateIds.end()
+                || vStandardDateIds.find(styleId) != vStandardDateIds.end();
+
+            // For purely Time characteristics with no Date characteristics, consign values
+            // to UNIX standards
+            if (isDate)
+                vCellFormats[n] = FMT_DATE;
+            else if (isTime)
+                vCellFormats[n] = FMT_TIME;
+        }
 
-            // Search the data section and the dimensions
-            // of the current sheet
-            _node = _sheet.FirstChildElement()->FirstChildElement("sheetData")->FirstChild();
-            _element = _sheet.FirstChildElement()->FirstChildElement("dimension");
+        // Read the shared strings into the string
+        // pool
+        SharedStringPool stringPool;
 
-            // Ensure that data is available
-            if (!_node)
-                continue;
+        if (_zip.openItem("xl/sharedStrings.xml"))
+        {
+            XmlPullParser parser(getZipItemSource(_zip));
 
-            // Extract the target indices
-            sCellLocation = _element->Attribute("ref");
-            evalIndices(sCellLocation.substr(0, sCellLocation.find(':')), nRowmin, nColmin);
-            evalIndices(sCellLocation.substr(sCellLocation.find(':')+1), nRowmax, nColmax);
+            while ((event = parser.next()) != XmlPullParser::END_DOCUMENT)
+            {
+                if (event == XmlPullParser::START_ELEMENT && parser.getLocalName() == "si")
+                    stringPool.add(utf8parser(readXlsxStringItem(parser)));
+            }
+        }
 
-            tinyxml2::XMLElement* cols = _sheet.FirstChildElement()->FirstChildElement("cols");
+        static const double epochOffset = to_double(StrToTime("1899-12-30"));
 
-            if (cols && cols->FirstChildElement())
-            {
-                cols = cols->FirstChildElement();
+        // Go through all sheets
+        for (size_t i = 0; i < nSheets; i++)
+        {
+            const SheetInfo& sheet = vSheets[i];
 
-                do
-                {
-                    if (cols->IntAttribute("max") > nColmax+1
-                        && (nColmax+1 + 100 >= MAXXLSXCOLS || cols->IntAttribute("max") != MAXXLSXCOLS))
-                        nColmax = cols->IntAttribute("max")-1;
+            // Ensure that data is available
+            if (sheet.isEmpty)
+                continue;
 
-                } while ((cols = cols->NextSiblingElement()));
-            }
+            if (!_zip.openItem("xl/worksheets/sheet"+toString(i+1)+".xml"))
+                throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+            XmlPullParser parser(getZipItemSource(_zip));
+            bool isInSheetData = false;
+            int currentRow = 0;
+            int nRow = 0, nCol = 0;
+            std::string sValue;
+            double dValue;
 
             // Go through each cell and store its
             // value at the correct position in the
             // final table. If we hit a textual cell,
             // then we store its contents as a table
             // column head
-            do
+            while ((event = parser.next()) != XmlPullParser::END_DOCUMENT)
             {
-                _element = _node->ToElement()->FirstChildElement("c");
+                if (event == XmlPullParser::END_ELEMENT && isInSheetData && parser.getLocalName() == "sheetData")
+                    break;
 
-                // Does not contain any cells
-                if (!_element)
+                if (event != XmlPullParser::START_ELEMENT)
                     continue;
 
-                // Go through the cells of the current
-                // row
-                do
+                if (!isInSheetData)
                 {
-                    sCellLocation = _element->Attribute("r");
-                    evalIndices(sCellLocation, nRow, nCol);
-                    nCol -= nColmin;
-                    nRow -= nRowmin;
+                    isInSheetData = parser.getLocalName() == "sheetData";
+                    continue;
+                }
 
-                    if (nCol+nOffset >= nCols)
-                        continue;
+                if (parser.getLocalName() == "row")
+                {
+                    currentRow = parser.getIntAttribute("r", currentRow+1);
+                    nCol = -1;
+                    continue;
+                }
 
-                    // catch textual cells and store them
-                    // in the corresponding table column
-                    // head
-                    if (_element->Attribute("t") && _element->Attribute("t") == std::string("s"))
-                    {
-                        //Handle text
-                        int nPos = 0;
-                        _element->FirstChildElement("v")->QueryIntText(&nPos);
-                        _stringelement = _strings.FirstChildElement()->FirstChildElement("si");
+                if (parser.getLocalName() != "c")
+                    continue;
 
-                        for (int k = 1; k <= nPos; k++)
-                        {
-                            _stringelement = _stringelement->NextSiblingElement();
-                        }
+                // Determine the cell position. The
+                // reference is optional
+                const std::string* sCellLocation = parser.findAttribute("r");
+                nRow = currentRow-1;
+                nCol++;
 
-                        if (_stringelement->FirstChildElement()->FirstChild()
-			    && _stringelement->FirstChildElement()->FirstChild()->ToText())
-                            sEntry = utf8parser(_stringelement->FirstChildElement()->FirstChild()->ToText()->Value());
-                        else
-                            sEntry.clear();
+                if (sCellLocation)
+                    evalIndices(*sCellLocation, nRow, nCol);
 
-                        // If the string is not empty, then
-                        // we'll add it to the correct table
-                        // column head
-                        if (sEntry.length())
-                        {
-                            if (nRow - vCommentLines[i] < 0)
-                            {
-                                if (!fileData->at(nCol+nOffset)->m_sHeadLine.length())
-                                    fileData->at(nCol+nOffset)->m_sHeadLine = sEntry;
-                                else if (fileData->at(nCol+nOffset)->m_sHeadLine != sEntry)
-                                    fileData->at(nCol+nOffset)->m_sHeadLine += "\n" + sEntry;
-                            }
-                            else
-                                fileData->at(nCol+nOffset)->setValue(nRow-vCommentLines[i], sEntry);
-                        }
+                std::string sType = parser.getAttribute("t");
+                long long int nStyle = parser.getIntAttribute("s", -1);
+                size_t nCellDepth = parser.getDepth();
+                bool hasValue = false;
+                sValue.clear();
 
+                // Read the value or the inline string
+                // of the current cell
+                while ((event = parser.next()) != XmlPullParser::END_DOCUMENT)
+                {
+                    if (event == XmlPullParser::END_ELEMENT && parser.getDepth() == nCellDepth)
+                        break;
+
+                    if (event != XmlPullParser::START_ELEMENT)
                         continue;
+
+                    if (parser.getLocalName() == "v")
+                    {
+                        sValue = parser.readElementText();
+                        hasValue = true;
                     }
-                    else if (_element->FirstChildElement("v") && _element->FirstChildElement("v")->GetText())
+                    else if (parser.getLocalName() == "is")
                     {
-                        std::string sValue = utf8parser(_element->FirstChildElement("v")->GetText());
+                        sValue = readXlsxStringItem(parser);
+                        hasValue = true;
+                    }
+                    else
+                        parser.skipElement();
+                }
 
-                        // Decode styles
-                        if (_element->Attribute("t") && _element->Attribute("t") == std::string("b"))
-                            sValue = sValue == "0" ? "false" : "true";
-                        else if (_element->Attribute("s") && cellXfs && cellXfs->FirstChildElement())
-                        {
-                            // Style ID
-                            int styleId = _element->IntAttribute("s");
-                            tinyxml2::XMLElement* style = cellXfs->FirstChildElement();
+                long long int nTargetCol = nCol - sheet.nColmin + nOffset;
+                long long int nTargetRow = nRow - sheet.nRowmin - sheet.nCommentLines;
 
-                            // Find the correct style ID
-                            while (styleId && style)
-                            {
-                                style = style->NextSiblingElement();
-                                styleId--;
-                            }
+                if (nCol < sheet.nColmin || nTargetCol >= nCols || nRow < sheet.nRowmin || !hasValue)
+                    continue;
 
-                            if (!styleId && style && style->Attribute("numFmtId"))
-                            {
-                                styleId = style->IntAttribute("numFmtId");
+                TblColPtr& col = fileData->at(nTargetCol);
+
+                // catch textual cells and store them
+                // in the corresponding table column
+                // head
+                if (sType == "s" || sType == "inlineStr")
+                {
+                    //Handle text
+                    std::string sEntry = sType == "s" ? stringPool.get(StrToInt(sValue)) : utf8parser(sValue);
+
+                    // If the string is not empty, then
+                    // we'll add it to the correct table
+                    // column head
+                    if (sEntry.length())
+                    {
+                        if (nTargetRow < 0)
+                            appendSpreadSheetHeadLine(vHeadLines[nTargetCol], sEntry);
+                        else
+                            setSpreadSheetString(col, nTargetRow, sEntry);
+                    }
 
+                    continue;
+                }
 
-                                // Check if styleId is in vTimeIds or vStandardTimeIds sets
-                                bool isTime = vTimeIds.find(styleId) != vTimeIds.end()
-                                    || vStandardTimeIds.find(styleId) != vStandardTimeIds.end();
-                                bool isDate = vDateIds.find(styleId) != vDateIds.end()
-                                    || vStandardDateIds.find(styleId) != vStandardDateIds.end();
+                if (!sValue.length())
+                    continue;
 
-                                if (isDate || isTime)
-                                {
-                                    // For purely Time characteristics with no Date characteristics, consign values
-                                    // to UNIX standards
-                                    sValue = convertExcelTimeToEpoch(sValue, isTime && !isDate);
-                                }
-                            }
-                        }
+                // Decode styles
+                if (sType == "b")
+                    sValue = sValue == "0" ? "false" : "true";
+                else if (sType == "" || sType == "n")
+                {
+                    CellFormat format = nStyle >= 0 && nStyle < (long long int)vCellFormats.size() ? vCellFormats[nStyle] : FMT_NONE;
 
-                        // Write the decoded string to the table column array
-                        if (nRow - vCommentLines[i] < 0)
-                        {
-                            if (!fileData->at(nCol+nOffset)->m_sHeadLine.length())
-                                fileData->at(nCol+nOffset)->m_sHeadLine = sValue;
-                            else if (fileData->at(nCol+nOffset)->m_sHeadLine != sValue)
-                                fileData->at(nCol+nOffset)->m_sHeadLine += "\n" + sValue;
-                        }
+                    if (format == FMT_TIME)
+                        sValue = convertExcelTimeToEpoch(sValue, true);
+                    else if (parseSpreadSheetValue(sValue, dValue))
+                    {
+                        if (format == FMT_DATE)
+                            dValue = std::round((dValue*24*3600 + epochOffset + 24*3600*(dValue < 61)) * 1000.0) / 1000.0;
+
+                        // Write the decoded value to the table column array
+                        if (nTargetRow < 0)
+                            appendSpreadSheetHeadLine(vHeadLines[nTargetCol],
+                                                      format == FMT_DATE ? toSpreadSheetString(dValue, true) : sValue);
                         else
-                            fileData->at(nCol+nOffset)->setValue(nRow-vCommentLines[i], sValue);
+                            setSpreadSheetValue(col, nExcelLines, nTargetRow, dValue, format == FMT_DATE);
+
+                        continue;
                     }
                 }
-                while ((_element = _element->NextSiblingElement()));
+                else
+                    sValue = utf8parser(sValue);
+
+                // Write the decoded string to the table column array
+                if (nTargetRow < 0)
+                    appendSpreadSheetHeadLine(vHeadLines[nTargetCol], sValue);
+                else
+                    setSpreadSheetString(col, nTargetRow, sValue);
             }
-            while ((_node = _node->NextSibling()));
 
-            nOffset += nColmax-nColmin+1;
+            nOffset += sheet.nColmax-sheet.nColmin+1;
         }
 
         // Now separate column headers and their units
-        for (TblColPtr& col : *fileData)
-        {
-            std::pair<std::string,std::string> headAndUnit = findAndParseUnit(col->m_sHeadLine);
-            col->m_sHeadLine = headAndUnit.first;
-            col->m_sUnit = headAndUnit.second;
-            nRows = col->size() > nRows ? col->size() : nRows;
-        }
+        finalizeSpreadSheet(*fileData, vHeadLines, nRows);
     }
 
 
@@ -4774,38 +6681,32 @@ namespace NumeRe
     /// \brief This member function converts the
     /// usual Excel indices into numerical ones.
     ///
-    /// \param _sIndices const std::string&
+    /// \param sIndices const std::string&
     /// \param nLine int&
     /// \param nCol int&
     /// \return void
     ///
     /////////////////////////////////////////////////
-    void XLSXSpreadSheet::evalIndices(const std::string& _sIndices, int& nLine, int& nCol)
+    void XLSXSpreadSheet::evalIndices(const std::string& sIndices, int& nLine, int& nCol)
     {
-        //A1 -> IV65536
-        std::string sIndices = toUpperCase(_sIndices);
+        //A1 -> XFD1048576
+        int nColumn = 0;
+        size_t i = 0;
 
-        for (size_t i = 0; i < sIndices.length(); i++)
+        // Convert the column index. This index
+        // might be up to three characters long
+        for (; i < sIndices.length() && std::isalpha((unsigned char)sIndices[i]); i++)
         {
-            // Find the first character,
-            // which is a digit: that's a
-            // line index
-            if (isdigit(sIndices[i]))
-            {
-                // Convert the line index
-                nLine = StrToInt(sIndices.substr(i))-1;
+            nColumn = nColumn*26 + std::toupper((unsigned char)sIndices[i]) - 'A' + 1;
+        }
 
-                // Convert the column index.
-                // This index might be two
-                // characters long
-                if (i == 2)
-                    nCol = (sIndices[0]-'A'+1)*26+sIndices[1]-'A';
-                else if (i == 1)
-                    nCol = sIndices[0]-'A';
+        // Find the first character, which is a
+        // digit: that's a line index
+        if (!i || i >= sIndices.length() || !isdigit(sIndices[i]))
+            return;
 
-                break;
-            }
-        }
+        nLine = std::atoi(sIndices.c_str() + i)-1;
+        nCol = nColumn-1;
     }
 
 
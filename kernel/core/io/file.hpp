@@ -29,10 +29,27 @@
 #include "../utils/stringtools.hpp"
 #include "../ui/error.hpp"
 #include "../datamanagement/tablecolumn.hpp"
+#include "../datamanagement/mappedcolumn.hpp"
 #include "filesystem.hpp"
+#include "blockcodec.hpp"
 
 namespace NumeRe
 {
+    /////////////////////////////////////////////////
+    /// \brief This structure describes a single
+    /// column of a file without its values.
+    /////////////////////////////////////////////////
+    struct FileColumnInfo
+    {
+        std::string sHeadLine;
+        std::string sUnit;
+        TableColumn::ColumnType type;
+        int64_t nRows;
+
+        FileColumnInfo() : sHeadLine(), sUnit(), type(TableColumn::TYPE_NONE), nRows(0) {}
+    };
+
+
     /////////////////////////////////////////////////
     /// \brief This structure wraps all necessary
     /// meta information of a single file.
@@ -51,6 +68,7 @@ namespace NumeRe
         float fileVersion;
         __time64_t timeStamp;
         bool needsConversion;
+        std::vector<FileColumnInfo> vColumns;
 
         FileHeaderInfo() : sFileExtension(), sFileName(), sTableName(), sComment(), nRows(0), nCols(0), versionMajor(-1), versionMinor(-1), versionBuild(-1), timeStamp(0), needsConversion(true) {}
     };
@@ -1591,21 +1609,38 @@ namespace NumeRe
             int32_t versionMajor;
             int32_t versionMinor;
             int32_t versionBuild;
-            const short fileSpecVersionMajor = 4;
+            const short fileSpecVersionMajor = 5;
             const short fileSpecVersionMinor = 1;
             float fileVersionRead;
             size_t checkPos;
             size_t checkStart;
+            uint64_t nFileEnd;
+            bool useMapping;
+            bool useCompressedColumns;
+            bool isCorrupted;
+            bool isProjected;
+            std::string sChecksum;
+            Xxh64 checksum;
+            VectorIndex vProjectedCols;
+            VectorIndex vProjectedRows;
+            std::vector<FileColumnInfo> vColumnInfo;
+            std::shared_ptr<MappedFile> mappedFile;
 
             void writeHeader();
             void writeDummyHeader();
             void writeFile();
             void writeColumn(const TblColPtr& col);
+            void writeHashed(const std::string& sBlock);
+            void hashRange(size_t nStart, size_t nEnd);
             void readHeader();
             void skipDummyHeader();
             void readFile();
             void readColumn(TblColPtr& col);
             void readColumnV4(TblColPtr& col);
+            void readColumnV5(TblColPtr& col, size_t nFirstRow = 0, size_t nEndRow = std::string::npos);
+            void readColumnInfoV5(FileColumnInfo& info);
+            std::vector<uint64_t> readColumnIndex();
+            void readProjectedFile(size_t nFileStart);
             void readLegacyFormat();
             void* readGenericField(std::string& type, int64_t& size);
             void deleteGenericData(void* data, const std::string& type);
@@ -1642,6 +1677,8 @@ namespace NumeRe
                 readHeader();
             }
 
+            void readFileSchema();
+
             /////////////////////////////////////////////////
             /// \brief Returns the file timestamp.
             ///
@@ -1653,6 +1690,53 @@ namespace NumeRe
                 return timeStamp;
             }
 
+            /////////////////////////////////////////////////
+            /// \brief Activates the memory mapping of the
+            /// file. Numerical columns are then not read
+            /// into memory but will reference the mapped
+            /// file instead.
+            ///
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void useMemoryMapping()
+            {
+                useMapping = true;
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Activates the compression of the
+            /// column chunks, when writing the file.
+            /// Chunks, which do not get smaller, are still
+            /// stored uncompressed.
+            ///
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void useCompression()
+            {
+                useCompressedColumns = true;
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Restricts the next read to the
+            /// passed columns and to the range of rows
+            /// between the smallest and the largest passed
+            /// row. Other columns and rows are not read
+            /// from the file, if it is in the v5 format.
+            ///
+            /// \param cols const VectorIndex&
+            /// \param rows const VectorIndex&
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void setProjection(const VectorIndex& cols, const VectorIndex& rows)
+            {
+                vProjectedCols = cols;
+                vProjectedRows = rows;
+                isProjected = true;
+            }
+
             virtual FileHeaderInfo getFileHeaderInformation() override
             {
                 FileHeaderInfo info;
@@ -1669,6 +1753,7 @@ namespace NumeRe
                 info.fileVersion = fileVersionRead;
                 info.timeStamp = timeStamp;
                 info.needsConversion = needsConversion;
+                info.vColumns = vColumnInfo;
 
                 return info;
             }
@@ -1692,7 +1777,7 @@ namespace NumeRe
     class CacheFile : public NumeReDataFile
     {
         private:
-            std::vector<uint32_t> vFileIndex;
+            std::vector<uint64_t> vFileIndex;
             size_t nIndexPos;
 
             void reset();
@@ -1741,7 +1826,7 @@ namespace NumeRe
             /////////////////////////////////////////////////
             void setNumberOfTables(size_t nTables)
             {
-                vFileIndex = std::vector<uint32_t>(nTables, 0u);
+                vFileIndex = std::vector<uint64_t>(nTables, 0u);
             }
 
             /////////////////////////////////////////////////
@@ -1749,10 +1834,10 @@ namespace NumeRe
             /// passed table index.
             ///
             /// \param nthTable size_t
-            /// \return uint32_t
+            /// \return uint64_t
             ///
             /////////////////////////////////////////////////
-            uint32_t getPosition(size_t nthTable)
+            uint64_t getPosition(size_t nthTable)
             {
                 if (nthTable < vFileIndex.size())
                     return vFileIndex[nthTable];
@@ -1899,9 +1984,9 @@ namespace NumeRe
     /////////////////////////////////////////////////
     /// \brief This class resembles an OpenDocument
     /// spreadsheet (*.ods), which is based upon a
-    /// zipped XML file. The data is read using the
-    /// Zipfile extractor from GenericFile. Only
-    /// reading is supported by this class.
+    /// zipped XML file. The XML file is inflated
+    /// chunk-wise and read using the XmlPullParser.
+    /// Only reading is supported by this class.
     /////////////////////////////////////////////////
     class OpenDocumentSpreadSheet : public GenericFile
     {
@@ -1960,9 +2045,9 @@ namespace NumeRe
     /////////////////////////////////////////////////
     /// \brief This class resembles an Excel (2003)
     /// spreadsheet (*.xlsx), which is based upon a
-    /// zipped XML file. The data is read using the
-    /// Zipfile extractor from GenericFile. Only
-    /// reading is supported by this class.
+    /// zipped XML file. The XML files are inflated
+    /// chunk-wise and read using the XmlPullParser.
+    /// Only reading is supported by this class.
     /////////////////////////////////////////////////
     class XLSXSpreadSheet : public GenericFile
     {
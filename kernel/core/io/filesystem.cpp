@@ -19,8 +19,17 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#ifdef _WIN32
 #include <windows.h>
 #include <shobjidl.h>
+#else
+#include <algorithm>
+#include <filesystem>
+#include <cstring>
+#include <dirent.h>
+#include <fnmatch.h>
+#include <sys/stat.h>
+#endif
 
 #include "filesystem.hpp"
 #ifndef PARSERSTANDALONE
@@ -31,6 +40,124 @@
 
 std::string removeQuotationMarks(const std::string& sString);
 
+#ifndef _WIN32
+/////////////////////////////////////////////////
+/// \brief Minimal POSIX replacements for the
+/// Windows file search functions, which are used
+/// by the FileSystem class. Only the fields of
+/// WIN32_FIND_DATA used in this file are
+/// available.
+/////////////////////////////////////////////////
+#define INVALID_HANDLE_VALUE nullptr
+#define FILE_ATTRIBUTE_DIRECTORY 0x10
+
+struct WIN32_FIND_DATA
+{
+    unsigned dwFileAttributes;
+    char cFileName[256];
+};
+
+struct FindHandle
+{
+    DIR* dir;
+    std::string sDir;
+    std::string sPattern;
+};
+
+
+/////////////////////////////////////////////////
+/// \brief Reads the next directory entry
+/// matching the pattern of the search handle.
+///
+/// \param hFind HANDLE
+/// \param FindFileData WIN32_FIND_DATA*
+/// \return bool
+///
+/////////////////////////////////////////////////
+static bool FindNextFile(HANDLE hFind, WIN32_FIND_DATA* FindFileData)
+{
+    FindHandle* handle = static_cast<FindHandle*>(hFind);
+
+    while (dirent* entry = readdir(handle->dir))
+    {
+        if (fnmatch(handle->sPattern.c_str(), entry->d_name, FNM_CASEFOLD))
+            continue;
+
+        struct stat fileStat;
+        bool isDir = !stat((handle->sDir + "/" + entry->d_name).c_str(), &fileStat) && S_ISDIR(fileStat.st_mode);
+
+        FindFileData->dwFileAttributes = isDir ? FILE_ATTRIBUTE_DIRECTORY : 0;
+        strncpy(FindFileData->cFileName, entry->d_name, sizeof(FindFileData->cFileName)-1);
+        FindFileData->cFileName[sizeof(FindFileData->cFileName)-1] = '\0';
+        return true;
+    }
+
+    return false;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Closes a search handle created by
+/// FindFirstFile.
+///
+/// \param hFind HANDLE
+/// \return void
+///
+/////////////////////////////////////////////////
+static void FindClose(HANDLE hFind)
+{
+    FindHandle* handle = static_cast<FindHandle*>(hFind);
+    closedir(handle->dir);
+    delete handle;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Starts a search for all entries
+/// matching the wildcard pattern in the last
+/// part of the passed path.
+///
+/// \param sFileName const char*
+/// \param FindFileData WIN32_FIND_DATA*
+/// \return HANDLE
+///
+/////////////////////////////////////////////////
+static HANDLE FindFirstFile(const char* sFileName, WIN32_FIND_DATA* FindFileData)
+{
+    std::string sPath = sFileName;
+    std::replace(sPath.begin(), sPath.end(), '\\', '/');
+
+    FindHandle* handle = new FindHandle;
+
+    if (sPath.find('/') != std::string::npos)
+    {
+        handle->sDir = sPath.substr(0, sPath.rfind('/'));
+        handle->sPattern = sPath.substr(sPath.rfind('/')+1);
+    }
+    else
+    {
+        handle->sDir = ".";
+        handle->sPattern = sPath;
+    }
+
+    handle->dir = opendir(handle->sDir.length() ? handle->sDir.c_str() : "/");
+
+    if (!handle->dir)
+    {
+        delete handle;
+        return INVALID_HANDLE_VALUE;
+    }
+
+    if (!FindNextFile(handle, FindFileData))
+    {
+        FindClose(handle);
+        return INVALID_HANDLE_VALUE;
+    }
+
+    return handle;
+}
+#endif // _WIN32
+
 
 
 /////////////////////////////////////////////////
@@ -490,6 +617,16 @@ std::vector<std::string> FileSystem::resolveChooseTokens(const std::string& sDir
 /////////////////////////////////////////////////
 int FileSystem::createFolders(const std::string& _sPath) const
 {
+#ifndef _WIN32
+    std::error_code ec;
+
+    // Note that the folder might already exist
+    if (std::filesystem::is_directory(_sPath, ec))
+        return -1;
+
+    std::filesystem::create_directories(_sPath, ec);
+    return 1;
+#else
     // Create the folder (returns false, if there's more
     // than one folder to be created)
     if (CreateDirectory(_sPath.c_str(), nullptr))
@@ -519,6 +656,7 @@ int FileSystem::createFolders(const std::string& _sPath) const
     }
 
     return 1;
+#endif // _WIN32
 }
 
 
@@ -699,7 +837,9 @@ std::string FileSystem::ValidizeAndPrepareName(const std::string& _sFileName, co
 std::string FileSystem::resolveLink(const std::string& sLink)
 {
 #warning FIXME (numere#9#10/31/23): It seems that TDM-GCC 9.2.0 lacks the necessary declarations
-#ifdef NR_HAVE_GSL2
+#ifndef _WIN32
+    return sLink;
+#elif defined(NR_HAVE_GSL2)
     HRESULT hres;
     IShellLink* psl;
     CHAR szGotPath[MAX_PATH];
@@ -873,7 +1013,9 @@ void FileSystem::createRevisionsFolder()
 {
     std::string sRevisionsPath = sPath.substr(1, sPath.length()-2) + "/.revisions";
     createFolders(sRevisionsPath);
+#ifdef _WIN32
     SetFileAttributesA(sRevisionsPath.c_str(), FILE_ATTRIBUTE_HIDDEN | FILE_ATTRIBUTE_NOT_CONTENT_INDEXED);
+#endif // _WIN32
 }
 
 
@@ -1134,6 +1276,7 @@ std::vector<std::string> FileSystem::getFileParts(const std::string& sFilePath)
 }
 
 
+#ifdef _WIN32
 /////////////////////////////////////////////////
 /// \brief Static function to convert Windows UTC
 /// system time to a sys_time_point.
@@ -1154,6 +1297,7 @@ static sys_time_point windowSystemTimeToTimePoint(SYSTEMTIME stUTC)
 
     return getTimePointFromTimeStamp(timeStamp);
 }
+#endif // _WIN32
 
 
 /////////////////////////////////////////////////
@@ -1175,6 +1319,23 @@ FileInfo FileSystem::getFileInfo(const std::string& sFilePath) const
     fInfo.name = vFileParts[2];
     fInfo.ext = vFileParts[3];
 
+#ifndef _WIN32
+    std::error_code ec;
+    std::filesystem::path filePath(isFile(sFilePath) ? ValidFileName(sFilePath, ".dat", false) : ValidFolderName(sFilePath, true, false));
+
+    // Only fill in the remainig information, if a corresponding
+    // file could be found
+    if (std::filesystem::exists(filePath, ec))
+    {
+        if (std::filesystem::is_directory(filePath, ec))
+            fInfo.fileAttributes = FileInfo::ATTR_DIRECTORY;
+        else
+            fInfo.filesize = std::filesystem::file_size(filePath, ec);
+
+        fInfo.modificationTime = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::file_clock::to_sys(std::filesystem::last_write_time(filePath, ec)));
+        fInfo.creationTime = fInfo.modificationTime;
+    }
+#else
     WIN32_FIND_DATA FindFileData;
     HANDLE hFind = INVALID_HANDLE_VALUE;
 
@@ -1202,6 +1363,7 @@ FileInfo FileSystem::getFileInfo(const std::string& sFilePath) const
         fInfo.fileAttributes = FindFileData.dwFileAttributes;
         FindClose(hFind);
     }
+#endif // _WIN32
 
     return fInfo;
 }
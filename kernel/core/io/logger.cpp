@@ -18,11 +18,17 @@
 
 #include "logger.hpp"
 #include "../utils/stringtools.hpp"
+#ifdef _WIN32
 #include <windows.h>
+#else
+#include <sys/utsname.h>
+#endif
 
 DetachedLogger g_logger;
 
+#ifdef _WIN32
 typedef BOOL (WINAPI* LPFN_ISWOW64PROCESS) (HANDLE, PBOOL);
+#endif
 
 
 /////////////////////////////////////////////////
@@ -36,6 +42,8 @@ bool IsWow64()
 {
 #ifdef __GNUWIN64__
     return true; // always a 64 bit system in this situation
+#elif !defined(_WIN32)
+    return sizeof(void*) == 8;
 #else
     BOOL bIsWow64 = false;
 
@@ -395,6 +403,14 @@ std::string DetachedLogger::get_system_information() const
 {
     std::string sysInfo;
 
+#ifndef _WIN32
+    utsname _uname;
+
+    if (!uname(&_uname))
+        sysInfo = "OS: " + std::string(_uname.sysname) + " v " + _uname.release + (IsWow64() ? " (x64)" : " (x86)");
+
+    return sysInfo;
+#else
     // Get the version of the operating system
     // Prepare the signature of the callback
     NTSTATUS(WINAPI *RtlGetVersion)(LPOSVERSIONINFOEXW);
@@ -415,6 +431,7 @@ std::string DetachedLogger::get_system_information() const
     sysInfo = "OS: Windows v " + toString((int)_osversioninfo.dwMajorVersion) + "." + toString((int)_osversioninfo.dwMinorVersion) + "." + toString((int)_osversioninfo.dwBuildNumber) + (IsWow64() ? " (x64)" : " (x86)");
 
     return sysInfo;
+#endif // _WIN32
 }
 
 
@@ -0,0 +1,110 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "workerpool.hpp"
+
+namespace NumeRe
+{
+    /////////////////////////////////////////////////
+    /// \brief Constructor. The threads are not
+    /// started before the first task is scheduled.
+    ///
+    /// \param nWorkers size_t
+    ///
+    /////////////////////////////////////////////////
+    WorkerPool::WorkerPool(size_t nWorkers) : m_nWorkers(nWorkers ? nWorkers : 1), m_stop(false)
+    {
+        //
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Destructor. Completes all scheduled
+    /// tasks and joins the threads afterwards.
+    /////////////////////////////////////////////////
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+
+        m_condition.notify_all();
+
+        for (std::thread& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief The loop of a single worker thread.
+    /// Returns, once the pool is stopped and no
+    /// tasks are left.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void WorkerPool::work()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this](){return m_stop || !m_tasks.empty();});
+
+                if (m_tasks.empty())
+                    return;
+
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+
+            task();
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Schedules a task for background
+    /// execution and starts the worker threads, if
+    /// they are not running yet.
+    ///
+    /// \param task std::function<void()>
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void WorkerPool::schedule(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(std::move(task));
+
+            while (m_workers.size() < m_nWorkers)
+            {
+                m_workers.emplace_back(&WorkerPool::work, this);
+            }
+        }
+
+        m_condition.notify_one();
+    }
+}
+
@@ -0,0 +1,82 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef WORKERPOOL_HPP
+#define WORKERPOOL_HPP
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <memory>
+#include <deque>
+#include <vector>
+
+namespace NumeRe
+{
+    /////////////////////////////////////////////////
+    /// \brief This class represents a small pool of
+    /// worker threads, which execute tasks in the
+    /// background in the order of their scheduling.
+    /// The threads are started with the first
+    /// scheduled task. All scheduled tasks are
+    /// completed before the pool is destroyed.
+    /////////////////////////////////////////////////
+    class WorkerPool
+    {
+        private:
+            std::vector<std::thread> m_workers;
+            std::deque<std::function<void()>> m_tasks;
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+            size_t m_nWorkers;
+            bool m_stop;
+
+            void work();
+
+        public:
+            WorkerPool(size_t nWorkers);
+            ~WorkerPool();
+
+            void schedule(std::function<void()> task);
+
+            /////////////////////////////////////////////////
+            /// \brief Schedules a task returning a value.
+            /// The value (or the exception thrown by the
+            /// task) is available from the returned future.
+            /// Dropping the future does not wait for the
+            /// task.
+            ///
+            /// \param task std::function<T()>
+            /// \return std::future<T>
+            ///
+            /////////////////////////////////////////////////
+            template<class T>
+            std::future<T> schedule(std::function<T()> task)
+            {
+                std::shared_ptr<std::packaged_task<T()>> packagedTask = std::make_shared<std::packaged_task<T()>>(task);
+                std::future<T> result = packagedTask->get_future();
+                schedule(std::function<void()>([packagedTask](){(*packagedTask)();}));
+
+                return result;
+            }
+    };
+}
+
+#endif // WORKERPOOL_HPP
@@ -0,0 +1,581 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "xmlpullparser.hpp"
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+namespace NumeRe
+{
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to determine,
+    /// whether the character is XML whitespace.
+    ///
+    /// \param c char
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    static bool isXmlSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to append a
+    /// unicode code point as UTF-8 sequence.
+    ///
+    /// \param nCodePoint unsigned long
+    /// \param sTarget std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void appendUtf8(unsigned long nCodePoint, std::string& sTarget)
+    {
+        if (nCodePoint < 0x80)
+            sTarget += (char)nCodePoint;
+        else if (nCodePoint < 0x800)
+        {
+            sTarget += (char)(0xC0 | (nCodePoint >> 6));
+            sTarget += (char)(0x80 | (nCodePoint & 0x3F));
+        }
+        else if (nCodePoint < 0x10000)
+        {
+            sTarget += (char)(0xE0 | (nCodePoint >> 12));
+            sTarget += (char)(0x80 | ((nCodePoint >> 6) & 0x3F));
+            sTarget += (char)(0x80 | (nCodePoint & 0x3F));
+        }
+        else if (nCodePoint < 0x110000)
+        {
+            sTarget += (char)(0xF0 | (nCodePoint >> 18));
+            sTarget += (char)(0x80 | ((nCodePoint >> 12) & 0x3F));
+            sTarget += (char)(0x80 | ((nCodePoint >> 6) & 0x3F));
+            sTarget += (char)(0x80 | (nCodePoint & 0x3F));
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Constructor.
+    ///
+    /// \param source ChunkSource
+    /// \param nChunkSize size_t
+    ///
+    /////////////////////////////////////////////////
+    XmlPullParser::XmlPullParser(ChunkSource source, size_t nChunkSize)
+        : m_source(source), m_pos(0), m_end(0), m_chunkSize(nChunkSize ? nChunkSize : 1),
+          m_eof(false), m_pendingEnd(false), m_popDepth(false), m_depth(0), m_nAttributes(0)
+    {
+        //
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Requests the next chunk from the
+    /// source. The already consumed part of the
+    /// buffer is discarded first, so that the buffer
+    /// only grows, if a single token is larger than
+    /// a chunk.
+    ///
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    bool XmlPullParser::fill()
+    {
+        if (m_eof)
+            return false;
+
+        if (m_pos)
+        {
+            std::memmove(m_buffer.data(), m_buffer.data() + m_pos, m_end - m_pos);
+            m_end -= m_pos;
+            m_pos = 0;
+        }
+
+        if (m_buffer.size() < m_end + m_chunkSize)
+            m_buffer.resize(m_end + m_chunkSize);
+
+        size_t nRead = m_source(m_buffer.data() + m_end, m_chunkSize);
+
+        if (!nRead)
+        {
+            m_eof = true;
+            return false;
+        }
+
+        m_end += nRead;
+        return true;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Finds the passed character sequence
+    /// in the unconsumed part of the buffer and
+    /// requests new chunks, if necessary. Returns
+    /// the offset relative to the current position
+    /// or std::string::npos, if the document ends
+    /// before.
+    ///
+    /// \param sSequence const char*
+    /// \param nLength size_t
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+    size_t XmlPullParser::find(const char* sSequence, size_t nLength)
+    {
+        size_t nFrom = 0;
+
+        while (true)
+        {
+            const char* pStart = m_buffer.data() + m_pos;
+            const char* pEnd = m_buffer.data() + m_end;
+
+            if ((size_t)(pEnd - pStart) >= nLength)
+            {
+                const char* pFound = std::search(pStart + nFrom, pEnd, sSequence, sSequence + nLength);
+
+                if (pFound != pEnd)
+                    return pFound - pStart;
+
+                nFrom = pEnd - pStart - nLength + 1;
+            }
+
+            if (!fill())
+                return std::string::npos;
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Finds the closing angle bracket of the
+    /// tag starting at the current position.
+    /// Brackets within quoted attribute values are
+    /// ignored.
+    ///
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+    size_t XmlPullParser::findTagEnd()
+    {
+        size_t nFrom = 1;
+        char cQuote = 0;
+
+        while (true)
+        {
+            const char* pStart = m_buffer.data() + m_pos;
+            size_t nAvailable = m_end - m_pos;
+
+            for (; nFrom < nAvailable; nFrom++)
+            {
+                if (cQuote)
+                {
+                    if (pStart[nFrom] == cQuote)
+                        cQuote = 0;
+                }
+                else if (pStart[nFrom] == '"' || pStart[nFrom] == '\'')
+                    cQuote = pStart[nFrom];
+                else if (pStart[nFrom] == '>')
+                    return nFrom;
+            }
+
+            if (!fill())
+                return std::string::npos;
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Decodes the name and the attributes of
+    /// the start tag at the current position. The
+    /// attribute storage is reused between the tags.
+    ///
+    /// \param nTagEnd size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void XmlPullParser::parseTag(size_t nTagEnd)
+    {
+        const char* pCurrent = m_buffer.data() + m_pos + 1;
+        const char* pEnd = m_buffer.data() + m_pos + nTagEnd;
+
+        m_pendingEnd = pEnd > pCurrent && *(pEnd-1) == '/';
+
+        if (m_pendingEnd)
+            pEnd--;
+
+        const char* pName = pCurrent;
+
+        while (pCurrent < pEnd && !isXmlSpace(*pCurrent))
+            pCurrent++;
+
+        m_name.assign(pName, pCurrent);
+        m_nAttributes = 0;
+
+        while (pCurrent < pEnd)
+        {
+            while (pCurrent < pEnd && isXmlSpace(*pCurrent))
+                pCurrent++;
+
+            pName = pCurrent;
+
+            while (pCurrent < pEnd && *pCurrent != '=' && !isXmlSpace(*pCurrent))
+                pCurrent++;
+
+            const char* pNameEnd = pCurrent;
+
+            while (pCurrent < pEnd && *pCurrent != '"' && *pCurrent != '\'')
+                pCurrent++;
+
+            if (pCurrent >= pEnd || pNameEnd == pName)
+                break;
+
+            char cQuote = *pCurrent;
+            const char* pValue = ++pCurrent;
+
+            while (pCurrent < pEnd && *pCurrent != cQuote)
+                pCurrent++;
+
+            if (m_nAttributes == m_attributes.size())
+                m_attributes.emplace_back();
+
+            std::pair<std::string, std::string>& attribute = m_attributes[m_nAttributes++];
+            attribute.first.assign(pName, pNameEnd);
+            attribute.second.clear();
+            decode(pValue, pCurrent, attribute.second);
+
+            pCurrent++;
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Appends the passed character range to
+    /// the target and resolves the predefined and
+    /// the numeric entities. Line endings are
+    /// normalized to a single line feed.
+    ///
+    /// \param pStart const char*
+    /// \param pEnd const char*
+    /// \param sTarget std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void XmlPullParser::decode(const char* pStart, const char* pEnd, std::string& sTarget) const
+    {
+        while (pStart < pEnd)
+        {
+            const char* pSpecial = std::find_if(pStart, pEnd, [](char c){return c == '&' || c == '\r';});
+            sTarget.append(pStart, pSpecial);
+
+            if (pSpecial == pEnd)
+                return;
+
+            if (*pSpecial == '\r')
+            {
+                sTarget += '\n';
+                pStart = pSpecial + 1;
+
+                if (pStart < pEnd && *pStart == '\n')
+                    pStart++;
+
+                continue;
+            }
+
+            const char* pLimit = std::min(pEnd, pSpecial + 12);
+            const char* pSemicolon = std::find(pSpecial, pLimit, ';');
+
+            if (pSemicolon == pLimit)
+            {
+                sTarget += '&';
+                pStart = pSpecial + 1;
+                continue;
+            }
+
+            std::string sEntity(pSpecial + 1, pSemicolon);
+
+            if (sEntity == "lt")
+                sTarget += '<';
+            else if (sEntity == "gt")
+                sTarget += '>';
+            else if (sEntity == "amp")
+                sTarget += '&';
+            else if (sEntity == "quot")
+                sTarget += '"';
+            else if (sEntity == "apos")
+                sTarget += '\'';
+            else if (sEntity.length() > 1 && sEntity[0] == '#')
+            {
+                if (sEntity[1] == 'x' || sEntity[1] == 'X')
+                    appendUtf8(std::strtoul(sEntity.c_str() + 2, nullptr, 16), sTarget);
+                else
+                    appendUtf8(std::strtoul(sEntity.c_str() + 1, nullptr, 10), sTarget);
+            }
+            else
+                sTarget.append(pSpecial, pSemicolon + 1);
+
+            pStart = pSemicolon + 1;
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Advances to the next event in the
+    /// document.
+    ///
+    /// \return XmlPullParser::Event
+    ///
+    /////////////////////////////////////////////////
+    XmlPullParser::Event XmlPullParser::next()
+    {
+        if (m_popDepth)
+        {
+            m_depth--;
+            m_popDepth = false;
+        }
+
+        if (m_pendingEnd)
+        {
+            m_pendingEnd = false;
+            m_popDepth = true;
+            m_nAttributes = 0;
+            return END_ELEMENT;
+        }
+
+        while (true)
+        {
+            if (m_pos >= m_end && !fill())
+                return END_DOCUMENT;
+
+            // Character data up to the next tag
+            if (m_buffer[m_pos] != '<')
+            {
+                size_t nLength = find("<", 1);
+
+                if (nLength == std::string::npos)
+                    nLength = m_end - m_pos;
+
+                m_text.clear();
+                decode(m_buffer.data() + m_pos, m_buffer.data() + m_pos + nLength, m_text);
+                m_pos += nLength;
+                return TEXT;
+            }
+
+            // Ensure that the longest markup prefix is
+            // available
+            while (m_end - m_pos < 9 && fill())
+                ;
+
+            const char* pTag = m_buffer.data() + m_pos;
+            size_t nAvailable = m_end - m_pos;
+
+            if (nAvailable >= 2 && pTag[1] == '?')
+            {
+                size_t nLength = find("?>", 2);
+                m_pos = nLength == std::string::npos ? m_end : m_pos + nLength + 2;
+            }
+            else if (nAvailable >= 4 && !std::strncmp(pTag, "<!--", 4))
+            {
+                size_t nLength = find("-->", 3);
+                m_pos = nLength == std::string::npos ? m_end : m_pos + nLength + 3;
+            }
+            else if (nAvailable >= 9 && !std::strncmp(pTag, "<![CDATA[", 9))
+            {
+                size_t nLength = find("]]>", 3);
+
+                if (nLength == std::string::npos)
+                    nLength = m_end - m_pos;
+
+                m_text.assign(m_buffer.data() + m_pos + 9, m_buffer.data() + m_pos + std::max(nLength, (size_t)9));
+                m_pos = std::min(m_pos + nLength + 3, m_end);
+                return TEXT;
+            }
+            else if (nAvailable >= 2 && pTag[1] == '!')
+            {
+                size_t nLength = findTagEnd();
+                m_pos = nLength == std::string::npos ? m_end : m_pos + nLength + 1;
+            }
+            else if (nAvailable >= 2 && pTag[1] == '/')
+            {
+                size_t nLength = find(">", 1);
+
+                if (nLength == std::string::npos)
+                {
+                    m_pos = m_end;
+                    return END_DOCUMENT;
+                }
+
+                const char* pName = m_buffer.data() + m_pos + 2;
+                const char* pNameEnd = m_buffer.data() + m_pos + nLength;
+
+                while (pNameEnd > pName && isXmlSpace(*(pNameEnd-1)))
+                    pNameEnd--;
+
+                m_name.assign(pName, pNameEnd);
+                m_nAttributes = 0;
+                m_pos += nLength + 1;
+                m_popDepth = true;
+                return END_ELEMENT;
+            }
+            else
+            {
+                size_t nLength = findTagEnd();
+
+                if (nLength == std::string::npos)
+                {
+                    m_pos = m_end;
+                    return END_DOCUMENT;
+                }
+
+                parseTag(nLength);
+                m_pos += nLength + 1;
+                m_depth++;
+                return START_ELEMENT;
+            }
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Concatenates the text of the current
+    /// element including its child elements and
+    /// advances to its end element. Must be called
+    /// directly after its start element.
+    ///
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+    std::string XmlPullParser::readElementText()
+    {
+        std::string sText;
+        size_t nDepth = m_depth;
+        Event event;
+
+        while ((event = next()) != END_DOCUMENT)
+        {
+            if (event == TEXT)
+                sText += m_text;
+            else if (event == END_ELEMENT && m_depth == nDepth)
+                break;
+        }
+
+        return sText;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Skips the current element including
+    /// its child elements. Must be called directly
+    /// after its start element.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void XmlPullParser::skipElement()
+    {
+        size_t nDepth = m_depth;
+        Event event;
+
+        while ((event = next()) != END_DOCUMENT)
+        {
+            if (event == END_ELEMENT && m_depth == nDepth)
+                break;
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the name of the current
+    /// element without its namespace prefix.
+    ///
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+    std::string XmlPullParser::getLocalName() const
+    {
+        size_t nColon = m_name.find(':');
+
+        if (nColon == std::string::npos)
+            return m_name;
+
+        return m_name.substr(nColon+1);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns a pointer to the value of the
+    /// selected attribute of the current start
+    /// element or a nullptr, if it does not exist.
+    ///
+    /// \param sName const std::string&
+    /// \return const std::string*
+    ///
+    /////////////////////////////////////////////////
+    const std::string* XmlPullParser::findAttribute(const std::string& sName) const
+    {
+        for (size_t i = 0; i < m_nAttributes; i++)
+        {
+            if (m_attributes[i].first == sName)
+                return &m_attributes[i].second;
+        }
+
+        return nullptr;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the value of the selected
+    /// attribute or the default value, if it does
+    /// not exist.
+    ///
+    /// \param sName const std::string&
+    /// \param sDefault const std::string&
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+    std::string XmlPullParser::getAttribute(const std::string& sName, const std::string& sDefault) const
+    {
+        const std::string* sValue = findAttribute(sName);
+        return sValue ? *sValue : sDefault;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the value of the selected
+    /// attribute as integer or the default value,
+    /// if it does not exist or is not numeric.
+    ///
+    /// \param sName const std::string&
+    /// \param nDefault long long int
+    /// \return long long int
+    ///
+    /////////////////////////////////////////////////
+    long long int XmlPullParser::getIntAttribute(const std::string& sName, long long int nDefault) const
+    {
+        const std::string* sValue = findAttribute(sName);
+
+        if (!sValue)
+            return nDefault;
+
+        char* pEnd = nullptr;
+        long long int nValue = std::strtoll(sValue->c_str(), &pEnd, 10);
+
+        return pEnd == sValue->c_str() ? nDefault : nValue;
+    }
+}
+
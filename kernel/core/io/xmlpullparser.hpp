@@ -0,0 +1,126 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef XMLPULLPARSER_HPP
+#define XMLPULLPARSER_HPP
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+
+namespace NumeRe
+{
+    /////////////////////////////////////////////////
+    /// \brief This class is a minimal, non-validating
+    /// XML pull parser. The document is requested
+    /// chunk-wise from the passed source, therefore
+    /// the memory usage is bounded by the chunk size
+    /// and the size of the largest single token.
+    /// Comments, processing instructions and
+    /// declarations are skipped, self-closing
+    /// elements are reported as a start and an end
+    /// element.
+    /////////////////////////////////////////////////
+    class XmlPullParser
+    {
+        public:
+            enum Event
+            {
+                START_ELEMENT,
+                END_ELEMENT,
+                TEXT,
+                END_DOCUMENT
+            };
+
+            typedef std::function<size_t(char*, size_t)> ChunkSource;
+
+        private:
+            ChunkSource m_source;
+            std::vector<char> m_buffer;
+            size_t m_pos;
+            size_t m_end;
+            size_t m_chunkSize;
+            bool m_eof;
+            bool m_pendingEnd;
+            bool m_popDepth;
+            size_t m_depth;
+            std::string m_name;
+            std::string m_text;
+            std::vector<std::pair<std::string, std::string>> m_attributes;
+            size_t m_nAttributes;
+
+            bool fill();
+            size_t find(const char* sSequence, size_t nLength);
+            size_t findTagEnd();
+            void parseTag(size_t nTagEnd);
+            void decode(const char* pStart, const char* pEnd, std::string& sTarget) const;
+
+        public:
+            XmlPullParser(ChunkSource source, size_t nChunkSize = 65536);
+
+            Event next();
+            std::string readElementText();
+            void skipElement();
+
+            /////////////////////////////////////////////////
+            /// \brief Returns the qualified name of the
+            /// current element.
+            ///
+            /// \return const std::string&
+            ///
+            /////////////////////////////////////////////////
+            const std::string& getName() const
+            {
+                return m_name;
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Returns the decoded text of the
+            /// current text event.
+            ///
+            /// \return const std::string&
+            ///
+            /////////////////////////////////////////////////
+            const std::string& getText() const
+            {
+                return m_text;
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Returns the nesting depth of the
+            /// current element. The document element has
+            /// the depth one.
+            ///
+            /// \return size_t
+            ///
+            /////////////////////////////////////////////////
+            size_t getDepth() const
+            {
+                return m_depth;
+            }
+
+            std::string getLocalName() const;
+            const std::string* findAttribute(const std::string& sName) const;
+            std::string getAttribute(const std::string& sName, const std::string& sDefault = "") const;
+            long long int getIntAttribute(const std::string& sName, long long int nDefault = 0) const;
+    };
+}
+
+#endif // XMLPULLPARSER_HPP
+
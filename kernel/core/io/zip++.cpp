@@ -24,6 +24,9 @@ Zipfile::Zipfile()
 {
     hZip = NULL;
     bIsOpen = false;
+    nItemIndex = -1;
+    nItemRead = 0;
+    bItemPending = false;
 }
 
 Zipfile::~Zipfile()
@@ -126,3 +129,54 @@ std::string Zipfile::getZipItem(const std::string& sFilename)
     return "";
 }
 
+
+// Prepares the passed item for reading it
+// in chunks using readItem(). Returns false,
+// if the item does not exist
+bool Zipfile::openItem(const std::string& sFilename)
+{
+    nItemIndex = -1;
+    nItemRead = 0;
+    bItemPending = false;
+
+    if (!bIsOpen || hZip == NULL)
+        return false;
+
+    if (FindZipItem(hZip, sFilename.c_str(), true, &nItemIndex, &zEntry) != ZR_OK || nItemIndex < 0)
+    {
+        nItemIndex = -1;
+        return false;
+    }
+
+    bItemPending = zEntry.unc_size > 0;
+    return true;
+}
+
+
+// Inflates the next chunk of the item opened
+// by openItem() into the buffer and returns the
+// number of written bytes. Returns zero, once
+// the item has been read completely
+size_t Zipfile::readItem(char* cBuffer, size_t nLength)
+{
+    if (!bItemPending || !nLength || hZip == NULL)
+        return 0;
+
+    ZRESULT zRes = UnzipItem(hZip, nItemIndex, cBuffer, (unsigned int)nLength);
+
+    if (zRes == ZR_MORE)
+    {
+        nItemRead += nLength;
+        return nLength;
+    }
+
+    bItemPending = false;
+
+    if (zRes != ZR_OK || (unsigned long int)zEntry.unc_size < nItemRead)
+        return 0;
+
+    size_t nWritten = zEntry.unc_size - nItemRead;
+    nItemRead = zEntry.unc_size;
+    return nWritten;
+}
+
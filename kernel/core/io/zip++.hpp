@@ -37,6 +37,9 @@ class Zipfile
         HZIP hZip;
         ZIPENTRY zEntry;
         bool bIsOpen;
+        int nItemIndex;
+        unsigned long int nItemRead;
+        bool bItemPending;
 
     public:
         Zipfile();
@@ -48,6 +51,8 @@ class Zipfile
         bool addFile(const std::string& sFilename);
         std::string getZipContent();
         std::string getZipItem(const std::string& sFilename);
+        bool openItem(const std::string& sFilename);
+        size_t readItem(char* cBuffer, size_t nLength);
 };
 
 #endif
@@ -34,7 +34,7 @@
 #include <gsl/gsl_cdf.h>
 #include <noise/noise.h>
 #include <omp.h>
-#include <windows.h>
+#include <thread>
 
 #include "student_t.hpp"
 #ifndef PARSERSTANDALONE
@@ -1728,6 +1728,28 @@ static mu::Value numfnc_rint(const mu::Value& val)
 /////////////////////////////////////////////////
 mu::Array numfnc_rint(const mu::Array& a)
 {
+    if (a.size() >= mu::NumArray::MIN_SIZE)
+    {
+        mu::NumArray vals(a);
+
+        // Real floating point arrays are rounded at once
+        if (vals.getStorage() == mu::NumArray::STORE_FLOAT && vals.getType() != mu::DATETIME)
+        {
+            std::vector<double> vRounded(a.size());
+            mu::simd::rint(vals.reals(), vRounded.data(), a.size());
+
+            mu::Array ret;
+            ret.reserve(a.size());
+
+            for (double val : vRounded)
+            {
+                ret.emplace_back((int64_t)val);
+            }
+
+            return ret;
+        }
+    }
+
     return mu::apply(numfnc_rint, a);
 }
 
@@ -1743,6 +1765,37 @@ mu::Array numfnc_rint(const mu::Array& a)
 /////////////////////////////////////////////////
 mu::Array numfnc_round(const mu::Array& vToRound, const mu::Array& vDecimals)
 {
+    if (vToRound.size() >= mu::NumArray::MIN_SIZE && vDecimals.size() == 1 && vDecimals.front().isNumerical())
+    {
+        std::complex<double> decimals = vDecimals.front().getNum().asCF64();
+        mu::NumArray vals(vToRound);
+
+        // Real arrays with a common number of decimals
+        // are rounded in a tight loop
+        if (vals.isValid()
+            && vals.getStorage() != mu::NumArray::STORE_COMPLEX
+            && !mu::isinf(decimals)
+            && !mu::isnan(decimals))
+        {
+            std::vector<double> buffer;
+            const double* pVals = vals.asReals(buffer);
+            double dDecimals = intPower(10, -abs(intCast(decimals)));
+
+            mu::Array ret;
+            ret.reserve(vToRound.size());
+
+            for (size_t i = 0; i < vToRound.size(); i++)
+            {
+                if (std::isinf(pVals[i]) || std::isnan(pVals[i]))
+                    ret.emplace_back(mu::Value(NAN));
+                else
+                    ret.emplace_back(std::round(pVals[i] / dDecimals) * dDecimals);
+            }
+
+            return ret;
+        }
+    }
+
     return mu::apply(round_impl, vToRound, vDecimals);
 }
 
@@ -2433,7 +2486,7 @@ mu::Array numfnc_Heaviside(const mu::Array& v)
 /////////////////////////////////////////////////
 static std::complex<double> phi_impl(const std::complex<double>& x, const std::complex<double>& y)
 {
-    if (isinf(x.real()) || isnan(x.real()) || isinf(y.real()) || isnan(y.real()))
+    if (std::isinf(x.real()) || std::isnan(x.real()) || std::isinf(y.real()) || std::isnan(y.real()))
         return NAN;
     if (y.real() < 0)
         return M_PI+abs(M_PI + atan2(y.real(), x.real()));
@@ -3355,7 +3408,7 @@ static std::complex<double> roof_impl(const std::complex<double>& x)
 /////////////////////////////////////////////////
 mu::Array numfnc_floor(const mu::Array& x)
 {
-    return mu::apply(floor_impl, x);
+    return mu::apply(floor_impl, mu::simd::floor, x);
 }
 
 
@@ -3368,7 +3421,7 @@ mu::Array numfnc_floor(const mu::Array& x)
 /////////////////////////////////////////////////
 mu::Array numfnc_roof(const mu::Array& x)
 {
-    return mu::apply(roof_impl, x);
+    return mu::apply(roof_impl, mu::simd::ceil, x);
 }
 
 
@@ -3773,7 +3826,7 @@ mu::Array timfnc_today()
 mu::Array numfnc_sleep(const mu::Array& ms)
 {
     int64_t msec = ms.front().getNum().asI64();
-    Sleep(msec);
+    std::this_thread::sleep_for(std::chrono::milliseconds(msec));
     return mu::Value(msec);
 }
 
@@ -3787,7 +3840,7 @@ mu::Array numfnc_sleep(const mu::Array& ms)
 /////////////////////////////////////////////////
 mu::Array numfnc_exp(const mu::Array& a)
 {
-    return mu::apply(mu::MathImpl<std::complex<double>>::Exp, a);
+    return mu::apply(mu::MathImpl<std::complex<double>>::Exp, mu::simd::exp, a);
 }
 
 
@@ -3817,7 +3870,7 @@ static std::complex<double> numfnc_abs(const std::complex<double>& val)
 /////////////////////////////////////////////////
 mu::Array numfnc_abs(const mu::Array& a)
 {
-    return mu::apply(numfnc_abs, a);
+    return mu::apply(numfnc_abs, mu::simd::abs, a);
 }
 
 
@@ -3830,7 +3883,7 @@ mu::Array numfnc_abs(const mu::Array& a)
 /////////////////////////////////////////////////
 mu::Array numfnc_sqrt(const mu::Array& a)
 {
-    return mu::apply(mu::MathImpl<std::complex<double>>::Sqrt, a);
+    return mu::apply(mu::MathImpl<std::complex<double>>::Sqrt, mu::simd::sqrt, a);
 }
 
 
@@ -3858,7 +3911,7 @@ static std::complex<double> numfnc_sign(const std::complex<double>& val)
 /////////////////////////////////////////////////
 mu::Array numfnc_sign(const mu::Array& a)
 {
-    return mu::apply(numfnc_sign, a);
+    return mu::apply(numfnc_sign, mu::simd::sign, a);
 }
 
 
@@ -3871,7 +3924,7 @@ mu::Array numfnc_sign(const mu::Array& a)
 /////////////////////////////////////////////////
 mu::Array numfnc_log2(const mu::Array& a)
 {
-    return mu::apply(mu::MathImpl<std::complex<double>>::Log2, a);
+    return mu::apply(mu::MathImpl<std::complex<double>>::Log2, mu::simd::log2, a);
 }
 
 
@@ -3884,7 +3937,7 @@ mu::Array numfnc_log2(const mu::Array& a)
 /////////////////////////////////////////////////
 mu::Array numfnc_log10(const mu::Array& a)
 {
-    return mu::apply(mu::MathImpl<std::complex<double>>::Log10, a);
+    return mu::apply(mu::MathImpl<std::complex<double>>::Log10, mu::simd::log10, a);
 }
 
 
@@ -3897,7 +3950,7 @@ mu::Array numfnc_log10(const mu::Array& a)
 /////////////////////////////////////////////////
 mu::Array numfnc_ln(const mu::Array& a)
 {
-    return mu::apply(mu::MathImpl<std::complex<double>>::Log, a);
+    return mu::apply(mu::MathImpl<std::complex<double>>::Log, mu::simd::log, a);
 }
 
 
@@ -4350,7 +4403,7 @@ mu::Array numfnc_cot(const mu::Array& x)
 /////////////////////////////////////////////////
 mu::Array numfnc_sin(const mu::Array& a)
 {
-    return mu::apply(mu::MathImpl<std::complex<double>>::Sin, a);
+    return mu::apply(mu::MathImpl<std::complex<double>>::Sin, mu::simd::sin, a);
 }
 
 
@@ -4363,7 +4416,7 @@ mu::Array numfnc_sin(const mu::Array& a)
 /////////////////////////////////////////////////
 mu::Array numfnc_cos(const mu::Array& a)
 {
-    return mu::apply(mu::MathImpl<std::complex<double>>::Cos, a);
+    return mu::apply(mu::MathImpl<std::complex<double>>::Cos, mu::simd::cos, a);
 }
 
 
@@ -4376,7 +4429,7 @@ mu::Array numfnc_cos(const mu::Array& a)
 /////////////////////////////////////////////////
 mu::Array numfnc_tan(const mu::Array& a)
 {
-    return mu::apply(mu::MathImpl<std::complex<double>>::Tan, a);
+    return mu::apply(mu::MathImpl<std::complex<double>>::Tan, mu::simd::tan, a);
 }
 
 
@@ -4389,7 +4442,7 @@ mu::Array numfnc_tan(const mu::Array& a)
 /////////////////////////////////////////////////
 mu::Array numfnc_asin(const mu::Array& a)
 {
-    return mu::apply(mu::MathImpl<std::complex<double>>::ASin, a);
+    return mu::apply(mu::MathImpl<std::complex<double>>::ASin, mu::simd::asin, a);
 }
 
 
@@ -4402,7 +4455,7 @@ mu::Array numfnc_asin(const mu::Array& a)
 /////////////////////////////////////////////////
 mu::Array numfnc_acos(const mu::Array& a)
 {
-    return mu::apply(mu::MathImpl<std::complex<double>>::ACos, a);
+    return mu::apply(mu::MathImpl<std::complex<double>>::ACos, mu::simd::acos, a);
 }
 
 
@@ -4415,7 +4468,7 @@ mu::Array numfnc_acos(const mu::Array& a)
 /////////////////////////////////////////////////
 mu::Array numfnc_atan(const mu::Array& a)
 {
-    return mu::apply(mu::MathImpl<std::complex<double>>::ATan, a);
+    return mu::apply(mu::MathImpl<std::complex<double>>::ATan, mu::simd::atan, a);
 }
 
 
@@ -4428,7 +4481,7 @@ mu::Array numfnc_atan(const mu::Array& a)
 /////////////////////////////////////////////////
 mu::Array numfnc_sinh(const mu::Array& a)
 {
-    return mu::apply(mu::MathImpl<std::complex<double>>::Sinh, a);
+    return mu::apply(mu::MathImpl<std::complex<double>>::Sinh, mu::simd::sinh, a);
 }
 
 
@@ -4441,7 +4494,7 @@ mu::Array numfnc_sinh(const mu::Array& a)
 /////////////////////////////////////////////////
 mu::Array numfnc_cosh(const mu::Array& a)
 {
-    return mu::apply(mu::MathImpl<std::complex<double>>::Cosh, a);
+    return mu::apply(mu::MathImpl<std::complex<double>>::Cosh, mu::simd::cosh, a);
 }
 
 
@@ -4454,7 +4507,7 @@ mu::Array numfnc_cosh(const mu::Array& a)
 /////////////////////////////////////////////////
 mu::Array numfnc_tanh(const mu::Array& a)
 {
-    return mu::apply(mu::MathImpl<std::complex<double>>::Tanh, a);
+    return mu::apply(mu::MathImpl<std::complex<double>>::Tanh, mu::simd::tanh, a);
 }
 
 
@@ -6297,8 +6350,8 @@ mu::Array timfnc_is_daylightsavingtime(const mu::Array& nDate)
         time_info.tm_mday = day;
         time_info.tm_hour = 12;          // Set to noon to avoid ambiguity
 
-        __time64_t timestamp = _mktime64(&time_info);
-        std::tm* local_time = _localtime64(&timestamp);
+        time_t timestamp = std::mktime(&time_info);
+        std::tm* local_time = std::localtime(&timestamp);
 
         ret.emplace_back(local_time != nullptr && local_time->tm_isdst > 0);
     }
@@ -1722,6 +1722,29 @@ static Matrix matrixMaxPos(const MatFuncData& funcData, const MatFuncErrorInfo&
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Returns the real parts of all valid
+/// elements of the passed matrix.
+///
+/// \param mat const Matrix&
+/// \return std::vector<double>
+///
+/////////////////////////////////////////////////
+static std::vector<double> getValidRealValues(const Matrix& mat)
+{
+    std::vector<double> vData;
+    vData.reserve(mat.data().size());
+
+    for (const std::complex<double>& val : mat.data())
+    {
+        if (!isnan(val))
+            vData.push_back(val.real());
+    }
+
+    return vData;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief This static function applies the
 /// \c med() function on the matrix elements.
@@ -1736,19 +1759,8 @@ static Matrix matrixMed(const MatFuncData& funcData, const MatFuncErrorInfo& err
     if (funcData.mat1.isEmpty())
         throw SyntaxError(SyntaxError::MATRIX_CANNOT_HAVE_ZERO_SIZE, errorInfo.command, errorInfo.position);
 
-    Memory _mem;
-    size_t nElems = funcData.mat1.data().size();
-
-    // Preallocate
-    _mem.writeData(nElems-1, 0, 0.0);
-
-    //#pragma omp parallel for
-    for (size_t i = 0; i < nElems; i++)
-    {
-        _mem.writeDataDirectUnsafe(i, 0, funcData.mat1.data()[i]);
-    }
-
-    return createFilledMatrix(1, 1, _mem.med(VectorIndex(0, funcData.mat1.rows()*funcData.mat1.cols()-1), VectorIndex(0)));
+    std::vector<double> vData = getValidRealValues(funcData.mat1);
+    return createFilledMatrix(1, 1, selectQuantile(vData, 0.5));
 }
 
 
@@ -1772,30 +1784,47 @@ static Matrix matrixMovMed(const MatFuncData& funcData, const MatFuncErrorInfo&
 
     Matrix _mResult = createFilledMatrix(funcData.mat1.rows(), funcData.mat1.cols(), NAN);
 
+    int rows = funcData.mat1.rows();
+    int cols = funcData.mat1.cols();
+
+    // Returns the real part of an element or NaN, if
+    // the element is invalid. NaNs are ignored by the
+    // window
+    auto value = [&funcData](int i, int j) -> double
+    {
+        return isnan(funcData.mat1(i, j)) ? NAN : funcData.mat1(i, j).real();
+    };
+
     #pragma omp parallel for
-    for (int i = 0; i < (int)_mResult.rows(); i++)
+    for (int i = 0; i < rows; i++)
     {
-        for (int j = 0; j < (int)_mResult.cols(); j++)
+        int rowStart = std::max(0, i-funcData.nVal);
+        int rowEnd = std::min(rows-1, i+funcData.nVal);
+        WindowQuantile window(0.5);
+
+        // Fill the initial window
+        for (int m = 0; m <= std::min(cols-1, funcData.mVal); m++)
         {
-            if (!isnan(funcData.mat1(i, j)))
+            for (int n = rowStart; n <= rowEnd; n++)
             {
-                Memory _mem;
-
-                for (int n = 0; n < 2*funcData.nVal+1; n++)
-                {
-                    if (i+n-funcData.nVal < 0 || i+n-funcData.nVal >= (int)funcData.mat1.rows())
-                        continue;
+                window.push(value(n, m));
+            }
+        }
 
-                    for (int m = 0; m < 2*funcData.mVal+1; m++)
-                    {
-                        if (j+m-funcData.mVal < 0 || j+m-funcData.mVal >= (int)funcData.mat1.cols())
-                            continue;
+        // Slide the window along the row and exchange
+        // only the leaving and the entering column
+        for (int j = 0; j < cols; j++)
+        {
+            if (!isnan(funcData.mat1(i, j)))
+                _mResult(i, j) = window.quantile();
 
-                        _mem.writeData(m + n*(2*funcData.mVal+1), 0, funcData.mat1(i+n-funcData.nVal, j+m-funcData.mVal));
-                    }
-                }
+            for (int n = rowStart; n <= rowEnd; n++)
+            {
+                if (j-funcData.mVal >= 0)
+                    window.erase(value(n, j-funcData.mVal));
 
-                _mResult(i, j) = _mem.med(VectorIndex(0, (2*funcData.nVal+1)*(2*funcData.mVal+1)), VectorIndex(0));
+                if (j+funcData.mVal+1 < cols)
+                    window.push(value(n, j+funcData.mVal+1));
             }
         }
     }
@@ -1818,19 +1847,13 @@ static Matrix matrixPct(const MatFuncData& funcData, const MatFuncErrorInfo& err
     if (funcData.mat1.isEmpty())
         throw SyntaxError(SyntaxError::MATRIX_CANNOT_HAVE_ZERO_SIZE, errorInfo.command, errorInfo.position);
 
-    Memory _mem;
-    size_t nElems = funcData.mat1.data().size();
-
-    // Preallocate
-    _mem.writeData(nElems-1, 0, 0.0);
+    double dPct = funcData.fVal.getNum().asF64();
 
-    //#pragma omp parallel for
-    for (size_t i = 0; i < nElems; i++)
-    {
-        _mem.writeDataDirectUnsafe(i, 0, funcData.mat1.data()[i]);
-    }
+    if (dPct >= 1 || dPct <= 0)
+        return createFilledMatrix(1, 1, NAN);
 
-    return createFilledMatrix(1, 1, _mem.pct(VectorIndex(0, (long long int)(funcData.mat1.rows()*funcData.mat1.cols())-1), VectorIndex(0), funcData.fVal.getNum().asCF64()));
+    std::vector<double> vData = getValidRealValues(funcData.mat1);
+    return createFilledMatrix(1, 1, selectQuantile(vData, dPct));
 }
 
 
@@ -20,6 +20,9 @@
 #define STATSLOGIC_HPP
 
 #include "../ParserLib/muParserDef.h"
+#include <algorithm>
+#include <vector>
+#include <set>
 
 /////////////////////////////////////////////////
 /// \brief Simplify the creation of some
@@ -119,5 +122,377 @@ struct StatsLogic
 };
 
 
+/////////////////////////////////////////////////
+/// \brief Numerically stable single-pass
+/// accumulator for the count, the extrema, the
+/// compensated sum of squares and the central
+/// moments up to the fourth order of a real
+/// data set. Partial results (e.g. from
+/// different threads) may be merged.
+/////////////////////////////////////////////////
+struct StatsAccumulator
+{
+    size_t m_count;
+    double m_mean;
+    double m_m2;
+    double m_m3;
+    double m_m4;
+    double m_min;
+    double m_max;
+    double m_sumSq;
+    double m_sumSqComp;
+
+    StatsAccumulator() : m_count(0), m_mean(0), m_m2(0), m_m3(0), m_m4(0), m_min(NAN), m_max(NAN), m_sumSq(0), m_sumSqComp(0) {}
+
+    /////////////////////////////////////////////////
+    /// \brief Add a new value to the accumulator.
+    /// NaNs are ignored.
+    ///
+    /// \param val double
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void push(double val)
+    {
+        if (std::isnan(val))
+            return;
+
+        double n1 = m_count;
+        m_count++;
+
+        double n = m_count;
+        double delta = val - m_mean;
+        double delta_n = delta / n;
+        double delta_n2 = delta_n * delta_n;
+        double term = delta * delta_n * n1;
+
+        m_mean += delta_n;
+        m_m4 += term * delta_n2 * (n*n - 3*n + 3) + 6 * delta_n2 * m_m2 - 4 * delta_n * m_m3;
+        m_m3 += term * delta_n * (n - 2) - 3 * delta_n * m_m2;
+        m_m2 += term;
+
+        if (m_count == 1 || val < m_min)
+            m_min = val;
+
+        if (m_count == 1 || val > m_max)
+            m_max = val;
+
+        // Kahan summation of the squares
+        double y = val*val - m_sumSqComp;
+        double t = m_sumSq + y;
+        m_sumSqComp = (t - m_sumSq) - y;
+        m_sumSq = t;
+    }
+
+    /////////////////////////////////////////////////
+    /// \brief Merge the results of another
+    /// accumulator into this one.
+    ///
+    /// \param other const StatsAccumulator&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void merge(const StatsAccumulator& other)
+    {
+        if (!other.m_count)
+            return;
+
+        if (!m_count)
+        {
+            *this = other;
+            return;
+        }
+
+        double na = m_count;
+        double nb = other.m_count;
+        double n = na + nb;
+        double delta = other.m_mean - m_mean;
+        double delta2 = delta * delta;
+
+        double m4 = m_m4 + other.m_m4
+            + delta2 * delta2 * na * nb * (na*na - na*nb + nb*nb) / (n*n*n)
+            + 6 * delta2 * (na*na * other.m_m2 + nb*nb * m_m2) / (n*n)
+            + 4 * delta * (na * other.m_m3 - nb * m_m3) / n;
+        double m3 = m_m3 + other.m_m3
+            + delta2 * delta * na * nb * (na - nb) / (n*n)
+            + 3 * delta * (na * other.m_m2 - nb * m_m2) / n;
+
+        m_m2 += other.m_m2 + delta2 * na * nb / n;
+        m_m3 = m3;
+        m_m4 = m4;
+        m_mean += delta * nb / n;
+        m_count += other.m_count;
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+        m_sumSq += other.m_sumSq;
+        m_sumSqComp += other.m_sumSqComp;
+    }
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the sample variance.
+    ///
+    /// \return double
+    ///
+    /////////////////////////////////////////////////
+    double variance() const
+    {
+        if (m_count < 2)
+            return NAN;
+
+        return m_m2 / (m_count - 1);
+    }
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the compensated sum of
+    /// squares.
+    ///
+    /// \return double
+    ///
+    /////////////////////////////////////////////////
+    double sumOfSquares() const
+    {
+        return m_sumSq - m_sumSqComp;
+    }
+};
+
+
+/////////////////////////////////////////////////
+/// \brief Calculates the quantile p of the
+/// passed data set by selection instead of a
+/// full sort. The data is reordered in-place and
+/// must not contain NaNs. The result is
+/// identical to gsl_stats_quantile_from_sorted_data().
+///
+/// \param vData std::vector<double>&
+/// \param p double
+/// \return double
+///
+/////////////////////////////////////////////////
+inline double selectQuantile(std::vector<double>& vData, double p)
+{
+    if (!vData.size() || p < 0 || p > 1)
+        return NAN;
+
+    double index = (vData.size() - 1) * p;
+    size_t lhs = (size_t)index;
+    double delta = index - lhs;
+
+    std::nth_element(vData.begin(), vData.begin()+lhs, vData.end());
+
+    if (delta == 0.0 || lhs+1 >= vData.size())
+        return vData[lhs];
+
+    // The next order statistic is the smallest value
+    // of the right partition
+    double rhs = *std::min_element(vData.begin()+lhs+1, vData.end());
+
+    return (1.0 - delta) * vData[lhs] + delta * rhs;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Calculates multiple quantiles of the
+/// passed data set at once. Every selection
+/// only works on the partition right of the
+/// previous one, which is considerably cheaper
+/// than repeated calls to selectQuantile(). The
+/// data is reordered in-place and must not
+/// contain NaNs.
+///
+/// \param vData std::vector<double>&
+/// \param vP const std::vector<double>&
+/// \return std::vector<double>
+///
+/////////////////////////////////////////////////
+inline std::vector<double> selectQuantiles(std::vector<double>& vData, const std::vector<double>& vP)
+{
+    std::vector<double> vQuantiles(vP.size(), NAN);
+
+    if (!vData.size())
+        return vQuantiles;
+
+    // Collect all necessary order statistics
+    std::vector<size_t> vOrder;
+
+    for (double p : vP)
+    {
+        if (p < 0 || p > 1)
+            continue;
+
+        double index = (vData.size() - 1) * p;
+        vOrder.push_back((size_t)index);
+
+        if (index > (size_t)index && (size_t)index+1 < vData.size())
+            vOrder.push_back((size_t)index+1);
+    }
+
+    std::sort(vOrder.begin(), vOrder.end());
+    vOrder.erase(std::unique(vOrder.begin(), vOrder.end()), vOrder.end());
+
+    // Select them in ascending order on the
+    // shrinking right partitions
+    size_t first = 0;
+
+    for (size_t k : vOrder)
+    {
+        std::nth_element(vData.begin()+first, vData.begin()+k, vData.end());
+        first = k+1;
+    }
+
+    for (size_t i = 0; i < vP.size(); i++)
+    {
+        if (vP[i] < 0 || vP[i] > 1)
+            continue;
+
+        double index = (vData.size() - 1) * vP[i];
+        size_t lhs = (size_t)index;
+        double delta = index - lhs;
+
+        if (delta == 0.0 || lhs+1 >= vData.size())
+            vQuantiles[i] = vData[lhs];
+        else
+            vQuantiles[i] = (1.0 - delta) * vData[lhs] + delta * vData[lhs+1];
+    }
+
+    return vQuantiles;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Order statistic structure for sliding
+/// windows. The window is split into two sorted
+/// halves, whose boundary is kept at the
+/// requested quantile. Inserting and removing a
+/// value is logarithmic in the window size.
+/// NaNs are ignored.
+/////////////////////////////////////////////////
+class WindowQuantile
+{
+    private:
+        std::multiset<double> m_lower;
+        std::multiset<double> m_upper;
+        double m_p;
+
+        /////////////////////////////////////////////////
+        /// \brief Moves values between both halves
+        /// until the lower half contains exactly the
+        /// order statistics up to the quantile
+        /// position.
+        ///
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void rebalance()
+        {
+            size_t nCount = size();
+            size_t nLower = nCount ? (size_t)((nCount - 1) * m_p) + 1 : 0;
+
+            while (m_lower.size() > nLower)
+            {
+                auto iter = std::prev(m_lower.end());
+                m_upper.insert(*iter);
+                m_lower.erase(iter);
+            }
+
+            while (m_lower.size() < nLower)
+            {
+                m_lower.insert(*m_upper.begin());
+                m_upper.erase(m_upper.begin());
+            }
+        }
+
+    public:
+        WindowQuantile(double p = 0.5) : m_p(p) {}
+
+        /////////////////////////////////////////////////
+        /// \brief Add a value to the window.
+        ///
+        /// \param val double
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void push(double val)
+        {
+            if (std::isnan(val))
+                return;
+
+            if (m_lower.size() && val <= *m_lower.rbegin())
+                m_lower.insert(val);
+            else
+                m_upper.insert(val);
+
+            rebalance();
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Remove a value from the window.
+        ///
+        /// \param val double
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void erase(double val)
+        {
+            if (std::isnan(val))
+                return;
+
+            auto iter = m_lower.find(val);
+
+            if (iter != m_lower.end())
+                m_lower.erase(iter);
+            else if ((iter = m_upper.find(val)) != m_upper.end())
+                m_upper.erase(iter);
+
+            rebalance();
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Remove all values from the window.
+        ///
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void clear()
+        {
+            m_lower.clear();
+            m_upper.clear();
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Returns the number of values in the
+        /// window.
+        ///
+        /// \return size_t
+        ///
+        /////////////////////////////////////////////////
+        size_t size() const
+        {
+            return m_lower.size() + m_upper.size();
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Returns the quantile of the current
+        /// window using the same interpolation as
+        /// selectQuantile().
+        ///
+        /// \return double
+        ///
+        /////////////////////////////////////////////////
+        double quantile() const
+        {
+            if (!m_lower.size())
+                return NAN;
+
+            double index = (size() - 1) * m_p;
+            double delta = index - (size_t)index;
+
+            if (delta == 0.0 || !m_upper.size())
+                return *m_lower.rbegin();
+
+            return (1.0 - delta) * *m_lower.rbegin() + delta * *m_upper.begin();
+        }
+};
+
+
 #endif // STATSLOGIC_HPP
 
@@ -72,71 +72,48 @@ static std::vector<std::vector<double>> calcStats(MemoryManager& _data, const st
 {
     std::vector<std::vector<double>> vStats (STATS_FIELD_COUNT, std::vector<double>());
 
-    for (size_t j = 0; j < _idx.col.size(); j++)
+    // Calculate all values within a single pass
+    // over each column
+    std::vector<ColumnStatistics> vColStats = _data.describe(sTable, _idx.row, _idx.col);
+
+    for (const ColumnStatistics& colStats : vColStats)
     {
-        // Calculate built-in statistical values (short-cuts)
-        vStats[STATS_AVG].push_back(_data.avg(sTable, _idx.row, _idx.col.subidx(j, 1)).real());
-        vStats[STATS_STD].push_back(_data.std(sTable, _idx.row, _idx.col.subidx(j, 1)).real());
-        vStats[STATS_MED].push_back(_data.med(sTable, _idx.row, _idx.col.subidx(j, 1)).real());
-        vStats[STATS_Q1].push_back(_data.pct(sTable, _idx.row, _idx.col.subidx(j, 1), 0.25).real());
-        vStats[STATS_Q3].push_back(_data.pct(sTable, _idx.row, _idx.col.subidx(j, 1), 0.75).real());
-        vStats[STATS_MIN].push_back(_data.min(sTable, _idx.row, _idx.col.subidx(j, 1)).real());
-        vStats[STATS_MAX].push_back(_data.max(sTable, _idx.row, _idx.col.subidx(j, 1)).real());
-        vStats[STATS_NUM].push_back(_data.num(sTable, _idx.row, _idx.col.subidx(j, 1)).real());
-        vStats[STATS_CNT].push_back(_data.cnt(sTable, _idx.row, _idx.col.subidx(j, 1)).real());
-        vStats[STATS_RMS].push_back(_data.norm(sTable, _idx.row, _idx.col.subidx(j, 1)).real());
+        vStats[STATS_AVG].push_back(colStats.m_avg);
+        vStats[STATS_STD].push_back(colStats.m_std);
+        vStats[STATS_MED].push_back(colStats.m_med);
+        vStats[STATS_Q1].push_back(colStats.m_q1);
+        vStats[STATS_Q3].push_back(colStats.m_q3);
+        vStats[STATS_MIN].push_back(colStats.m_min);
+        vStats[STATS_MAX].push_back(colStats.m_max);
+        vStats[STATS_NUM].push_back(colStats.m_num);
+        vStats[STATS_CNT].push_back(colStats.m_cnt);
 
         // Many values make no sense if no data
         // is available
-        if (!vStats[STATS_NUM].back())
+        if (!colStats.m_num)
         {
             vStats[STATS_CONFINT].push_back(NAN);
             vStats[STATS_SKEW].push_back(NAN);
             vStats[STATS_EXC].push_back(NAN);
             vStats[STATS_STDERR].push_back(NAN);
             vStats[STATS_S_T].push_back(NAN);
+            vStats[STATS_RMS].push_back(NAN);
             vStats[STATS_STD].back() = NAN;
-            vStats[STATS_RMS].back() = NAN;
             continue;
         }
 
-        vStats[STATS_CONFINT].push_back(0.0);
-        vStats[STATS_SKEW].push_back(0.0);
-        vStats[STATS_EXC].push_back(0.0);
-
-        // Calculate Confidence interval count,
-        // Skewness and Excess
-        for (size_t i = 0; i < _idx.row.size(); i++)
-        {
-            if (!_data.isValidElement(_idx.row[i], _idx.col[j], sTable))
-                continue;
-
-            double val = _data.getElement(_idx.row[i], _idx.col[j], sTable).getNum().asF64();
-
-            if (fabs(val - vStats[STATS_AVG].back()) <= vStats[STATS_STD].back())
-                vStats[STATS_CONFINT].back()++;
-
-            vStats[STATS_SKEW].back() += intPower(val - vStats[STATS_AVG].back(), 3);
-            vStats[STATS_EXC].back() += intPower(val - vStats[STATS_AVG].back(), 4);
-        }
-
-        // Finalize the confidence interval count
-        vStats[STATS_CONFINT].back() /= vStats[STATS_NUM].back();
-        vStats[STATS_CONFINT].back() = round(10000.0*vStats[STATS_CONFINT].back()) / 100.0;
-
-        // Finalize Skewness and Excess
-        vStats[STATS_SKEW].back() /= vStats[STATS_NUM].back() * intPower(vStats[STATS_STD].back(), 3);
-        vStats[STATS_EXC].back() /= vStats[STATS_NUM].back() * intPower(vStats[STATS_STD].back(), 4);
-        vStats[STATS_EXC].back() -= 3.0; // Convert Kurtosis to Excess
+        vStats[STATS_CONFINT].push_back(round(10000.0*colStats.m_confidence) / 100.0);
+        vStats[STATS_SKEW].push_back(colStats.m_skew);
+        vStats[STATS_EXC].push_back(colStats.m_excess);
 
         // Calculate 2nd order stats values available
         // from simple arithmetic operations
-        vStats[STATS_STDERR].push_back(vStats[STATS_STD].back() / sqrt(vStats[STATS_NUM].back()));
-        vStats[STATS_RMS].back() /= sqrt(vStats[STATS_NUM].back());
+        vStats[STATS_STDERR].push_back(colStats.m_std / sqrt(colStats.m_num));
+        vStats[STATS_RMS].push_back(colStats.m_norm / sqrt(colStats.m_num));
 
         // Use BOOST to calculate the Student-t value for
         // the current number of freedoms
-        vStats[STATS_S_T].push_back(student_t(vStats[STATS_NUM].back(), 0.95));
+        vStats[STATS_S_T].push_back(student_t(colStats.m_num, 0.95));
     }
 
     return vStats;
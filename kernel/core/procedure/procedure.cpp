@@ -105,6 +105,7 @@ void Procedure::init()
     nthBlock = 0;
     nFlags = 0;
 
+    m_procElement = nullptr;
     _varFactory = nullptr;
 }
 
@@ -443,9 +444,14 @@ Returnvalue Procedure::ProcCalc(string sLine, string sCurrentCommand, int& nByte
         }
     }
 
-    // Set the expression and evaluate it
+    // Set the expression and evaluate it. The current
+    // line is used as key in the persistent bytecode cache.
+    // The file is only hashed, if a line has to be parsed
     if (!_parser.IsAlreadyParsed(sLine))
+    {
+        _parser.SetCacheLocation(m_procElement ? m_procElement->getFileHash() : "", nCurrentLine);
         _parser.SetExpr(sLine);
+    }
 
     v = _parser.Eval(nNum);
     _assertionHandler.checkAssertion(v, nNum);
@@ -572,6 +578,7 @@ Returnvalue Procedure::execute(StringView sProc, string sVarList, mu::Parser& _p
     bool bSupressAnswer_back = NumeReKernel::bSupressAnswer;
 
     ProcedureElement* ProcElement = NumeReKernel::ProcLibrary.getProcedureContents(sCurrentProcedureName);
+    m_procElement = ProcElement;
 
     NumeReDebugger& _debugger = NumeReKernel::getInstance()->getDebugger();
     _debugger.pushStackItem(sProc + "(" + sVarList + ")", this);
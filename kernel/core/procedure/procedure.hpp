@@ -45,6 +45,7 @@
 
 // forward declaration of the var factory
 class ProcedureVarFactory;
+class ProcedureElement;
 
 
 /////////////////////////////////////////////////
@@ -61,6 +62,7 @@ class Procedure : public FlowCtrl, public PackageManager
         std::fstream fProcedure;
         std::string sProcNames;
         std::string sCurrentProcedureName;
+        ProcedureElement* m_procElement;
         int nCurrentLine;
         std::string sNameSpace;
         std::string sCallingNameSpace;
@@ -23,6 +23,8 @@
 #include "../plotting/plotting.hpp"
 
 #include <memory>
+#include <fstream>
+#include <libsha.hpp>
 
 
 /////////////////////////////////////////////////
@@ -33,7 +35,7 @@
 /// \param sFilePath const std::string&
 ///
 /////////////////////////////////////////////////
-ProcedureElement::ProcedureElement(const StyledTextFile& procedureContents, const std::string& sFilePath) : sFileName(sFilePath), m_dependencies(nullptr)
+ProcedureElement::ProcedureElement(const StyledTextFile& procedureContents, const std::string& sFilePath) : sFileName(sFilePath), m_isHashed(false), m_dependencies(nullptr)
 {
     std::string sFolderPath = sFileName.substr(0, sFileName.rfind('/'));
     std::string sProcCommandLine;
@@ -41,7 +43,6 @@ ProcedureElement::ProcedureElement(const StyledTextFile& procedureContents, cons
     std::string sCurrentLineCache;
     std::string sProcPlotCompose;
 
-
     std::unique_ptr<Includer> _includer;
     int i = 0;
     int currentLine = 0;
@@ -491,3 +492,28 @@ Dependencies* ProcedureElement::getDependencies()
     return m_dependencies;
 }
 
+
+/////////////////////////////////////////////////
+/// \brief This member function returns the hash
+/// identifying the current contents of the file
+/// within the persistent bytecode cache. The
+/// hash is only calculated upon the first call.
+///
+/// \return const std::string&
+///
+/////////////////////////////////////////////////
+const std::string& ProcedureElement::getFileHash() const
+{
+    if (!m_isHashed)
+    {
+        std::fstream procFile(sFileName, std::ios_base::in | std::ios_base::binary);
+
+        if (procFile.good())
+            m_fileHash = sha256(procFile);
+
+        m_isHashed = true;
+    }
+
+    return m_fileHash;
+}
+
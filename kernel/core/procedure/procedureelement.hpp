@@ -40,6 +40,8 @@ class ProcedureElement
         std::vector<std::pair<int, ProcedureCommandLine>> mProcedureContents;
         std::map<std::string, int> mProcedureList;
         std::string sFileName;
+        mutable std::string m_fileHash;
+        mutable bool m_isHashed;
         Dependencies* m_dependencies;
         SymDefManager _symdefs;
 
@@ -58,6 +60,20 @@ class ProcedureElement
             return sFileName;
         }
 
+        const std::string& getFileHash() const;
+
+        /////////////////////////////////////////////////
+        /// \brief Returns, whether the hash of the file
+        /// was already calculated.
+        ///
+        /// \return bool
+        ///
+        /////////////////////////////////////////////////
+        bool isHashed() const
+        {
+            return m_isHashed;
+        }
+
         void resolveSymbols(std::string& sCommandLine)
         {
             _symdefs.resolveSymbols(sCommandLine);
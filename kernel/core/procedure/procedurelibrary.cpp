@@ -99,7 +99,8 @@ ProcedureElement* ProcedureLibrary::getProcedureContents(const std::string& sPro
 
 /////////////////////////////////////////////////
 /// \brief Perform an update, e.g. if a procedure
-/// was deleted.
+/// was deleted. The cached bytecode of modified or
+/// deleted files is invalidated.
 ///
 /// \return void
 ///
@@ -108,6 +109,9 @@ void ProcedureLibrary::updateLibrary()
 {
     for (auto iter = mLibraryEntries.begin(); iter != mLibraryEntries.end(); )
     {
+        // Files, which have not been hashed yet, have
+        // not consulted the cache in this session
+        std::string sFileHash = iter->second->isHashed() ? iter->second->getFileHash() : "";
         delete (iter->second);
 
         try
@@ -116,14 +120,21 @@ void ProcedureLibrary::updateLibrary()
 
             if (element)
             {
+                if (sFileHash.length() && element->getFileHash() != sFileHash)
+                    m_byteCodeCache.invalidate(sFileHash);
+
                 iter->second = element;
                 iter++;
             }
             else
+            {
+                m_byteCodeCache.invalidate(sFileHash);
                 iter = mLibraryEntries.erase(iter);
+            }
         }
         catch (...)
         {
+            m_byteCodeCache.invalidate(sFileHash);
             iter = mLibraryEntries.erase(iter);
         }
     }
@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include "procedureelement.hpp"
+#include "../ParserLib/muParserCache.hpp"
 #include <string>
 #include <fstream>
 #include <map>
@@ -34,6 +35,7 @@ class ProcedureLibrary
 {
     private:
         std::map<std::string, ProcedureElement*> mLibraryEntries;
+        mu::ByteCodeCache m_byteCodeCache;
 
         ProcedureElement* constructProcedureElement(const std::string& sProcedureFileName);
         StyledTextFile getFileContents(const std::string& sProcedureFileName);
@@ -43,6 +45,11 @@ class ProcedureLibrary
 
         ProcedureElement* getProcedureContents(const std::string& sProcedureFileName);
         void updateLibrary();
+
+        mu::ByteCodeCache& getByteCodeCache()
+        {
+            return m_byteCodeCache;
+        }
 };
 
 #endif
@@ -58,6 +58,7 @@ Settings::Settings() : Documentation()
     m_settings[SETTING_B_ENABLEEXECUTE] = SettingsValue(false, SettingsValue::SAVE | SettingsValue::IMMUTABLE);
     m_settings[SETTING_B_MASKDEFAULT] = SettingsValue(false);
     m_settings[SETTING_B_DECODEARGUMENTS] = SettingsValue(false);
+    m_settings[SETTING_B_PARSERJIT] = SettingsValue(false);
     m_settings[SETTING_V_PRECISION] = SettingsValue(7u, 1u, 14u);
     m_settings[SETTING_V_AUTOSAVE] = SettingsValue(30u, 0u, -1u);
     m_settings[SETTING_V_WINDOW_X] = SettingsValue(140u, 0u, -1u, SettingsValue::HIDDEN);
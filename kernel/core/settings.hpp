@@ -47,6 +47,7 @@
 #define SETTING_B_ENABLEEXECUTE       "flowctrl.enableexecute"
 #define SETTING_B_MASKDEFAULT         "flowctrl.maskdefault"
 #define SETTING_B_DECODEARGUMENTS     "debugger.decodearguments"
+#define SETTING_B_PARSERJIT           "parser.jit"
 #define SETTING_B_GREETING            "terminal.greeting"
 #define SETTING_V_PRECISION           "terminal.precision"
 #define SETTING_V_WINDOW_X            "terminal.windowsize.x"
@@ -1206,6 +1207,17 @@ class Settings : public Documentation
         inline bool useMaskDefault() const
             {return m_settings.at(SETTING_B_MASKDEFAULT).active();}
 
+        /////////////////////////////////////////////////
+        /// \brief Returns, whether the parser shall
+        /// use the compiled tier for frequently
+        /// evaluated expressions.
+        ///
+        /// \return bool
+        ///
+        /////////////////////////////////////////////////
+        inline bool useParserJit() const
+            {return m_settings.at(SETTING_B_PARSERJIT).active();}
+
         /////////////////////////////////////////////////
         /// \brief Returns, whether the debugger shall
         /// try to decode procedure arguments.
@@ -1554,9 +1554,9 @@ mu::Array strfnc_substr(const mu::Array& sStr, const mu::Array& pos, const mu::A
         }
 
         if (!len.isDefault())
-            ret.emplace_back(sStr.get(i).getStr().substr(std::max(0LL, pos.get(i).getNum().asI64()-1), len.get(i).getNum().asI64()));
+            ret.emplace_back(sStr.get(i).getStr().substr(std::max<int64_t>(0, pos.get(i).getNum().asI64()-1), len.get(i).getNum().asI64()));
         else
-            ret.emplace_back(sStr.get(i).getStr().substr(std::max(0LL, pos.get(i).getNum().asI64()-1)));
+            ret.emplace_back(sStr.get(i).getStr().substr(std::max<int64_t>(0, pos.get(i).getNum().asI64()-1)));
     }
 
     return ret;
@@ -1813,7 +1813,7 @@ mu::Array strfnc_replace(const mu::Array& where, const mu::Array& from, const mu
         std::string s = where.get(i).getStr();
         const std::string& r = rep.get(i).getStr();
 
-        int64_t p = std::min((int64_t)s.length(), std::max(1LL, from.get(i).getNum().asI64()));
+        int64_t p = std::min((int64_t)s.length(), std::max<int64_t>(1, from.get(i).getNum().asI64()));
         int64_t l = len.get(i).getNum().asI64();
 
         if (!s.length())
@@ -1935,7 +1935,7 @@ mu::Array strfnc_textparse(const mu::Array& sStr, const mu::Array& pattern, cons
             pos1 = std::max(pos1, p1.get(i).getNum().asI64());
 
         if (!p2.isDefault())
-            pos2 = std::min(pos2, std::max(1LL, p2.get(i).getNum().asI64()));
+            pos2 = std::min(pos2, std::max<int64_t>(1, p2.get(i).getNum().asI64()));
 
         // Exclude border cases
         if (!sSearchString.length() || pos1 > (int64_t)sSearchString.length())
@@ -2995,7 +2995,9 @@ mu::Array strfnc_getodbcdrivers()
 
 /////////////////////////////////////////////////
 /// \brief Implementation of the getfileinfo()
-/// function.
+/// function. NDAT files additionally return
+/// their table name, their dimensions and a
+/// description of every column.
 ///
 /// \param file const mu::Array&
 /// \return mu::Array
@@ -3044,6 +3046,47 @@ mu::Array strfnc_getfileinfo(const mu::Array& file)
         sFileInfo.emplace_back(fInfo.creationTime);
         sFileInfo.emplace_back("ModificationTime");
         sFileInfo.emplace_back(fInfo.modificationTime);
+
+        // NDAT files additionally describe the stored
+        // table and its columns. v5 files are not read
+        // completely for this
+        if (toLowerCase(fInfo.ext) != "ndat")
+            continue;
+
+        NumeRe::NumeReDataFile ndat(file[i].getStr());
+
+        try
+        {
+            ndat.readFileSchema();
+        }
+        catch (...)
+        {
+            continue;
+        }
+
+        NumeRe::FileHeaderInfo info = ndat.getFileHeaderInformation();
+
+        sFileInfo.emplace_back("TableName");
+        sFileInfo.emplace_back(info.sTableName);
+        sFileInfo.emplace_back("Rows");
+        sFileInfo.emplace_back(info.nRows);
+        sFileInfo.emplace_back("Cols");
+        sFileInfo.emplace_back(info.nCols);
+
+        // One key-value pair per column: "name [unit]: type (rows)"
+        for (size_t j = 0; j < info.vColumns.size(); j++)
+        {
+            const NumeRe::FileColumnInfo& col = info.vColumns[j];
+            std::string sColumn = col.sHeadLine;
+
+            if (col.sUnit.length())
+                sColumn += " [" + col.sUnit + "]";
+
+            sColumn += ": " + TableColumn::typeToString(col.type) + " (" + toString(col.nRows) + ")";
+
+            sFileInfo.emplace_back("Column" + toString(j+1));
+            sFileInfo.emplace_back(sColumn);
+        }
     }
 #endif // PARSERSTANDALONE
     return sFileInfo;
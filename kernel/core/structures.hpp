@@ -22,6 +22,7 @@
 
 #include <string>
 #include <cstring>
+#include <cstdint>
 #include <stdexcept>
 #include <vector>
 #include <set>
@@ -29,8 +30,9 @@
 #include <algorithm>
 #include "interval.hpp"
 
-long long int intCast(const std::complex<double>&);
+int64_t intCast(const std::complex<double>&);
 std::string toString(int);
+std::string toString(long int);
 std::string toString(long long int);
 
 
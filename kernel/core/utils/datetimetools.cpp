@@ -18,7 +18,12 @@
 
 #include "datetimetools.hpp"
 #include "../../../externals/date/include/date/iso_week.h"
+#include <cmath>
+#ifdef _WIN32
 #include "windows.h"
+#else
+#include <ctime>
+#endif
 
 /////////////////////////////////////////////////
 /// \brief Default constructor for
@@ -295,6 +300,19 @@ size_t getWeekNum(sys_time_point tp)
 /////////////////////////////////////////////////
 time_zone getCurrentTimeZone()
 {
+#ifndef _WIN32
+    // Use the Windows convention: the bias is UTC minus
+    // local time in minutes without the daylight saving time
+    time_t now = time(nullptr);
+    tm localTime;
+    localtime_r(&now, &localTime);
+
+    time_zone tz;
+    tz.DayLightBias = std::chrono::minutes(localTime.tm_isdst > 0 ? -60 : 0);
+    tz.Bias = std::chrono::minutes(-localTime.tm_gmtoff / 60) - tz.DayLightBias;
+
+    return tz;
+#else
     TIME_ZONE_INFORMATION timezone;
     int res = GetTimeZoneInformation(&timezone);
 
@@ -303,6 +321,7 @@ time_zone getCurrentTimeZone()
     tz.DayLightBias = res == TIME_ZONE_ID_DAYLIGHT ? std::chrono::minutes(timezone.DaylightBias) : std::chrono::minutes(0);
 
     return tz;
+#endif // _WIN32
 }
 
 
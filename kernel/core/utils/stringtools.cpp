@@ -185,9 +185,9 @@ std::string toString(sys_time_point tp, int timeStampFlags)
 
     if (!(timeStampFlags & GET_ONLY_TIME))
     {
-        timeStream << ltm.m_ymd.year() << "-"; //YYYY-
-        timeStream << std::setfill('0') << std::setw(2) << unsigned(ltm.m_ymd.month()) << "-"; // MM-
-        timeStream << ltm.m_ymd.day(); 	// DD
+        timeStream << std::setfill('0') << std::setw(4) << int(ltm.m_ymd.year()) << "-"; //YYYY-
+        timeStream << std::setw(2) << unsigned(ltm.m_ymd.month()) << "-"; // MM-
+        timeStream << std::setw(2) << unsigned(ltm.m_ymd.day()); 	// DD
 
         if (!(timeStampFlags & GET_ONLY_DATE))
         {
@@ -240,6 +240,21 @@ std::string toString(sys_time_point tp, int timeStampFlags)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Converts a long int to a string. This
+/// overload resolves int64_t on platforms, where
+/// it is a long int instead of a long long int.
+///
+/// \param nNumber long int
+/// \return string
+///
+/////////////////////////////////////////////////
+std::string toString(long int nNumber)
+{
+    return toString((long long int)nNumber);
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Converts a long long int to a string.
 ///
@@ -1768,7 +1783,7 @@ std::string ansiToUtf8(const std::string& sString)
 /////////////////////////////////////////////////
 std::string getTimeStamp(bool bGetStamp)
 {
-    return toString(_time64(0), bGetStamp ? GET_AS_TIMESTAMP : GET_WITH_TEXT);
+    return toString(time(nullptr), bGetStamp ? GET_AS_TIMESTAMP : GET_WITH_TEXT);
 }
 
 
@@ -434,6 +434,7 @@ std::string toString(const std::complex<double>& dNumber, int nPrecision = 7);
 std::string toString(int);
 std::string toString(__time64_t tTime, int timeStampFlags);
 std::string toString(sys_time_point tp, int timeStampFlags);
+std::string toString(long int nNumber);
 std::string toString(long long int nNumber);
 std::string toString(size_t nNumber);
 std::string toCmdString(double dNumber);
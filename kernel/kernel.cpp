@@ -25,6 +25,8 @@
 
 #include "core/maths/functionimplementation.hpp"
 #include "core/strings/functionimplementation.hpp"
+#include "core/ParserLib/muParserTemplateMagic.h"
+#include "core/ParserLib/muParserParallel.hpp"
 
 #define KERNEL_PRINT_SLEEP 2
 #define TERMINAL_FORMAT_FIELD_LENOFFSET 16
@@ -126,6 +128,7 @@ void NumeReKernel::setKernelSettings(const Settings& _settings)
 {
     _option.copySettings(_settings);
     _debugger.setActive(_settings.useDebugger());
+    _parser.EnableJit(_settings.useParserJit());
 
     synchronizePathSettings();
 }
@@ -172,10 +175,16 @@ void NumeReKernel::synchronizePathSettings()
 /////////////////////////////////////////////////
 void NumeReKernel::Autosave()
 {
+    // Report the errors of finished background saves
+    _memoryManager.collectFinishedSaves(false);
+
     if (!_memoryManager.getSaveStatus())
     {
         g_logger.info("Autosaving tables.");
-        _memoryManager.saveToCacheFile();
+
+        // The cache file is written in the background
+        // so that the session is not blocked
+        _memoryManager.saveToCacheFile(true);
     }
 }
 
@@ -315,6 +324,17 @@ void NumeReKernel::StartUp(NumeReTerminal* _parent, const std::string& __sPath,
         }
     }
 
+    // Load the persistent bytecode cache of the procedures
+    g_logger.info("Loading bytecode cache.");
+    ProcLibrary.getByteCodeCache().setFileName(_option.getExePath() + "/numere.bytecode");
+    ProcLibrary.getByteCodeCache().load();
+    _parser.SetByteCodeCache(&ProcLibrary.getByteCodeCache());
+    _parser.EnableJit(_option.useParserJit());
+
+    // Measure the costs of the parallel evaluation
+    g_logger.info("Calibrating parallel evaluation.");
+    mu::ParallelCalibration::get();
+
     // Load the binary plot font
     g_logger.info("Loading plotting font.");
     _fontData.LoadFont(_option.getDefaultPlotFont().c_str(), (_option.getExePath() + "\\fonts").c_str());
@@ -744,6 +764,25 @@ void NumeReKernel::defineNumFunctions()
     _parser.DefineFun("cf32", cast_numerical_cmplx<float>);                      // cf32(x)
     _parser.DefineFun("cf64", cast_numerical_cmplx<double>);                     // cf64(x)
 
+    // Scalar counterparts for the compiled expression tier
+    _parser.DefineScalarFun(numfnc_exp, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Exp>);
+    _parser.DefineScalarFun(numfnc_sqrt, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Sqrt>);
+    _parser.DefineScalarFun(numfnc_log2, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Log2>);
+    _parser.DefineScalarFun(numfnc_log10, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Log10>);
+    _parser.DefineScalarFun(numfnc_ln, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Log>);
+    _parser.DefineScalarFun(numfnc_sin, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Sin>);
+    _parser.DefineScalarFun(numfnc_cos, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Cos>);
+    _parser.DefineScalarFun(numfnc_tan, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Tan>);
+    _parser.DefineScalarFun(numfnc_asin, mu::scalarImpl<mu::MathImpl<std::complex<double>>::ASin>);
+    _parser.DefineScalarFun(numfnc_acos, mu::scalarImpl<mu::MathImpl<std::complex<double>>::ACos>);
+    _parser.DefineScalarFun(numfnc_atan, mu::scalarImpl<mu::MathImpl<std::complex<double>>::ATan>);
+    _parser.DefineScalarFun(numfnc_sinh, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Sinh>);
+    _parser.DefineScalarFun(numfnc_cosh, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Cosh>);
+    _parser.DefineScalarFun(numfnc_tanh, mu::scalarImpl<mu::MathImpl<std::complex<double>>::Tanh>);
+    _parser.DefineScalarFun(numfnc_asinh, mu::scalarImpl<mu::MathImpl<std::complex<double>>::ASinh>);
+    _parser.DefineScalarFun(numfnc_acosh, mu::scalarImpl<mu::MathImpl<std::complex<double>>::ACosh>);
+    _parser.DefineScalarFun(numfnc_atanh, mu::scalarImpl<mu::MathImpl<std::complex<double>>::ATanh>);
+
     /////////////////////////////////////////////////////////////////////
     // NOTE:
     // If multi-argument functions are declared, think of whether
@@ -2509,6 +2548,8 @@ void NumeReKernel::CloseSession()
     if (!m_parent)
         return;
 
+    // Complete all background loads and saves first
+    _memoryManager.waitForPendingIO();
     saveData();
     _memoryManager.removeTablesFromMemory();
 
@@ -2529,6 +2570,18 @@ void NumeReKernel::CloseSession()
     g_logger.info("Saving options.");
     _option.save(_option.getExePath()); // MAIN_QUIT
 
+    g_logger.info("Saving bytecode cache.");
+    ProcLibrary.getByteCodeCache().save();
+
+    if (_option.useParserJit())
+    {
+        mu::JitStatistics jitStats = mu::ParserBase::GetJitStatistics();
+        g_logger.info("Compiled expressions: " + toString(jitStats.compiled) + " compiled, "
+                      + toString(jitStats.rejected) + " rejected, "
+                      + toString(jitStats.evaluations) + " evaluations, "
+                      + toString(jitStats.fallbacks) + " fallbacks.");
+    }
+
     // Do some clean-up stuff here
     sCommandLine.clear();
     sAnswer.clear();
@@ -2766,6 +2819,14 @@ NumeReVariables NumeReKernel::getVariableList()
         if ((iter->first).starts_with("_~"))
             continue;
 
+        // Tables, which are still loaded in the background,
+        // shall not be awaited here
+        if (_memoryManager.isPendingTable(iter->first))
+        {
+            vars.vVariables.push_back(iter->first + "()\t0 x 0\ttable\t{...}\t" + iter->first + "()\t" + formatByteSize(0));
+            continue;
+        }
+
         sCurrentLine = iter->first + "()\t" + toString(_memoryManager.getLines(iter->first, false)) + " x "
             + toString(_memoryManager.getCols(iter->first, false));
         sCurrentLine += "\ttable\t{" + toString(_memoryManager.min(iter->first, "")[0], DEFAULT_MINMAX_PRECISION) + ", ..., "
@@ -3466,7 +3527,7 @@ void NumeReKernel::showTable(NumeRe::Table _table, std::string __name, bool open
         // Create the task
         NumeReTask task;
         task.sString = __name + "()";
-        task.table = _table;
+        task.table = std::move(_table);
 
         // Use the corresponding task type
         if (openeditable)